@@ -21,7 +21,6 @@
 #include "eth.h"
 #include "fdcan.h"
 #include "ltdc.h"
-#include "quadspi.h"
 #include "sai.h"
 #include "sdmmc.h"
 #include "gpio.h"
@@ -113,7 +112,6 @@ int main(void)
   MX_FDCAN2_Init();
   MX_FMC_Init();
   MX_LTDC_Init();
-  MX_QUADSPI_Init();
   MX_SAI2_Init();
   MX_SDMMC1_MMC_Init();
   /* USER CODE BEGIN 2 */
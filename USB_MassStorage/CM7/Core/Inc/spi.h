@@ -36,6 +36,9 @@ extern SPI_HandleTypeDef hspi2;
 
 /* USER CODE BEGIN Private defines */
 
+extern DMA_HandleTypeDef hdma_spi2_rx;
+extern DMA_HandleTypeDef hdma_spi2_tx;
+
 /* USER CODE END Private defines */
 
 void MX_SPI2_Init(void);
@@ -57,7 +57,9 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void OTG_FS_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void DMA1_Stream0_IRQHandler(void);
+void DMA1_Stream1_IRQHandler(void);
+void SPI2_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
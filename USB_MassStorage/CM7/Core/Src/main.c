@@ -18,6 +18,7 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "quadspi.h"
 #include "spi.h"
 #include "usart.h"
 #include "usb_device.h"
@@ -30,6 +31,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "FactoryInvalidBlockScan_Test.h"
+#include "FlashTranslationLayer.h"
+#include "Remap_service.h"
+#include "usbd_storage_if.h"
 
 /* USER CODE END Includes */
 
@@ -45,6 +49,9 @@
 #define HSEM_ID_0 (0U) /* HW semaphore 0*/
 #endif
 
+/// Main loop: no fixed delay, the NAND idle work (FTL_Idle) times itself
+#define MAIN_HEARTBEAT_MS   1000U   // USART2 alive message
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -133,12 +140,19 @@ int main(void)
 	/* Initialize all configured peripherals */
 	MX_GPIO_Init();
 	MX_SPI2_Init();
+	MX_QUADSPI_Init();
 	// MX_USART3_UART_Init();
 	MX_USB_DEVICE_Init();
 	MX_USART2_UART_Init();
 	/* USER CODE BEGIN 2 */
 
 	GPIO_Initial_PB4();
+	NandLog_Init();                 // NAND trace ring (RAM_D3), before any NAND access
+	BBT_MountLazy();                // Saved table, or verify blocks in the idle loop
+#if NAND_REMAP
+	Remap_Mount();                  // Raw partition above the FTL range
+#endif
+	FTL_Mount();                    // USB storage reports ready from here on
 	/// printf("\033[2J\033[H"); // 清空 Terminal UART 畫面
 
 	/// ======================================================================
@@ -156,15 +170,39 @@ int main(void)
 	/* Infinite loop */
 	/* USER CODE BEGIN WHILE */
 
+	uint32_t beat = HAL_GetTick();
+
 	while (1)
 	{
 		/* USER CODE END WHILE */
 
-		uint8_t msg[] = "USART2 check\r\n";
-		HAL_UART_Transmit(&huart2, msg, sizeof(msg)-1, HAL_MAX_DELAY);
-		HAL_Delay(1000);
-
 		/* USER CODE BEGIN 3 */
+
+		/// Heartbeat on its own tick, the NAND work below runs on every pass
+		if (HAL_GetTick() - beat >= MAIN_HEARTBEAT_MS)
+		{
+			uint8_t msg[] = "USART2 check\r\n";
+			HAL_UART_Transmit(&huart2, msg, sizeof(msg)-1, HAL_MAX_DELAY);
+			beat = HAL_GetTick();
+		}
+
+		/// NAND background work, USB storage callbacks (OTG_FS IRQ) held off
+		HAL_NVIC_DisableIRQ(OTG_FS_IRQn);
+		FTL_Idle();
+		HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
+
+		/// Host idle: background GC, one bounded step per masked section
+		bool gc_more = true;
+
+		while (gc_more)
+		{
+			HAL_NVIC_DisableIRQ(OTG_FS_IRQn);
+			gc_more = USBD_MSC_IsIdle() && FTL_Background();
+			HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
+		}
+
+		/// NAND trace: format pending records in idle time
+		NandLog_Drain(0);
 	}
 
 	/* USER CODE END 3 */
@@ -0,0 +1,97 @@
+/*
+ *  Cache.h
+ *
+ *  Created on: Nov 20, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_CACHE_H_
+#define INC_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FlashTranslationLayer.h"
+
+/* ---------------------------------------------------------------------------
+ * Sector Write Buffer
+ * ---------------------------------------------------------------------------
+ * Host sectors that do not fill a whole page are collected here, one page
+ * sized slot per logical page, instead of a page read + merge + program per
+ * command. A slot goes to the mapping layer when:
+ *
+ *  - Complete   : all sectors of the page written -> programmed as is
+ *  - Pressure   : no slot left for a new page -> least recently written one
+ *  - Idle       : not written for CACHE_IDLE_US (checked from FTL_Idle)
+ *  - Sync       : SYNCHRONIZE CACHE / eject / FTL_Sync
+ *
+ * Only the last three merge (read the page for the sectors not held).
+ * Reads of buffered sectors are served from the slot.
+ *
+ * CACHE_SLOTS   : Page slots (2 KB each)
+ * CACHE_IDLE_US : Age after which FTL_Idle writes a slot out
+ * --------------------------------------------------------------------------- */
+#ifndef CACHE_SLOTS
+#define CACHE_SLOTS             4U
+#endif
+
+#ifndef CACHE_IDLE_US
+#define CACHE_IDLE_US           200000U
+#endif
+
+#if CACHE_SLOTS < 1 || CACHE_SLOTS > 32
+#error "CACHE_SLOTS must be 1 ~ 32"
+#endif
+
+#define CACHE_FULL_MASK         ((1U << FTL_SECTORS_PER_PAGE) - 1U)
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t sectors_in;      // Sectors taken into a slot
+	uint32_t sectors_hit;     // Sectors read back from a slot
+	uint32_t complete;        // Slots written because the page was complete
+	uint32_t evicted;         // Slots written for room
+	uint32_t idle;            // Slots written after CACHE_IDLE_US
+	uint32_t synced;          // Slots written by Cache_Flush
+	uint32_t merges;          // Page reads to fill a partial slot
+	uint32_t errors;          // Slot writes that failed
+} Cache_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Cache_Reset
+ *  - Drop every slot (mount: sectors of a lost session are gone).
+ *
+ * Cache_Write
+ *  - Sectors [off, off + n) of logical page `lpn` into its slot. A page
+ *    completed by them is written at once.
+ *
+ * Cache_Discard
+ *  - Page `lpn` written whole by the caller: its slot is stale.
+ *
+ * Cache_Mask / Cache_Overlay
+ *  - Sectors of `lpn` held (bit per sector) / copied over `buf`, which holds
+ *    sectors [off, off + n) of the page.
+ *
+ * Cache_Flush
+ *  - Every slot written to the mapping layer (no checkpoint).
+ *
+ * Cache_Idle
+ *  - Slots older than CACHE_IDLE_US written. A slot seen twice is written
+ *    regardless (the clock wraps after a few seconds).
+ * ------------------------------------------------------------------------- */
+void Cache_Reset(void);
+bool Cache_Write(uint32_t lpn, uint32_t off, uint32_t n, const uint8_t *data);
+void Cache_Discard(uint32_t lpn);
+uint32_t Cache_Mask(uint32_t lpn);
+void Cache_Overlay(uint32_t lpn, uint32_t off, uint32_t n, uint8_t *buf);
+bool Cache_Flush(void);
+bool Cache_Idle(void);
+
+const Cache_Stats_t* Cache_GetStats(void);
+
+#endif /* INC_CACHE_H_ */
@@ -0,0 +1,213 @@
+/*
+ *  FTL_Config.h
+ *
+ *  Created on: Nov 19, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_FTL_CONFIG_H_
+#define INC_FTL_CONFIG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "BBT_service.h"
+#include "Remap_service.h"
+
+/* ---------------------------------------------------------------------------
+ * Physical Range
+ * ---------------------------------------------------------------------------
+ * FTL_FIRST_BLOCK / FTL_LAST_BLOCK : Blocks owned by the FTL (between the
+ *                                    checkpoint spares and the Remap raw
+ *                                    partition below the second factory info
+ *                                    area)
+ * FTL_CKPT_BLOCK_A / B             : Checkpoint ping-pong blocks (factory info
+ *                                    area, next to the Remap store 4 / 5 and
+ *                                    the BBT copies 6 / 7)
+ * FTL_CKPT_SPARES                  : Replacement checkpoint blocks right after
+ *                                    the factory info area, one takes over
+ *                                    when a ping-pong block goes bad
+ * FTL_CKPT_BLOCK(i)                : Checkpoint block candidates, A / B first
+ * --------------------------------------------------------------------------- */
+#ifndef FTL_CKPT_SPARES
+#define FTL_CKPT_SPARES         4U
+#endif
+
+#define FTL_FIRST_BLOCK         (FACTORY_INFO_BLOCK_END + FTL_CKPT_SPARES)
+#define FTL_LAST_BLOCK          (REMAP_FIRST_BLOCK - 1)
+#define FTL_BLOCKS              (FTL_LAST_BLOCK + 1 - FTL_FIRST_BLOCK)
+#define FTL_CKPT_BLOCK_A        (FACTORY_INFO_BLOCK_END - 6)
+#define FTL_CKPT_BLOCK_B        (FACTORY_INFO_BLOCK_END - 5)
+#define FTL_CKPT_BLOCKS         (2U + FTL_CKPT_SPARES)
+#define FTL_CKPT_BLOCK(i)       (((i) < 2U) ? FTL_CKPT_BLOCK_A + (i) : \
+                                 FACTORY_INFO_BLOCK_END + (i) - 2U)
+#define FTL_NONE                0xFFFFFFFFU
+
+/* ---------------------------------------------------------------------------
+ * Mapping Scheme (build time)
+ * ---------------------------------------------------------------------------
+ * FTL_MAPPING_PAGE   : Page mapping (MappingTable.c, GarbageCollection.c,
+ *                      Invalidata.c), best random writes, ~100 KB of RAM
+ * FTL_MAPPING_HYBRID : Block mapping with log blocks (HybridMapping.c),
+ *                      a few KB of RAM, for builds without external SDRAM
+ *
+ * Both use the same API (MappingTable.h) and the same FTL range. Hybrid
+ * mode formats a device without its format record, page mode refuses one
+ * holding data but no checkpoint: erase the FTL range to switch to it.
+ * --------------------------------------------------------------------------- */
+#define FTL_MAPPING_PAGE        0
+#define FTL_MAPPING_HYBRID      1
+
+#ifndef FTL_MAPPING
+#define FTL_MAPPING             FTL_MAPPING_PAGE
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Capacity
+ * ---------------------------------------------------------------------------
+ * FTL_OP_PERCENT     : Over-provisioning, share of the good pages never
+ *                      exposed to the host (GC headroom, translation pages)
+ * FTL_RESERVE_BLOCKS : Blocks kept out of the capacity on top of it (open
+ *                      blocks, GC reserve, blocks going bad over the life)
+ *
+ * The logical size is fixed when the FTL is formatted and stored in the
+ * checkpoint, later bad blocks eat into the over-provisioning.
+ * --------------------------------------------------------------------------- */
+#ifndef FTL_OP_PERCENT
+#define FTL_OP_PERCENT          7U
+#endif
+
+#ifndef FTL_RESERVE_BLOCKS
+#define FTL_RESERVE_BLOCKS      24U
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Garbage Collection
+ * ---------------------------------------------------------------------------
+ * FTL_GC_FREE_LOW : A block allocation for host data runs GC first when
+ *                   fewer free blocks remain (whole victims, unbounded)
+ * FTL_GC_FREE_HIGH: Bounded GC steps keep the free blocks up to this many:
+ *                   in idle time (USB BOT idle) and per host write command
+ * FTL_GC_FG_MOVES : Page moves per host sector written, foreground share
+ *                   below FTL_GC_FREE_HIGH (bounds the write latency)
+ * FTL_GC_IDLE_MOVES : Page moves per background step (interrupt held off
+ *                   for that long, ~0.3 ms per move)
+ * FTL_GC_RESERVE  : Free blocks only GC relocation may take
+ * FTL_GC_POLICY   : Victim choice at start-up (GC_SetPolicy changes it)
+ *                   FTL_GC_GREEDY       : fewest valid pages
+ *                   FTL_GC_COST_BENEFIT : age * (1 - u) / 2u, u = valid share
+ *                                         (cold blocks collected earlier,
+ *                                         hot ones left to invalidate more)
+ * --------------------------------------------------------------------------- */
+#define FTL_GC_GREEDY           0
+#define FTL_GC_COST_BENEFIT     1
+
+#ifndef FTL_GC_FREE_LOW
+#define FTL_GC_FREE_LOW         8U
+#endif
+
+#ifndef FTL_GC_FREE_HIGH
+#define FTL_GC_FREE_HIGH        16U
+#endif
+
+#ifndef FTL_GC_FG_MOVES
+#define FTL_GC_FG_MOVES         2U
+#endif
+
+#ifndef FTL_GC_IDLE_MOVES
+#define FTL_GC_IDLE_MOVES       16U
+#endif
+
+#ifndef FTL_GC_RESERVE
+#define FTL_GC_RESERVE          3U
+#endif
+
+#if FTL_GC_FREE_HIGH <= FTL_GC_FREE_LOW
+#error "FTL_GC_FREE_HIGH must be above FTL_GC_FREE_LOW"
+#endif
+
+#ifndef FTL_GC_POLICY
+#define FTL_GC_POLICY           FTL_GC_GREEDY
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Hot / Cold Separation (HotCold.h)
+ * ---------------------------------------------------------------------------
+ * FTL_HOT_COLD : 1 -> three write frontiers: host pages estimated hot, host
+ *                pages estimated cold, GC copies. 0 -> one for everything.
+ * --------------------------------------------------------------------------- */
+#ifndef FTL_HOT_COLD
+#define FTL_HOT_COLD            1
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Wear Leveling (WearLeveling.h)
+ * ---------------------------------------------------------------------------
+ * FTL_WL_THRESHOLD : Erase count spread (highest - coldest used block) above
+ *                    which cold data is migrated
+ * FTL_WL_INTERVAL  : Block erases between two static wear leveling checks
+ * --------------------------------------------------------------------------- */
+#ifndef FTL_WL_THRESHOLD
+#define FTL_WL_THRESHOLD        32U
+#endif
+
+#ifndef FTL_WL_INTERVAL
+#define FTL_WL_INTERVAL         32U
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Cached Mapping Table
+ * ---------------------------------------------------------------------------
+ * MAP_CACHE_SLOTS   : Translation pages held in RAM (2 KB each, LRU). 16 slots
+ *                     cover 8192 logical pages = 16 MB of mapping at a time.
+ * MAP_PENDING_BITS  : 2^bits mapping updates held in RAM until their
+ *                     translation page is written (8 bytes each, stored in
+ *                     the checkpoint). More of them -> more updates per
+ *                     translation page write, GC relocations included.
+ *
+ * MAP_ENTRIES_PER_TPAGE : Physical page numbers in one translation page
+ * MAP_TPAGES            : Translation pages of the largest logical space
+ * --------------------------------------------------------------------------- */
+#ifndef MAP_CACHE_SLOTS
+#define MAP_CACHE_SLOTS         16U
+#endif
+
+#ifndef MAP_PENDING_BITS
+#define MAP_PENDING_BITS        12U
+#endif
+
+#define MAP_ENTRIES_PER_TPAGE   (PAGE_MAIN_SIZE / sizeof(uint32_t))
+#define MAP_TPAGES              (TOTAL_PAGES / MAP_ENTRIES_PER_TPAGE)
+
+/* ---------------------------------------------------------------------------
+ * Page Tag (spare area of every page written by the FTL)
+ * ---------------------------------------------------------------------------
+ * kind : FTL_TAG_DATA / FTL_TAG_TRANS / FTL_TAG_CKPT / FTL_TAG_LOG (hybrid
+ *        random-write log), erased -> 0xFFFFFFFF
+ * gen  : Format generation, pages of an older format are never replayed
+ * id   : Logical page (data), translation page index (trans),
+ *        index << 16 | page count (checkpoint). FTL_TAG_MOVED set on a
+ *        copy made by GC (content unchanged).
+ * seq  : Write sequence, one per page programmed, never reused
+ *
+ * FTL_TAG_COL : Spare column (spare[0..3] left to the bad block marker)
+ * FTL_WL_COL  : Erase count of the block (uint32_t), right after the tag
+ * --------------------------------------------------------------------------- */
+#define FTL_TAG_DATA            0x41544144u   // "DATA"
+#define FTL_TAG_TRANS           0x4E415254u   // "TRAN"
+#define FTL_TAG_CKPT            0x54504B43u   // "CKPT"
+#define FTL_TAG_LOG             0x474F4C52u   // "RLOG"
+#define FTL_TAG_MOVED           0x80000000u
+#define FTL_TAG_COL             (PAGE_MAIN_SIZE + 4)
+#define FTL_WL_COL              (FTL_TAG_COL + 16)
+
+typedef struct
+{
+	uint32_t kind;
+	uint32_t gen;
+	uint32_t id;
+	uint32_t seq;
+} FTL_Tag_t;
+
+#endif /* INC_FTL_CONFIG_H_ */
@@ -0,0 +1,104 @@
+/*
+ *  FlashTranslationLayer.h
+ *
+ *  Created on: Nov 18, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_FLASHTRANSLATIONLAYER_H_
+#define INC_FLASHTRANSLATIONLAYER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "MappingTable.h"
+
+/* ---------------------------------------------------------------------------
+ * Sector Geometry (USB MSC view)
+ * ---------------------------------------------------------------------------
+ * FTL_SECTOR_SIZE      : Host sector (STORAGE_BLK_SIZ)
+ * FTL_SECTORS_PER_PAGE : Sectors in one NAND main area (2048 / 512 = 4)
+ * --------------------------------------------------------------------------- */
+#define FTL_SECTOR_SIZE         512U
+#define FTL_SECTORS_PER_PAGE    (PAGE_MAIN_SIZE / FTL_SECTOR_SIZE)
+
+/* ---------------------------------------------------------------------------
+ * Idle Schedule (FTL_Idle)
+ * ---------------------------------------------------------------------------
+ * FTL_IDLE_PERIOD_US : Write buffer aging / checkpoint check interval (half
+ *                      of CACHE_IDLE_US), the lazy BBT step runs on every
+ *                      call
+ * FTL_SYNC_IDLE_US   : Host quiet time before the checkpoint is written
+ *                      (not between the packets of a transfer)
+ * --------------------------------------------------------------------------- */
+#ifndef FTL_IDLE_PERIOD_US
+#define FTL_IDLE_PERIOD_US      100000U
+#endif
+
+#ifndef FTL_SYNC_IDLE_US
+#define FTL_SYNC_IDLE_US        1000000U
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t read_cmds;       // FTL_ReadSectors calls
+	uint32_t write_cmds;      // FTL_WriteSectors calls
+	uint32_t sectors_read;
+	uint32_t sectors_written;
+	uint32_t page_reads;      // Pages read from the mapping layer
+	uint32_t page_writes;     // Pages written to the mapping layer
+	uint32_t buffered;        // Sectors of partial pages sent to the write buffer
+	uint32_t errors;          // Calls that returned false
+} FTL_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * FTL_Mount
+ *  - Mount the mapping layer (after BBT_Mount / BBT_MountLazy). The FTL
+ *    reports "ready" only afterwards.
+ *
+ * FTL_IsReady / FTL_SectorCount
+ *  - USB MSC TEST UNIT READY / READ CAPACITY.
+ *
+ * FTL_ReadSectors / FTL_WriteSectors
+ *  - `count` host sectors from `lba`. Whole pages straight from / to `buf`,
+ *    a partial first / last page goes through the sector write buffer
+ *    (Cache.h). One mapping call per 64 logical pages touched.
+ *
+ * FTL_Sync
+ *  - Write buffer flushed and checkpoint now (no roll-forward needed).
+ *    SYNCHRONIZE CACHE / eject.
+ *
+ * FTL_Flush
+ *  - Write buffer flushed only, the pages are found by roll-forward.
+ *    WRITE(10/12) with FUA, before the command status.
+ *
+ * FTL_Idle
+ *  - Background work, called on every main loop pass: lazy BBT
+ *    verification each call, idle write buffer slots and the checkpoint
+ *    after host writes stopped every FTL_IDLE_PERIOD_US. The caller keeps
+ *    the USB interrupt off meanwhile.
+ *
+ * FTL_Background
+ *  - Host idle (USB BOT state machine idle): one bounded GC step towards
+ *    FTL_GC_FREE_HIGH free blocks, true while more remains. Host writes
+ *    do their own bounded share (FTL_GC_FG_MOVES per sector).
+ * ------------------------------------------------------------------------- */
+bool FTL_Mount(void);
+bool FTL_IsReady(void);
+uint32_t FTL_SectorCount(void);
+
+bool FTL_ReadSectors(uint32_t lba, uint8_t *buf, uint32_t count);
+bool FTL_WriteSectors(uint32_t lba, const uint8_t *buf, uint32_t count);
+bool FTL_Sync(void);
+bool FTL_Flush(void);
+void FTL_Idle(void);
+bool FTL_Background(void);
+
+const FTL_Stats_t* FTL_GetStats(void);
+
+#endif /* INC_FLASHTRANSLATIONLAYER_H_ */
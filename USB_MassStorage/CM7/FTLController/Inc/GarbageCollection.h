@@ -0,0 +1,117 @@
+/*
+ *  GarbageCollection.h
+ *
+ *  Created on: Nov 19, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_GARBAGECOLLECTION_H_
+#define INC_GARBAGECOLLECTION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+#include "Invalidata.h"
+
+/* ---------------------------------------------------------------------------
+ * Block States (FTL range)
+ * ---------------------------------------------------------------------------
+ * GC_BLOCK_FREE : No valid page, erased when allocated
+ * GC_BLOCK_OPEN : Being written (write frontier)
+ * GC_BLOCK_USED : Full or closed, GC candidate
+ * GC_BLOCK_BAD  : Bad block table entry, never allocated
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	GC_BLOCK_FREE = 0,
+	GC_BLOCK_OPEN,
+	GC_BLOCK_USED,
+	GC_BLOCK_BAD
+} GC_BlockState_t;
+
+/* ---------------------------------------------------------------------------
+ * Victim Policy
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	GC_POLICY_GREEDY = FTL_GC_GREEDY,
+	GC_POLICY_COST_BENEFIT = FTL_GC_COST_BENEFIT
+} GC_Policy_t;
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t collections;     // Victim blocks reclaimed
+	uint32_t pages_moved;     // Valid pages relocated
+	uint32_t retired;         // Blocks retired after a program / erase failure
+	uint32_t erases;          // Blocks erased for allocation
+	uint32_t runs;            // GC_Run calls that collected something
+	uint32_t steps;           // GC_Step calls that moved pages
+	uint32_t time_us;         // Time spent in runs and steps
+	uint32_t max_us;          // Longest run
+	uint32_t step_max_us;     // Longest step
+} GC_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * GC_Reset
+ *  - Block states from the BBT and the valid counts (mount): bad, used
+ *    (valid pages) or free. Open blocks are set by the caller afterwards.
+ *
+ * GC_SetState / GC_State / GC_FreeCount
+ *  - Block state bookkeeping, the free count follows the transitions.
+ *
+ * GC_AllocBlock
+ *  - Least worn free block (WearLeveling.h), BBT verified and erased, now
+ *    open.
+ *    Erase failure -> marked bad, next one. Only GC (`reserve` = true) may
+ *    go below FTL_GC_RESERVE free blocks.
+ *
+ * GC_Run
+ *  - GC until `target` blocks are free: victim from the valid count
+ *    buckets (Invalidata.h) by the policy, a cold block first when static
+ *    wear leveling asks for it. Pages relocated in batches through
+ *    Map_RelocateBlock.
+ *
+ * GC_Step
+ *  - Bounded GC towards `target` free blocks: `moves` page relocations at
+ *    most, the victim carried over to the next step. Idle time and host
+ *    command share.
+ *
+ * GC_SetPolicy / GC_GetPolicy
+ *  - Greedy or cost-benefit victim choice.
+ *
+ * GC_Retire
+ *  - Block that failed a program: valid pages relocated, marked bad.
+ *
+ * GC_Pin / GC_UnpinAll
+ *  - Pinned blocks hold translation pages of the last checkpoint and are
+ *    not collected before the next one (roll-forward reads them).
+ *
+ * GC_IsActive
+ *  - Inside GC: block allocations may use the reserve, no nested GC.
+ * ------------------------------------------------------------------------- */
+void GC_Reset(void);
+void GC_SetState(uint32_t block, GC_BlockState_t state);
+GC_BlockState_t GC_State(uint32_t block);
+uint32_t GC_FreeCount(void);
+
+uint32_t GC_AllocBlock(bool reserve);
+bool GC_Run(uint32_t target);
+bool GC_Step(uint32_t target, uint32_t moves);
+bool GC_Retire(uint32_t block);
+
+void GC_SetPolicy(GC_Policy_t policy);
+GC_Policy_t GC_GetPolicy(void);
+
+void GC_Pin(uint32_t block);
+void GC_UnpinAll(void);
+bool GC_IsActive(void);
+
+const GC_Stats_t* GC_GetStats(void);
+
+#endif /* INC_GARBAGECOLLECTION_H_ */
@@ -0,0 +1,84 @@
+/*
+ *  HotCold.h
+ *
+ *  Created on: Nov 23, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_HOTCOLD_H_
+#define INC_HOTCOLD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+
+/* ---------------------------------------------------------------------------
+ * Hot / Cold Classification
+ * ---------------------------------------------------------------------------
+ * Update frequency of the logical pages, kept in a count-min sketch:
+ * HC_ROWS rows of HC_WIDTH 8-bit counters, one hash per row. A host write
+ * raises only the smallest of its counters (conservative update), the
+ * estimate is the smallest of them: never below the real count, above it
+ * only when every row collides.
+ *
+ * Every HC_DECAY writes all counters are halved: what counts is the recent
+ * rate, a page rewritten often long ago cools down again.
+ *
+ * Hot: estimate >= HC_HOT_THRESHOLD once the write is counted (FAT,
+ * directory entries, metadata rewritten by every append). Everything else
+ * is cold (bulk data written once). RAM only, all pages start cold after
+ * a mount.
+ *
+ * HC_WIDTH         : Counters per row (power of 2), HC_ROWS rows
+ * HC_DECAY         : Writes between two halvings (well below HC_WIDTH, the
+ *                    counters of pages written once stay near 0)
+ * HC_HOT_THRESHOLD : Recent writes of a page that make it hot
+ * --------------------------------------------------------------------------- */
+#define HC_ROWS                 4U
+
+#ifndef HC_WIDTH
+#define HC_WIDTH                2048U
+#endif
+
+#ifndef HC_DECAY
+#define HC_DECAY                (HC_WIDTH / 2U)
+#endif
+
+#ifndef HC_HOT_THRESHOLD
+#define HC_HOT_THRESHOLD        2U
+#endif
+
+#if (HC_WIDTH & (HC_WIDTH - 1U)) != 0 || HC_WIDTH < 64U
+#error "HC_WIDTH must be a power of 2, 64 at least"
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t hot;             // Writes classified hot
+	uint32_t cold;            // Writes classified cold
+	uint32_t decays;          // Halvings of the sketch
+} HC_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * HC_Reset
+ *  - Every counter 0 (mount).
+ *
+ * HC_Write
+ *  - Count a host write of `lpn`, true when the page is hot.
+ *
+ * HC_Estimate
+ *  - Recent writes of `lpn` (sketch estimate).
+ * ------------------------------------------------------------------------- */
+void HC_Reset(void);
+bool HC_Write(uint32_t lpn);
+uint32_t HC_Estimate(uint32_t lpn);
+
+const HC_Stats_t* HC_GetStats(void);
+
+#endif /* INC_HOTCOLD_H_ */
@@ -0,0 +1,97 @@
+/*
+ *  HybridMapping.h
+ *
+ *  Created on: Nov 21, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_HYBRIDMAPPING_H_
+#define INC_HYBRIDMAPPING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+#include "MappingTable.h"
+
+/* ---------------------------------------------------------------------------
+ * Hybrid Mapping (FAST: block-mapped data blocks + page-mapped log blocks)
+ * ---------------------------------------------------------------------------
+ * FTL_MAPPING == FTL_MAPPING_HYBRID only, implements the Map_* API.
+ *
+ * Data block : Logical block -> one physical block, page i holds logical
+ *              page i of the block (block map in RAM, 2 bytes per block).
+ * SW log     : One sequential log block. A write to page 0 of a logical
+ *              block opens it, following pages are appended in order.
+ *              Complete -> switch merge (it becomes the data block, no copy),
+ *              broken off -> partial merge (remaining pages copied in).
+ * RW log     : HYB_LOG_BLOCKS random log blocks shared by all logical blocks
+ *              (fully associative), page map in RAM. All full -> the oldest is
+ *              reclaimed: full merge (new data block from the newest copies)
+ *              of every logical block with a page in it.
+ *
+ * Nothing is checkpointed: every page carries its tag, the mount scans page
+ * 0 / 63 of every block and the RW log pages. A merge interrupted by power
+ * loss (or the open SW log) is completed at mount.
+ *
+ * RAM: block map (4 KB) + RW page map (256 bytes per log block) + bitmaps.
+ * Capacity: good blocks less FTL_RESERVE_BLOCKS and the log blocks
+ * (FTL_OP_PERCENT does not apply, there is no GC).
+ *
+ * HYB_LOG_BLOCKS : RW log blocks (more -> fewer full merges under random
+ *                  writes, part of the format)
+ * --------------------------------------------------------------------------- */
+#ifndef HYB_LOG_BLOCKS
+#define HYB_LOG_BLOCKS         8U
+#endif
+
+#if HYB_LOG_BLOCKS < 2 || HYB_LOG_BLOCKS > 32
+#error "HYB_LOG_BLOCKS must be 2 ~ 32"
+#endif
+
+#define HYB_FORMAT_MAGIC       0x31425948u   // "HYB1"
+#define HYB_LBLOCKS_MAX        FTL_BLOCKS
+#define HYB_OPEN_MAX           4U
+
+/* ---------------------------------------------------------------------------
+ * Format Record (FTL_CKPT_BLOCK_A page 0, written once per format)
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t magic;
+	uint32_t gen;
+	uint32_t lblocks;
+	uint32_t log_blocks;
+	uint32_t crc;
+} Hyb_Format_t;
+
+/* ---------------------------------------------------------------------------
+ * Statistics (Map_GetStats: data_writes, copy_back, through_ram, replayed =
+ * RW log pages found at mount, recovered = mounts completing a merge)
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t sw_writes;       // Host pages appended to the SW log
+	uint32_t rw_writes;       // Host pages appended to the RW log
+	uint32_t switch_merges;   // SW log complete, became the data block
+	uint32_t partial_merges;  // SW log completed by copies
+	uint32_t full_merges;     // New data block from the newest copies
+	uint32_t merge_copies;    // Pages copied by partial / full merges
+	uint32_t reclaims;        // RW log blocks reclaimed
+	uint32_t erases;          // Blocks erased for allocation
+	uint32_t retired;         // Blocks retired after a program / erase failure
+} Hyb_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Hyb_FreeCount
+ *  - Free blocks (erased when allocated).
+ *
+ * Hyb_GetStats
+ *  - Merge and log counters.
+ * ------------------------------------------------------------------------- */
+uint32_t Hyb_FreeCount(void);
+const Hyb_Stats_t* Hyb_GetStats(void);
+
+#endif /* INC_HYBRIDMAPPING_H_ */
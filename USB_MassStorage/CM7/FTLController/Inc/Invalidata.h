@@ -0,0 +1,63 @@
+/*
+ *  Invalidata.h
+ *
+ *  Created on: Nov 19, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_INVALIDATA_H_
+#define INC_INVALIDATA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+
+/* ---------------------------------------------------------------------------
+ * Valid Page Tracking
+ * ---------------------------------------------------------------------------
+ * One bit per physical page (64 per block = one uint64_t, 16 KB in total).
+ * A page is valid while the mapping points at it: set when a data or
+ * translation page is written, cleared when its logical page is written
+ * again. Rebuilt from the translation pages at mount, never stored.
+ *
+ * Valid count buckets: tracked blocks (GC candidates) sit in one list per
+ * valid count (0 ~ 64), moved along as pages turn valid / invalid. The
+ * block with the fewest valid pages is the head of the lowest non-empty
+ * list, found without scanning the blocks. Within a list, the block that
+ * entered it first comes first.
+ * --------------------------------------------------------------------------- */
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Inv_Reset
+ *  - Every page invalid.
+ *
+ * Inv_SetValid / Inv_Invalidate / Inv_IsValid
+ *  - One physical page (FTL_NONE ignored).
+ *
+ * Inv_ValidCount
+ *  - Valid pages of a block (popcount).
+ *
+ * Inv_NextValid
+ *  - First valid page of `block` at or after `page`, PAGES_PER_BLOCK if none.
+ *
+ * Inv_Track
+ *  - Block into (true) / out of (false) its valid count bucket.
+ *
+ * Inv_BucketFirst / Inv_BucketNext
+ *  - Walk the tracked blocks with `count` valid pages, FTL_NONE at the end.
+ * ------------------------------------------------------------------------- */
+void Inv_Reset(void);
+void Inv_SetValid(uint32_t ppn);
+void Inv_Invalidate(uint32_t ppn);
+bool Inv_IsValid(uint32_t ppn);
+uint32_t Inv_ValidCount(uint32_t block);
+uint32_t Inv_NextValid(uint32_t block, uint32_t page);
+
+void Inv_Track(uint32_t block, bool on);
+uint32_t Inv_BucketFirst(uint32_t count);
+uint32_t Inv_BucketNext(uint32_t block);
+
+#endif /* INC_INVALIDATA_H_ */
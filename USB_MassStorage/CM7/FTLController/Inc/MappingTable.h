@@ -0,0 +1,183 @@
+/*
+ *  MappingTable.h
+ *
+ *  Created on: Nov 18, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_MAPPINGTABLE_H_
+#define INC_MAPPINGTABLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+#include "ContinuousRead_service.h"
+
+/* ---------------------------------------------------------------------------
+ * Page Mapping (DFTL: demand-based page-level mapping)
+ * ---------------------------------------------------------------------------
+ * Every logical page can live in any physical page. Writes go out of place
+ * to the write frontier, the old copy only turns invalid, GC reclaims it.
+ *
+ * Mapping table : One physical page number per logical page, itself stored
+ *                 in translation pages on flash (512 entries each).
+ * GTD           : Global translation directory, translation page -> physical
+ *                 page, in RAM (MAP_TPAGES entries, 1 KB).
+ * CMT           : Cached mapping table, MAP_CACHE_SLOTS translation pages in
+ *                 RAM, LRU, for lookups. Never dirty: eviction costs nothing.
+ * Pending       : Mapping updates not yet in their translation page (hash by
+ *                 logical page). Past MAP_PENDING_HIGH entries, the
+ *                 translation page with the most pending updates is written
+ *                 (batched: one program for all of them).
+ * Checkpoint    : GTD + pending updates + erase counters (WearLeveling.h)
+ *                 + frontier + sequence in the
+ *                 ping-pong blocks FTL_CKPT_BLOCK_A / B (a spare replaces
+ *                 one gone bad), every MAP_CKPT_INTERVAL blocks and on
+ *                 Map_Sync. After power loss,
+ *                 the pages written since are replayed from their tags
+ *                 (roll-forward).
+ *
+ * MAP_CKPT_INTERVAL : Block allocations between automatic checkpoints (bounds
+ *                     the roll-forward)
+ *
+ * Write frontiers (FTL_HOT_COLD, one open block each):
+ *  MAP_FR_HOT  : Host pages the update estimate calls hot (HotCold.h),
+ *                translation pages
+ *  MAP_FR_COLD : Other host pages
+ *  MAP_FR_GC   : GC copies (data that outlived its block: cold)
+ *
+ * FTL_MAPPING_HYBRID builds implement the same Map_* API in HybridMapping.c
+ * (Map_Relocate excepted, no GC there).
+ * --------------------------------------------------------------------------- */
+#ifndef MAP_CKPT_INTERVAL
+#define MAP_CKPT_INTERVAL      32U
+#endif
+
+#define MAP_PENDING_ENTRIES    (1U << MAP_PENDING_BITS)
+#define MAP_PENDING_HIGH       (MAP_PENDING_ENTRIES - MAP_PENDING_ENTRIES / 8U)
+#define MAP_CKPT_MAGIC         0x33504B43u   // "CKP3"
+#define MAP_CKPT_MAX_PAGES     20U
+#define MAP_REPLAY_MAX         (MAP_CKPT_INTERVAL * 2U)
+
+#if FTL_HOT_COLD
+#define MAP_FRONTIERS          3U
+#define MAP_FR_HOT             0U
+#define MAP_FR_COLD            1U
+#define MAP_FR_GC              2U
+#else
+#define MAP_FRONTIERS          1U
+#define MAP_FR_HOT             0U
+#define MAP_FR_COLD            0U
+#define MAP_FR_GC              0U
+#endif
+
+#if MAP_CACHE_SLOTS < 2 || MAP_CACHE_SLOTS > 255
+#error "MAP_CACHE_SLOTS must be 2 ~ 255"
+#endif
+
+/// GTD (1 KB) + pending updates (32 KB at 12 bits) + erase counts (4 KB)
+/// within MAP_CKPT_MAX_PAGES
+#if MAP_PENDING_BITS < 6 || MAP_PENDING_BITS > 12
+#error "MAP_PENDING_BITS must be 6 ~ 12"
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Pending mapping update (checkpoint payload after the GTD)
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t lpn;
+	uint32_t ppn;
+} Map_Pending_t;
+
+/* ---------------------------------------------------------------------------
+ * Checkpoint Header (last page of a checkpoint, payload pages in front)
+ * ---------------------------------------------------------------------------
+ * seq          : First write sequence not covered by the checkpoint
+ * pages        : Logical pages (fixed at format)
+ * pending      : Pending updates in the payload
+ * fr_block/page: Write frontiers, where their next page goes
+ * payload_pages: Pages in front of the header
+ * payload_crc  : CRC32 of each payload page
+ * crc          : CRC32 of the header up to this field
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t magic;
+	uint32_t gen;
+	uint32_t seq;
+	uint32_t pages;
+	uint32_t pending;
+	uint32_t fr_block[MAP_FRONTIERS];
+	uint32_t fr_page[MAP_FRONTIERS];
+	uint32_t payload_pages;
+	uint32_t payload_crc[MAP_CKPT_MAX_PAGES];
+	uint32_t crc;
+} Map_Ckpt_t;
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t data_writes;     // Host pages programmed
+	uint32_t cache_hits;      // Lookups served by the CMT or pending updates
+	uint32_t cache_misses;    // Translation pages loaded
+	uint32_t entry_reads;     // Single entries read from flash (write path)
+	uint32_t tpage_writes;    // Translation pages written (batched updates)
+	uint32_t checkpoints;
+	uint32_t copy_back;       // Relocations by internal copy
+	uint32_t through_ram;     // Relocations of uncorrectable sources
+	uint32_t replayed;        // Pages rolled forward at mount
+	uint32_t recovered;       // Mounts after power loss
+	uint32_t formats;
+	uint32_t programs;        // Pages programmed, any kind (WA = programs / data_writes)
+} Map_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Map_Mount
+ *  - Newest valid checkpoint, roll-forward if pages were written after it,
+ *    valid pages rebuilt from the translation pages. No checkpoint -> new
+ *    format (capacity from the good blocks).
+ *
+ * Map_PageCount
+ *  - Logical pages exposed (good pages less over-provisioning).
+ *
+ * Map_ReadPages
+ *  - `count` pages from `lpn` (PAGES_PER_BLOCK at most). Physically
+ *    consecutive runs in one Continuous Read stream, unwritten pages 0xFF.
+ *
+ * Map_WritePages
+ *  - `count` pages from `lpn` (PAGES_PER_BLOCK at most), data[i] -> lpn + i,
+ *    appended at the write frontier. Never rewrites a block in place.
+ *
+ * Map_Sync
+ *  - Checkpoint (no-op when nothing changed since the last one). Pending
+ *    updates go into it as they are, no translation page is written.
+ *
+ * Map_Reclaim
+ *  - Bounded GC below FTL_GC_FREE_HIGH free blocks, `moves` page copies at
+ *    most. true -> still below and more to do (idle time loop). Page
+ *    mapping only, the hybrid mode merges on demand (always false).
+ *
+ * Map_Relocate / Map_RelocateBlock (GC only)
+ *  - Move one valid physical page / every valid page of a block to the
+ *    frontier (copy-back) and repoint its mapping / GTD entry. The block
+ *    version queues the copies in batches.
+ * ------------------------------------------------------------------------- */
+bool Map_Mount(void);
+uint32_t Map_PageCount(void);
+bool Map_ReadPages(uint32_t lpn, uint8_t *buf, uint32_t count);
+bool Map_WritePages(uint32_t lpn, const uint8_t *const *data, uint32_t count);
+bool Map_Sync(void);
+bool Map_IsDirty(void);
+bool Map_Reclaim(uint32_t moves);
+bool Map_Relocate(uint32_t ppn);
+bool Map_RelocateBlock(uint32_t block, uint32_t max, uint32_t *moved);
+
+const Map_Stats_t* Map_GetStats(void);
+
+#endif /* INC_MAPPINGTABLE_H_ */
@@ -0,0 +1,72 @@
+/*
+ *  PageIO.h
+ *
+ *  Created on: Nov 21, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_PAGEIO_H_
+#define INC_PAGEIO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+#include "ContinuousRead_service.h"
+
+/* ---------------------------------------------------------------------------
+ * FTL Page I/O (both mappings)
+ * ---------------------------------------------------------------------------
+ * Every page the FTL programs carries its tag (FTL_TAG_COL) and the erase
+ * count of its block (FTL_WL_COL) in the spare area, written together with
+ * the main area in one program.
+ *
+ * PageIO_Stage : Main area + spare up to the erase count. Staging buffer of
+ *                PageIO_Program, free between calls (a mapping may read a
+ *                page with its tag into it).
+ * --------------------------------------------------------------------------- */
+#define PAGEIO_STAGE_WORDS     ((FTL_WL_COL + sizeof(uint32_t)) / sizeof(uint32_t))
+
+extern uint32_t PageIO_Stage[PAGEIO_STAGE_WORDS];
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * PageIO_ReadTag / PageIO_ReadErase
+ *  - Tag / erase count of a page (erase count 0xFFFFFFFF when unreadable
+ *    or erased).
+ *
+ * PageIO_TagErased
+ *  - Tag of a never programmed page.
+ *
+ * PageIO_Used
+ *  - Page programmed (an unreadable tag counts as programmed: never
+ *    appended over).
+ *
+ * PageIO_BlockFill
+ *  - Programmed pages of a block written in ascending order (binary
+ *    search for the first erased one).
+ *
+ * PageIO_Program
+ *  - Main area + tag + erase count (FTL_NONE: left erased) in one program.
+ *
+ * PageIO_NextTag
+ *  - Tag of the next page programmed, `*seq` advanced.
+ *
+ * PageIO_ReadRun
+ *  - `n` physically consecutive main areas (one block at most): one
+ *    Continuous Read stream, a single page by Standard Read.
+ * ------------------------------------------------------------------------- */
+bool PageIO_ReadTag(uint32_t ppn, FTL_Tag_t *tag);
+uint32_t PageIO_ReadErase(uint32_t ppn);
+bool PageIO_TagErased(const FTL_Tag_t *tag);
+bool PageIO_Used(uint32_t ppn);
+uint32_t PageIO_BlockFill(uint32_t block);
+
+bool PageIO_Program(uint32_t ppn, const void *data, const FTL_Tag_t *tag,
+		uint32_t erase);
+FTL_Tag_t PageIO_NextTag(uint32_t kind, uint32_t gen, uint32_t id, uint32_t *seq);
+
+bool PageIO_ReadRun(uint32_t ppn, uint8_t *buf, uint32_t n);
+
+#endif /* INC_PAGEIO_H_ */
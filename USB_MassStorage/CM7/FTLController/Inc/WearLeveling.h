@@ -0,0 +1,88 @@
+/*
+ *  WearLeveling.h
+ *
+ *  Created on: Nov 22, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Inc
+ */
+
+#ifndef INC_WEARLEVELING_H_
+#define INC_WEARLEVELING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FTL_Config.h"
+
+/* ---------------------------------------------------------------------------
+ * Wear Leveling
+ * ---------------------------------------------------------------------------
+ * Erase counters : WL_EraseCount, one per physical block (2 bytes, 4 KB),
+ *                  saturating. Stored twice: in the spare area of every page
+ *                  the FTL programs (FTL_WL_COL, count of its block) and in
+ *                  the checkpoint payload. Mount takes the checkpoint and
+ *                  raises it with the pages written since (roll-forward), a
+ *                  format takes the spare area of page 0.
+ *
+ * Dynamic        : Free blocks sit in a min-heap on their erase count, the
+ *                  allocator always takes the least worn one.
+ * Static         : Every FTL_WL_INTERVAL erases, the used block with the
+ *                  lowest count is looked at. Spread (highest count - its
+ *                  count) above FTL_WL_THRESHOLD -> it becomes the next GC
+ *                  victim: its cold data moves to a worn block, the block
+ *                  itself goes back to the pool.
+ *
+ * Page mapping only (the hybrid mode rotates its own pool).
+ * --------------------------------------------------------------------------- */
+#define WL_COUNT_MAX            0xFFFFu
+
+extern uint16_t WL_EraseCount[TOTAL_BLOCKS];
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t min;             // Lowest erase count of a good FTL block
+	uint32_t max;             // Highest erase count
+	uint32_t total;           // Erases counted since mount
+	uint32_t checks;          // Static wear leveling checks
+	uint32_t migrations;      // Cold blocks handed to GC
+} WL_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * WL_Clear
+ *  - Every counter 0 (format, before WL_Seen).
+ *
+ * WL_Seen
+ *  - Count read from a spare area: the counter never goes below it.
+ *
+ * WL_Reset
+ *  - Empty free heap, highest count from the table (mount, before the
+ *    free blocks are added).
+ *
+ * WL_Erased
+ *  - Block erased once more.
+ *
+ * WL_FreeAdd / WL_FreeRemove / WL_FreeMin
+ *  - Free block heap: in, out, least worn (FTL_NONE when empty).
+ *
+ * WL_StaticVictim
+ *  - Cold block to migrate now (FTL_NONE: not due / spread within
+ *    FTL_WL_THRESHOLD). `skip` excluded (pinned, being collected).
+ * ------------------------------------------------------------------------- */
+void WL_Clear(void);
+void WL_Seen(uint32_t block, uint32_t count);
+void WL_Reset(void);
+void WL_Erased(uint32_t block);
+
+void WL_FreeAdd(uint32_t block);
+void WL_FreeRemove(uint32_t block);
+uint32_t WL_FreeMin(void);
+
+uint32_t WL_StaticVictim(bool (*skip)(uint32_t block));
+
+const WL_Stats_t* WL_GetStats(void);
+
+#endif /* INC_WEARLEVELING_H_ */
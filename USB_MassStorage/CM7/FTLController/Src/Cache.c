@@ -0,0 +1,247 @@
+/*
+ *  Cache.c
+ *
+ *  Created on: Nov 20, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "Cache.h"
+#include "nand_ready.h"
+
+/* ---------------------------------------------------------------------------
+ * Slots
+ * ---------------------------------------------------------------------------
+ * lpn   : Logical page held, FTL_NONE when free
+ * mask  : Sectors held (bit s = sector s of the page)
+ * aged  : Seen by Cache_Idle before it expired
+ * use   : Write order (least recently written = smallest)
+ * stamp : NandClock_Ticks() of the last write
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t lpn;
+	uint8_t mask;
+	uint8_t aged;
+	uint32_t use;
+	uint32_t stamp;
+} Cache_Slot_t;
+
+static Cache_Slot_t slot[CACHE_SLOTS];
+static uint8_t slot_data[CACHE_SLOTS][PAGE_MAIN_SIZE];
+static uint8_t merge_buf[PAGE_MAIN_SIZE];
+static uint32_t cache_use = 0;
+static Cache_Stats_t stats;
+
+#define CACHE_NONE   0xFFFFFFFFU
+
+static uint32_t find(uint32_t lpn)
+{
+	for (uint32_t i = 0; i < CACHE_SLOTS; i++)
+		if (slot[i].lpn == lpn)
+			return i;
+
+	return CACHE_NONE;
+}
+
+static uint32_t sector_bits(uint32_t off, uint32_t n)
+{
+	return ((1U << n) - 1U) << off;
+}
+
+/* ===========================================================================
+ * Function: flush_slot
+ * ===========================================================================
+ * @brief
+ *  - Write slot `i` to the mapping layer and free it.
+ *
+ * @details
+ *  - Partial slot: the page is read first and the sectors not held copied
+ *    in. An unreadable page is still written (the buffered sectors are the
+ *    host's newest data, the others were lost already) but reported.
+ *  - Write failure: the slot stays, nothing buffered is lost.
+ * --------------------------------------------------------------------------- */
+static bool flush_slot(uint32_t i)
+{
+	Cache_Slot_t *s = &slot[i];
+	bool read_ok = true;
+
+	if (s->lpn == FTL_NONE)
+		return true;
+
+	if (s->mask != CACHE_FULL_MASK)
+	{
+		read_ok = Map_ReadPages(s->lpn, merge_buf, 1);
+		stats.merges++;
+
+		for (uint32_t k = 0; k < FTL_SECTORS_PER_PAGE; k++)
+			if (!(s->mask & (1U << k)))
+				memcpy(&slot_data[i][k * FTL_SECTOR_SIZE], &merge_buf[k * FTL_SECTOR_SIZE],
+						FTL_SECTOR_SIZE);
+	}
+
+	const uint8_t *page = slot_data[i];
+
+	if (!Map_WritePages(s->lpn, &page, 1))
+	{
+		s->mask = CACHE_FULL_MASK;
+		stats.errors++;
+		return false;
+	}
+
+	s->lpn = FTL_NONE;
+	s->mask = 0;
+
+	if (!read_ok)
+		stats.errors++;
+
+	return read_ok;
+}
+
+void Cache_Reset(void)
+{
+	for (uint32_t i = 0; i < CACHE_SLOTS; i++)
+	{
+		slot[i].lpn = FTL_NONE;
+		slot[i].mask = 0;
+	}
+
+	cache_use = 0;
+	memset(&stats, 0, sizeof(stats));
+}
+
+/* ===========================================================================
+ * Function: Cache_Write
+ * ===========================================================================
+ * @brief
+ *  - Buffer sectors [off, off + n) of logical page `lpn`.
+ *
+ * @details
+ *  - Page not held: a free slot, else the least recently written slot is
+ *    written out first (pressure).
+ *  - The page complete afterwards -> written right away, no merge read.
+ *
+ * @return
+ *  - true  : Sectors buffered (or written).
+ *  - false : Slot write failed.
+ * --------------------------------------------------------------------------- */
+bool Cache_Write(uint32_t lpn, uint32_t off, uint32_t n, const uint8_t *data)
+{
+	uint32_t i = find(lpn);
+
+	if (i == CACHE_NONE)
+	{
+		i = find(FTL_NONE);
+
+		if (i == CACHE_NONE)
+		{
+			i = 0;
+			for (uint32_t k = 1; k < CACHE_SLOTS; k++)
+				if (slot[k].use - slot[i].use > 0x80000000U)
+					i = k;
+
+			stats.evicted++;
+			if (!flush_slot(i))
+				return false;
+		}
+
+		slot[i].lpn = lpn;
+		slot[i].mask = 0;
+	}
+
+	memcpy(&slot_data[i][off * FTL_SECTOR_SIZE], data, n * FTL_SECTOR_SIZE);
+	slot[i].mask |= (uint8_t) sector_bits(off, n);
+	slot[i].aged = 0;
+	slot[i].use = ++cache_use;
+	slot[i].stamp = NandClock_Ticks();
+	stats.sectors_in += n;
+
+	if (slot[i].mask != CACHE_FULL_MASK)
+		return true;
+
+	stats.complete++;
+	return flush_slot(i);
+}
+
+void Cache_Discard(uint32_t lpn)
+{
+	uint32_t i = find(lpn);
+
+	if (i != CACHE_NONE)
+	{
+		slot[i].lpn = FTL_NONE;
+		slot[i].mask = 0;
+	}
+}
+
+uint32_t Cache_Mask(uint32_t lpn)
+{
+	uint32_t i = find(lpn);
+
+	return (i != CACHE_NONE) ? slot[i].mask : 0;
+}
+
+void Cache_Overlay(uint32_t lpn, uint32_t off, uint32_t n, uint8_t *buf)
+{
+	uint32_t i = find(lpn);
+
+	if (i == CACHE_NONE)
+		return;
+
+	for (uint32_t k = off; k < off + n; k++)
+	{
+		if (slot[i].mask & (1U << k))
+		{
+			memcpy(&buf[(k - off) * FTL_SECTOR_SIZE], &slot_data[i][k * FTL_SECTOR_SIZE],
+					FTL_SECTOR_SIZE);
+			stats.sectors_hit++;
+		}
+	}
+}
+
+bool Cache_Flush(void)
+{
+	bool ok = true;
+
+	for (uint32_t i = 0; i < CACHE_SLOTS; i++)
+	{
+		if (slot[i].lpn == FTL_NONE)
+			continue;
+
+		stats.synced++;
+		if (!flush_slot(i))
+			ok = false;
+	}
+
+	return ok;
+}
+
+bool Cache_Idle(void)
+{
+	uint32_t limit = CACHE_IDLE_US * NandClock_TicksPerUs();
+	uint32_t now = NandClock_Ticks();
+	bool ok = true;
+
+	for (uint32_t i = 0; i < CACHE_SLOTS; i++)
+	{
+		if (slot[i].lpn == FTL_NONE)
+			continue;
+
+		if (!slot[i].aged && now - slot[i].stamp < limit)
+		{
+			slot[i].aged = 1;
+			continue;
+		}
+
+		stats.idle++;
+		if (!flush_slot(i))
+			ok = false;
+	}
+
+	return ok;
+}
+
+const Cache_Stats_t* Cache_GetStats(void)
+{
+	return &stats;
+}
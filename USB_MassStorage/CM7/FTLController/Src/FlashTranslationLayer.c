@@ -0,0 +1,358 @@
+/*
+ *  FlashTranslationLayer.c
+ *
+ *  Created on: Nov 18, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "FlashTranslationLayer.h"
+#include "Cache.h"
+#include "nand_ready.h"
+
+/* ---------------------------------------------------------------------------
+ * FTL state
+ * ---------------------------------------------------------------------------
+ * ftl_ready   : Mounted with a non-empty logical space (USB reports ready)
+ * ftl_written : Host write since the last idle period (no checkpoint yet)
+ * idle_stamp  : NandClock_Ticks() of the last idle period
+ * idle_quiet  : Idle periods in a row without host writes
+ * part_buf    : Page buffer of a partial page read
+ * --------------------------------------------------------------------------- */
+static volatile bool ftl_ready = false;
+static volatile bool ftl_written = false;
+static uint32_t idle_stamp = 0;
+static uint32_t idle_quiet = 0;
+static FTL_Stats_t stats;
+
+static uint8_t part_buf[PAGE_MAIN_SIZE];
+
+static bool range_ok(uint32_t lba, uint32_t count)
+{
+	uint32_t total = FTL_SectorCount();
+
+	return ftl_ready && count != 0 && count <= total && lba <= total - count;
+}
+
+/* ===========================================================================
+ * Function: FTL_Mount
+ * ===========================================================================
+ * @brief
+ *  - Mount the mapping layer and open the logical space to the host.
+ *
+ * @return
+ *  - true  : Ready, FTL_SectorCount() sectors.
+ *  - false : Mapping layer incomplete (still ready if sectors remain).
+ *
+ * @note
+ *  - Call after BBT_Mount / BBT_MountLazy, before the USB interrupt
+ *    reaches the storage callbacks (they report "not ready" until then).
+ * --------------------------------------------------------------------------- */
+bool FTL_Mount(void)
+{
+	ftl_ready = false;
+	memset(&stats, 0, sizeof(stats));
+	idle_stamp = NandClock_Ticks();
+	idle_quiet = 0;
+	Cache_Reset();
+
+	bool ok = Map_Mount();
+
+	ftl_ready = (Map_PageCount() != 0);
+	NAND_LOG(FTL_MOUNT, FTL_SectorCount(), Map_GetStats()->recovered);
+
+	return ok && ftl_ready;
+}
+
+bool FTL_IsReady(void)
+{
+	return ftl_ready;
+}
+
+uint32_t FTL_SectorCount(void)
+{
+	return Map_PageCount() * FTL_SECTORS_PER_PAGE;
+}
+
+/* ===========================================================================
+ * Function: FTL_ReadSectors
+ * ===========================================================================
+ * @brief
+ *  - Read `count` sectors from `lba` into `buf`.
+ *
+ * @details
+ *  - Whole pages go straight into `buf`, up to 64 logical pages per mapping
+ *    call (Continuous Read streams over physically consecutive pages).
+ *  - A partial first / last page is read into a page buffer and the
+ *    requested sectors copied out, not read at all when the write buffer
+ *    holds all of them.
+ *  - Sectors still in the write buffer replace what the NAND returned.
+ *
+ * @return
+ *  - true  : All sectors valid.
+ *  - false : Not ready, out of range or NAND read failure.
+ * --------------------------------------------------------------------------- */
+bool FTL_ReadSectors(uint32_t lba, uint8_t *buf, uint32_t count)
+{
+	if (!range_ok(lba, count))
+	{
+		stats.errors++;
+		return false;
+	}
+
+	stats.read_cmds++;
+	stats.sectors_read += count;
+
+	bool ok = true;
+
+	while (ok && count != 0)
+	{
+		uint32_t lpn = lba / FTL_SECTORS_PER_PAGE;
+		uint32_t off = lba % FTL_SECTORS_PER_PAGE;
+		uint32_t n;
+
+		if (off != 0 || count < FTL_SECTORS_PER_PAGE)
+		{
+			/// Partial page
+			n = FTL_SECTORS_PER_PAGE - off;
+			if (n > count)
+				n = count;
+
+			uint32_t want = ((1U << n) - 1U) << off;
+
+			if ((Cache_Mask(lpn) & want) != want)
+			{
+				ok = Map_ReadPages(lpn, part_buf, 1);
+				memcpy(buf, &part_buf[off * FTL_SECTOR_SIZE], n * FTL_SECTOR_SIZE);
+				stats.page_reads++;
+			}
+
+			Cache_Overlay(lpn, off, n, buf);
+		}
+		else
+		{
+			/// Whole pages, PAGES_PER_BLOCK at most per mapping call
+			uint32_t pages = count / FTL_SECTORS_PER_PAGE;
+			uint32_t room = PAGES_PER_BLOCK - lpn % PAGES_PER_BLOCK;
+
+			if (pages > room)
+				pages = room;
+
+			ok = Map_ReadPages(lpn, buf, pages);
+			n = pages * FTL_SECTORS_PER_PAGE;
+			stats.page_reads += pages;
+
+			for (uint32_t k = 0; k < pages; k++)
+				if (Cache_Mask(lpn + k) != 0)
+					Cache_Overlay(lpn + k, 0, FTL_SECTORS_PER_PAGE, &buf[k * PAGE_MAIN_SIZE]);
+		}
+
+		buf += n * FTL_SECTOR_SIZE;
+		lba += n;
+		count -= n;
+	}
+
+	if (!ok)
+	{
+		stats.errors++;
+		NAND_LOG(FTL_READ_FAIL, lba, count);
+	}
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: FTL_WriteSectors
+ * ===========================================================================
+ * @brief
+ *  - Write `count` sectors from `buf` to `lba`.
+ *
+ * @details
+ *  - Whole pages go straight from `buf` to the mapping layer, up to 64
+ *    logical pages per call (a buffered copy of them is dropped).
+ *  - A partial first / last page goes to the write buffer (Cache): single
+ *    sector commands fill a page over several calls and cost one program,
+ *    no read-modify-write per command.
+ *  - Below FTL_GC_FREE_HIGH free blocks, FTL_GC_FG_MOVES GC page moves per
+ *    sector first: GC work spread over the commands of a burst instead of
+ *    whole victims in one command (GC_Run only below FTL_GC_FREE_LOW).
+ *
+ * @return
+ *  - true  : All sectors taken.
+ *  - false : Not ready, out of range or NAND failure.
+ * --------------------------------------------------------------------------- */
+bool FTL_WriteSectors(uint32_t lba, const uint8_t *buf, uint32_t count)
+{
+	const uint8_t *pages[PAGES_PER_BLOCK];
+
+	if (!range_ok(lba, count))
+	{
+		stats.errors++;
+		return false;
+	}
+
+	stats.write_cmds++;
+	stats.sectors_written += count;
+	ftl_written = true;
+
+	/// Foreground GC share, bounded by the command size
+	Map_Reclaim(count * FTL_GC_FG_MOVES);
+
+	bool ok = true;
+
+	while (ok && count != 0)
+	{
+		uint32_t lpn = lba / FTL_SECTORS_PER_PAGE;
+		uint32_t off = lba % FTL_SECTORS_PER_PAGE;
+		uint32_t n;
+
+		if (off != 0 || count < FTL_SECTORS_PER_PAGE)
+		{
+			/// Partial page
+			n = FTL_SECTORS_PER_PAGE - off;
+			if (n > count)
+				n = count;
+
+			ok = Cache_Write(lpn, off, n, buf);
+			stats.buffered += n;
+		}
+		else
+		{
+			/// Whole pages, PAGES_PER_BLOCK at most per mapping call
+			uint32_t np = count / FTL_SECTORS_PER_PAGE;
+			uint32_t room = PAGES_PER_BLOCK - lpn % PAGES_PER_BLOCK;
+
+			if (np > room)
+				np = room;
+
+			for (uint32_t k = 0; k < np; k++)
+			{
+				pages[k] = &buf[k * PAGE_MAIN_SIZE];
+				Cache_Discard(lpn + k);
+			}
+
+			ok = Map_WritePages(lpn, pages, np);
+			n = np * FTL_SECTORS_PER_PAGE;
+			stats.page_writes += np;
+		}
+
+		buf += n * FTL_SECTOR_SIZE;
+		lba += n;
+		count -= n;
+	}
+
+	if (!ok)
+	{
+		stats.errors++;
+		NAND_LOG(FTL_WRITE_FAIL, lba, count);
+	}
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: FTL_Sync
+ * ===========================================================================
+ * @brief
+ *  - Write buffer flushed, mapping checkpointed: everything written so far
+ *    is found at the next mount without roll-forward (SYNCHRONIZE CACHE).
+ * --------------------------------------------------------------------------- */
+bool FTL_Sync(void)
+{
+	if (!ftl_ready)
+		return false;
+
+	bool ok = Cache_Flush();
+
+	return Map_Sync() && ok;
+}
+
+/* ===========================================================================
+ * Function: FTL_Flush
+ * ===========================================================================
+ * @brief
+ *  - Write buffer flushed, no checkpoint: the pages carry their tags, the
+ *    next mount finds them by roll-forward (FUA write).
+ *
+ * @note
+ *  - Hosts set FUA on file system metadata writes, a checkpoint each time
+ *    would cost a map page program per command.
+ * --------------------------------------------------------------------------- */
+bool FTL_Flush(void)
+{
+	if (!ftl_ready)
+		return false;
+
+	return Cache_Flush();
+}
+
+/* ===========================================================================
+ * Function: FTL_Idle
+ * ===========================================================================
+ * @brief
+ *  - Background NAND work for the main loop.
+ *
+ * @details
+ *  - Lazy BBT verification step, every call.
+ *  - Every FTL_IDLE_PERIOD_US: write buffer slots idle for CACHE_IDLE_US
+ *    written out, checkpoint once the host stopped writing for
+ *    FTL_SYNC_IDLE_US (not between the packets of a transfer).
+ *  - Meant for every main loop pass: the periods are timed here, the
+ *    clock wrap (DWT) is harmless as long as calls come more often.
+ *
+ * @note
+ *  - USB storage callbacks run in the OTG interrupt: the caller masks it
+ *    around this call so both never drive the NAND at the same time.
+ * --------------------------------------------------------------------------- */
+void FTL_Idle(void)
+{
+	BBT_BackgroundStep(BBT_BACKGROUND_BLOCKS);
+
+	uint32_t now = NandClock_Ticks();
+
+	if (!ftl_ready || now - idle_stamp < FTL_IDLE_PERIOD_US * NandClock_TicksPerUs())
+		return;
+
+	idle_stamp = now;
+	Cache_Idle();
+
+	if (ftl_written)
+		idle_quiet = 0;
+	else if (idle_quiet < FTL_SYNC_IDLE_US / FTL_IDLE_PERIOD_US)
+		idle_quiet++;
+	ftl_written = false;
+
+	if (idle_quiet >= FTL_SYNC_IDLE_US / FTL_IDLE_PERIOD_US && Map_IsDirty())
+		Map_Sync();
+}
+
+/* ===========================================================================
+ * Function: FTL_Background
+ * ===========================================================================
+ * @brief
+ *  - One bounded GC step (FTL_GC_IDLE_MOVES page moves) while the host is
+ *    idle.
+ *
+ * @details
+ *  - Free blocks brought up to FTL_GC_FREE_HIGH between bursts, the next
+ *    burst finds them and GC in the write path stays at its share.
+ *
+ * @return
+ *  - true  : More to do, call again while the host stays idle.
+ *  - false : Watermark reached (or nothing left to collect).
+ *
+ * @note
+ *  - Same interrupt masking as FTL_Idle, one step per masked section.
+ * --------------------------------------------------------------------------- */
+bool FTL_Background(void)
+{
+	if (!ftl_ready)
+		return false;
+
+	return Map_Reclaim(FTL_GC_IDLE_MOVES);
+}
+
+const FTL_Stats_t* FTL_GetStats(void)
+{
+	return &stats;
+}
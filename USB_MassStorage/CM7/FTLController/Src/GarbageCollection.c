@@ -0,0 +1,458 @@
+/*
+ *  GarbageCollection.c
+ *
+ *  Created on: Nov 19, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "GarbageCollection.h"
+#include "MappingTable.h"
+#include "WearLeveling.h"
+#include "nand_ready.h"
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+
+/* ---------------------------------------------------------------------------
+ * GC state
+ * ---------------------------------------------------------------------------
+ * gc_state  : GC_BlockState_t per physical block (outside the range: bad)
+ * gc_pinned : Bit per block, checkpointed translation pages inside
+ * gc_free   : Blocks in GC_BLOCK_FREE
+ * gc_depth  : Nesting of GC_Run / GC_Retire
+ * gc_clock  : Block allocations so far (age unit of cost-benefit)
+ * gc_stamp  : gc_clock when the block was last closed (became used)
+ * gc_policy : Victim choice
+ * gc_victim : Block GC_Step is emptying, FTL_NONE between victims
+ * --------------------------------------------------------------------------- */
+static uint8_t gc_state[TOTAL_BLOCKS];
+static uint32_t gc_pinned[TOTAL_BLOCKS / 32];
+static uint32_t gc_free = 0;
+static uint32_t gc_depth = 0;
+static uint32_t gc_clock = 0;
+static uint32_t gc_stamp[TOTAL_BLOCKS];
+static GC_Policy_t gc_policy = (GC_Policy_t) FTL_GC_POLICY;
+static uint32_t gc_victim = FTL_NONE;
+static GC_Stats_t stats;
+
+static bool is_pinned(uint32_t block)
+{
+	return (gc_pinned[block >> 5] >> (block & 31u)) & 1u;
+}
+
+void GC_Reset(void)
+{
+	memset(gc_state, GC_BLOCK_BAD, sizeof(gc_state));
+	memset(gc_stamp, 0, sizeof(gc_stamp));
+	memset(&stats, 0, sizeof(stats));
+	gc_free = 0;
+	gc_depth = 0;
+	gc_clock = 0;
+	gc_victim = FTL_NONE;
+	WL_Reset();
+
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+	{
+		bool used = !BBT_IsBad(b) && Inv_ValidCount(b) != 0;
+
+		Inv_Track(b, used);
+
+		if (BBT_IsBad(b))
+			continue;
+
+		if (used)
+			gc_state[b] = GC_BLOCK_USED;
+		else
+		{
+			gc_state[b] = GC_BLOCK_FREE;
+			gc_free++;
+			WL_FreeAdd(b);
+		}
+	}
+}
+
+void GC_SetState(uint32_t block, GC_BlockState_t state)
+{
+	if (block < FTL_FIRST_BLOCK || block > FTL_LAST_BLOCK || gc_state[block] == state)
+		return;
+
+	/// Free blocks wait in the wear leveling heap
+	if (gc_state[block] == GC_BLOCK_FREE)
+	{
+		gc_free--;
+		WL_FreeRemove(block);
+	}
+	if (state == GC_BLOCK_FREE)
+	{
+		gc_free++;
+		WL_FreeAdd(block);
+	}
+
+	/// Only used blocks are victims: listed in their valid count bucket
+	if (state == GC_BLOCK_USED)
+		gc_stamp[block] = gc_clock;
+	Inv_Track(block, state == GC_BLOCK_USED);
+
+	gc_state[block] = (uint8_t) state;
+}
+
+GC_BlockState_t GC_State(uint32_t block)
+{
+	return (block < TOTAL_BLOCKS) ? (GC_BlockState_t) gc_state[block] : GC_BLOCK_BAD;
+}
+
+uint32_t GC_FreeCount(void)
+{
+	return gc_free;
+}
+
+/* ===========================================================================
+ * Function: GC_AllocBlock
+ * ===========================================================================
+ * @brief
+ *  - Take the next free block, erased and open for writing.
+ *
+ * @details
+ *  - Least worn free block first (dynamic wear leveling, WearLeveling.h),
+ *    its erase count raised after the erase.
+ *  - Blocks still unknown to the lazy BBT are verified first. A block failing
+ *    verification or erase leaves the pool (runtime bad).
+ *
+ * @param reserve
+ *  - true  : GC relocation, may take the last FTL_GC_RESERVE blocks.
+ *  - false : Host data / mapping, stops at the reserve.
+ *
+ * @return
+ *  - Block number, FTL_NONE when none is left.
+ * --------------------------------------------------------------------------- */
+uint32_t GC_AllocBlock(bool reserve)
+{
+	for (uint32_t n = 0; n < FTL_BLOCKS; n++)
+	{
+		if (gc_free == 0 || (!reserve && gc_free <= FTL_GC_RESERVE))
+			return FTL_NONE;
+
+		uint32_t b = WL_FreeMin();
+
+		if (b == FTL_NONE)
+			return FTL_NONE;
+
+		if (!BBT_VerifyBlock(b))
+		{
+			GC_SetState(b, GC_BLOCK_BAD);
+			continue;
+		}
+
+		if (!BlockErase128K_service(b, 0))
+		{
+			BBT_MarkRuntimeBad(b);
+			GC_SetState(b, GC_BLOCK_BAD);
+			stats.retired++;
+			continue;
+		}
+
+		stats.erases++;
+		gc_clock++;
+		GC_SetState(b, GC_BLOCK_OPEN);
+		WL_Erased(b);
+		return b;
+	}
+
+	return FTL_NONE;
+}
+
+/* ---------------------------------------------------------------------------
+ * Move the valid pages of `block` out, then free it (or retire it).
+ * --------------------------------------------------------------------------- */
+static bool collect(uint32_t block, bool retire)
+{
+	uint32_t moved = 0;
+
+	gc_depth++;
+
+	bool ok = Map_RelocateBlock(block, PAGES_PER_BLOCK, &moved)
+			&& Inv_ValidCount(block) == 0;
+
+	stats.pages_moved += moved;
+	gc_depth--;
+
+	if (!ok)
+		return false;
+
+	if (retire)
+	{
+		BBT_MarkRuntimeBad(block);
+		GC_SetState(block, GC_BLOCK_BAD);
+		stats.retired++;
+		NAND_LOG(FTL_BLOCK_RETIRE, block, moved);
+	}
+	else
+	{
+		GC_SetState(block, GC_BLOCK_FREE);
+		stats.collections++;
+	}
+
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Greedy: head of the lowest valid count bucket. Pinned blocks are skipped,
+ * the first one seen is the last resort. Full blocks (64 valid) gain
+ * nothing and are never returned.
+ * --------------------------------------------------------------------------- */
+static uint32_t pick_greedy(void)
+{
+	uint32_t pinned = FTL_NONE;
+
+	for (uint32_t v = 0; v < PAGES_PER_BLOCK; v++)
+	{
+		for (uint32_t b = Inv_BucketFirst(v); b != FTL_NONE; b = Inv_BucketNext(b))
+		{
+			if (!is_pinned(b))
+				return b;
+
+			if (pinned == FTL_NONE)
+				pinned = b;
+		}
+	}
+
+	return pinned;
+}
+
+/* ===========================================================================
+ * Function: pick_cost_benefit
+ * ===========================================================================
+ * @brief
+ *  - Used block with the highest age * (1 - u) / 2u (u = valid / 64).
+ *
+ * @details
+ *  - Score in integers: age * (64 - v) / v, age = gc_clock - gc_stamp.
+ *    A block without valid pages wins at once (nothing to copy).
+ *  - Buckets from the fewest valid pages up: the best score a bucket can
+ *    still reach is gc_clock * (64 - v) / v (falls with v), the walk stops
+ *    once the best found reaches it. Usually a few buckets are looked at.
+ * --------------------------------------------------------------------------- */
+static uint32_t pick_cost_benefit(void)
+{
+	uint32_t best = FTL_NONE, pinned = FTL_NONE;
+	uint64_t best_score = 0;
+
+	for (uint32_t b = Inv_BucketFirst(0); b != FTL_NONE; b = Inv_BucketNext(b))
+	{
+		if (!is_pinned(b))
+			return b;
+
+		if (pinned == FTL_NONE)
+			pinned = b;
+	}
+
+	for (uint32_t v = 1; v < PAGES_PER_BLOCK; v++)
+	{
+		uint64_t bound = (uint64_t) (gc_clock + 1) * (PAGES_PER_BLOCK - v) / v;
+
+		if (best != FTL_NONE && best_score >= bound)
+			break;
+
+		for (uint32_t b = Inv_BucketFirst(v); b != FTL_NONE; b = Inv_BucketNext(b))
+		{
+			if (is_pinned(b))
+			{
+				if (pinned == FTL_NONE)
+					pinned = b;
+				continue;
+			}
+
+			uint64_t score = (uint64_t) (gc_clock - gc_stamp[b] + 1)
+					* (PAGES_PER_BLOCK - v) / v;
+
+			if (best == FTL_NONE || score > best_score)
+			{
+				best = b;
+				best_score = score;
+			}
+		}
+	}
+
+	if (best != FTL_NONE)
+		return best;
+
+	return pinned;
+}
+
+/// Cold block due for migration (static wear leveling) first
+static uint32_t pick_victim(void)
+{
+	uint32_t cold = WL_StaticVictim(is_pinned);
+
+	if (cold != FTL_NONE)
+		return cold;
+
+	return (gc_policy == GC_POLICY_COST_BENEFIT) ? pick_cost_benefit() : pick_greedy();
+}
+
+/* ===========================================================================
+ * Function: GC_Run
+ * ===========================================================================
+ * @brief
+ *  - Reclaim used blocks until `target` blocks are free.
+ *
+ * @details
+ *  - Greedy: the victim with the fewest valid pages costs the fewest
+ *    relocations per block gained. Cost-benefit weighs that against the
+ *    age of the block. No victim with an invalid page left -> GC stops
+ *    (logical space full).
+ *  - Time spent and pages moved go to the statistics (sustained random
+ *    write tuning).
+ *
+ * @return
+ *  - true  : `target` free blocks reached.
+ *  - false : Nothing left to reclaim or relocation failed.
+ * --------------------------------------------------------------------------- */
+bool GC_Run(uint32_t target)
+{
+	bool ok = true;
+
+	if (gc_depth != 0)
+		return gc_free >= target;
+
+	uint32_t t0 = NandClock_Ticks();
+	uint32_t done = stats.collections;
+
+	gc_depth++;
+
+	while (ok && gc_free < target)
+	{
+		uint32_t victim = pick_victim();
+
+		if (victim == FTL_NONE)
+			ok = false;
+		else
+			ok = collect(victim, false);
+	}
+
+	gc_depth--;
+
+	if (stats.collections != done)
+	{
+		uint32_t us = (NandClock_Ticks() - t0) / NandClock_TicksPerUs();
+
+		stats.runs++;
+		stats.time_us += us;
+		if (us > stats.max_us)
+			stats.max_us = us;
+	}
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: GC_Step
+ * ===========================================================================
+ * @brief
+ *  - Bounded GC: at most `moves` page relocations towards `target` free
+ *    blocks.
+ *
+ * @details
+ *  - The victim is kept between calls and emptied a batch at a time, host
+ *    writes in between only make it cheaper. Blocks without valid pages
+ *    are freed without a copy (not counted against `moves`).
+ *  - Used from idle time (background) and per host command (foreground
+ *    share), GC_Run stays the fallback below FTL_GC_FREE_LOW.
+ *
+ * @return
+ *  - true  : Progress possible, more steps useful while below `target`.
+ *  - false : No victim left or relocation failed.
+ * --------------------------------------------------------------------------- */
+bool GC_Step(uint32_t target, uint32_t moves)
+{
+	bool ok = true;
+	uint32_t used = 0;
+
+	if (gc_depth != 0)
+		return false;
+
+	uint32_t t0 = NandClock_Ticks();
+
+	gc_depth++;
+
+	while (ok && gc_free < target && used < moves)
+	{
+		uint32_t moved = 0;
+
+		if (gc_victim == FTL_NONE || gc_state[gc_victim] != GC_BLOCK_USED
+				|| is_pinned(gc_victim))
+			gc_victim = pick_victim();
+
+		/// Pinned blocks only as the last resort of GC_Run
+		if (gc_victim == FTL_NONE || is_pinned(gc_victim))
+		{
+			gc_victim = FTL_NONE;
+			ok = false;
+			break;
+		}
+
+		ok = Map_RelocateBlock(gc_victim, moves - used, &moved);
+		used += moved;
+		stats.pages_moved += moved;
+
+		if (ok && Inv_ValidCount(gc_victim) == 0)
+		{
+			GC_SetState(gc_victim, GC_BLOCK_FREE);
+			stats.collections++;
+			gc_victim = FTL_NONE;
+		}
+	}
+
+	gc_depth--;
+
+	if (used != 0)
+	{
+		uint32_t us = (NandClock_Ticks() - t0) / NandClock_TicksPerUs();
+
+		stats.steps++;
+		stats.time_us += us;
+		if (us > stats.step_max_us)
+			stats.step_max_us = us;
+	}
+
+	return ok;
+}
+
+bool GC_Retire(uint32_t block)
+{
+	GC_SetState(block, GC_BLOCK_USED);
+	return collect(block, true);
+}
+
+void GC_Pin(uint32_t block)
+{
+	if (block < TOTAL_BLOCKS)
+		gc_pinned[block >> 5] |= 1u << (block & 31u);
+}
+
+void GC_UnpinAll(void)
+{
+	memset(gc_pinned, 0, sizeof(gc_pinned));
+}
+
+void GC_SetPolicy(GC_Policy_t policy)
+{
+	gc_policy = policy;
+}
+
+GC_Policy_t GC_GetPolicy(void)
+{
+	return gc_policy;
+}
+
+bool GC_IsActive(void)
+{
+	return gc_depth != 0;
+}
+
+const GC_Stats_t* GC_GetStats(void)
+{
+	return &stats;
+}
+
+#endif /* FTL_MAPPING */
@@ -0,0 +1,116 @@
+/*
+ *  HotCold.c
+ *
+ *  Created on: Nov 23, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "HotCold.h"
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+
+/* ---------------------------------------------------------------------------
+ * Sketch
+ * ---------------------------------------------------------------------------
+ * hc_count : HC_ROWS x HC_WIDTH saturating counters
+ * hc_seed  : Odd multiplier per row (multiplicative hash, top bits taken)
+ * hc_left  : Writes until the next halving
+ * --------------------------------------------------------------------------- */
+static uint8_t hc_count[HC_ROWS][HC_WIDTH];
+static const uint32_t hc_seed[HC_ROWS] =
+{
+	0x9E3779B1u, 0x85EBCA77u, 0xC2B2AE3Du, 0x27D4EB2Fu
+};
+static uint32_t hc_left = HC_DECAY;
+static HC_Stats_t stats;
+
+static uint32_t hc_slot(uint32_t row, uint32_t lpn)
+{
+	return (((lpn + 1u) * hc_seed[row]) >> 16) & (HC_WIDTH - 1u);
+}
+
+/// All counters halved
+static void hc_decay(void)
+{
+	for (uint32_t r = 0; r < HC_ROWS; r++)
+		for (uint32_t i = 0; i < HC_WIDTH; i++)
+			hc_count[r][i] >>= 1;
+
+	stats.decays++;
+}
+
+void HC_Reset(void)
+{
+	memset(hc_count, 0, sizeof(hc_count));
+	memset(&stats, 0, sizeof(stats));
+	hc_left = HC_DECAY;
+}
+
+uint32_t HC_Estimate(uint32_t lpn)
+{
+	uint32_t est = 0xFFu;
+
+	for (uint32_t r = 0; r < HC_ROWS; r++)
+	{
+		uint32_t c = hc_count[r][hc_slot(r, lpn)];
+
+		if (c < est)
+			est = c;
+	}
+
+	return est;
+}
+
+/* ===========================================================================
+ * Function: HC_Write
+ * ===========================================================================
+ * @brief
+ *  - Count one host write of `lpn` and classify it.
+ *
+ * @details
+ *  - Conservative update: only counters at the current minimum are raised,
+ *    the others already hold more (collisions) and stay.
+ *
+ * @return
+ *  - true  : Hot (HC_HOT_THRESHOLD recent writes or more).
+ *  - false : Cold.
+ * --------------------------------------------------------------------------- */
+bool HC_Write(uint32_t lpn)
+{
+	uint32_t est = HC_Estimate(lpn);
+
+	if (est < 0xFFu)
+	{
+		for (uint32_t r = 0; r < HC_ROWS; r++)
+		{
+			uint8_t *c = &hc_count[r][hc_slot(r, lpn)];
+
+			if (*c == est)
+				(*c)++;
+		}
+		est++;
+	}
+
+	if (--hc_left == 0)
+	{
+		hc_decay();
+		hc_left = HC_DECAY;
+	}
+
+	if (est >= HC_HOT_THRESHOLD)
+	{
+		stats.hot++;
+		return true;
+	}
+
+	stats.cold++;
+	return false;
+}
+
+const HC_Stats_t* HC_GetStats(void)
+{
+	return &stats;
+}
+
+#endif /* FTL_MAPPING */
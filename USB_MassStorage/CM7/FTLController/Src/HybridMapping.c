@@ -0,0 +1,1060 @@
+/*
+ *  HybridMapping.c
+ *
+ *  Created on: Nov 21, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "HybridMapping.h"
+#include "PageIO.h"
+
+#if FTL_MAPPING == FTL_MAPPING_HYBRID
+
+/* ---------------------------------------------------------------------------
+ * Mapping state
+ * ---------------------------------------------------------------------------
+ * blk_map     : Logical block -> data block (HYB_NONE: never written)
+ * blk_logged  : Bit per logical block, pages of it in the RW log
+ * blk_free    : Bit per physical block, free (erased when allocated)
+ * free_cursor : Next block the allocator looks at
+ * hyb_lblocks : Logical blocks (fixed at format)
+ * hyb_gen     : Format generation written into every tag
+ * hyb_seq     : Sequence of the next page programmed
+ * --------------------------------------------------------------------------- */
+#define HYB_NONE          0xFFFFu
+#define HYB_WRITE_TRIES   4U
+#define HYB_LAST_PAGE     (PAGES_PER_BLOCK - 1U)
+
+static uint16_t blk_map[HYB_LBLOCKS_MAX];
+static uint32_t blk_logged[(HYB_LBLOCKS_MAX + 31) / 32];
+static uint32_t blk_free[TOTAL_BLOCKS / 32];
+static uint32_t free_count = 0;
+static uint32_t free_cursor = FTL_FIRST_BLOCK;
+static uint32_t hyb_lblocks = 0;
+static uint32_t hyb_gen = 0;
+static uint32_t hyb_seq = 0;
+static Map_Stats_t stats;
+static Hyb_Stats_t hstats;
+
+/* ---------------------------------------------------------------------------
+ * SW log
+ * ---------------------------------------------------------------------------
+ * sw_lbn   : Logical block it belongs to, FTL_NONE when closed
+ * sw_block : Physical block, sw_next its next page (pages below it hold the
+ *            newest copies)
+ * sw_hot   : Logical block whose page 0 was rewritten while the SW log held
+ *            nothing else: single page writes of its page 0 go to the RW log
+ *            (a FAT sector at page 0 would cost a partial merge each time)
+ * --------------------------------------------------------------------------- */
+static uint32_t sw_lbn = FTL_NONE;
+static uint32_t sw_block = FTL_NONE;
+static uint32_t sw_next = 0;
+static uint32_t sw_hot = FTL_NONE;
+
+/* ---------------------------------------------------------------------------
+ * RW log (ring of HYB_LOG_BLOCKS slots, oldest first)
+ * ---------------------------------------------------------------------------
+ * rw_block  : Physical block of a slot
+ * rw_lpn    : Logical page of every log page, FTL_NONE when superseded (one
+ *             valid copy per logical page at most)
+ * rw_head   : Oldest slot, rw_count slots in use, rw_page next page of the
+ *             newest one
+ * rw_sealed : Bit per slot, a program failed in it: no more appends, retired
+ *             when reclaimed
+ * --------------------------------------------------------------------------- */
+static uint16_t rw_block[HYB_LOG_BLOCKS];
+static uint32_t rw_lpn[HYB_LOG_BLOCKS][PAGES_PER_BLOCK];
+static uint32_t rw_head = 0;
+static uint32_t rw_count = 0;
+static uint32_t rw_page = PAGES_PER_BLOCK;
+static uint32_t rw_sealed = 0;
+
+/* ---------------------------------------------------------------------------
+ * Mount: block-mapped blocks without page 63 (open SW log, interrupted
+ * merge) newer than the data block, RW log page 0 sequences
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t lbn;
+	uint32_t block;
+	uint32_t seq;
+	uint32_t last;
+} Hyb_Open_t;
+
+static Hyb_Open_t open_blk[HYB_OPEN_MAX];
+static uint32_t open_count = 0;
+static uint32_t log_seq[HYB_LOG_BLOCKS];
+
+/* ---------------------------------------------------------------------------
+ * Page buffer
+ * copy_buf : Merge copy through RAM, filler pages, format record
+ * --------------------------------------------------------------------------- */
+static uint32_t copy_buf[PAGE_MAIN_SIZE / sizeof(uint32_t)];
+
+static bool rw_append(uint32_t lpn, const uint8_t *data);
+
+static bool bit_get(const uint32_t *map, uint32_t i)
+{
+	return (map[i >> 5] >> (i & 31u)) & 1u;
+}
+
+static void bit_set(uint32_t *map, uint32_t i, bool on)
+{
+	if (on)
+		map[i >> 5] |= 1u << (i & 31u);
+	else
+		map[i >> 5] &= ~(1u << (i & 31u));
+}
+
+/* ---------------------------------------------------------------------------
+ * Page tag I/O (PageIO.h) of this mapping
+ * --------------------------------------------------------------------------- */
+/// Block-mapped or RW log page of the mounted format
+static bool tag_ours(const FTL_Tag_t *tag)
+{
+	return tag->gen == hyb_gen
+			&& (tag->kind == FTL_TAG_DATA || tag->kind == FTL_TAG_LOG);
+}
+
+static uint32_t tag_lpn(const FTL_Tag_t *tag)
+{
+	return tag->id & ~FTL_TAG_MOVED;
+}
+
+/// Merged blocks may skip pages (never written): from the top
+static uint32_t block_last(uint32_t block)
+{
+	for (uint32_t p = PAGES_PER_BLOCK; p-- > 0;)
+		if (PageIO_Used(PAGE_ADDR(block, p)))
+			return p + 1;
+
+	return 0;
+}
+
+static void seen(uint32_t seq)
+{
+	if (seq >= hyb_seq)
+		hyb_seq = seq + 1;
+}
+
+/* ---------------------------------------------------------------------------
+ * Block pool
+ * ---------------------------------------------------------------------------
+ * Free blocks are erased when allocated (round robin, BBT verified first),
+ * so a freed block keeps its tags until then: the mount tells it from the
+ * live copy by the sequence.
+ * --------------------------------------------------------------------------- */
+static void free_block(uint32_t block)
+{
+	if (block < FTL_FIRST_BLOCK || block > FTL_LAST_BLOCK || bit_get(blk_free, block))
+		return;
+
+	bit_set(blk_free, block, true);
+	free_count++;
+}
+
+static void take_block(uint32_t block)
+{
+	if (block < FTL_FIRST_BLOCK || block > FTL_LAST_BLOCK || !bit_get(blk_free, block))
+		return;
+
+	bit_set(blk_free, block, false);
+	free_count--;
+}
+
+static void retire_block(uint32_t block)
+{
+	BBT_MarkRuntimeBad(block);
+	hstats.retired++;
+	NAND_LOG(FTL_BLOCK_RETIRE, block, 0);
+}
+
+static uint32_t alloc_block(void)
+{
+	for (uint32_t n = 0; n < FTL_BLOCKS && free_count != 0; n++)
+	{
+		uint32_t b = free_cursor;
+
+		free_cursor = (b >= FTL_LAST_BLOCK) ? FTL_FIRST_BLOCK : b + 1;
+
+		if (!bit_get(blk_free, b))
+			continue;
+
+		take_block(b);
+
+		if (!BBT_VerifyBlock(b))
+			continue;
+
+		if (!BlockErase128K_service(b, 0))
+		{
+			retire_block(b);
+			continue;
+		}
+
+		hstats.erases++;
+		return b;
+	}
+
+	return FTL_NONE;
+}
+
+/* ---------------------------------------------------------------------------
+ * RW log page map
+ * --------------------------------------------------------------------------- */
+static uint32_t rw_slot(uint32_t k)
+{
+	return (rw_head + k) % HYB_LOG_BLOCKS;
+}
+
+/// Log page index (slot * PAGES_PER_BLOCK + page) of `lpn`, FTL_NONE if none
+static uint32_t rw_find(uint32_t lpn)
+{
+	if (!bit_get(blk_logged, lpn / PAGES_PER_BLOCK))
+		return FTL_NONE;
+
+	for (uint32_t k = 0; k < rw_count; k++)
+	{
+		uint32_t l = rw_slot(k);
+
+		for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+			if (rw_lpn[l][p] == lpn)
+				return l * PAGES_PER_BLOCK + p;
+	}
+
+	return FTL_NONE;
+}
+
+static void rw_forget(uint32_t lpn)
+{
+	uint32_t i = rw_find(lpn);
+
+	if (i != FTL_NONE)
+		rw_lpn[i / PAGES_PER_BLOCK][i % PAGES_PER_BLOCK] = FTL_NONE;
+}
+
+/// Logical block merged: every RW log page of it superseded
+static void rw_drop(uint32_t lbn)
+{
+	if (!bit_get(blk_logged, lbn))
+		return;
+
+	for (uint32_t k = 0; k < rw_count; k++)
+	{
+		uint32_t l = rw_slot(k);
+
+		for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+			if (rw_lpn[l][p] != FTL_NONE && rw_lpn[l][p] / PAGES_PER_BLOCK == lbn)
+				rw_lpn[l][p] = FTL_NONE;
+	}
+
+	bit_set(blk_logged, lbn, false);
+}
+
+/* ---------------------------------------------------------------------------
+ * Newest copy of `lpn`: SW log (below sw_next), RW log, data block.
+ * FTL_NONE when never written.
+ * --------------------------------------------------------------------------- */
+static uint32_t locate(uint32_t lpn)
+{
+	uint32_t lbn = lpn / PAGES_PER_BLOCK;
+	uint32_t off = lpn % PAGES_PER_BLOCK;
+
+	if (lbn == sw_lbn && off < sw_next)
+		return PAGE_ADDR(sw_block, off);
+
+	uint32_t i = rw_find(lpn);
+
+	if (i != FTL_NONE)
+		return PAGE_ADDR(rw_block[i / PAGES_PER_BLOCK], i % PAGES_PER_BLOCK);
+
+	if (blk_map[lbn] != HYB_NONE)
+		return PAGE_ADDR(blk_map[lbn], off);
+
+	return FTL_NONE;
+}
+
+/* ===========================================================================
+ * Function: copy_to
+ * ===========================================================================
+ * @brief
+ *  - Merge: page `src` copied to `dst` as logical page `lpn`.
+ *
+ * @details
+ *  - Copy-back with a new tag, through RAM when the source is uncorrectable.
+ *  - `src` = FTL_NONE: a filler page (erased content). Pages 0 and 63 of a
+ *    merged block are always programmed, the mount tells a complete block
+ *    from an interrupted merge by page 63.
+ * --------------------------------------------------------------------------- */
+static bool copy_to(uint32_t src, uint32_t dst, uint32_t lpn)
+{
+	FTL_Tag_t tag = PageIO_NextTag(FTL_TAG_DATA, hyb_gen, lpn | FTL_TAG_MOVED,
+			&hyb_seq);
+
+	if (src == FTL_NONE)
+	{
+		memset(copy_buf, NAND_ERASED_STATE, PAGE_MAIN_SIZE);
+		return PageIO_Program(dst, copy_buf, &tag, FTL_NONE);
+	}
+
+	NandPatch_t patch = { FTL_TAG_COL, sizeof(tag), (const uint8_t*) &tag };
+	ECC_Status_t ecc = ECC_SUCCESS;
+
+	hstats.merge_copies++;
+
+	if (CopyPage_Service(src, dst, &patch, 1, &ecc))
+	{
+		stats.copy_back++;
+		return true;
+	}
+
+	if (ecc != ECC_UNCORRECTABLE)
+		return false;
+
+	StandardRead_Service(src, 0, (uint8_t*) copy_buf, PAGE_MAIN_SIZE);
+	stats.through_ram++;
+	return PageIO_Program(dst, copy_buf, &tag, FTL_NONE);
+}
+
+/// Pages `from`..63 of logical block `lbn` into `dst` from their newest copies
+static bool fill_block(uint32_t dst, uint32_t lbn, uint32_t from)
+{
+	for (uint32_t off = from; off < PAGES_PER_BLOCK; off++)
+	{
+		uint32_t lpn = lbn * PAGES_PER_BLOCK + off;
+		uint32_t src = locate(lpn);
+
+		if (src == FTL_NONE && off != 0 && off != HYB_LAST_PAGE)
+			continue;
+
+		if (!copy_to(src, PAGE_ADDR(dst, off), lpn))
+			return false;
+	}
+
+	return true;
+}
+
+/// `block` is the data block of `lbn` now, the old one and its log pages go
+static void set_data(uint32_t lbn, uint32_t block)
+{
+	if (blk_map[lbn] != HYB_NONE)
+		free_block(blk_map[lbn]);
+
+	blk_map[lbn] = (uint16_t) block;
+	rw_drop(lbn);
+}
+
+/* ---------------------------------------------------------------------------
+ * Full merge: new data block of `lbn` from the newest copies of its pages
+ * --------------------------------------------------------------------------- */
+static bool merge_full(uint32_t lbn)
+{
+	for (uint32_t t = 0; t < HYB_WRITE_TRIES; t++)
+	{
+		uint32_t dst = alloc_block();
+
+		if (dst == FTL_NONE)
+			return false;
+
+		if (fill_block(dst, lbn, 0))
+		{
+			set_data(lbn, dst);
+			hstats.full_merges++;
+			return true;
+		}
+
+		retire_block(dst);
+	}
+
+	return false;
+}
+
+/* ===========================================================================
+ * Function: sw_close
+ * ===========================================================================
+ * @brief
+ *  - Turn the SW log into the data block of its logical block.
+ *
+ * @details
+ *  - Complete: switch merge, nothing copied.
+ *  - Otherwise partial merge: the remaining pages copied in from the RW log
+ *    or the old data block.
+ *  - Program failure inside the SW log: full merge instead (the SW pages
+ *    below sw_next are still sources), the SW block retired.
+ * --------------------------------------------------------------------------- */
+static bool sw_close(void)
+{
+	uint32_t lbn = sw_lbn;
+
+	if (lbn == FTL_NONE)
+		return true;
+
+	if (sw_next < PAGES_PER_BLOCK && !fill_block(sw_block, lbn, sw_next))
+	{
+		if (!merge_full(lbn))
+			return false;
+
+		retire_block(sw_block);
+		sw_lbn = FTL_NONE;
+		return true;
+	}
+
+	if (sw_next < PAGES_PER_BLOCK)
+		hstats.partial_merges++;
+	else
+		hstats.switch_merges++;
+
+	sw_lbn = FTL_NONE;
+	set_data(lbn, sw_block);
+	return true;
+}
+
+static bool sw_open(uint32_t lbn)
+{
+	if (!sw_close())
+		return false;
+
+	uint32_t b = alloc_block();
+
+	if (b == FTL_NONE)
+		return false;
+
+	sw_lbn = lbn;
+	sw_block = b;
+	sw_next = 0;
+	return true;
+}
+
+static bool sw_append(uint32_t lpn, const uint8_t *data)
+{
+	FTL_Tag_t tag = PageIO_NextTag(FTL_TAG_DATA, hyb_gen, lpn, &hyb_seq);
+
+	if (!PageIO_Program(PAGE_ADDR(sw_block, sw_next), data, &tag, FTL_NONE))
+	{
+		/// Pages so far into a new data block, this one to the RW log
+		uint32_t bad = sw_block;
+
+		if (!merge_full(sw_lbn))
+			return false;
+
+		sw_lbn = FTL_NONE;
+		retire_block(bad);
+		return rw_append(lpn, data);
+	}
+
+	sw_next++;
+	rw_forget(lpn);
+	hstats.sw_writes++;
+
+	return (sw_next < PAGES_PER_BLOCK) || sw_close();
+}
+
+/* ===========================================================================
+ * Function: rw_reclaim
+ * ===========================================================================
+ * @brief
+ *  - Free the oldest RW log block.
+ *
+ * @details
+ *  - Every logical block with a valid page in it is merged: the SW log's
+ *    own block by closing it, any other by a full merge. Both supersede all
+ *    RW log pages of the logical block, in every log block.
+ * --------------------------------------------------------------------------- */
+static bool rw_reclaim(void)
+{
+	uint32_t l = rw_head;
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+	{
+		uint32_t lpn = rw_lpn[l][p];
+
+		if (lpn == FTL_NONE)
+			continue;
+
+		uint32_t lbn = lpn / PAGES_PER_BLOCK;
+
+		if (!((lbn == sw_lbn) ? sw_close() : merge_full(lbn)))
+			return false;
+	}
+
+	if (rw_sealed & (1u << l))
+		retire_block(rw_block[l]);
+	else
+		free_block(rw_block[l]);
+
+	rw_head = rw_slot(1);
+	rw_count--;
+	hstats.reclaims++;
+	return true;
+}
+
+/// Newest RW log block has a free page (new block, oldest reclaimed first)
+static bool rw_room(void)
+{
+	while (rw_count == 0 || rw_page >= PAGES_PER_BLOCK)
+	{
+		if (rw_count == HYB_LOG_BLOCKS && !rw_reclaim())
+			return false;
+
+		uint32_t b = alloc_block();
+
+		if (b == FTL_NONE)
+			return false;
+
+		uint32_t l = rw_slot(rw_count);
+
+		rw_block[l] = (uint16_t) b;
+		memset(rw_lpn[l], 0xFF, sizeof(rw_lpn[l]));
+		rw_sealed &= ~(1u << l);
+		rw_count++;
+		rw_page = 0;
+	}
+
+	return true;
+}
+
+static bool rw_append(uint32_t lpn, const uint8_t *data)
+{
+	for (uint32_t t = 0; t < HYB_WRITE_TRIES; t++)
+	{
+		if (!rw_room())
+			return false;
+
+		uint32_t l = rw_slot(rw_count - 1);
+		uint32_t p = rw_page++;
+		FTL_Tag_t tag = PageIO_NextTag(FTL_TAG_LOG, hyb_gen, lpn, &hyb_seq);
+
+		if (PageIO_Program(PAGE_ADDR(rw_block[l], p), data, &tag, FTL_NONE))
+		{
+			rw_forget(lpn);
+			rw_lpn[l][p] = lpn;
+			bit_set(blk_logged, lpn / PAGES_PER_BLOCK, true);
+			hstats.rw_writes++;
+			return true;
+		}
+
+		/// Its pages stay readable until it is reclaimed
+		rw_page = PAGES_PER_BLOCK;
+		rw_sealed |= 1u << l;
+	}
+
+	return false;
+}
+
+/* ===========================================================================
+ * Function: write_data
+ * ===========================================================================
+ * @brief
+ *  - One host page to the SW or the RW log.
+ *
+ * @details
+ *  - Page 0 opens a new SW log (the previous one closed), except single
+ *    page writes of sw_hot.
+ *  - The page following in the SW log's block -> appended there.
+ *  - Any other page of the SW log's block: the SW log is closed first (RW
+ *    log pages of it must be newer than the SW log).
+ *  - Everything else -> RW log.
+ * --------------------------------------------------------------------------- */
+static bool write_data(uint32_t lpn, const uint8_t *data, bool run)
+{
+	uint32_t lbn = lpn / PAGES_PER_BLOCK;
+	uint32_t off = lpn % PAGES_PER_BLOCK;
+
+	stats.data_writes++;
+
+	if (off == 0 && (run || lbn != sw_hot))
+	{
+		if (!run && lbn == sw_lbn && sw_next == 1)
+			sw_hot = lbn;
+		else if (!sw_open(lbn))
+			return false;
+	}
+
+	if (lbn == sw_lbn && off == sw_next)
+		return sw_append(lpn, data);
+
+	if (lbn == sw_lbn && !sw_close())
+		return false;
+
+	return rw_append(lpn, data);
+}
+
+/* ---------------------------------------------------------------------------
+ * Format record
+ * --------------------------------------------------------------------------- */
+static bool fmt_load(Hyb_Format_t *fmt)
+{
+	FTL_Tag_t tag;
+	uint32_t ppn = PAGE_ADDR(FTL_CKPT_BLOCK_A, 0);
+
+	if (!PageIO_ReadTag(ppn, &tag) || tag.kind != FTL_TAG_CKPT
+			|| !StandardRead_Service(ppn, 0, (uint8_t*) copy_buf, PAGE_MAIN_SIZE))
+		return false;
+
+	memcpy(fmt, copy_buf, sizeof(*fmt));
+
+	return fmt->magic == HYB_FORMAT_MAGIC
+			&& fmt->crc == BBT_Crc32(fmt, offsetof(Hyb_Format_t, crc))
+			&& fmt->gen == tag.gen && fmt->lblocks != 0
+			&& fmt->lblocks <= HYB_LBLOCKS_MAX && fmt->log_blocks == HYB_LOG_BLOCKS;
+}
+
+/* ---------------------------------------------------------------------------
+ * New format: generation above anything tagged on flash, capacity from the
+ * good blocks (BBT_GoodLowerBound after a lazy BBT mount), every block free
+ * --------------------------------------------------------------------------- */
+static bool hyb_format(void)
+{
+	uint32_t gen = 0;
+	uint32_t good = BBT_GoodLowerBound(FTL_FIRST_BLOCK, FTL_LAST_BLOCK);
+
+	for (uint32_t b = FTL_CKPT_BLOCK_A; b <= FTL_LAST_BLOCK; b++)
+	{
+		FTL_Tag_t tag;
+
+		if (b > FTL_CKPT_BLOCK_B && b < FTL_FIRST_BLOCK)
+			continue;
+
+		if (PageIO_ReadTag(PAGE_ADDR(b, 0), &tag) && (tag.kind == FTL_TAG_DATA
+				|| tag.kind == FTL_TAG_TRANS || tag.kind == FTL_TAG_CKPT
+				|| tag.kind == FTL_TAG_LOG) && tag.gen >= gen)
+			gen = tag.gen + 1;
+	}
+
+	hyb_gen = (gen == 0 || gen == FTL_NONE) ? 1 : gen;
+	hyb_seq = 0;
+
+	/// Data blocks: the rest after the reserve, the logs and a merge target
+	uint32_t fixed = FTL_RESERVE_BLOCKS + HYB_LOG_BLOCKS + 2;
+
+	hyb_lblocks = (good > fixed) ? good - fixed : 0;
+	if (hyb_lblocks > HYB_LBLOCKS_MAX)
+		hyb_lblocks = HYB_LBLOCKS_MAX;
+
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+		if (!BBT_IsBad(b))
+			free_block(b);
+
+	stats.formats++;
+	NAND_LOG(FTL_FORMAT, hyb_lblocks * PAGES_PER_BLOCK, hyb_gen);
+
+	/// A page mapping checkpoint must not be found next to the record
+	BlockErase128K_service(FTL_CKPT_BLOCK_A, 0);
+	BlockErase128K_service(FTL_CKPT_BLOCK_B, 0);
+
+	Hyb_Format_t fmt = { HYB_FORMAT_MAGIC, hyb_gen, hyb_lblocks, HYB_LOG_BLOCKS, 0 };
+	FTL_Tag_t tag = PageIO_NextTag(FTL_TAG_CKPT, hyb_gen, 1, &hyb_seq);
+
+	fmt.crc = BBT_Crc32(&fmt, offsetof(Hyb_Format_t, crc));
+	memset(copy_buf, NAND_ERASED_STATE, PAGE_MAIN_SIZE);
+	memcpy(copy_buf, &fmt, sizeof(fmt));
+
+	return hyb_lblocks != 0
+			&& PageIO_Program(PAGE_ADDR(FTL_CKPT_BLOCK_A, 0), copy_buf, &tag,
+					FTL_NONE);
+}
+
+/* ---------------------------------------------------------------------------
+ * Mount scan helpers
+ * --------------------------------------------------------------------------- */
+static uint32_t page0_seq(uint32_t block)
+{
+	FTL_Tag_t tag;
+
+	return PageIO_ReadTag(PAGE_ADDR(block, 0), &tag) ? tag.seq : 0;
+}
+
+/// Complete block-mapped block: newest per logical block wins
+static void mount_data(uint32_t lbn, uint32_t block, uint32_t seq)
+{
+	if (blk_map[lbn] != HYB_NONE)
+	{
+		if (page0_seq(blk_map[lbn]) > seq)
+			return;
+
+		free_block(blk_map[lbn]);
+	}
+
+	blk_map[lbn] = (uint16_t) block;
+	take_block(block);
+}
+
+/// Incomplete block-mapped block: kept if among the HYB_OPEN_MAX newest
+static void mount_open(uint32_t lbn, uint32_t block, uint32_t seq)
+{
+	uint32_t k = open_count;
+
+	if (open_count == HYB_OPEN_MAX)
+	{
+		k = 0;
+		for (uint32_t i = 1; i < open_count; i++)
+			if (open_blk[i].seq < open_blk[k].seq)
+				k = i;
+
+		if (open_blk[k].seq > seq)
+			return;
+
+		free_block(open_blk[k].block);
+	}
+	else
+		open_count++;
+
+	open_blk[k].lbn = lbn;
+	open_blk[k].block = block;
+	open_blk[k].seq = seq;
+	take_block(block);
+}
+
+/// RW log block: the HYB_LOG_BLOCKS newest are the log, older ones reclaimed
+static void mount_log(uint32_t block, uint32_t seq)
+{
+	uint32_t k = rw_count;
+
+	if (rw_count == HYB_LOG_BLOCKS)
+	{
+		k = 0;
+		for (uint32_t i = 1; i < rw_count; i++)
+			if (log_seq[i] < log_seq[k])
+				k = i;
+
+		if (log_seq[k] > seq)
+			return;
+
+		free_block(rw_block[k]);
+	}
+	else
+		rw_count++;
+
+	rw_block[k] = (uint16_t) block;
+	log_seq[k] = seq;
+	take_block(block);
+}
+
+/// Sequence + 1 of the newest block-mapped copy of `lpn` (0: none)
+static uint32_t mapped_seq(uint32_t lpn)
+{
+	uint32_t lbn = lpn / PAGES_PER_BLOCK;
+	uint32_t off = lpn % PAGES_PER_BLOCK;
+	uint32_t best = 0;
+	FTL_Tag_t tag;
+
+	for (uint32_t i = 0; i <= open_count; i++)
+	{
+		uint32_t b = (i < open_count) ? open_blk[i].block : blk_map[lbn];
+
+		if ((i < open_count && open_blk[i].lbn != lbn) || b == HYB_NONE)
+			continue;
+
+		if (PageIO_ReadTag(PAGE_ADDR(b, off), &tag) && tag_ours(&tag)
+				&& tag.kind == FTL_TAG_DATA && tag_lpn(&tag) == lpn && tag.seq >= best)
+			best = tag.seq + 1;
+	}
+
+	return best;
+}
+
+/* ===========================================================================
+ * Function: Map_Mount
+ * ===========================================================================
+ * @brief
+ *  - Rebuild the block map and the log blocks from the page tags.
+ *
+ * @details
+ *  - No valid format record -> new format.
+ *  - Step 1: Page 0 (and 63) tag of every block. Block-mapped with page 63
+ *            -> data block candidate (newest per logical block), without
+ *            -> open (SW log or interrupted merge), RW log -> log candidate.
+ *            Everything else is free.
+ *  - Step 2: Open blocks older than their data block are stale.
+ *  - Step 3: RW log pages in sequence order, a page counts if it is newer
+ *            than every block-mapped copy of its logical page.
+ *  - Step 4: Open blocks completed (partial merge, oldest first): the SW
+ *            log state is never needed across a power cycle.
+ *
+ *  - About 2 tag reads per block: ~4100 short reads for the full device.
+ *
+ * @return
+ *  - true  : Mounted.
+ *  - false : Format record or a merge could not be written.
+ * --------------------------------------------------------------------------- */
+bool Map_Mount(void)
+{
+	Hyb_Format_t fmt;
+	bool ok = true;
+
+	memset(&stats, 0, sizeof(stats));
+	memset(&hstats, 0, sizeof(hstats));
+	memset(blk_map, 0xFF, sizeof(blk_map));
+	memset(blk_logged, 0, sizeof(blk_logged));
+	memset(blk_free, 0, sizeof(blk_free));
+	free_count = 0;
+	hyb_lblocks = 0;
+	sw_lbn = sw_hot = FTL_NONE;
+	rw_head = rw_count = 0;
+	rw_page = PAGES_PER_BLOCK;
+	rw_sealed = 0;
+	open_count = 0;
+
+	if (!fmt_load(&fmt))
+		return hyb_format();
+
+	hyb_gen = fmt.gen;
+	hyb_lblocks = fmt.lblocks;
+	hyb_seq = 0;
+
+	/// Step 1
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+	{
+		FTL_Tag_t tag, last;
+
+		if (BBT_IsBad(b))
+			continue;
+
+		free_block(b);
+
+		if (!PageIO_ReadTag(PAGE_ADDR(b, 0), &tag) || !tag_ours(&tag)
+				|| tag_lpn(&tag) >= hyb_lblocks * PAGES_PER_BLOCK)
+			continue;
+
+		seen(tag.seq);
+
+		if (tag.kind == FTL_TAG_LOG)
+		{
+			mount_log(b, tag.seq);
+			continue;
+		}
+
+		uint32_t lpn = tag_lpn(&tag);
+
+		if (lpn % PAGES_PER_BLOCK != 0)
+			continue;
+
+		if (PageIO_ReadTag(PAGE_ADDR(b, HYB_LAST_PAGE), &last) && tag_ours(&last)
+				&& last.kind == FTL_TAG_DATA && tag_lpn(&last) == lpn + HYB_LAST_PAGE)
+		{
+			seen(last.seq);
+			mount_data(lpn / PAGES_PER_BLOCK, b, tag.seq);
+		}
+		else
+			mount_open(lpn / PAGES_PER_BLOCK, b, tag.seq);
+	}
+
+	/// Step 2 (sorted oldest first for step 4)
+	for (uint32_t i = 0; i < open_count;)
+	{
+		uint32_t d = blk_map[open_blk[i].lbn];
+
+		if (d != HYB_NONE && page0_seq(d) > open_blk[i].seq)
+		{
+			free_block(open_blk[i].block);
+			open_blk[i] = open_blk[--open_count];
+		}
+		else
+			i++;
+	}
+
+	for (uint32_t i = 1; i < open_count; i++)
+		for (uint32_t k = i; k > 0 && open_blk[k].seq < open_blk[k - 1].seq; k--)
+		{
+			Hyb_Open_t t = open_blk[k];
+
+			open_blk[k] = open_blk[k - 1];
+			open_blk[k - 1] = t;
+		}
+
+	/// Step 3: slots sorted by age, pages applied oldest first
+	for (uint32_t i = 1; i < rw_count; i++)
+		for (uint32_t k = i; k > 0 && log_seq[k] < log_seq[k - 1]; k--)
+		{
+			uint32_t s = log_seq[k];
+			uint16_t b = rw_block[k];
+
+			log_seq[k] = log_seq[k - 1];
+			rw_block[k] = rw_block[k - 1];
+			log_seq[k - 1] = s;
+			rw_block[k - 1] = b;
+		}
+
+	uint32_t logs = rw_count;
+
+	for (rw_count = 0; rw_count < logs;)
+	{
+		uint32_t l = rw_count++;
+		uint32_t fill = PageIO_BlockFill(rw_block[l]);
+
+		memset(rw_lpn[l], 0xFF, sizeof(rw_lpn[l]));
+
+		for (uint32_t p = 0; p < fill; p++)
+		{
+			FTL_Tag_t tag;
+
+			if (!PageIO_ReadTag(PAGE_ADDR(rw_block[l], p), &tag) || !tag_ours(&tag)
+					|| tag.kind != FTL_TAG_LOG)
+				continue;
+
+			uint32_t lpn = tag_lpn(&tag);
+
+			seen(tag.seq);
+
+			if (lpn >= hyb_lblocks * PAGES_PER_BLOCK || tag.seq < mapped_seq(lpn))
+				continue;
+
+			rw_forget(lpn);
+			rw_lpn[l][p] = lpn;
+			bit_set(blk_logged, lpn / PAGES_PER_BLOCK, true);
+			stats.replayed++;
+		}
+
+		rw_page = fill;
+	}
+
+	/// Step 4: sequences of every page first, the merges write new ones
+	for (uint32_t i = 0; i < open_count; i++)
+	{
+		FTL_Tag_t tag;
+		Hyb_Open_t *o = &open_blk[i];
+
+		o->last = block_last(o->block);
+
+		if (o->last != 0 && PageIO_ReadTag(PAGE_ADDR(o->block, o->last - 1), &tag)
+				&& tag_ours(&tag))
+			seen(tag.seq);
+	}
+
+	for (uint32_t i = 0; ok && i < open_count; i++)
+	{
+		sw_lbn = open_blk[i].lbn;
+		sw_block = open_blk[i].block;
+		sw_next = open_blk[i].last;
+		ok = sw_close();
+	}
+
+	if (open_count != 0)
+		stats.recovered++;
+
+	open_count = 0;
+	NAND_LOG(FTL_HYB_MOUNT, stats.replayed, stats.recovered);
+
+	return ok;
+}
+
+uint32_t Map_PageCount(void)
+{
+	return hyb_lblocks * PAGES_PER_BLOCK;
+}
+
+/* ===========================================================================
+ * Function: Map_ReadPages
+ * ===========================================================================
+ * @brief
+ *  - Read `count` main areas from `lpn`.
+ *
+ * @details
+ *  - Each page from its newest copy (SW log, RW log, data block), runs of
+ *    physically consecutive pages in one Continuous Read stream: a merged
+ *    data block is read in one stream.
+ *  - Never written -> 0xFF, no NAND access.
+ *
+ * @return
+ *  - true  : Data valid.
+ *  - false : Out of range or uncorrectable page.
+ * --------------------------------------------------------------------------- */
+bool Map_ReadPages(uint32_t lpn, uint8_t *buf, uint32_t count)
+{
+	uint32_t ppn[PAGES_PER_BLOCK];
+	uint32_t pages = Map_PageCount();
+
+	if (count == 0 || count > PAGES_PER_BLOCK || lpn >= pages || count > pages - lpn)
+		return false;
+
+	for (uint32_t i = 0; i < count; i++)
+		ppn[i] = locate(lpn + i);
+
+	bool ok = true;
+
+	for (uint32_t i = 0, n; ok && i < count; i += n)
+	{
+		n = 1;
+
+		if (ppn[i] == FTL_NONE)
+		{
+			while (i + n < count && ppn[i + n] == FTL_NONE)
+				n++;
+			memset(&buf[i * PAGE_MAIN_SIZE], NAND_ERASED_STATE, n * PAGE_MAIN_SIZE);
+			continue;
+		}
+
+		while (i + n < count && ppn[i + n] == ppn[i] + n
+				&& (ppn[i] + n) % PAGES_PER_BLOCK != 0)
+			n++;
+
+		ok = PageIO_ReadRun(ppn[i], &buf[i * PAGE_MAIN_SIZE], n);
+	}
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: Map_WritePages
+ * ===========================================================================
+ * @brief
+ *  - Write `count` pages from `lpn`, data[i] -> lpn + i.
+ *
+ * @details
+ *  - A run starting at page 0 of a block fills a SW log (switch merge when
+ *    complete: sequential data costs no copy). Random pages go to the RW
+ *    log, merges happen when its oldest block is reclaimed.
+ *
+ * @return
+ *  - true  : Pages written.
+ *  - false : Out of range or no free block left.
+ * --------------------------------------------------------------------------- */
+bool Map_WritePages(uint32_t lpn, const uint8_t *const *data, uint32_t count)
+{
+	uint32_t pages = Map_PageCount();
+
+	if (count == 0 || count > PAGES_PER_BLOCK || lpn >= pages || count > pages - lpn)
+		return false;
+
+	bool ok = true;
+
+	for (uint32_t i = 0; ok && i < count; i++)
+		ok = write_data(lpn + i, data[i], count > 1);
+
+	return ok;
+}
+
+/// Every page is found from its tag at mount: nothing to checkpoint
+bool Map_Sync(void)
+{
+	return true;
+}
+
+bool Map_IsDirty(void)
+{
+	return false;
+}
+
+/// Merges run when a log block is needed, nothing to do ahead of time
+bool Map_Reclaim(uint32_t moves)
+{
+	(void) moves;
+	return false;
+}
+
+const Map_Stats_t* Map_GetStats(void)
+{
+	return &stats;
+}
+
+uint32_t Hyb_FreeCount(void)
+{
+	return free_count;
+}
+
+const Hyb_Stats_t* Hyb_GetStats(void)
+{
+	return &hstats;
+}
+
+#endif /* FTL_MAPPING */
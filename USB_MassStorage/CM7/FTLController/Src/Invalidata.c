@@ -0,0 +1,165 @@
+/*
+ *  Invalidata.c
+ *
+ *  Created on: Nov 19, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "Invalidata.h"
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+
+/* ---------------------------------------------------------------------------
+ * inv_map    : Valid bit of page p of block b = bit p of inv_map[b]
+ * inv_bucket : Valid count a tracked block is listed under, INV_UNTRACKED
+ *              when not tracked
+ * inv_next / inv_prev : Bucket list links (INV_END: none)
+ * inv_head / inv_tail : Bucket list ends, one per valid count
+ * --------------------------------------------------------------------------- */
+#define INV_UNTRACKED   0xFFu
+#define INV_END         0xFFFFu
+#define INV_BUCKETS     (PAGES_PER_BLOCK + 1)
+
+static uint64_t inv_map[TOTAL_BLOCKS];
+static uint8_t inv_bucket[TOTAL_BLOCKS];
+static uint16_t inv_next[TOTAL_BLOCKS];
+static uint16_t inv_prev[TOTAL_BLOCKS];
+static uint16_t inv_head[INV_BUCKETS];
+static uint16_t inv_tail[INV_BUCKETS];
+
+static void bucket_unlink(uint32_t block)
+{
+	uint32_t c = inv_bucket[block];
+	uint16_t prev = inv_prev[block];
+	uint16_t next = inv_next[block];
+
+	if (prev != INV_END)
+		inv_next[prev] = next;
+	else
+		inv_head[c] = next;
+
+	if (next != INV_END)
+		inv_prev[next] = prev;
+	else
+		inv_tail[c] = prev;
+
+	inv_bucket[block] = INV_UNTRACKED;
+}
+
+static void bucket_append(uint32_t block)
+{
+	uint32_t c = (uint32_t) __builtin_popcountll(inv_map[block]);
+
+	inv_bucket[block] = (uint8_t) c;
+	inv_next[block] = INV_END;
+	inv_prev[block] = inv_tail[c];
+
+	if (inv_tail[c] != INV_END)
+		inv_next[inv_tail[c]] = (uint16_t) block;
+	else
+		inv_head[c] = (uint16_t) block;
+
+	inv_tail[c] = (uint16_t) block;
+}
+
+/// Valid count of a tracked block changed: to the tail of its new bucket
+static void bucket_move(uint32_t block)
+{
+	if (inv_bucket[block] == INV_UNTRACKED)
+		return;
+
+	bucket_unlink(block);
+	bucket_append(block);
+}
+
+void Inv_Reset(void)
+{
+	memset(inv_map, 0, sizeof(inv_map));
+	memset(inv_bucket, INV_UNTRACKED, sizeof(inv_bucket));
+	memset(inv_head, 0xFF, sizeof(inv_head));
+	memset(inv_tail, 0xFF, sizeof(inv_tail));
+}
+
+void Inv_SetValid(uint32_t ppn)
+{
+	if (ppn >= TOTAL_PAGES)
+		return;
+
+	uint32_t b = ppn / PAGES_PER_BLOCK;
+	uint64_t bit = 1ULL << (ppn % PAGES_PER_BLOCK);
+
+	if (!(inv_map[b] & bit))
+	{
+		inv_map[b] |= bit;
+		bucket_move(b);
+	}
+}
+
+void Inv_Invalidate(uint32_t ppn)
+{
+	if (ppn >= TOTAL_PAGES)
+		return;
+
+	uint32_t b = ppn / PAGES_PER_BLOCK;
+	uint64_t bit = 1ULL << (ppn % PAGES_PER_BLOCK);
+
+	if (inv_map[b] & bit)
+	{
+		inv_map[b] &= ~bit;
+		bucket_move(b);
+	}
+}
+
+bool Inv_IsValid(uint32_t ppn)
+{
+	if (ppn >= TOTAL_PAGES)
+		return false;
+
+	return (inv_map[ppn / PAGES_PER_BLOCK] >> (ppn % PAGES_PER_BLOCK)) & 1U;
+}
+
+uint32_t Inv_ValidCount(uint32_t block)
+{
+	return (block < TOTAL_BLOCKS) ? (uint32_t) __builtin_popcountll(inv_map[block]) : 0;
+}
+
+uint32_t Inv_NextValid(uint32_t block, uint32_t page)
+{
+	if (block >= TOTAL_BLOCKS || page >= PAGES_PER_BLOCK)
+		return PAGES_PER_BLOCK;
+
+	uint64_t rest = inv_map[block] >> page;
+
+	return (rest != 0) ? page + (uint32_t) __builtin_ctzll(rest) : PAGES_PER_BLOCK;
+}
+
+void Inv_Track(uint32_t block, bool on)
+{
+	if (block >= TOTAL_BLOCKS || on == (inv_bucket[block] != INV_UNTRACKED))
+		return;
+
+	if (on)
+		bucket_append(block);
+	else
+		bucket_unlink(block);
+}
+
+uint32_t Inv_BucketFirst(uint32_t count)
+{
+	if (count >= INV_BUCKETS || inv_head[count] == INV_END)
+		return FTL_NONE;
+
+	return inv_head[count];
+}
+
+uint32_t Inv_BucketNext(uint32_t block)
+{
+	if (block >= TOTAL_BLOCKS || inv_bucket[block] == INV_UNTRACKED
+			|| inv_next[block] == INV_END)
+		return FTL_NONE;
+
+	return inv_next[block];
+}
+
+#endif /* FTL_MAPPING */
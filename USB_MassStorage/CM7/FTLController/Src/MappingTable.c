@@ -0,0 +1,1703 @@
+/*
+ *  MappingTable.c
+ *
+ *  Created on: Nov 18, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "MappingTable.h"
+#include "PageIO.h"
+#include "GarbageCollection.h"
+#include "Invalidata.h"
+#include "WearLeveling.h"
+#include "HotCold.h"
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+
+/* ---------------------------------------------------------------------------
+ * Mapping state
+ * ---------------------------------------------------------------------------
+ * map_gtd       : Translation page -> physical page (FTL_NONE: never written,
+ *                 every entry unmapped)
+ * map_pages     : Logical pages, map_tpages translation pages in use
+ * map_gen       : Format generation written into every tag
+ * map_seq       : Sequence of the next page programmed
+ * map_dirty     : Something was programmed since the last checkpoint
+ * map_allocs    : Blocks allocated since the last checkpoint
+ * fr_block/page : Write frontiers (MAP_FR_HOT / COLD / GC), FTL_NONE when
+ *                 closed
+ * --------------------------------------------------------------------------- */
+static uint32_t map_gtd[MAP_TPAGES];
+static uint32_t map_pages = 0;
+static uint32_t map_tpages = 0;
+static uint32_t map_gen = 0;
+static uint32_t map_seq = 0;
+static bool map_dirty = false;
+static uint32_t map_allocs = 0;
+static Map_Stats_t stats;
+
+static uint32_t fr_block[MAP_FRONTIERS];
+static uint32_t fr_page[MAP_FRONTIERS];
+
+/* ---------------------------------------------------------------------------
+ * Cached mapping table
+ * ---------------------------------------------------------------------------
+ * cmt_data : Translation page contents, pending updates applied (never dirty)
+ * cmt_slot : Owner translation page (CMT_FREE: unused), pin count (not
+ *            evicted while being written out), LRU links
+ * cmt_of   : Translation page -> slot, SLOT_NONE when not cached
+ * cmt_head : Most recently used, cmt_tail least recently used
+ * --------------------------------------------------------------------------- */
+#define SLOT_NONE   0xFFu
+#define CMT_FREE    0xFFFFu
+
+typedef struct
+{
+	uint16_t tvpn;
+	uint8_t pin;
+	uint8_t prev;
+	uint8_t next;
+} Map_Slot_t;
+
+static uint32_t cmt_data[MAP_CACHE_SLOTS][MAP_ENTRIES_PER_TPAGE];
+static Map_Slot_t cmt_slot[MAP_CACHE_SLOTS];
+static uint8_t cmt_of[MAP_TPAGES];
+static uint8_t cmt_head = SLOT_NONE;
+static uint8_t cmt_tail = SLOT_NONE;
+
+/* ---------------------------------------------------------------------------
+ * Pending updates
+ * ---------------------------------------------------------------------------
+ * pend       : Updates, dense (pend_count first entries), checkpoint payload
+ * pend_index : Open addressing hash on the logical page, entry + 1 (0: empty),
+ *              twice as many buckets as entries
+ * pend_of    : Pending updates per translation page
+ * --------------------------------------------------------------------------- */
+#define PEND_BUCKETS   (MAP_PENDING_ENTRIES * 2U)
+
+static Map_Pending_t pend[MAP_PENDING_ENTRIES];
+static uint16_t pend_index[PEND_BUCKETS];
+static uint16_t pend_of[MAP_TPAGES];
+static uint32_t pend_count = 0;
+
+/* ---------------------------------------------------------------------------
+ * Checkpoint
+ * ---------------------------------------------------------------------------
+ * ckpt_sections : Payload, concatenated and cut into pages (pending part
+ *                 sized per checkpoint)
+ * ckpt_block    : Checkpoint block written now, ckpt_page its next free page
+ * ckpt_good     : Block holding the last good checkpoint, never erased
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint8_t *data;
+	uint32_t size;
+} Map_Section_t;
+
+static Map_Section_t ckpt_sections[] =
+{
+	{ (uint8_t*) map_gtd, sizeof(map_gtd) },
+	{ (uint8_t*) pend, 0 },
+	{ (uint8_t*) WL_EraseCount, sizeof(WL_EraseCount) },
+};
+
+#define CKPT_SECTIONS   (sizeof(ckpt_sections) / sizeof(ckpt_sections[0]))
+
+static Map_Ckpt_t ckpt;
+static uint32_t ckpt_block = FTL_NONE;
+static uint32_t ckpt_page = 0;
+static uint32_t ckpt_good = FTL_NONE;
+
+/* ---------------------------------------------------------------------------
+ * Roll-forward: blocks written after the checkpoint, next page to replay
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t block;
+	uint32_t page;
+	FTL_Tag_t tag;
+} Map_Replay_t;
+
+static Map_Replay_t replay[MAP_REPLAY_MAX];
+
+/* ---------------------------------------------------------------------------
+ * Page buffers (word arrays: translation pages are read as entries)
+ * copy_buf : Relocation through RAM, checkpoint payload pages
+ * (PageIO_Stage: translation pages read back with their tag, rebuild_valid)
+ * --------------------------------------------------------------------------- */
+static uint32_t copy_buf[PAGE_MAIN_SIZE / sizeof(uint32_t)];
+
+/* ---------------------------------------------------------------------------
+ * Page tag I/O (PageIO.h), erase count and statistics of this mapping
+ * --------------------------------------------------------------------------- */
+/// Data or translation page of the mounted format
+static bool tag_ours(const FTL_Tag_t *tag)
+{
+	return tag->gen == map_gen
+			&& (tag->kind == FTL_TAG_DATA || tag->kind == FTL_TAG_TRANS);
+}
+
+static bool program_page(uint32_t ppn, const void *data, const FTL_Tag_t *tag)
+{
+	map_dirty = true;
+	if (!PageIO_Program(ppn, data, tag, WL_EraseCount[BLOCK_ADDR(ppn)]))
+		return false;
+
+	stats.programs++;
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Write frontiers
+ * ---------------------------------------------------------------------------
+ * One open block per frontier `f`: hot host pages (and translation pages),
+ * cold host pages, GC copies. Pages of one kind of lifetime share blocks,
+ * hot blocks turn invalid as a whole and GC copies little out of them.
+ *
+ * A full frontier is closed (GC candidate) and a new block allocated. Host
+ * allocations run GC first when free blocks run low, allocations inside GC
+ * may use the reserve.
+ * --------------------------------------------------------------------------- */
+static void frontier_reset(void)
+{
+	for (uint32_t f = 0; f < MAP_FRONTIERS; f++)
+	{
+		fr_block[f] = FTL_NONE;
+		fr_page[f] = 0;
+	}
+}
+
+static bool frontier_open(uint32_t f)
+{
+	bool gc_tried = false;
+
+	while (fr_block[f] == FTL_NONE || fr_page[f] >= PAGES_PER_BLOCK)
+	{
+		if (fr_block[f] != FTL_NONE)
+		{
+			GC_SetState(fr_block[f], GC_BLOCK_USED);
+			fr_block[f] = FTL_NONE;
+		}
+
+		/// GC may open the frontier itself, checked again
+		if (!gc_tried && !GC_IsActive()
+				&& GC_FreeCount() < FTL_GC_FREE_LOW)
+		{
+			gc_tried = true;
+			GC_Run(FTL_GC_FREE_LOW);
+			continue;
+		}
+
+		uint32_t b = GC_AllocBlock(GC_IsActive());
+
+		if (b == FTL_NONE)
+			return false;
+
+		fr_block[f] = b;
+		fr_page[f] = 0;
+		map_allocs++;
+	}
+
+	return true;
+}
+
+/// Program failure: the frontier block leaves the pool, its pages move out
+static void retire_block(uint32_t block)
+{
+	for (uint32_t f = 0; f < MAP_FRONTIERS; f++)
+		if (fr_block[f] == block)
+			fr_block[f] = FTL_NONE;
+
+	GC_Retire(block);
+}
+
+#define MAP_WRITE_TRIES   4U
+
+static bool write_page(uint32_t f, const void *data, uint32_t kind, uint32_t id,
+		uint32_t *ppn)
+{
+	for (uint32_t t = 0; t < MAP_WRITE_TRIES; t++)
+	{
+		if (!frontier_open(f))
+			return false;
+
+		uint32_t dst = PAGE_ADDR(fr_block[f], fr_page[f]++);
+		FTL_Tag_t tag = PageIO_NextTag(kind, map_gen, id, &map_seq);
+
+		if (program_page(dst, data, &tag))
+		{
+			*ppn = dst;
+			return true;
+		}
+
+		retire_block(BLOCK_ADDR(dst));
+	}
+
+	return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * Relocate one page to the GC frontier: copy-back with a new tag, through
+ * RAM when the source is uncorrectable (keeps what it still holds).
+ * --------------------------------------------------------------------------- */
+static bool copy_page(uint32_t src, uint32_t kind, uint32_t id, uint32_t *ppn)
+{
+	for (uint32_t t = 0; t < MAP_WRITE_TRIES; t++)
+	{
+		if (!frontier_open(MAP_FR_GC))
+			return false;
+
+		uint32_t dst = PAGE_ADDR(fr_block[MAP_FR_GC], fr_page[MAP_FR_GC]++);
+		FTL_Tag_t tag = PageIO_NextTag(kind, map_gen, id, &map_seq);
+		uint32_t erase = WL_EraseCount[BLOCK_ADDR(dst)];
+		NandPatch_t patch[2] =
+		{
+			{ FTL_TAG_COL, sizeof(tag), (const uint8_t*) &tag },
+			{ FTL_WL_COL, sizeof(erase), (const uint8_t*) &erase }
+		};
+		ECC_Status_t ecc = ECC_SUCCESS;
+
+		map_dirty = true;
+
+		if (CopyPage_Service(src, dst, patch, 2, &ecc))
+		{
+			stats.copy_back++;
+			stats.programs++;
+			*ppn = dst;
+			return true;
+		}
+
+		if (ecc == ECC_UNCORRECTABLE)
+		{
+			StandardRead_Service(src, 0, (uint8_t*) copy_buf, PAGE_MAIN_SIZE);
+
+			if (program_page(dst, copy_buf, &tag))
+			{
+				stats.through_ram++;
+				*ppn = dst;
+				return true;
+			}
+		}
+
+		retire_block(BLOCK_ADDR(dst));
+	}
+
+	return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * CMT: LRU list over all slots (free slots drift to the tail)
+ * --------------------------------------------------------------------------- */
+static void lru_unlink(uint8_t s)
+{
+	Map_Slot_t *sl = &cmt_slot[s];
+
+	if (sl->prev != SLOT_NONE)
+		cmt_slot[sl->prev].next = sl->next;
+	else
+		cmt_head = sl->next;
+
+	if (sl->next != SLOT_NONE)
+		cmt_slot[sl->next].prev = sl->prev;
+	else
+		cmt_tail = sl->prev;
+}
+
+static void lru_push_front(uint8_t s)
+{
+	cmt_slot[s].prev = SLOT_NONE;
+	cmt_slot[s].next = cmt_head;
+
+	if (cmt_head != SLOT_NONE)
+		cmt_slot[cmt_head].prev = s;
+	else
+		cmt_tail = s;
+
+	cmt_head = s;
+}
+
+static void lru_push_back(uint8_t s)
+{
+	cmt_slot[s].next = SLOT_NONE;
+	cmt_slot[s].prev = cmt_tail;
+
+	if (cmt_tail != SLOT_NONE)
+		cmt_slot[cmt_tail].next = s;
+	else
+		cmt_head = s;
+
+	cmt_tail = s;
+}
+
+static void cmt_reset(void)
+{
+	memset(cmt_of, SLOT_NONE, sizeof(cmt_of));
+	cmt_head = cmt_tail = SLOT_NONE;
+
+	for (uint8_t s = 0; s < MAP_CACHE_SLOTS; s++)
+	{
+		cmt_slot[s].tvpn = CMT_FREE;
+		cmt_slot[s].pin = 0;
+		lru_push_back(s);
+	}
+}
+
+/// Forget a cached translation page (roll-forward found a newer copy)
+static void cmt_drop(uint32_t tvpn)
+{
+	uint8_t s = cmt_of[tvpn];
+
+	if (s == SLOT_NONE)
+		return;
+
+	cmt_of[tvpn] = SLOT_NONE;
+	cmt_slot[s].tvpn = CMT_FREE;
+	lru_unlink(s);
+	lru_push_back(s);
+}
+
+/* ---------------------------------------------------------------------------
+ * Pending updates: hash with linear probing
+ * --------------------------------------------------------------------------- */
+static uint32_t pend_home(uint32_t lpn)
+{
+	return (lpn * 2654435761u) >> (32U - (MAP_PENDING_BITS + 1U));
+}
+
+/// Bucket holding `lpn`, or the empty bucket ending its probe sequence
+static uint32_t pend_bucket(uint32_t lpn)
+{
+	uint32_t h = pend_home(lpn);
+
+	while (pend_index[h] != 0 && pend[pend_index[h] - 1].lpn != lpn)
+		h = (h + 1) & (PEND_BUCKETS - 1);
+
+	return h;
+}
+
+static void pend_reset(void)
+{
+	memset(pend_index, 0, sizeof(pend_index));
+	memset(pend_of, 0, sizeof(pend_of));
+	pend_count = 0;
+}
+
+static bool pend_get(uint32_t lpn, uint32_t *ppn)
+{
+	uint32_t h = pend_bucket(lpn);
+
+	if (pend_index[h] == 0)
+		return false;
+
+	*ppn = pend[pend_index[h] - 1].ppn;
+	return true;
+}
+
+/// Insert or update, false when every entry is taken
+static bool pend_put(uint32_t lpn, uint32_t ppn)
+{
+	uint32_t h = pend_bucket(lpn);
+
+	if (pend_index[h] != 0)
+	{
+		pend[pend_index[h] - 1].ppn = ppn;
+		return true;
+	}
+
+	if (pend_count == MAP_PENDING_ENTRIES)
+		return false;
+
+	pend[pend_count].lpn = lpn;
+	pend[pend_count].ppn = ppn;
+	pend_index[h] = (uint16_t) ++pend_count;
+	pend_of[lpn / MAP_ENTRIES_PER_TPAGE]++;
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Remove the entry of bucket `h`: later buckets of the probe run shifted
+ * back (no tombstones), the last dense entry moved into the hole.
+ * --------------------------------------------------------------------------- */
+static void pend_remove(uint32_t h)
+{
+	uint32_t e = pend_index[h] - 1u;
+	uint32_t i = h;
+
+	pend_index[i] = 0;
+
+	for (uint32_t j = (i + 1) & (PEND_BUCKETS - 1); pend_index[j] != 0;
+			j = (j + 1) & (PEND_BUCKETS - 1))
+	{
+		uint32_t k = pend_home(pend[pend_index[j] - 1].lpn);
+		bool stays = (i < j) ? (k > i && k <= j) : (k > i || k <= j);
+
+		if (!stays)
+		{
+			pend_index[i] = pend_index[j];
+			pend_index[j] = 0;
+			i = j;
+		}
+	}
+
+	pend_of[pend[e].lpn / MAP_ENTRIES_PER_TPAGE]--;
+	pend_count--;
+
+	if (e != pend_count)
+	{
+		pend[e] = pend[pend_count];
+		pend_index[pend_bucket(pend[e].lpn)] = (uint16_t) (e + 1);
+	}
+}
+
+/// Drop the updates of translation page `tvpn` (now written to it)
+static void pend_drop(uint32_t tvpn)
+{
+	for (uint32_t i = 0; pend_of[tvpn] != 0 && i < pend_count;)
+	{
+		if (pend[i].lpn / MAP_ENTRIES_PER_TPAGE == tvpn)
+			pend_remove(pend_bucket(pend[i].lpn));
+		else
+			i++;
+	}
+}
+
+/// Apply the updates of translation page `tvpn` to its entries `e`
+static void pend_apply(uint32_t tvpn, uint32_t *e)
+{
+	for (uint32_t i = 0; pend_of[tvpn] != 0 && i < pend_count; i++)
+		if (pend[i].lpn / MAP_ENTRIES_PER_TPAGE == tvpn)
+			e[pend[i].lpn % MAP_ENTRIES_PER_TPAGE] = pend[i].ppn;
+}
+
+/// Hash rebuilt from the `count` entries of a checkpoint
+static void pend_load(uint32_t count)
+{
+	pend_reset();
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Map_Pending_t e = pend[i];
+
+		if (e.lpn < map_pages)
+			pend_put(e.lpn, e.ppn);
+	}
+}
+
+/* ===========================================================================
+ * Function: cmt_get
+ * ===========================================================================
+ * @brief
+ *  - Slot holding translation page `tvpn`, loaded on a miss.
+ *
+ * @details
+ *  - Miss: least recently used slot that is not pinned. Slots are never
+ *    dirty, eviction writes nothing: flash copy read, pending updates
+ *    applied on top.
+ *
+ * @return
+ *  - Slot, SLOT_NONE when every slot is pinned or the read failed.
+ * --------------------------------------------------------------------------- */
+static uint8_t cmt_get(uint32_t tvpn)
+{
+	uint8_t s = cmt_of[tvpn];
+
+	if (s != SLOT_NONE)
+		stats.cache_hits++;
+	else
+	{
+		stats.cache_misses++;
+
+		for (s = cmt_tail; s != SLOT_NONE && cmt_slot[s].pin != 0; s = cmt_slot[s].prev)
+			;
+
+		if (s == SLOT_NONE)
+			return SLOT_NONE;
+
+		if (cmt_slot[s].tvpn != CMT_FREE)
+			cmt_of[cmt_slot[s].tvpn] = SLOT_NONE;
+
+		cmt_slot[s].tvpn = CMT_FREE;
+
+		if (map_gtd[tvpn] == FTL_NONE)
+			memset(cmt_data[s], 0xFF, PAGE_MAIN_SIZE);
+		else if (!StandardRead_Service(map_gtd[tvpn], 0, (uint8_t*) cmt_data[s],
+				PAGE_MAIN_SIZE))
+			return SLOT_NONE;
+
+		pend_apply(tvpn, cmt_data[s]);
+		cmt_slot[s].tvpn = (uint16_t) tvpn;
+		cmt_of[tvpn] = s;
+	}
+
+	lru_unlink(s);
+	lru_push_front(s);
+	return s;
+}
+
+/* ---------------------------------------------------------------------------
+ * Mapping entry of `lpn`: CMT, pending updates, then the translation page.
+ * `install`: load the translation page into the CMT (host reads, sequential
+ * neighbours follow). Otherwise only the 4-byte entry is read from flash
+ * (writes and GC, no eviction churn).
+ * --------------------------------------------------------------------------- */
+static bool map_lookup(uint32_t lpn, bool install, uint32_t *ppn)
+{
+	uint32_t tvpn = lpn / MAP_ENTRIES_PER_TPAGE;
+	uint32_t idx = lpn % MAP_ENTRIES_PER_TPAGE;
+	uint8_t s = cmt_of[tvpn];
+
+	if (s != SLOT_NONE && !install)
+	{
+		stats.cache_hits++;
+		*ppn = cmt_data[s][idx];
+		return true;
+	}
+
+	if (s == SLOT_NONE && pend_get(lpn, ppn))
+	{
+		stats.cache_hits++;
+		return true;
+	}
+
+	if (install)
+	{
+		s = cmt_get(tvpn);
+		if (s == SLOT_NONE)
+			return false;
+
+		*ppn = cmt_data[s][idx];
+		return true;
+	}
+
+	*ppn = FTL_NONE;
+	if (map_gtd[tvpn] == FTL_NONE)
+		return true;
+
+	stats.entry_reads++;
+	return StandardRead_Service(map_gtd[tvpn], idx * sizeof(uint32_t), (uint8_t*) ppn,
+			sizeof(*ppn));
+}
+
+/// Repoint `lpn`: cached copy and pending update
+static bool map_update(uint32_t lpn, uint32_t ppn)
+{
+	uint8_t s = cmt_of[lpn / MAP_ENTRIES_PER_TPAGE];
+
+	if (s != SLOT_NONE)
+		cmt_data[s][lpn % MAP_ENTRIES_PER_TPAGE] = ppn;
+
+	return pend_put(lpn, ppn);
+}
+
+/* ===========================================================================
+ * Function: map_absorb
+ * ===========================================================================
+ * @brief
+ *  - Write translation page `tvpn` with its pending updates, drop them.
+ *
+ * @details
+ *  - The slot stays pinned while the write runs: GC inside it may update
+ *    entries of `tvpn` (cached copy and pending alike), the page is only
+ *    staged when programmed and carries them too.
+ * --------------------------------------------------------------------------- */
+static bool map_absorb(uint32_t tvpn)
+{
+	uint8_t s = cmt_get(tvpn);
+	uint32_t ppn;
+
+	if (s == SLOT_NONE)
+		return false;
+
+	cmt_slot[s].pin++;
+	bool ok = write_page(MAP_FR_HOT, cmt_data[s], FTL_TAG_TRANS, tvpn, &ppn);
+	cmt_slot[s].pin--;
+
+	if (!ok)
+		return false;
+
+	Inv_Invalidate(map_gtd[tvpn]);
+	map_gtd[tvpn] = ppn;
+	Inv_SetValid(ppn);
+	pend_drop(tvpn);
+	stats.tpage_writes++;
+	return true;
+}
+
+/// Above MAP_PENDING_HIGH: translation page with the most updates written
+static bool map_balance(void)
+{
+	while (pend_count > MAP_PENDING_HIGH)
+	{
+		uint32_t best = 0;
+
+		for (uint32_t t = 1; t < map_tpages; t++)
+			if (pend_of[t] > pend_of[best])
+				best = t;
+
+		if (!map_absorb(best))
+			return false;
+	}
+
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Valid pages from the mapping: every translation page and every page it
+ * points at (cached copy when there is one, pending updates on top).
+ * Translation pages whose tag does not match are skipped.
+ * --------------------------------------------------------------------------- */
+static void rebuild_valid(void)
+{
+	const FTL_Tag_t *tag = (const FTL_Tag_t*) &((uint8_t*) PageIO_Stage)[FTL_TAG_COL];
+
+	Inv_Reset();
+
+	for (uint32_t t = 0; t < map_tpages; t++)
+	{
+		const uint32_t *e = PageIO_Stage;
+
+		if (cmt_of[t] != SLOT_NONE)
+		{
+			e = cmt_data[cmt_of[t]];
+			Inv_SetValid(map_gtd[t]);
+		}
+		else if (map_gtd[t] == FTL_NONE && pend_of[t] == 0)
+			continue;
+		else
+		{
+			if (map_gtd[t] != FTL_NONE)
+				StandardRead_Service(map_gtd[t], 0, (uint8_t*) PageIO_Stage,
+						sizeof(PageIO_Stage));
+
+			if (map_gtd[t] != FTL_NONE && tag->kind == FTL_TAG_TRANS
+					&& tag->gen == map_gen && (tag->id & ~FTL_TAG_MOVED) == t)
+				Inv_SetValid(map_gtd[t]);
+			else
+				memset(PageIO_Stage, 0xFF, PAGE_MAIN_SIZE);
+
+			pend_apply(t, PageIO_Stage);
+		}
+
+		for (uint32_t i = 0; i < MAP_ENTRIES_PER_TPAGE; i++)
+			Inv_SetValid(e[i]);
+	}
+}
+
+/// Block states from the valid pages, frontiers open
+static void reset_blocks(void)
+{
+	GC_Reset();
+
+	for (uint32_t f = 0; f < MAP_FRONTIERS; f++)
+		if (fr_block[f] != FTL_NONE)
+			GC_SetState(fr_block[f], GC_BLOCK_OPEN);
+}
+
+static void pin_tpages(void)
+{
+	GC_UnpinAll();
+
+	for (uint32_t t = 0; t < map_tpages; t++)
+		if (map_gtd[t] != FTL_NONE)
+			GC_Pin(BLOCK_ADDR(map_gtd[t]));
+}
+
+/* ---------------------------------------------------------------------------
+ * Checkpoint payload bytes [off, off + len) to / from `buf`, size with
+ * `pending` updates
+ * --------------------------------------------------------------------------- */
+static uint32_t ckpt_payload_size(uint32_t pending)
+{
+	uint32_t size = 0;
+
+	ckpt_sections[1].size = pending * sizeof(Map_Pending_t);
+
+	for (uint32_t i = 0; i < CKPT_SECTIONS; i++)
+		size += ckpt_sections[i].size;
+
+	return size;
+}
+
+static void ckpt_move(uint32_t off, uint8_t *buf, uint32_t len, bool load)
+{
+	for (uint32_t i = 0; i < CKPT_SECTIONS && len != 0; i++)
+	{
+		const Map_Section_t *sec = &ckpt_sections[i];
+
+		if (off >= sec->size)
+		{
+			off -= sec->size;
+			continue;
+		}
+
+		uint32_t n = sec->size - off;
+
+		if (n > len)
+			n = len;
+
+		if (load)
+			memcpy(&sec->data[off], buf, n);
+		else
+			memcpy(buf, &sec->data[off], n);
+
+		buf += n;
+		len -= n;
+		off = 0;
+	}
+}
+
+/* ===========================================================================
+ * Function: ckpt_write
+ * ===========================================================================
+ * @brief
+ *  - Append a checkpoint (payload pages, header last) to the current
+ *    checkpoint block.
+ *
+ * @details
+ *  - No room left: the first good candidate other than the block of the
+ *    last good checkpoint (A <-> B ping-pong) is erased and written from
+ *    page 0. That block is never erased, whatever fails.
+ *  - Erase / program failure on another block: marked bad, the next
+ *    candidate (FTL_CKPT_SPARES) takes over.
+ *  - A torn checkpoint is never found: the header page is written last and
+ *    carries the CRC of every payload page.
+ * --------------------------------------------------------------------------- */
+/// First good checkpoint block other than `a` and `b`
+static uint32_t ckpt_next(uint32_t a, uint32_t b)
+{
+	for (uint32_t i = 0; i < FTL_CKPT_BLOCKS; i++)
+	{
+		uint32_t block = FTL_CKPT_BLOCK(i);
+
+		if (block != a && block != b && !BBT_IsBad(block) && BBT_VerifyBlock(block))
+			return block;
+	}
+
+	return FTL_NONE;
+}
+
+/// Failed block: out of the rotation unless it holds the last good checkpoint
+static void ckpt_retire(uint32_t block)
+{
+	ckpt_page = PAGES_PER_BLOCK;
+
+	if (block == ckpt_good)
+		return;
+
+	BBT_MarkRuntimeBad(block);
+	NAND_LOG(FTL_CKPT_BAD, block);
+}
+
+static bool ckpt_write(void)
+{
+	uint32_t size = ckpt_payload_size(pend_count);
+	uint32_t np = (size + PAGE_MAIN_SIZE - 1) / PAGE_MAIN_SIZE;
+	uint32_t total = np + 1;
+
+	if (np > MAP_CKPT_MAX_PAGES)
+		return false;
+
+	memset(&ckpt, 0, sizeof(ckpt));
+	ckpt.magic = MAP_CKPT_MAGIC;
+	ckpt.gen = map_gen;
+	ckpt.seq = map_seq;
+	ckpt.pages = map_pages;
+	ckpt.pending = pend_count;
+	memcpy(ckpt.fr_block, fr_block, sizeof(ckpt.fr_block));
+	memcpy(ckpt.fr_page, fr_page, sizeof(ckpt.fr_page));
+	ckpt.payload_pages = np;
+
+	for (uint32_t t = 0; t <= FTL_CKPT_BLOCKS; t++)
+	{
+		if (ckpt_block == FTL_NONE || ckpt_page + total > PAGES_PER_BLOCK)
+		{
+			ckpt_block = ckpt_next(ckpt_good, ckpt_block);
+			if (ckpt_block == FTL_NONE)
+				break;
+
+			ckpt_page = 0;
+
+			if (!BlockErase128K_service(ckpt_block, 0))
+			{
+				ckpt_retire(ckpt_block);
+				continue;
+			}
+			WL_Erased(ckpt_block);
+		}
+
+		bool ok = true;
+
+		for (uint32_t i = 0; ok && i <= np; i++)
+		{
+			FTL_Tag_t tag = { FTL_TAG_CKPT, map_gen, (i << 16) | total, ckpt.seq };
+
+			memset(copy_buf, 0xFF, PAGE_MAIN_SIZE);
+
+			if (i < np)
+			{
+				uint32_t len = size - i * PAGE_MAIN_SIZE;
+
+				ckpt_move(i * PAGE_MAIN_SIZE, (uint8_t*) copy_buf,
+						(len < PAGE_MAIN_SIZE) ? len : PAGE_MAIN_SIZE, false);
+				ckpt.payload_crc[i] = BBT_Crc32(copy_buf, PAGE_MAIN_SIZE);
+			}
+			else
+			{
+				ckpt.crc = BBT_Crc32(&ckpt, offsetof(Map_Ckpt_t, crc));
+				memcpy(copy_buf, &ckpt, sizeof(ckpt));
+			}
+
+			ok = program_page(PAGE_ADDR(ckpt_block, ckpt_page + i), copy_buf, &tag);
+		}
+
+		ckpt_page += total;
+		if (ok)
+		{
+			ckpt_good = ckpt_block;
+			return true;
+		}
+
+		ckpt_retire(ckpt_block);
+	}
+
+	return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * Newest checkpoint header of a ping-pong block: from the last programmed
+ * page backwards (a torn checkpoint is skipped). `fill`: programmed pages.
+ * --------------------------------------------------------------------------- */
+static bool ckpt_find(uint32_t block, Map_Ckpt_t *hdr, uint32_t *hdr_page,
+		uint32_t *fill)
+{
+	*fill = PageIO_BlockFill(block);
+
+	for (uint32_t p = *fill; p-- > 0;)
+	{
+		FTL_Tag_t tag;
+
+		if (!PageIO_ReadTag(PAGE_ADDR(block, p), &tag) || tag.kind != FTL_TAG_CKPT
+				|| (tag.id >> 16) + 1 != (tag.id & 0xFFFFu))
+			continue;
+
+		if (!StandardRead_Service(PAGE_ADDR(block, p), 0, (uint8_t*) copy_buf,
+				PAGE_MAIN_SIZE))
+			continue;
+
+		memcpy(hdr, copy_buf, sizeof(*hdr));
+
+		if (hdr->magic == MAP_CKPT_MAGIC
+				&& hdr->crc == BBT_Crc32(hdr, offsetof(Map_Ckpt_t, crc))
+				&& hdr->payload_pages <= MAP_CKPT_MAX_PAGES
+				&& hdr->payload_pages <= p && hdr->gen == tag.gen)
+		{
+			*hdr_page = p;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Payload pages checked against the header first, loaded only when all match
+static bool ckpt_load(uint32_t block, uint32_t hdr_page, const Map_Ckpt_t *hdr)
+{
+	uint32_t first = hdr_page - hdr->payload_pages;
+
+	if (hdr->pending > MAP_PENDING_ENTRIES)
+		return false;
+
+	uint32_t size = ckpt_payload_size(hdr->pending);
+
+	if (hdr->payload_pages != (size + PAGE_MAIN_SIZE - 1) / PAGE_MAIN_SIZE
+			|| hdr->pages == 0 || hdr->pages > MAP_TPAGES * MAP_ENTRIES_PER_TPAGE)
+		return false;
+
+	for (uint32_t pass = 0; pass < 2; pass++)
+	{
+		for (uint32_t i = 0; i < hdr->payload_pages; i++)
+		{
+			uint32_t len = size - i * PAGE_MAIN_SIZE;
+
+			if (!StandardRead_Service(PAGE_ADDR(block, first + i), 0,
+					(uint8_t*) copy_buf, PAGE_MAIN_SIZE)
+					|| BBT_Crc32(copy_buf, PAGE_MAIN_SIZE) != hdr->payload_crc[i])
+				return false;
+
+			if (pass == 1)
+				ckpt_move(i * PAGE_MAIN_SIZE, (uint8_t*) copy_buf,
+						(len < PAGE_MAIN_SIZE) ? len : PAGE_MAIN_SIZE, true);
+		}
+	}
+
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Roll-forward: apply one page written after the checkpoint
+ * --------------------------------------------------------------------------- */
+static bool replay_page(uint32_t ppn, const FTL_Tag_t *tag)
+{
+	uint32_t id = tag->id & ~FTL_TAG_MOVED;
+
+	stats.replayed++;
+
+	if (tag->kind == FTL_TAG_TRANS)
+	{
+		if (id >= map_tpages)
+			return true;
+
+		map_gtd[id] = ppn;
+
+		/// Written translation page (not a GC copy): holds every update before it
+		if (!(tag->id & FTL_TAG_MOVED))
+		{
+			cmt_drop(id);
+			pend_drop(id);
+		}
+		return true;
+	}
+
+	return (id >= map_pages) || map_update(id, ppn);
+}
+
+/* ===========================================================================
+ * Function: map_replay
+ * ===========================================================================
+ * @brief
+ *  - Bring the mapping from the checkpoint up to the last page written
+ *    before power was lost.
+ *
+ * @details
+ *  - Step 1: Blocks written since = first page (frontier: its write
+ *            pointer) tagged with this generation and seq >= checkpoint.
+ *  - Step 2: Pages of these blocks applied in sequence order (merge over
+ *            the blocks, each one programmed in order), data -> pending
+ *            update, translation -> GTD entry (its pending updates dropped,
+ *            a GC copy only repoints).
+ *  - Step 3: Valid pages from the new mapping, new frontier, checkpoint.
+ *
+ *  - Nothing is written while replaying (the free blocks are unknown until
+ *    step 3): translation pages written back then come in the same order,
+ *    pending updates never grow beyond what they were before power loss.
+ *    Translation pages of the checkpoint are pinned, GC never erased them.
+ * --------------------------------------------------------------------------- */
+static bool map_replay(void)
+{
+	uint32_t n = 0;
+	uint32_t next_seq = ckpt.seq;
+	bool ok = true;
+
+	/// Step 1
+	for (uint32_t b = FTL_FIRST_BLOCK; ok && b <= FTL_LAST_BLOCK; b++)
+	{
+		uint32_t p = 0;
+		FTL_Tag_t tag;
+
+		for (uint32_t f = 0; f < MAP_FRONTIERS; f++)
+			if (b == ckpt.fr_block[f])
+				p = ckpt.fr_page[f];
+
+		/// Unknown blocks are not verified: only a block this FTL wrote
+		/// carries its tag
+		if (p >= PAGES_PER_BLOCK || BBT_IsBad(b))
+			continue;
+
+		if (!PageIO_ReadTag(PAGE_ADDR(b, p), &tag) || !tag_ours(&tag) || tag.seq < ckpt.seq)
+			continue;
+
+		if (n == MAP_REPLAY_MAX)
+		{
+			ok = false;
+			continue;
+		}
+
+		replay[n].block = b;
+		replay[n].page = p;
+		replay[n].tag = tag;
+		n++;
+
+		/// Erased since the checkpoint: its pages carry the newer count
+		WL_Seen(b, PageIO_ReadErase(PAGE_ADDR(b, p)));
+
+		uint32_t last = PageIO_BlockFill(b);
+
+		if (last > p && PageIO_ReadTag(PAGE_ADDR(b, last - 1), &tag) && tag_ours(&tag)
+				&& tag.seq >= next_seq)
+			next_seq = tag.seq + 1;
+	}
+
+	NAND_LOG(FTL_REPLAY, n, ckpt.seq);
+
+	/// Step 2
+	map_seq = next_seq;
+
+	while (ok && n != 0)
+	{
+		uint32_t k = 0;
+
+		for (uint32_t i = 1; i < n; i++)
+			if (replay[i].tag.seq < replay[k].tag.seq)
+				k = i;
+
+		Map_Replay_t *r = &replay[k];
+		uint32_t prev = r->tag.seq;
+
+		ok = replay_page(PAGE_ADDR(r->block, r->page), &r->tag);
+
+		/// Block ends at its first page not following in sequence
+		if (++r->page >= PAGES_PER_BLOCK
+				|| !PageIO_ReadTag(PAGE_ADDR(r->block, r->page), &r->tag)
+				|| !tag_ours(&r->tag) || r->tag.seq <= prev)
+			replay[k] = replay[--n];
+	}
+
+	/// Step 3
+	rebuild_valid();
+	frontier_reset();
+	reset_blocks();
+	map_dirty = true;
+
+	return Map_Sync() && ok;
+}
+
+/* ---------------------------------------------------------------------------
+ * Page 0 tag of every checkpoint and FTL block: generation above anything
+ * tagged on flash (0: none), `good` FTL blocks (after a lazy BBT mount the
+ * unknown ones less the factory bad blocks they may hide, nothing verified
+ * here), erase counts kept where readable. `data`: the newest generation
+ * owns data / translation pages, only a format whose checkpoint was written
+ * could have programmed them.
+ * --------------------------------------------------------------------------- */
+static uint32_t map_scan(uint32_t *good, bool *data)
+{
+	uint32_t gen = 0, data_gen = 0;
+
+	*good = BBT_GoodLowerBound(FTL_FIRST_BLOCK, FTL_LAST_BLOCK);
+	WL_Clear();
+
+	for (uint32_t b = FTL_CKPT_BLOCK_A; b <= FTL_LAST_BLOCK; b++)
+	{
+		FTL_Tag_t tag;
+
+		if (b > FTL_CKPT_BLOCK_B && b < FACTORY_INFO_BLOCK_END)
+			continue;
+
+		if (!PageIO_ReadTag(PAGE_ADDR(b, 0), &tag) || (tag.kind != FTL_TAG_DATA
+				&& tag.kind != FTL_TAG_TRANS && tag.kind != FTL_TAG_CKPT))
+			continue;
+
+		if (tag.gen >= gen)
+			gen = tag.gen + 1;
+
+		if (tag.kind != FTL_TAG_CKPT && b >= FTL_FIRST_BLOCK && tag.gen >= data_gen)
+			data_gen = tag.gen + 1;
+
+		/// Erase counts survive a new format where page 0 still holds one
+		WL_Seen(b, PageIO_ReadErase(PAGE_ADDR(b, 0)));
+	}
+
+	*data = (data_gen != 0 && data_gen == gen);
+	return gen;
+}
+
+/* ---------------------------------------------------------------------------
+ * New format (map_scan first): capacity from the good blocks, empty mapping
+ * --------------------------------------------------------------------------- */
+static bool map_format(uint32_t gen, uint32_t good)
+{
+	map_gen = (gen == 0 || gen == FTL_NONE) ? 1 : gen;
+	map_seq = 0;
+
+	good = (good > FTL_RESERVE_BLOCKS) ? good - FTL_RESERVE_BLOCKS : 0;
+	map_pages = good * PAGES_PER_BLOCK * (100 - FTL_OP_PERCENT) / 100;
+	if (map_pages > MAP_TPAGES * MAP_ENTRIES_PER_TPAGE)
+		map_pages = MAP_TPAGES * MAP_ENTRIES_PER_TPAGE;
+	map_tpages = (map_pages + MAP_ENTRIES_PER_TPAGE - 1) / MAP_ENTRIES_PER_TPAGE;
+
+	/// Checkpoints of the old format must not outrank the new ones
+	ckpt_block = ckpt_good = FTL_NONE;
+
+	for (uint32_t i = 0; i < FTL_CKPT_BLOCKS; i++)
+	{
+		uint32_t block = FTL_CKPT_BLOCK(i);
+
+		if (BBT_IsBad(block) || !BBT_VerifyBlock(block))
+			continue;
+
+		if (BlockErase128K_service(block, 0))
+			WL_Erased(block);
+		else
+			ckpt_retire(block);
+	}
+
+	memset(map_gtd, 0xFF, sizeof(map_gtd));
+	pend_reset();
+	Inv_Reset();
+	reset_blocks();
+
+	stats.formats++;
+	NAND_LOG(FTL_FORMAT, map_pages, map_gen);
+
+	map_dirty = true;
+	return Map_Sync();
+}
+
+/* ===========================================================================
+ * Function: Map_Mount
+ * ===========================================================================
+ * @brief
+ *  - Load the newest checkpoint, roll forward, rebuild the valid pages.
+ *
+ * @details
+ *  - Every good checkpoint block is searched, the newest valid checkpoint
+ *    wins (an older one if the newer payload is damaged).
+ *  - None: blank flash (or a format interrupted before its checkpoint) ->
+ *    format. Data of the newest generation without a checkpoint -> not
+ *    mounted, nothing erased (the logical size is only in the checkpoint).
+ *  - Clean: the frontier page the checkpoint points at is still erased,
+ *    nothing was written since. Otherwise map_replay.
+ *  - Pending updates of the checkpoint hashed again.
+ *  - Valid pages: every translation page is read once (~256 page reads for
+ *    the full device), blocks without valid pages are free.
+ *
+ * @return
+ *  - true  : Mounted.
+ *  - false : Checkpoint lost, no checkpoint could be written or
+ *            roll-forward incomplete.
+ * --------------------------------------------------------------------------- */
+bool Map_Mount(void)
+{
+	uint32_t hdr_page[FTL_CKPT_BLOCKS], fill[FTL_CKPT_BLOCKS], seq[FTL_CKPT_BLOCKS];
+	bool have[FTL_CKPT_BLOCKS];
+
+	memset(&stats, 0, sizeof(stats));
+	cmt_reset();
+	pend_reset();
+	map_pages = map_tpages = 0;
+	map_dirty = false;
+	map_allocs = 0;
+	frontier_reset();
+	HC_Reset();
+	ckpt_block = ckpt_good = FTL_NONE;
+	ckpt_page = 0;
+
+	for (uint32_t i = 0; i < FTL_CKPT_BLOCKS; i++)
+	{
+		uint32_t block = FTL_CKPT_BLOCK(i);
+
+		have[i] = !BBT_IsBad(block)
+				&& ckpt_find(block, &ckpt, &hdr_page[i], &fill[i]);
+		seq[i] = ckpt.seq;
+	}
+
+	/// Newest first, headers read again (one on the stack)
+	while (ckpt_good == FTL_NONE)
+	{
+		uint32_t k = FTL_NONE;
+
+		for (uint32_t i = 0; i < FTL_CKPT_BLOCKS; i++)
+			if (have[i] && (k == FTL_NONE || seq[i] > seq[k]))
+				k = i;
+
+		if (k == FTL_NONE)
+			break;
+
+		have[k] = false;
+
+		if (ckpt_find(FTL_CKPT_BLOCK(k), &ckpt, &hdr_page[k], &fill[k])
+				&& ckpt_load(FTL_CKPT_BLOCK(k), hdr_page[k], &ckpt))
+		{
+			ckpt_block = ckpt_good = FTL_CKPT_BLOCK(k);
+			ckpt_page = fill[k];
+		}
+	}
+
+	if (ckpt_good == FTL_NONE)
+	{
+		uint32_t good;
+		bool data;
+		uint32_t gen = map_scan(&good, &data);
+
+		if (data)
+		{
+			NAND_LOG(FTL_CKPT_LOST, gen - 1);
+			return false;
+		}
+
+		return map_format(gen, good);
+	}
+
+	map_gen = ckpt.gen;
+	map_seq = ckpt.seq;
+	map_pages = ckpt.pages;
+	map_tpages = (map_pages + MAP_ENTRIES_PER_TPAGE - 1) / MAP_ENTRIES_PER_TPAGE;
+	pend_load(ckpt.pending);
+	memcpy(fr_block, ckpt.fr_block, sizeof(fr_block));
+	memcpy(fr_page, ckpt.fr_page, sizeof(fr_page));
+
+	/// Clean: nothing programmed at any frontier since the checkpoint
+	bool clean = true;
+
+	for (uint32_t f = 0; clean && f < MAP_FRONTIERS; f++)
+	{
+		FTL_Tag_t tag;
+
+		clean = fr_block[f] >= FTL_FIRST_BLOCK && fr_block[f] <= FTL_LAST_BLOCK
+				&& fr_page[f] < PAGES_PER_BLOCK
+				&& PageIO_ReadTag(PAGE_ADDR(fr_block[f], fr_page[f]), &tag)
+				&& PageIO_TagErased(&tag);
+	}
+
+	if (clean)
+	{
+		rebuild_valid();
+		reset_blocks();
+		pin_tpages();
+		return true;
+	}
+
+	stats.recovered++;
+	return map_replay();
+}
+
+uint32_t Map_PageCount(void)
+{
+	return map_pages;
+}
+
+/* ===========================================================================
+ * Function: Map_ReadPages
+ * ===========================================================================
+ * @brief
+ *  - Read `count` main areas from `lpn`.
+ *
+ * @details
+ *  - Mapping entries first (pending updates, else translation pages loaded
+ *    on a CMT miss), then
+ *    runs of physically consecutive pages inside a block: one Continuous
+ *    Read stream each (sequentially written data stays consecutive).
+ *  - Never written -> 0xFF, no NAND access.
+ *
+ * @return
+ *  - true  : Data valid.
+ *  - false : Out of range, uncorrectable page, translation page unreadable.
+ * --------------------------------------------------------------------------- */
+bool Map_ReadPages(uint32_t lpn, uint8_t *buf, uint32_t count)
+{
+	uint32_t ppn[PAGES_PER_BLOCK];
+
+	if (count == 0 || count > PAGES_PER_BLOCK || lpn >= map_pages
+			|| count > map_pages - lpn)
+		return false;
+
+	for (uint32_t i = 0; i < count; i++)
+		if (!map_lookup(lpn + i, true, &ppn[i]))
+			return false;
+
+	bool ok = true;
+
+	for (uint32_t i = 0, n; ok && i < count; i += n)
+	{
+		n = 1;
+
+		if (ppn[i] == FTL_NONE)
+		{
+			while (i + n < count && ppn[i + n] == FTL_NONE)
+				n++;
+			memset(&buf[i * PAGE_MAIN_SIZE], NAND_ERASED_STATE, n * PAGE_MAIN_SIZE);
+			continue;
+		}
+
+		while (i + n < count && ppn[i + n] == ppn[i] + n
+				&& (ppn[i] + n) % PAGES_PER_BLOCK != 0)
+			n++;
+
+		ok = PageIO_ReadRun(ppn[i], &buf[i * PAGE_MAIN_SIZE], n);
+	}
+
+	return ok;
+}
+
+/// One host page: programmed at the frontier, mapping entry repointed
+static bool write_data(uint32_t lpn, const uint8_t *data)
+{
+	uint32_t ppn, old;
+	uint32_t f = HC_Write(lpn) ? MAP_FR_HOT : MAP_FR_COLD;
+
+	if (!write_page(f, data, FTL_TAG_DATA, lpn, &ppn))
+		return false;
+
+	/// Looked up after the program: GC inside it may have moved the old copy
+	if (!map_lookup(lpn, false, &old))
+		old = FTL_NONE;
+
+	if (!map_update(lpn, ppn))
+		return false;
+
+	Inv_Invalidate(old);
+	Inv_SetValid(ppn);
+	stats.data_writes++;
+	return map_balance();
+}
+
+/* ===========================================================================
+ * Function: Map_WritePages
+ * ===========================================================================
+ * @brief
+ *  - Write `count` pages from `lpn`, data[i] -> lpn + i.
+ *
+ * @details
+ *  - Out of place: each page goes to the next frontier page, the previous
+ *    copy only turns invalid. A random 4 KB write is 2 page programs, the
+ *    mapping updates wait in the pending buffer and reach their translation
+ *    page in batches.
+ *  - Every MAP_CKPT_INTERVAL block allocations a checkpoint follows.
+ *
+ * @return
+ *  - true  : Pages written.
+ *  - false : Out of range or no space left (GC could not free a block).
+ * --------------------------------------------------------------------------- */
+bool Map_WritePages(uint32_t lpn, const uint8_t *const *data, uint32_t count)
+{
+	if (count == 0 || count > PAGES_PER_BLOCK || lpn >= map_pages
+			|| count > map_pages - lpn)
+		return false;
+
+	bool ok = true;
+
+	for (uint32_t i = 0; ok && i < count; i++)
+		ok = write_data(lpn + i, data[i]);
+
+	if (map_allocs >= MAP_CKPT_INTERVAL)
+		Map_Sync();
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: Map_Sync
+ * ===========================================================================
+ * @brief
+ *  - Make everything written so far survive power loss without replay.
+ *
+ * @details
+ *  - Frontiers opened so the checkpoint can point at erased pages, then
+ *    the checkpoint appended with the pending updates as they are (no
+ *    translation page written).
+ *  - Translation pages of the new checkpoint are pinned against GC.
+ *
+ * @return
+ *  - true  : Checkpoint written (or nothing to do).
+ *  - false : NAND failure.
+ * --------------------------------------------------------------------------- */
+bool Map_Sync(void)
+{
+	if (!map_dirty)
+		return true;
+
+	bool ok = true;
+
+	for (uint32_t f = 0; ok && f < MAP_FRONTIERS; f++)
+		ok = frontier_open(f);
+
+	if (!ok || !ckpt_write())
+	{
+		NAND_LOG(FTL_CKPT_FAIL, map_seq, ckpt_block);
+		return false;
+	}
+
+	pin_tpages();
+	map_dirty = false;
+	map_allocs = 0;
+	stats.checkpoints++;
+	return true;
+}
+
+bool Map_IsDirty(void)
+{
+	return map_dirty;
+}
+
+bool Map_Reclaim(uint32_t moves)
+{
+	if (map_pages == 0 || GC_FreeCount() >= FTL_GC_FREE_HIGH)
+		return false;
+
+	return GC_Step(FTL_GC_FREE_HIGH, moves) && GC_FreeCount() < FTL_GC_FREE_HIGH;
+}
+
+/* ===========================================================================
+ * Function: Map_Relocate
+ * ===========================================================================
+ * @brief
+ *  - GC: move the valid page `ppn` out of its block.
+ *
+ * @details
+ *  - The tag says what the page is. Data: moved only if the mapping entry
+ *    still points at it, entry repointed (pending update). Translation: GTD
+ *    entry repointed. Copies are tagged FTL_TAG_MOVED.
+ *  - Anything else (stale page, tag unreadable) is just marked invalid.
+ *
+ * @return
+ *  - true  : Page no longer valid at `ppn`.
+ *  - false : No space or mapping entry unreadable.
+ * --------------------------------------------------------------------------- */
+bool Map_Relocate(uint32_t ppn)
+{
+	FTL_Tag_t tag;
+	uint32_t dst, cur;
+
+	bool ours = PageIO_ReadTag(ppn, &tag) && tag.gen == map_gen;
+	uint32_t id = tag.id & ~FTL_TAG_MOVED;
+
+	if (ours && tag.kind == FTL_TAG_DATA && id < map_pages)
+	{
+		if (!map_lookup(id, false, &cur))
+			return false;
+
+		if (cur == ppn)
+		{
+			if (!copy_page(ppn, FTL_TAG_DATA, id | FTL_TAG_MOVED, &dst))
+				return false;
+
+			if (map_lookup(id, false, &cur) && cur == ppn)
+			{
+				if (!map_update(id, dst))
+					return false;
+				Inv_SetValid(dst);
+			}
+		}
+	}
+	else if (ours && tag.kind == FTL_TAG_TRANS && id < map_tpages
+			&& map_gtd[id] == ppn)
+	{
+		if (!copy_page(ppn, FTL_TAG_TRANS, id | FTL_TAG_MOVED, &dst))
+			return false;
+
+		if (map_gtd[id] == ppn)
+		{
+			map_gtd[id] = dst;
+			Inv_SetValid(dst);
+		}
+	}
+
+	Inv_Invalidate(ppn);
+	return map_balance();
+}
+
+/* ---------------------------------------------------------------------------
+ * GC batch (Map_RelocateBlock): requests queued together, caller storage of
+ * the queue. Used once per batch, a nested GC (block retired) only runs
+ * after the batch is done with them.
+ *
+ * MAP_GC_BATCH : Copies in flight, at most the queue depth
+ * --------------------------------------------------------------------------- */
+#define MAP_GC_BATCH   NAND_QUEUE_DEPTH
+
+typedef struct
+{
+	uint32_t src;
+	uint32_t kind;
+	uint32_t id;
+	FTL_Tag_t tag;
+	uint32_t erase;
+	NandPatch_t patch[2];
+	NandRequest_t req;
+} Map_Move_t;
+
+static Map_Move_t gc_move[MAP_GC_BATCH];
+
+/// Page `ppn` still mapped: what it is (DATA / TRANS + id), else false
+/// (tag unreadable included)
+static bool move_kind(uint32_t ppn, uint32_t *kind, uint32_t *id, bool *ok)
+{
+	FTL_Tag_t tag;
+	uint32_t cur;
+
+	if (!PageIO_ReadTag(ppn, &tag) || tag.gen != map_gen)
+		return false;
+
+	*id = tag.id & ~FTL_TAG_MOVED;
+	*kind = tag.kind;
+
+	if (tag.kind == FTL_TAG_DATA && *id < map_pages)
+	{
+		if (!map_lookup(*id, false, &cur))
+		{
+			*ok = false;
+			return false;
+		}
+		return cur == ppn;
+	}
+
+	return tag.kind == FTL_TAG_TRANS && *id < map_tpages && map_gtd[*id] == ppn;
+}
+
+/// Copy of `m` landed at `dst`: entry repointed, source invalid
+static bool move_done(const Map_Move_t *m, uint32_t dst)
+{
+	if (m->kind == FTL_TAG_DATA)
+	{
+		if (!map_update(m->id, dst))
+			return false;
+	}
+	else
+		map_gtd[m->id] = dst;
+
+	Inv_SetValid(dst);
+	Inv_Invalidate(m->src);
+	return true;
+}
+
+/* ===========================================================================
+ * Function: Map_RelocateBlock
+ * ===========================================================================
+ * @brief
+ *  - GC: move the valid pages out of `block` (`max` copies at most), up to
+ *    MAP_GC_BATCH copies queued at a time.
+ *
+ * @details
+ *  - Per batch: tags and mapping entries read first (stale pages only
+ *    invalidated), frontier pages reserved in order, then all copy-backs
+ *    submitted and waited for. The chip loads / programs the next copy
+ *    while the engine finishes the previous one, instead of one blocking
+ *    Map_Relocate round trip per page.
+ *  - Uncorrectable source: the reserved page is programmed through RAM
+ *    after the batch (SLC, no page order rule inside a block; a power loss
+ *    in between ends the roll-forward of the block there, the source is
+ *    still mapped).
+ *  - Program failure: the destination block is retired once the batch is
+ *    done, the sources that did not make it go through Map_Relocate.
+ *  - Pending updates balanced once per batch.
+ *
+ * @param max   : Copies allowed (bounded GC step), PAGES_PER_BLOCK = all.
+ * @param moved : [out] Pages copied.
+ *
+ * @return
+ *  - true  : Done, valid pages left only when `max` was reached.
+ *  - false : No space or mapping entry unreadable.
+ * --------------------------------------------------------------------------- */
+bool Map_RelocateBlock(uint32_t block, uint32_t max, uint32_t *moved)
+{
+	uint32_t p = Inv_NextValid(block, 0);
+	bool ok = true;
+
+	*moved = 0;
+
+	while (ok && p < PAGES_PER_BLOCK && *moved < max)
+	{
+		uint32_t retry[MAP_GC_BATCH];
+		uint32_t n = 0, failed = 0, bad_block = FTL_NONE;
+
+		if (!frontier_open(MAP_FR_GC))
+			return false;
+
+		uint32_t room = PAGES_PER_BLOCK - fr_page[MAP_FR_GC];
+
+		if (room > MAP_GC_BATCH)
+			room = MAP_GC_BATCH;
+		if (room > max - *moved)
+			room = max - *moved;
+
+		/// Pick the pages of the batch, reserve their frontier pages
+		for (; ok && n < room && p < PAGES_PER_BLOCK; p = Inv_NextValid(block, p + 1))
+		{
+			Map_Move_t *m = &gc_move[n];
+			uint32_t ppn = PAGE_ADDR(block, p);
+
+			if (!move_kind(ppn, &m->kind, &m->id, &ok))
+			{
+				if (ok)
+					Inv_Invalidate(ppn);
+				continue;
+			}
+
+			m->src = ppn;
+			m->tag = PageIO_NextTag(m->kind, map_gen, m->id | FTL_TAG_MOVED, &map_seq);
+			m->erase = WL_EraseCount[fr_block[MAP_FR_GC]];
+			m->patch[0].col = FTL_TAG_COL;
+			m->patch[0].len = sizeof(m->tag);
+			m->patch[0].data = (const uint8_t*) &m->tag;
+			m->patch[1].col = FTL_WL_COL;
+			m->patch[1].len = sizeof(m->erase);
+			m->patch[1].data = (const uint8_t*) &m->erase;
+
+			memset(&m->req, 0, sizeof(m->req));
+			m->req.type = NAND_REQ_COPY;
+			m->req.page = ppn;
+			m->req.dst = PAGE_ADDR(fr_block[MAP_FR_GC], fr_page[MAP_FR_GC]++);
+			m->req.patch = m->patch;
+			m->req.patch_count = 2;
+			n++;
+		}
+
+		if (n != 0)
+			map_dirty = true;
+
+		/// Queue the copies (queue full: that one waits for room), the engine
+		/// runs them back to back
+		for (uint32_t i = 0; i < n; i++)
+			if (!NandQueue_Submit(&gc_move[i].req))
+				NandQueue_Run(&gc_move[i].req);
+
+		for (uint32_t i = 0; i < n; i++)
+			NandQueue_Wait(&gc_move[i].req);
+
+		/// Results in page order
+		for (uint32_t i = 0; i < n; i++)
+		{
+			Map_Move_t *m = &gc_move[i];
+			uint32_t dst = m->req.dst;
+			bool copied = m->req.ok && m->req.state == NAND_REQ_DONE;
+
+			if (copied)
+			{
+				stats.copy_back++;
+				stats.programs++;
+			}
+			else if (m->req.done.ecc == ECC_UNCORRECTABLE && bad_block != BLOCK_ADDR(dst))
+			{
+				StandardRead_Service(m->src, 0, (uint8_t*) copy_buf, PAGE_MAIN_SIZE);
+				copied = program_page(dst, copy_buf, &m->tag);
+				if (copied)
+					stats.through_ram++;
+			}
+
+			if (!copied)
+			{
+				bad_block = BLOCK_ADDR(dst);
+				retry[failed++] = m->src;
+				continue;
+			}
+
+			if (!move_done(m, dst))
+				ok = false;
+			(*moved)++;
+		}
+
+		/// Batch done: the queue storage is free for a nested GC
+		if (bad_block != FTL_NONE)
+			retire_block(bad_block);
+
+		for (uint32_t i = 0; ok && i < failed; i++)
+		{
+			ok = Map_Relocate(retry[i]);
+			if (ok)
+				(*moved)++;
+		}
+
+		if (ok)
+			ok = map_balance();
+	}
+
+	return ok;
+}
+
+const Map_Stats_t* Map_GetStats(void)
+{
+	return &stats;
+}
+
+#endif /* FTL_MAPPING */
@@ -0,0 +1,104 @@
+/*
+ *  PageIO.c
+ *
+ *  Created on: Nov 21, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "PageIO.h"
+
+uint32_t PageIO_Stage[PAGEIO_STAGE_WORDS];
+
+/* ---------------------------------------------------------------------------
+ * Page tag I/O
+ * --------------------------------------------------------------------------- */
+bool PageIO_ReadTag(uint32_t ppn, FTL_Tag_t *tag)
+{
+	return StandardRead_Service(ppn, FTL_TAG_COL, (uint8_t*) tag, sizeof(*tag));
+}
+
+uint32_t PageIO_ReadErase(uint32_t ppn)
+{
+	uint32_t erase;
+
+	if (!StandardRead_Service(ppn, FTL_WL_COL, (uint8_t*) &erase, sizeof(erase)))
+		return 0xFFFFFFFFu;
+
+	return erase;
+}
+
+bool PageIO_TagErased(const FTL_Tag_t *tag)
+{
+	return tag->kind == 0xFFFFFFFFu && tag->gen == 0xFFFFFFFFu
+			&& tag->id == 0xFFFFFFFFu && tag->seq == 0xFFFFFFFFu;
+}
+
+bool PageIO_Used(uint32_t ppn)
+{
+	FTL_Tag_t tag;
+
+	return !PageIO_ReadTag(ppn, &tag) || !PageIO_TagErased(&tag);
+}
+
+uint32_t PageIO_BlockFill(uint32_t block)
+{
+	uint32_t lo = 0, hi = PAGES_PER_BLOCK;
+
+	while (lo < hi)
+	{
+		uint32_t mid = (lo + hi) / 2;
+
+		if (PageIO_Used(PAGE_ADDR(block, mid)))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/* ---------------------------------------------------------------------------
+ * Program with tag
+ * --------------------------------------------------------------------------- */
+bool PageIO_Program(uint32_t ppn, const void *data, const FTL_Tag_t *tag,
+		uint32_t erase)
+{
+	uint8_t *sb = (uint8_t*) PageIO_Stage;
+
+	memcpy(sb, data, PAGE_MAIN_SIZE);
+	memset(&sb[PAGE_MAIN_SIZE], NAND_ERASED_STATE, FTL_TAG_COL - PAGE_MAIN_SIZE);
+	memcpy(&sb[FTL_TAG_COL], tag, sizeof(*tag));
+	memcpy(&sb[FTL_WL_COL], &erase, sizeof(erase));
+
+	return StandardProgram_Service(ppn, sb, sizeof(PageIO_Stage));
+}
+
+FTL_Tag_t PageIO_NextTag(uint32_t kind, uint32_t gen, uint32_t id, uint32_t *seq)
+{
+	FTL_Tag_t tag = { kind, gen, id, (*seq)++ };
+
+	return tag;
+}
+
+/* ---------------------------------------------------------------------------
+ * Consecutive pages
+ * --------------------------------------------------------------------------- */
+bool PageIO_ReadRun(uint32_t ppn, uint8_t *buf, uint32_t n)
+{
+	static ContRead_t stream;
+	bool ok;
+
+	if (n == 1)
+		return StandardRead_Service(ppn, 0, buf, PAGE_MAIN_SIZE);
+
+	if (!ContRead_Open(&stream, ppn, NULL, NULL))
+		return false;
+
+	ok = ContRead_Pull(&stream, buf, n * PAGE_MAIN_SIZE);
+
+	if (!ContRead_Close(&stream))
+		ok = false;
+
+	return ok;
+}
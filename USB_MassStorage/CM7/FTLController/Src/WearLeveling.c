@@ -0,0 +1,212 @@
+/*
+ *  WearLeveling.c
+ *
+ *  Created on: Nov 22, 2025
+ *  Author: Henry
+ *  Folder: FTLController/Src
+ */
+
+#include "WearLeveling.h"
+#include "GarbageCollection.h"
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+
+uint16_t WL_EraseCount[TOTAL_BLOCKS];
+
+/* ---------------------------------------------------------------------------
+ * Free block heap
+ * ---------------------------------------------------------------------------
+ * wl_heap  : Free blocks, wl_heap[0] has the lowest erase count, children
+ *            of i at 2i + 1 / 2i + 2
+ * wl_pos   : Heap index of a block, WL_OUT when not free
+ * wl_max   : Highest erase count
+ * wl_check : Erases left until the next static check
+ * --------------------------------------------------------------------------- */
+#define WL_OUT   0xFFFFu
+
+static uint16_t wl_heap[FTL_BLOCKS];
+static uint16_t wl_pos[TOTAL_BLOCKS];
+static uint32_t wl_size = 0;
+static uint32_t wl_max = 0;
+static uint32_t wl_check = FTL_WL_INTERVAL;
+static WL_Stats_t stats;
+
+static bool heap_less(uint32_t i, uint32_t j)
+{
+	return WL_EraseCount[wl_heap[i]] < WL_EraseCount[wl_heap[j]];
+}
+
+static void heap_swap(uint32_t i, uint32_t j)
+{
+	uint16_t b = wl_heap[i];
+
+	wl_heap[i] = wl_heap[j];
+	wl_heap[j] = b;
+	wl_pos[wl_heap[i]] = (uint16_t) i;
+	wl_pos[wl_heap[j]] = (uint16_t) j;
+}
+
+static void sift_up(uint32_t i)
+{
+	while (i != 0 && heap_less(i, (i - 1) / 2))
+	{
+		heap_swap(i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+
+static void sift_down(uint32_t i)
+{
+	for (;;)
+	{
+		uint32_t l = 2 * i + 1, r = l + 1, m = i;
+
+		if (l < wl_size && heap_less(l, m))
+			m = l;
+		if (r < wl_size && heap_less(r, m))
+			m = r;
+		if (m == i)
+			return;
+
+		heap_swap(i, m);
+		i = m;
+	}
+}
+
+void WL_Clear(void)
+{
+	memset(WL_EraseCount, 0, sizeof(WL_EraseCount));
+}
+
+void WL_Seen(uint32_t block, uint32_t count)
+{
+	if (block >= TOTAL_BLOCKS || count == 0xFFFFFFFFu)
+		return;
+
+	if (count > WL_COUNT_MAX)
+		count = WL_COUNT_MAX;
+
+	if (count > WL_EraseCount[block])
+		WL_EraseCount[block] = (uint16_t) count;
+}
+
+void WL_Reset(void)
+{
+	memset(wl_pos, 0xFF, sizeof(wl_pos));
+	memset(&stats, 0, sizeof(stats));
+	wl_size = 0;
+	wl_max = 0;
+	wl_check = FTL_WL_INTERVAL;
+
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+		if (WL_EraseCount[b] > wl_max)
+			wl_max = WL_EraseCount[b];
+}
+
+void WL_Erased(uint32_t block)
+{
+	if (block >= TOTAL_BLOCKS)
+		return;
+
+	if (WL_EraseCount[block] < WL_COUNT_MAX)
+		WL_EraseCount[block]++;
+
+	if (block >= FTL_FIRST_BLOCK && block <= FTL_LAST_BLOCK)
+	{
+		if (WL_EraseCount[block] > wl_max)
+			wl_max = WL_EraseCount[block];
+		if (wl_check != 0)
+			wl_check--;
+		stats.total++;
+	}
+}
+
+void WL_FreeAdd(uint32_t block)
+{
+	if (block < FTL_FIRST_BLOCK || block > FTL_LAST_BLOCK || wl_pos[block] != WL_OUT)
+		return;
+
+	wl_heap[wl_size] = (uint16_t) block;
+	wl_pos[block] = (uint16_t) wl_size;
+	sift_up(wl_size++);
+}
+
+void WL_FreeRemove(uint32_t block)
+{
+	if (block >= TOTAL_BLOCKS || wl_pos[block] == WL_OUT)
+		return;
+
+	uint32_t i = wl_pos[block];
+
+	wl_pos[block] = WL_OUT;
+
+	if (i == --wl_size)
+		return;
+
+	/// Last entry into the hole, then up or down
+	uint16_t moved = wl_heap[wl_size];
+
+	wl_heap[i] = moved;
+	wl_pos[moved] = (uint16_t) i;
+	sift_up(i);
+	sift_down(wl_pos[moved]);
+}
+
+uint32_t WL_FreeMin(void)
+{
+	return (wl_size != 0) ? wl_heap[0] : FTL_NONE;
+}
+
+/* ===========================================================================
+ * Function: WL_StaticVictim
+ * ===========================================================================
+ * @brief
+ *  - Used block holding cold data on a low erase count, when it is time.
+ *
+ * @details
+ *  - Checked every FTL_WL_INTERVAL erases (one scan of the block states),
+ *    the victim goes to GC as any other: FTL_WL_INTERVAL bounds the extra
+ *    copies to one block per interval.
+ *
+ * @return
+ *  - Block to collect now, FTL_NONE when none.
+ * --------------------------------------------------------------------------- */
+uint32_t WL_StaticVictim(bool (*skip)(uint32_t block))
+{
+	uint32_t best = FTL_NONE;
+
+	if (wl_check != 0)
+		return FTL_NONE;
+
+	wl_check = FTL_WL_INTERVAL;
+	stats.checks++;
+
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+	{
+		if (GC_State(b) != GC_BLOCK_USED || (skip != NULL && skip(b)))
+			continue;
+
+		if (best == FTL_NONE || WL_EraseCount[b] < WL_EraseCount[best])
+			best = b;
+	}
+
+	if (best == FTL_NONE || wl_max - WL_EraseCount[best] <= FTL_WL_THRESHOLD)
+		return FTL_NONE;
+
+	stats.migrations++;
+	return best;
+}
+
+const WL_Stats_t* WL_GetStats(void)
+{
+	stats.min = WL_COUNT_MAX;
+	stats.max = wl_max;
+
+	for (uint32_t b = FTL_FIRST_BLOCK; b <= FTL_LAST_BLOCK; b++)
+		if (!BBT_IsBad(b) && WL_EraseCount[b] < stats.min)
+			stats.min = WL_EraseCount[b];
+
+	return &stats;
+}
+
+#endif /* FTL_MAPPING */
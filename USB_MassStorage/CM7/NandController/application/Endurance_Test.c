@@ -8,6 +8,20 @@
 
 #include "Endurance_Test.h"
 
+/* ---------------------------------------------------------------------------
+ * Block access: through the Remap raw partition when it is built (logical
+ * block, bad blocks replaced by Remap), the raw services otherwise.
+ * --------------------------------------------------------------------------- */
+#if NAND_REMAP
+#define ENDURANCE_ERASE(b)            Remap_Erase(b)
+#define ENDURANCE_PROGRAM(p, buf, n)  Remap_Program((p), (buf), (n))
+#define ENDURANCE_READ(p, buf, n)     Remap_Read((p), 0x0000, (buf), (n))
+#else
+#define ENDURANCE_ERASE(b)            BlockErase128K_service((b), 500)
+#define ENDURANCE_PROGRAM(p, buf, n)  StandardProgram_Service((p), (buf), (n))
+#define ENDURANCE_READ(p, buf, n)     StandardRead_Service((p), 0x0000, (buf), (n))
+#endif
+
 /* ===========================================================================
  * Function : EnduranceTest_Run
  * ===========================================================================
@@ -29,6 +43,11 @@
  *         (d) Check ECC status and NAND SR1–SR3 for P_FAIL/E_FAIL.
  *         (e) Stop test if any failure condition detected.
  *
+ *   NAND_REMAP 1: block is a logical block of the Remap raw partition
+ *   (REMAP_FIRST_BLOCK ~ REMAP_POOL_START - 1, after Remap_Mount). A failed
+ *   erase / program retires the physical block to a spare: the test ends
+ *   there, the logical block keeps serving from the spare.
+ *
  * @param block: Logical block index to be tested.
  *
  * @return None(Test result is reported via console log.)
@@ -44,10 +63,24 @@ void EnduranceTest_Run(uint32_t block)
 	uint8_t readBuffer[PAGE_MAIN_SIZE];
 	uint8_t writeBuffer[PAGE_MAIN_SIZE];
 	uint32_t base_page = block * PAGES_PER_BLOCK;
+#if NAND_REMAP
+	uint32_t phys = Remap_Block(block);
+
+	if (phys == REMAP_NONE)
+	{
+		printf("[Endurance Test] Block %lu not in the raw partition (%u ~ %u)\r\n",
+				block, (unsigned) REMAP_FIRST_BLOCK,
+				(unsigned) (REMAP_POOL_START - 1));
+		return;
+	}
+#endif
 
 	printf("==========================================================\r\n");
 	printf("================ [Endurance Test Started] ================\r\n");
 	printf("[Endurance Test] Block: %lu \r\n", block);
+#if NAND_REMAP
+	printf("[Endurance Test] Physical Block: %lu \r\n", phys);
+#endif
 	printf("[Endurance Test] Cycle: %d  \r\n", MAX_PE_CYCLE);
 
 	/// Step 1:
@@ -60,7 +93,7 @@ void EnduranceTest_Run(uint32_t block)
 	{
 		/// Step 2:
 		/// [D8h] Erase Block -> Check Status Register (S2: E_Fail)
-		if (!BlockErase128K_service(block, 500))
+		if (!ENDURANCE_ERASE(block))
 			printf("[Endurance Test] Cycle %lu Erase Failed\r\n", cycle);
 
 		for (uint32_t page = 0; page < PAGES_PER_BLOCK; page++)
@@ -70,8 +103,7 @@ void EnduranceTest_Run(uint32_t block)
 			/// Step 3:
 			/// [06h] Write Enable -> [02h] Load Program Data -> [10h] Program Execute
 			/// Check Status Register (S3: P_Fail), return summary when test fail
-			if (!StandardProgram_Service(page_addr, writeBuffer,
-			PAGE_MAIN_SIZE))
+			if (!ENDURANCE_PROGRAM(page_addr, writeBuffer, PAGE_MAIN_SIZE))
 			{
 				printf("[Endurance] Cycle %lu\r\n", cycle);
 				printf("[Endurance] Page %lu Program Fail\r\n", page);
@@ -82,8 +114,7 @@ void EnduranceTest_Run(uint32_t block)
 			/// Step 4:
 			/// [13h] Page Data Read -> [03h] Read Data
 			/// Check ECC Status (00|01|10|11), return summary when test fail
-			if (!StandardRead_Service(page_addr, 0x0000, readBuffer,
-			PAGE_MAIN_SIZE))
+			if (!ENDURANCE_READ(page_addr, readBuffer, PAGE_MAIN_SIZE))
 			{
 				printf("[Endurance] Cycle %lu\r\n", cycle);
 				printf("[Endurance] Page %lu Read Failed\r\n", page);
@@ -108,6 +139,17 @@ void EnduranceTest_Run(uint32_t block)
 		if (verifyFail)
 			break;
 
+#if NAND_REMAP
+		/// Worn out: Remap moved the logical block to a spare, the physical
+		/// block under test is retired
+		if (Remap_Block(block) != phys)
+		{
+			printf("[Cycle %lu] Block %lu retired -> spare %lu, End Test\r\n",
+					cycle, phys, Remap_Block(block));
+			break;
+		}
+#endif
+
 		/// Step 5:
 		/// Check ECC and Status Registers (SR1 - SR3)
 		/// If P_Fail / E_Fail / ECC Status == ECC_UNCORRECTABLE, End Test
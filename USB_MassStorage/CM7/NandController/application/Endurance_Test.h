@@ -17,6 +17,7 @@
 #include "Reset_service.h"
 #include "Program_service.h"
 #include "BlockErase_service.h"
+#include "Remap_service.h"
 
 #define MAX_PE_CYCLE 60000
 
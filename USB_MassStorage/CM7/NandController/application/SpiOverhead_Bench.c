@@ -0,0 +1,304 @@
+/*
+ *  SpiOverhead_Bench.c
+ *
+ *  Created on: Oct 28, 2025
+ *  Author: Henry
+ */
+
+#include "SpiOverhead_Bench.h"
+
+/* ---------------------------------------------------------------------------
+ * DWT cycle counter
+ * --------------------------------------------------------------------------- */
+/// CYCCNT is shared with NandClock_Ticks() (ready-wait timeouts, FTL idle
+/// stamps, NAND_LOG): enabled only, never cleared, timed by unsigned deltas.
+static void bench_dwt_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->LAR = 0xC5ACCE55;                   /// Unlock DWT (Cortex-M7)
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static void bench_report(const char *name, uint32_t cycles, uint32_t loops)
+{
+	uint32_t avg = cycles / loops;
+	uint32_t mhz = SystemCoreClock / 1000000U;
+
+	printf("[SPI Bench] %-26s : %8lu cycles  %6lu.%02lu us\r\n", name,
+			(unsigned long) avg, (unsigned long) (avg / mhz),
+			(unsigned long) ((avg % mhz) * 100U / mhz));
+}
+
+/* ---------------------------------------------------------------------------
+ * Legacy two-phase transfer (command and payload in separate HAL sessions)
+ * --------------------------------------------------------------------------- */
+static void legacy_cmd_read(const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf,
+		uint16_t len)
+{
+	HAL_GPIO_WritePin(NandSpi2_Ctx.cs_port, NandSpi2_Ctx.cs_pin, GPIO_PIN_RESET);
+	HAL_SPI_Transmit(NandSpi2_Ctx.hspi, cmd, cmd_len, HAL_MAX_DELAY);
+	HAL_SPI_Receive(NandSpi2_Ctx.hspi, buf, len, HAL_MAX_DELAY);
+	HAL_GPIO_WritePin(NandSpi2_Ctx.cs_port, NandSpi2_Ctx.cs_pin, GPIO_PIN_SET);
+}
+
+static void single_cmd_read(const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf,
+		uint16_t len)
+{
+	NandTransport_SPI2_DMA.read(&NandSpi2_Ctx, cmd, cmd_len, buf, len);
+}
+
+/* ===========================================================================
+ * Function : SpiOverhead_Bench
+ * ===========================================================================
+ * @brief
+ *   Measure per-command SPI overhead before / after single-session transfer.
+ *
+ * @details
+ *   - Before : HAL_SPI_Transmit(cmd) + HAL_SPI_Receive(data), two sessions.
+ *   - After  : SPI2 DMA transport read (HAL_SPI_CmdRead), one session.
+ *   - Each case is timed with DWT->CYCCNT deltas (wrap-safe) over `loops`
+ *     iterations and the average is printed in cycles and microseconds.
+ *
+ *   Test Cases:
+ *     1. Read Status Register-3  [05h C0h] + 1 byte   (poll loop cost)
+ *     2. Read Data (cache)       [03h CA CA Dummy] + 2048 bytes
+ *
+ * @param loops : Iterations per case (0 -> SPI_BENCH_LOOPS).
+ *
+ * @note
+ *   - Read Data only reads the cache register, no array access is issued, so
+ *     the result is pure bus + driver overhead.
+ * --------------------------------------------------------------------------- */
+void SpiOverhead_Bench(uint32_t loops)
+{
+	static uint8_t page_buf[PAGE_MAIN_SIZE];
+	const uint8_t sr_cmd[2] = { READ_SR, Status_Register3 };
+	const uint8_t rd_cmd[4] = { CMD_READ_DATA, 0x00, 0x00, 0x00 };
+	uint8_t sr = 0;
+	uint32_t t0;
+
+	if (loops == 0)
+		loops = SPI_BENCH_LOOPS;
+
+	bench_dwt_init();
+
+	printf("=========================================================\r\n");
+	printf("================ [SPI Overhead Bench Start] =============\r\n");
+	printf("[SPI Bench] Core %lu MHz, %lu loops\r\n",
+			(unsigned long) (SystemCoreClock / 1000000U), (unsigned long) loops);
+
+	/// 1. Status register read
+	t0 = DWT->CYCCNT;
+	for (uint32_t i = 0; i < loops; i++)
+		legacy_cmd_read(sr_cmd, 2, &sr, 1);
+	bench_report("SR3 read  (TX + RX)", DWT->CYCCNT - t0, loops);
+
+	t0 = DWT->CYCCNT;
+	for (uint32_t i = 0; i < loops; i++)
+		single_cmd_read(sr_cmd, 2, &sr, 1);
+	bench_report("SR3 read  (CmdRead)", DWT->CYCCNT - t0, loops);
+
+	/// 2. Cache read, one full main area
+	t0 = DWT->CYCCNT;
+	for (uint32_t i = 0; i < loops; i++)
+		legacy_cmd_read(rd_cmd, 4, page_buf, PAGE_MAIN_SIZE);
+	bench_report("Read 2048 (TX + RX)", DWT->CYCCNT - t0, loops);
+
+	t0 = DWT->CYCCNT;
+	for (uint32_t i = 0; i < loops; i++)
+		single_cmd_read(rd_cmd, 4, page_buf, PAGE_MAIN_SIZE);
+	bench_report("Read 2048 (CmdRead)", DWT->CYCCNT - t0, loops);
+
+	printf("================ [SPI Overhead Bench End] ===============\r\n");
+	printf("=========================================================\r\n");
+}
+
+/* ===========================================================================
+ * Function : CacheReadThroughput_Bench
+ * ===========================================================================
+ * @brief
+ *   Measure cache -> MCU throughput for each data I/O mode on bound device.
+ *
+ * @details
+ *   - SPI2 transports : 03h only.
+ *   - QUADSPI         : 03h, 6Bh (1-1-4), EBh (1-4-4).
+ *   - Only the cache register is read, so the figure is the bus ceiling for
+ *     sequential reads (datasheet: 50 MB/s at 104 MHz quad).
+ *
+ * @param loops : 2048-byte reads per mode (0 -> SPI_BENCH_LOOPS).
+ *
+ * @note
+ *   - Restores the I/O mode that was active before the bench.
+ * --------------------------------------------------------------------------- */
+void CacheReadThroughput_Bench(uint32_t loops)
+{
+	static uint8_t page_buf[PAGE_MAIN_SIZE];
+	static const char *const mode_name[] =
+	{ "03h  1-1-1", "6Bh  1-1-4", "EBh  1-4-4" };
+	NandIoMode_t saved = Nand_GetIoMode();
+	NandIoMode_t last = (Nand_Dev()->tr->read_wide != NULL) ?
+			NAND_IO_QUAD_IO : NAND_IO_SINGLE;
+
+	if (loops == 0)
+		loops = SPI_BENCH_LOOPS;
+
+	bench_dwt_init();
+
+	printf("=========================================================\r\n");
+	printf("============ [Cache Read Throughput Bench Start] ========\r\n");
+
+	for (NandIoMode_t mode = NAND_IO_SINGLE; mode <= last; mode++)
+	{
+		Nand_SetIoMode(mode);
+
+		uint32_t t0 = DWT->CYCCNT;
+		for (uint32_t i = 0; i < loops; i++)
+		{
+			if (mode == NAND_IO_QUAD_OUTPUT)
+				FastReadQuadOutput(0, page_buf, PAGE_MAIN_SIZE);
+			else if (mode == NAND_IO_QUAD_IO)
+				FastReadQuadIO(0, page_buf, PAGE_MAIN_SIZE);
+			else
+				ReadData(0, page_buf, PAGE_MAIN_SIZE);
+		}
+		uint32_t cycles = DWT->CYCCNT - t0;
+
+		/// KB/s = bytes * f_cpu / cycles / 1024
+		uint64_t kbps = ((uint64_t) loops * PAGE_MAIN_SIZE * SystemCoreClock)
+				/ ((uint64_t) cycles * 1024U);
+
+		printf("[SPI Bench] %-12s : %6lu.%02lu MB/s\r\n", mode_name[mode],
+				(unsigned long) (kbps / 1024U),
+				(unsigned long) ((kbps % 1024U) * 100U / 1024U));
+	}
+
+	Nand_SetIoMode(saved);
+
+	printf("============ [Cache Read Throughput Bench End] ==========\r\n");
+	printf("=========================================================\r\n");
+}
+
+/* ===========================================================================
+ * Function : TransportCompare_Bench
+ * ===========================================================================
+ * @brief
+ *   Run the same page read workload on several device handles (A/B test).
+ *
+ * @details
+ *   - Per device: PageDataRead(13h) -> wait_ready -> 2048-byte cache read
+ *     in the device's own I/O mode, repeated `loops` times.
+ *   - Reports average page read time and effective MB/s per transport.
+ *   - The bound device is restored afterwards.
+ *
+ * @param devs  : Device handles, e.g. SPI2 polling / SPI2 DMA / QUADSPI.
+ * @param count : Number of handles.
+ * @param page  : Page address to read (must be programmed or erased).
+ * @param loops : Page reads per device (0 -> SPI_BENCH_LOOPS).
+ * --------------------------------------------------------------------------- */
+void TransportCompare_Bench(NandDevice_t *const devs[], uint8_t count,
+		uint32_t page, uint32_t loops)
+{
+	static uint8_t page_buf[PAGE_MAIN_SIZE];
+	NandDevice_t *saved = Nand_Dev();
+
+	if (loops == 0)
+		loops = SPI_BENCH_LOOPS;
+
+	bench_dwt_init();
+
+	printf("=========================================================\r\n");
+	printf("============== [Transport Compare Bench Start] ==========\r\n");
+
+	for (uint8_t d = 0; d < count; d++)
+	{
+		Nand_Bind(devs[d]);
+
+		uint32_t t0 = DWT->CYCCNT;
+		for (uint32_t i = 0; i < loops; i++)
+		{
+			PageDataRead(page);
+			Nand_WaitReadyOp(NAND_OP_READ, 0, NULL);
+
+			if (devs[d]->io_mode == NAND_IO_QUAD_IO)
+				FastReadQuadIO(0, page_buf, PAGE_MAIN_SIZE);
+			else if (devs[d]->io_mode == NAND_IO_QUAD_OUTPUT)
+				FastReadQuadOutput(0, page_buf, PAGE_MAIN_SIZE);
+			else
+				ReadData(0, page_buf, PAGE_MAIN_SIZE);
+		}
+		uint32_t cycles = DWT->CYCCNT - t0;
+
+		uint64_t kbps = ((uint64_t) loops * PAGE_MAIN_SIZE * SystemCoreClock)
+				/ ((uint64_t) cycles * 1024U);
+
+		bench_report(devs[d]->tr->name, cycles, loops);
+		printf("[SPI Bench] %-26s : %6lu.%02lu MB/s\r\n", "  -> page read",
+				(unsigned long) (kbps / 1024U),
+				(unsigned long) ((kbps % 1024U) * 100U / 1024U));
+	}
+
+	Nand_Bind(saved == &NandDev_Default ? NULL : saved);
+
+	printf("============== [Transport Compare Bench End] ============\r\n");
+	printf("=========================================================\r\n");
+}
+
+/* ===========================================================================
+ * Function : ReadyWait_Bench
+ * ===========================================================================
+ * @brief
+ *   Compare ready-wait schedules on a page read (13h -> BUSY = 0).
+ *
+ * @details
+ *   - For each NandReadyMode_t: PageDataRead(13h) + Nand_WaitReadyOp,
+ *     repeated `loops` times.
+ *   - Reports average wait time and SR3 transactions per wait. The poll
+ *     count is what the minimum delay / auto-polling saves on the bus.
+ *   - The previous ready mode is restored afterwards.
+ *
+ * @param page  : Page address to read.
+ * @param loops : Waits per mode (0 -> SPI_BENCH_LOOPS).
+ * --------------------------------------------------------------------------- */
+void ReadyWait_Bench(uint32_t page, uint32_t loops)
+{
+	static const char *const name[] =
+	{ "Ready POLL", "Ready DELAY_POLL", "Ready AUTO" };
+	NandReadyMode_t saved = Nand_GetReadyMode();
+
+	if (loops == 0)
+		loops = SPI_BENCH_LOOPS;
+
+	bench_dwt_init();
+
+	printf("=========================================================\r\n");
+	printf("================ [Ready Wait Bench Start] ===============\r\n");
+
+	for (uint8_t m = NAND_READY_POLL; m <= NAND_READY_AUTO; m++)
+	{
+		uint32_t polls = 0;
+		uint32_t cycles = 0;
+
+		Nand_SetReadyMode((NandReadyMode_t) m);
+
+		for (uint32_t i = 0; i < loops; i++)
+		{
+			PageDataRead(page);
+
+			uint32_t t0 = DWT->CYCCNT;
+			Nand_WaitReadyOp(NAND_OP_READ, 0, NULL);
+			cycles += DWT->CYCCNT - t0;
+
+			polls += Nand_GetReadyStats()->polls;
+		}
+
+		bench_report(name[m], cycles, loops);
+		printf("[SPI Bench] %-26s : %6lu.%02lu SR3 reads / wait\r\n",
+				"  -> status traffic", (unsigned long) (polls / loops),
+				(unsigned long) ((polls % loops) * 100U / loops));
+	}
+
+	Nand_SetReadyMode(saved);
+
+	printf("================= [Ready Wait Bench End] ================\r\n");
+	printf("=========================================================\r\n");
+}
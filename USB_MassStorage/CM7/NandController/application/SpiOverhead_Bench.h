@@ -0,0 +1,24 @@
+/*
+ *  SpiOverhead_Bench.h
+ *
+ *  Created on: Oct 28, 2025
+ *  Author: Henry
+ */
+
+#ifndef APPLICATION_SPIOVERHEAD_BENCH_H_
+#define APPLICATION_SPIOVERHEAD_BENCH_H_
+
+#include "nand_hal.h"
+#include "W25N02KV_Config.h"
+#include "nand_dri_Read.h"
+#include "StatusRegister_service.h"
+
+#define SPI_BENCH_LOOPS   1000
+
+void SpiOverhead_Bench(uint32_t loops);
+void CacheReadThroughput_Bench(uint32_t loops);
+void TransportCompare_Bench(NandDevice_t *const devs[], uint8_t count,
+		uint32_t page, uint32_t loops);
+void ReadyWait_Bench(uint32_t page, uint32_t loops);
+
+#endif /* APPLICATION_SPIOVERHEAD_BENCH_H_ */
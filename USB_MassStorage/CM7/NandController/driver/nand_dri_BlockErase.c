@@ -44,7 +44,5 @@ void BlockErase128KB(uint32_t block_addr)
 	command[2] = ((block_addr >> 8) & 0xFF);
 	command[3] = ((block_addr >> 0) & 0xFF);
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	CS_HIGH();
+	Nand_Command(command, 4);
 }
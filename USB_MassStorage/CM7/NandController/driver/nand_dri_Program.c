@@ -40,10 +40,7 @@ void LoadProgramData(uint16_t col_addr, const uint8_t *buf, uint16_t len)
 	command[1] = (col_addr >> 8) & 0xFF;
 	command[2] = col_addr & 0xFF;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 3);
-	HAL_SPI_TX(buf, len);
-	CS_HIGH();
+	Nand_Write(command, 3, buf, len);
 }
 
 /* ===========================================================================
@@ -75,38 +72,44 @@ void RandomLoadProgramData(uint16_t col_addr, const uint8_t *buf, uint16_t len)
 	command[1] = (col_addr >> 8) & 0xFF;
 	command[2] = col_addr & 0xFF;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 3);
-	HAL_SPI_TX(buf, len);
-	CS_HIGH();
+	Nand_Write(command, 3, buf, len);
 }
 
+/* ===========================================================================
+ * Function: QuadLoadProgramData / QuadRandomLoadProgramData
+ * ===========================================================================
+ * @brief
+ *  - Executes QUAD LOAD PROGRAM DATA (32h) / QUAD RANDOM LOAD (34h).
+ *
+ * @details
+ *  - Instruction and column address on IO0, data on IO0 ~ IO3.
+ *  - 32h resets the unused cache bytes to FFh, 34h keeps them (same as
+ *    02h / 84h).
+ *  - Transport without a wide bus (SPI2) falls back to 02h / 84h.
+ *
+ * @param col_addr : Column start address within the page.
+ * @param buf      : [in] Data buffer.
+ * @param len      : Number of bytes to load into cache.
+ *
+ * @note
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.9
+ * --------------------------------------------------------------------------- */
 void QuadLoadProgramData(uint16_t col_addr, const uint8_t *buf, uint16_t len)
 {
-	uint8_t command[3];
-
-	command[0] = CMD_QUAD_LOAD_PROGRAM_DATA;
-	command[1] = (col_addr >> 8) & 0xFF;
-	command[2] = col_addr & 0xFF;
+	static const NandLineCmd_t cmd =
+	{ CMD_QUAD_LOAD_PROGRAM_DATA, 1, 2, 0, 4 };
 
-	CS_LOW();
-	HAL_SPI_TX(command, 3);
-	HAL_SPI_TX(buf, len);
-	CS_HIGH();
+	if (!Nand_WriteWide(&cmd, col_addr, buf, len))
+		LoadProgramData(col_addr, buf, len);
 }
 
 void QuadRandomLoadProgramData(uint16_t col_addr, const uint8_t *buf, uint16_t len)
 {
-	uint8_t command[3];
-
-	command[0] = CMD_QUAD_RANDOM_LOAD_PROGRAM_DATA;
-	command[1] = (col_addr >> 8) & 0xFF;
-	command[2] = col_addr & 0xFF;
+	static const NandLineCmd_t cmd =
+	{ CMD_QUAD_RANDOM_LOAD_PROGRAM_DATA, 1, 2, 0, 4 };
 
-	CS_LOW();
-	HAL_SPI_TX(command, 3);
-	HAL_SPI_TX(buf, len);
-	CS_HIGH();
+	if (!Nand_WriteWide(&cmd, col_addr, buf, len))
+		RandomLoadProgramData(col_addr, buf, len);
 }
 
 /* ===========================================================================
@@ -139,7 +142,5 @@ void ProgramExecute(uint32_t page_addr)
 	command[2] = (page_addr >> 8) & 0xFF;
 	command[3] = page_addr & 0xFF;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	CS_HIGH();
+	Nand_Command(command, 4);
 }
@@ -30,9 +30,7 @@ void WriteEnable(void)
 {
 	uint8_t command = WRITE_ENABLE;
 
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	CS_HIGH();
+	Nand_Command(&command, 1);
 }
 
 /* ===========================================================================
@@ -55,7 +53,5 @@ void WriteDisable(void)
 {
 	uint8_t command = WRITE_DISABLE;
 
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	CS_HIGH();
+	Nand_Command(&command, 1);
 }
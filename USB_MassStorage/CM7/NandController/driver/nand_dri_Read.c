@@ -39,9 +39,7 @@ void PageDataRead(uint32_t page_addr)
 	command[2] = (page_addr >> 8) & 0xFF;
 	command[3] = (page_addr >> 0) & 0xFF;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	CS_HIGH();
+	Nand_Command(command, 4);
 }
 
 /* ===========================================================================
@@ -79,10 +77,7 @@ void ReadData(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF; /// CA[7:0]
 	command[3] = 0x00;					 /// Dummy byte (8 clocks)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -120,10 +115,7 @@ void FastRead(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -144,10 +136,7 @@ void FastReadWith4ByteAddr(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;  // Dummy (BUF:1 -> 24 clocks | BUF:0 -> 40 clocks)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -168,10 +157,7 @@ void FastReadDualOutput(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;   // Dummy (BUF=1: 8 cycles, BUF=0: 32 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -193,34 +179,35 @@ void FastReadDualOutputWith4ByteAddr(uint16_t col_addr, uint8_t *buf,
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;   // Dummy (BUF=1: 24 cycles, BUF=0: 40 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
  * Function: FastReadQuadOutput
  * ===========================================================================
  * @brief
+ *  - Executes FAST READ QUAD OUTPUT (6Bh), data phase on IO0 ~ IO3.
  *
  * @details
+ *  - Instruction and column address on IO0, 8 dummy clocks (BUF = 1),
+ *    then 2 clocks per byte on four lines.
+ *  - Transport without a wide bus (SPI2) cannot sample the quad data phase,
+ *    the read falls back to FAST READ (0Bh) with identical framing.
  *
- * @param
+ * @param col_addr : Column start address within the page.
+ * @param buf      : [out] Read data buffer.
+ * @param len      : Number of bytes to read.
+ *
+ * @note
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.17
  * --------------------------------------------------------------------------- */
 void FastReadQuadOutput(uint16_t col_addr, uint8_t *buf, uint16_t len)
 {
-	uint8_t command[4];
+	static const NandLineCmd_t cmd =
+	{ CMD_FAST_READ_QUAD_OUTPUT, 1, 2, 8, 4 };   /// 1-1-4, 8 dummy clocks
 
-	command[0] = CMD_FAST_READ_QUAD_OUTPUT;
-	command[1] = (col_addr >> 8) & 0xFF;
-	command[2] = (col_addr >> 0) & 0xFF;
-	command[3] = 0x00;   // Dummy (BUF=1: 8 cycles, BUF=0: 32 cycles)
-
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	if (!Nand_ReadWide(&cmd, col_addr, buf, len))
+		FastRead(col_addr, buf, len);
 }
 
 /* ===========================================================================
@@ -242,10 +229,7 @@ void FastReadQuadOutputWith4ByteAddr(uint16_t col_addr, uint8_t *buf,
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;  // Dummy (BUF=1: 24 cycles, BUF=0: 40 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -266,10 +250,7 @@ void FastReadDualIO(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;  // Dummy (BUF=1: 4 cycles, BUF=0: 16 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
@@ -290,34 +271,35 @@ void FastReadDualIOWith4ByteAddr(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;  // Dummy (BUF=1: 12 cycles, BUF=0: 20 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
 /* ===========================================================================
  * Function: FastReadQuadIO
  * ===========================================================================
  * @brief
+ *  - Executes FAST READ QUAD I/O (EBh), address and data on IO0 ~ IO3.
  *
  * @details
+ *  - Instruction on IO0, column address in 4 clocks on four lines,
+ *    4 dummy clocks (BUF = 1), then 2 clocks per byte.
+ *  - Shortest header of the read family, preferred for sequential reads.
+ *  - Transport without a wide bus (SPI2) falls back to FAST READ (0Bh).
  *
- * @param
+ * @param col_addr : Column start address within the page.
+ * @param buf      : [out] Read data buffer.
+ * @param len      : Number of bytes to read.
+ *
+ * @note
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.21
  * --------------------------------------------------------------------------- */
 void FastReadQuadIO(uint16_t col_addr, uint8_t *buf, uint16_t len)
 {
-	uint8_t command[4];
-
-	command[0] = CMD_FAST_READ_QUAD_IO;
-	command[1] = (col_addr >> 8) & 0xFF;
-	command[2] = (col_addr >> 0) & 0xFF;
-	command[3] = 0x00;  // Dummy (BUF=1: 4 cycles, BUF=0: 12 cycles)
+	static const NandLineCmd_t cmd =
+	{ CMD_FAST_READ_QUAD_IO, 4, 2, 4, 4 };       /// 1-4-4, 4 dummy clocks
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	if (!Nand_ReadWide(&cmd, col_addr, buf, len))
+		FastRead(col_addr, buf, len);
 }
 
 /* ===========================================================================
@@ -338,9 +320,66 @@ void FastReadQuadIOWith4ByteAddr(uint16_t col_addr, uint8_t *buf, uint16_t len)
 	command[2] = (col_addr >> 0) & 0xFF;
 	command[3] = 0x00;  // Dummy (BUF=1: 10 cycles, BUF=0: 14 cycles)
 
-	CS_LOW();
-	HAL_SPI_TX(command, 4);
-	HAL_SPI_RX(buf, len);
-	CS_HIGH();
+	Nand_Read(command, 4, buf, len);
 }
 
+
+/* ===========================================================================
+ * Function: ContinuousReadData
+ * ===========================================================================
+ * @brief
+ *  - Executes READ DATA (03h) in Continuous Read Mode (SR2[BUF] = 0).
+ *
+ * @details
+ *  - No column address: 3 dummy bytes (24 clocks), output starts at column 0
+ *    of the page in the cache and runs through the main area only.
+ *  - After the last byte of a page the device moves the next page (already
+ *    read during the output) into the cache, the data phase continues
+ *    without tR gap until /CS goes high.
+ *  - SR3[ECC] accumulates the worst class of every page output since the
+ *    last PAGE DATA READ (13h).
+ *
+ * @param buf : [out] Read data buffer.
+ * @param len : Number of bytes to read (may cross page boundaries).
+ *
+ * @note
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.12, 7.2.5 (BUF)
+ * --------------------------------------------------------------------------- */
+void ContinuousReadData(uint8_t *buf, uint16_t len)
+{
+	uint8_t command[4];
+
+	command[0] = CMD_READ_DATA;
+	command[1] = 0x00;   // Dummy (BUF=0: 24 clocks, no column address)
+	command[2] = 0x00;
+	command[3] = 0x00;
+
+	Nand_Read(command, 4, buf, len);
+}
+
+/* ===========================================================================
+ * Function: ContinuousReadQuadOutput
+ * ===========================================================================
+ * @brief
+ *  - Executes FAST READ QUAD OUTPUT (6Bh) in Continuous Read Mode.
+ *
+ * @details
+ *  - 32 dummy clocks after the instruction (sent as a zero 16-bit address
+ *    phase + 16 dummy clocks, fits the QUADSPI dummy field), data on
+ *    IO0 ~ IO3 from column 0, crossing page boundaries like 03h.
+ *  - Transport without a wide bus falls back to ContinuousReadData (03h).
+ *
+ * @param buf : [out] Read data buffer.
+ * @param len : Number of bytes to read.
+ *
+ * @note
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.17
+ * --------------------------------------------------------------------------- */
+void ContinuousReadQuadOutput(uint8_t *buf, uint16_t len)
+{
+	static const NandLineCmd_t cmd =
+	{ CMD_FAST_READ_QUAD_OUTPUT, 1, 2, 16, 4 };   /// 1-1-4, BUF = 0
+
+	if (!Nand_ReadWide(&cmd, 0, buf, len))
+		ContinuousReadData(buf, len);
+}
@@ -55,6 +55,8 @@
  * FastReadDualIOWith4ByteAddr
  * FastReadQuadIO
  * FastReadQuadIOWith4ByteAddr
+ * ContinuousReadData
+ * ContinuousReadQuadOutput
  * --------------------------------------------------------------------------- */
 void PageDataRead(uint32_t page_addr);
 void ReadData(uint16_t col_addr, uint8_t *buf, uint16_t len);
@@ -69,4 +71,7 @@ void FastReadDualIOWith4ByteAddr(uint16_t col_addr, uint8_t *buf, uint16_t len);
 void FastReadQuadIO(uint16_t col_addr, uint8_t *buf, uint16_t len);
 void FastReadQuadIOWith4ByteAddr(uint16_t col_addr, uint8_t *buf, uint16_t len);
 
+void ContinuousReadData(uint8_t *buf, uint16_t len);
+void ContinuousReadQuadOutput(uint8_t *buf, uint16_t len);
+
 #endif /* DRIVER_NAND_DRI_READ_H_ */
@@ -28,12 +28,7 @@ void W25N02_JEDECID(uint8_t *buf)
 	if (buf == NULL)
 		return;
 
-	uint8_t command = JEDECID;
-	uint8_t dummy = 0x00;
+	uint8_t command[2] = { JEDECID, 0x00 };   /// Opcode + 8 dummy clocks
 
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	HAL_SPI_TX(&dummy, 1);
-	HAL_SPI_RX(buf, 3);
-	CS_HIGH();
+	Nand_Read(command, 2, buf, 3);
 }
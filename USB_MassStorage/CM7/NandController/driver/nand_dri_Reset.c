@@ -30,9 +30,8 @@
 void Reset(void)
 {
 	uint8_t command = RESET;
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	CS_HIGH();
+	Nand_Command(&command, 1);
+	Nand_Dev()->sr_valid = 0;       // SR1 / SR2 back to power-up values
 }
 
 /* ===========================================================================
@@ -52,9 +51,7 @@ void Reset(void)
 void EnableReset(void)
 {
 	uint8_t command = ENABLE_RESET;
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	CS_HIGH();
+	Nand_Command(&command, 1);
 }
 
 /* ===========================================================================
@@ -79,7 +76,6 @@ void EnableReset(void)
 void DeviceReset(void)
 {
 	uint8_t command = DEVICE_RESET;
-	CS_LOW();
-	HAL_SPI_TX(&command, 1);
-	CS_HIGH();
+	Nand_Command(&command, 1);
+	Nand_Dev()->sr_valid = 0;       // SR1 / SR2 back to power-up values
 }
@@ -39,10 +39,7 @@ uint8_t ReadStatusRegister(uint8_t sr_addr)
 	uint8_t command[2] = { READ_SR, sr_addr };
 	uint8_t sr = 0;
 
-	CS_LOW();
-	HAL_SPI_TX(command, 2);
-	HAL_SPI_RX(&sr, 1);
-	CS_HIGH();
+	Nand_Read(command, 2, &sr, 1);
 
 	return sr;
 }
@@ -68,14 +65,107 @@ uint8_t ReadStatusRegister(uint8_t sr_addr)
  *
  * @note
  *  - Ensure SR[0] (OIP = 0) before issuing command.
- *  - Verify change by reading back with ReadStatusRegister().
+ *  - SR1 / SR2 shadow is written through (SR1-L / OTP-L respected), read
+ *    back and compared only when NAND_SR_SHADOW_VERIFY = 1 (debug build).
  *  - Reference: Winbond W25N02KV Datasheet 8.2.4
  * --------------------------------------------------------------------------- */
 void WriteStatusRegister(uint8_t sr_addr, uint8_t value)
 {
 	uint8_t command[3] = { WRITE_SR, sr_addr, value };
+	NandDevice_t *d = Nand_Dev();
 
-	CS_LOW();
-	HAL_SPI_TX(command, 3);
-	CS_HIGH();
+	Nand_Command(command, 3);
+
+	/// Write-through: shadow follows what the device accepts
+	if (sr_addr == NAND_SR1_ADDR)
+	{
+		if ((d->sr_valid & NAND_SHADOW_SR2) && (d->sr2 & NAND_SR2_SR1L))
+			return;                 // SR1-L: write ignored by the device
+
+		d->sr1 = value;
+		d->sr_valid |= NAND_SHADOW_SR1;
+	}
+	else if (sr_addr == NAND_SR2_ADDR)
+	{
+		if (d->sr_valid & NAND_SHADOW_SR2)
+			value |= d->sr2 & (NAND_SR2_OTPL | NAND_SR2_SR1L);
+
+		d->sr2 = value;
+		d->sr_valid |= NAND_SHADOW_SR2;
+	}
+	else
+	{
+		return;
+	}
+
+#if NAND_SR_SHADOW_VERIFY
+	uint8_t actual = ReadStatusRegister(sr_addr);
+
+	if (actual != value)
+	{
+		NAND_LOG(SR_SHADOW_MISMATCH, sr_addr, value, actual);
+
+		if (sr_addr == NAND_SR1_ADDR)
+			d->sr1 = actual;
+		else
+			d->sr2 = actual;
+	}
+#endif
+}
+
+/* ===========================================================================
+ * Function: ReadStatusRegisterCached
+ * ===========================================================================
+ * @brief
+ *  - SR1 / SR2 from the shadow of the bound device, SR3 always from the bus.
+ *
+ * @details
+ *  - SR1 (protection) and SR2 (configuration) only change through
+ *    WriteStatusRegister or reset, so after the first read they cost no
+ *    SPI transaction. SR3 (BUSY / WEL / FAIL / ECC) is never cached.
+ *  - The first access after power-up, reset or Nand_Bind reads the device.
+ *
+ * @param sr_addr : 0xA0 / 0xB0 / 0xC0
+ *
+ * @return uint8_t : Register value.
+ * --------------------------------------------------------------------------- */
+uint8_t ReadStatusRegisterCached(uint8_t sr_addr)
+{
+#if NAND_SR_SHADOW
+	NandDevice_t *d = Nand_Dev();
+
+	if (sr_addr == NAND_SR1_ADDR)
+	{
+		if (!(d->sr_valid & NAND_SHADOW_SR1))
+		{
+			d->sr1 = ReadStatusRegister(sr_addr);
+			d->sr_valid |= NAND_SHADOW_SR1;
+		}
+		return d->sr1;
+	}
+
+	if (sr_addr == NAND_SR2_ADDR)
+	{
+		if (!(d->sr_valid & NAND_SHADOW_SR2))
+		{
+			d->sr2 = ReadStatusRegister(sr_addr);
+			d->sr_valid |= NAND_SHADOW_SR2;
+		}
+		return d->sr2;
+	}
+#endif
+
+	return ReadStatusRegister(sr_addr);
+}
+
+/* ---------------------------------------------------------------------------
+ * Function: InvalidateStatusShadow
+ * ---------------------------------------------------------------------------
+ * @brief
+ *  - Drop the SR1 / SR2 shadow, next read goes to the device (after reset,
+ *    /WP pin change or anything done behind the driver's back).
+ * --------------------------------------------------------------------------- */
+void InvalidateStatusShadow(void)
+{
+	Nand_Dev()->sr_valid = 0;
 }
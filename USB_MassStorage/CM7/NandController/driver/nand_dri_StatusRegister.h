@@ -14,7 +14,34 @@
 #define READ_SR  0x05
 #define WRITE_SR 0x01
 
+/* ---------------------------------------------------------------------------
+ * SR1 / SR2 Shadow (NandDevice_t.sr1 / sr2)
+ * ---------------------------------------------------------------------------
+ * NAND_SR_SHADOW        : 1 -> SR1 / SR2 reads served from the shadow
+ * NAND_SR_SHADOW_VERIFY : 1 -> every WriteStatusRegister is read back and
+ *                         a mismatch is logged (debug build only)
+ * --------------------------------------------------------------------------- */
+#ifndef NAND_SR_SHADOW
+#define NAND_SR_SHADOW          1
+#endif
+
+#ifndef NAND_SR_SHADOW_VERIFY
+#ifdef DEBUG
+#define NAND_SR_SHADOW_VERIFY   1
+#else
+#define NAND_SR_SHADOW_VERIFY   0
+#endif
+#endif
+
+#define NAND_SR1_ADDR   0xA0
+#define NAND_SR2_ADDR   0xB0
+#define NAND_SR2_OTPL   0x80      // One-time, cannot be cleared
+#define NAND_SR2_SR1L   0x20      // One-time, SR1 read only afterwards
+
 uint8_t ReadStatusRegister(uint8_t sr_addr);
 void WriteStatusRegister(uint8_t sr_addr, uint8_t value);
 
+uint8_t ReadStatusRegisterCached(uint8_t sr_addr);
+void InvalidateStatusShadow(void);
+
 #endif /* DRIVER_NAND_DRI_STATUSREGISTER_H_ */
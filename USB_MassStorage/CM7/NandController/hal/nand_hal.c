@@ -9,28 +9,587 @@
 
 #include "nand_hal.h"
 
-/* -------------------------------------------------------------------------
+/* ---------------------------------------------------------------------------
+ * DMA transfer context
+ * ---------------------------------------------------------------------------
+ * - nand_dma_buf   : RX bounce buffer (caller buffers are not cache-line
+ *                    aligned and may share lines with stack data).
+ * - nand_dma_txbuf : TX bounce buffer, command header + payload gathered.
+ * - dma_busy       : Set on submit, cleared from SPI2 complete/error callback.
+ * - dma_cb / ctx   : Completion callback of the pending submit (or NULL).
+ * --------------------------------------------------------------------------- */
+static uint8_t nand_dma_buf[NAND_DMA_BUF_SIZE] NAND_DMA_BUFFER;
+static uint8_t nand_dma_txbuf[NAND_DMA_BUF_SIZE] NAND_DMA_BUFFER;
+
+static volatile bool dma_busy = false;
+static volatile bool dma_ok = true;
+static NandHal_Callback_t dma_cb = NULL;
+static void *dma_ctx = NULL;
+static uint8_t *dma_rx_buf = NULL;
+static uint16_t dma_rx_len = 0;
+
+/* ---------------------------------------------------------------------------
+ * D-Cache maintenance (no-op while D-Cache is disabled)
+ * --------------------------------------------------------------------------- */
+static inline uint32_t dcache_len(const void *addr, uint32_t len)
+{
+	uintptr_t start = (uintptr_t) addr & ~(uintptr_t) (NAND_DMA_ALIGN - 1);
+	uintptr_t end = ((uintptr_t) addr + len + NAND_DMA_ALIGN - 1)
+			& ~(uintptr_t) (NAND_DMA_ALIGN - 1);
+
+	return (uint32_t) (end - start);
+}
+
+static inline void dcache_clean(const void *addr, uint32_t len)
+{
+	if (SCB->CCR & SCB_CCR_DC_Msk)
+		SCB_CleanDCache_by_Addr(
+				(uint32_t*) ((uintptr_t) addr & ~(uintptr_t) (NAND_DMA_ALIGN - 1)),
+				(int32_t) dcache_len(addr, len));
+}
+
+static inline void dcache_invalidate(void *addr, uint32_t len)
+{
+	if (SCB->CCR & SCB_CCR_DC_Msk)
+		SCB_InvalidateDCache_by_Addr(
+				(uint32_t*) ((uintptr_t) addr & ~(uintptr_t) (NAND_DMA_ALIGN - 1)),
+				(int32_t) dcache_len(addr, len));
+}
+
+/* ===========================================================================
+ * Function: HAL_SPI_Transfer
+ * ===========================================================================
  * @brief
+ *  - Shift a list of segments through SPI2 in a single peripheral session.
  *
- * HAL_SPI_RX
+ * @details
+ *  - HAL_SPI_Transmit/Receive re-arm SPI2 on every call (lock, TSIZE, SPE,
+ *    CSTART, EOT wait, close). A command + payload pair paid that twice.
+ *  - Here TSIZE is programmed once with the total length, then TXDR/RXDR
+ *    are pumped byte by byte with at most NAND_SPI_FIFO_INFLIGHT bytes in
+ *    flight so the RX FIFO never overruns.
+ *  - SPI2 is left disabled (SPE = 0), same state HAL_SPI_xxx leaves it in.
  *
+ * @param hspi  : SPI handle (SPI2 / any H7 SPI with 16-byte FIFO).
+ * @param seg   : Segment list.
+ * @param count : Number of segments.
  *
- * HAL_SPI_TX
- * ------------------------------------------------------------------------- */
-void HAL_SPI_TX(const uint8_t *data, uint16_t len)
+ * @return
+ *  - true  : All bytes transferred.
+ *  - false : Timeout or DMA transfer still pending.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_Transfer(SPI_HandleTypeDef *hspi, const NandSpiSeg_t *seg,
+		uint8_t count)
 {
-	HAL_SPI_Transmit(&hspi2, data, len, HAL_MAX_DELAY);
+	SPI_TypeDef *spi = hspi->Instance;
+	uint32_t total = 0;
+
+	for (uint8_t i = 0; i < count; i++)
+		total += seg[i].len;
+
+	if (total == 0 || total > 0xFFFF || dma_busy)
+		return false;
+
+	uint8_t tx_seg = 0, rx_seg = 0;
+	uint16_t tx_pos = 0, rx_pos = 0;
+	uint32_t tx_left = total, rx_left = total;
+	uint32_t start = HAL_GetTick();
+	bool ok = true;
+
+	MODIFY_REG(spi->CFG2, SPI_CFG2_COMM, 0);   // Full-duplex
+	MODIFY_REG(spi->CR2, SPI_CR2_TSIZE, total);
+	SET_BIT(spi->CR1, SPI_CR1_SPE);
+	SET_BIT(spi->CR1, SPI_CR1_CSTART);
+
+	while (rx_left)
+	{
+		uint32_t sr = spi->SR;
+
+		if (tx_left && (sr & SPI_SR_TXP)
+				&& (rx_left - tx_left) < NAND_SPI_FIFO_INFLIGHT)
+		{
+			while (tx_pos >= seg[tx_seg].len)
+			{
+				tx_seg++;
+				tx_pos = 0;
+			}
+
+			uint8_t b = seg[tx_seg].tx ? seg[tx_seg].tx[tx_pos] : NAND_SPI_DUMMY;
+			*(__IO uint8_t*) &spi->TXDR = b;
+			tx_pos++;
+			tx_left--;
+		}
+
+		if (sr & SPI_SR_RXP)
+		{
+			uint8_t b = *(__IO uint8_t*) &spi->RXDR;
+
+			while (rx_pos >= seg[rx_seg].len)
+			{
+				rx_seg++;
+				rx_pos = 0;
+			}
+
+			if (seg[rx_seg].rx)
+				seg[rx_seg].rx[rx_pos] = b;
+			rx_pos++;
+			rx_left--;
+		}
+
+		if ((HAL_GetTick() - start) >= NAND_SPI_PUMP_TIMEOUT)
+		{
+			ok = false;
+			break;
+		}
+	}
+
+	while (ok && !(spi->SR & SPI_SR_EOT))
+	{
+		if ((HAL_GetTick() - start) >= NAND_SPI_PUMP_TIMEOUT)
+			ok = false;
+	}
+
+	spi->IFCR = SPI_IFCR_EOTC | SPI_IFCR_TXTFC | SPI_IFCR_OVRC;
+	CLEAR_BIT(spi->CR1, SPI_CR1_SPE);
+
+	return ok;
 }
 
-/* -------------------------------------------------------------------------
- * Function Introduction
- * -------------------------------------------------------------------------
- * HAL_SPI_RX
+/* ===========================================================================
+ * Function: HAL_SPI_CmdRead
+ * ===========================================================================
+ * @brief
+ *  - Send command header and receive the data phase in one SPI2 session.
+ *
+ * @details
+ *  - Data phase >= NAND_HAL_DMA_THRESHOLD : one TransmitReceive DMA covering
+ *    [header + dummy fill], header echo bytes are dropped on copy-out.
+ *  - Otherwise : register-level FIFO pump (HAL_SPI_Transfer).
+ *
+ * @param cmd     : Command header (opcode + address + dummy).
+ * @param cmd_len : Header length.
+ * @param buf     : [out] Data buffer.
+ * @param len     : Data length.
+ *
+ * @return
+ *  - true  : Transfer complete.
+ *  - false : SPI timeout.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_CmdRead(const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf,
+		uint16_t len)
+{
+#if NAND_HAL_USE_DMA
+	uint32_t total = (uint32_t) cmd_len + len;
+
+	if (len >= NAND_HAL_DMA_THRESHOLD && total <= NAND_DMA_BUF_SIZE && !dma_busy)
+	{
+		memcpy(nand_dma_txbuf, cmd, cmd_len);
+		memset(nand_dma_txbuf + cmd_len, NAND_SPI_DUMMY, len);
+
+		if (HAL_SPI_TXRX_DMA(nand_dma_txbuf, nand_dma_buf, (uint16_t) total,
+				NULL, NULL) && HAL_SPI_DMA_Wait(NAND_HAL_DMA_TIMEOUT))
+		{
+			memcpy(buf, nand_dma_buf + cmd_len, len);
+			return true;
+		}
+
+		NAND_LOG(HAL_DMA_READ_FAIL, len);
+	}
+#endif
+
+	NandSpiSeg_t seg[2] =
+	{
+	{ cmd, NULL, cmd_len },
+	{ NULL, buf, len } };
+
+	return HAL_SPI_Transfer(&hspi2, seg, 2);
+}
+
+/* ===========================================================================
+ * Function: HAL_SPI_CmdWrite
+ * ===========================================================================
+ * @brief
+ *  - Send command header and data phase in one SPI2 session.
  *
+ * @details
+ *  - Data phase >= NAND_HAL_DMA_THRESHOLD : header and payload are gathered
+ *    into the DMA buffer and sent with one Transmit DMA.
+ *  - Otherwise : register-level FIFO pump (HAL_SPI_Transfer).
  *
- * HAL_SPI_TX
- * ------------------------------------------------------------------------- */
-void HAL_SPI_RX(uint8_t *data, uint16_t len)
+ * @param cmd     : Command header (opcode + address).
+ * @param cmd_len : Header length.
+ * @param buf     : [in] Data buffer (NULL / len = 0 for header-only command).
+ * @param len     : Data length.
+ *
+ * @return
+ *  - true  : Transfer complete.
+ *  - false : SPI timeout.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_CmdWrite(const uint8_t *cmd, uint16_t cmd_len, const uint8_t *buf,
+		uint16_t len)
+{
+#if NAND_HAL_USE_DMA
+	uint32_t total = (uint32_t) cmd_len + len;
+
+	if (len >= NAND_HAL_DMA_THRESHOLD && total <= NAND_DMA_BUF_SIZE && !dma_busy)
+	{
+		memcpy(nand_dma_txbuf, cmd, cmd_len);
+		memcpy(nand_dma_txbuf + cmd_len, buf, len);
+
+		if (HAL_SPI_TX_DMA(nand_dma_txbuf, (uint16_t) total, NULL, NULL)
+				&& HAL_SPI_DMA_Wait(NAND_HAL_DMA_TIMEOUT))
+			return true;
+
+		NAND_LOG(HAL_DMA_WRITE_FAIL, len);
+	}
+#endif
+
+	NandSpiSeg_t seg[2] =
+	{
+	{ cmd, NULL, cmd_len },
+	{ buf, NULL, len } };
+
+	return HAL_SPI_Transfer(&hspi2, seg, (buf != NULL && len != 0) ? 2 : 1);
+}
+
+/* ---------------------------------------------------------------------------
+ * Submit bookkeeping shared by the TX / RX / TXRX entries
+ * --------------------------------------------------------------------------- */
+static void dma_arm(uint8_t *rx, uint16_t len, NandHal_Callback_t cb,
+		void *ctx)
+{
+	dma_cb = cb;
+	dma_ctx = ctx;
+	dma_rx_buf = rx;
+	dma_rx_len = len;
+	dma_ok = true;
+	dma_busy = true;
+}
+
+static void dma_complete(bool ok)
+{
+	NandHal_Callback_t cb = dma_cb;
+	void *ctx = dma_ctx;
+
+	if (ok && dma_rx_buf != NULL)
+		dcache_invalidate(dma_rx_buf, dma_rx_len);
+
+	dma_ok = ok;
+	dma_cb = NULL;
+	dma_busy = false;
+
+	if (cb != NULL)
+		cb(ok, ctx);
+}
+
+/* ===========================================================================
+ * Function: HAL_SPI_TX_DMA
+ * ===========================================================================
+ * @brief
+ *  - Submit an asynchronous SPI2 transmit through DMA1 Stream1.
+ *
+ * @details
+ *  - Cleans D-Cache lines of the source buffer before the DMA reads it.
+ *  - Returns immediately, cb(ok, ctx) runs from interrupt context.
+ *
+ * @param data : Source buffer (NAND_DMA_BUFFER recommended).
+ * @param len  : Number of bytes.
+ * @param cb   : Completion callback (NULL for polling via HAL_SPI_DMA_Busy).
+ * @param ctx  : User context passed to callback.
+ *
+ * @return
+ *  - true  : Transfer started.
+ *  - false : Previous transfer still pending or HAL error.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_TX_DMA(const uint8_t *data, uint16_t len, NandHal_Callback_t cb,
+		void *ctx)
+{
+	if (dma_busy || len == 0)
+		return false;
+
+	dcache_clean(data, len);
+	dma_arm(NULL, 0, cb, ctx);
+
+	if (HAL_SPI_Transmit_DMA(&hspi2, data, len) != HAL_OK)
+	{
+		dma_busy = false;
+		return false;
+	}
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: HAL_SPI_RX_DMA
+ * ===========================================================================
+ * @brief
+ *  - Submit an asynchronous SPI2 receive through DMA1 Stream0.
+ *
+ * @details
+ *  - Invalidates D-Cache lines of the target buffer before and after the
+ *    transfer, so the CPU never sees stale cache data.
+ *  - Buffer must be 32-byte aligned and sized to a cache line multiple,
+ *    otherwise invalidation may discard neighbouring variables.
+ *
+ * @param data : Target buffer (NAND_DMA_BUFFER).
+ * @param len  : Number of bytes.
+ * @param cb   : Completion callback (NULL for polling via HAL_SPI_DMA_Busy).
+ * @param ctx  : User context passed to callback.
+ *
+ * @return
+ *  - true  : Transfer started.
+ *  - false : Previous transfer still pending or HAL error.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_RX_DMA(uint8_t *data, uint16_t len, NandHal_Callback_t cb,
+		void *ctx)
+{
+	if (dma_busy || len == 0)
+		return false;
+
+	dcache_invalidate(data, len);
+	dma_arm(data, len, cb, ctx);
+
+	if (HAL_SPI_Receive_DMA(&hspi2, data, len) != HAL_OK)
+	{
+		dma_busy = false;
+		return false;
+	}
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: HAL_SPI_TXRX_DMA
+ * ===========================================================================
+ * @brief
+ *  - Submit an asynchronous full-duplex SPI2 transfer (DMA1 Stream0 + 1).
+ *
+ * @details
+ *  - Command header and dummy fill go out of `tx` while `rx` collects the
+ *    echo and the data phase, one SPI2 session.
+ *  - Same cache rules as TX_DMA (tx) and RX_DMA (rx).
+ *
+ * @param tx  : Source buffer (NAND_DMA_BUFFER).
+ * @param rx  : Target buffer (NAND_DMA_BUFFER).
+ * @param len : Number of bytes each way.
+ * @param cb  : Completion callback (NULL for polling via HAL_SPI_DMA_Busy).
+ * @param ctx : User context passed to callback.
+ *
+ * @return
+ *  - true  : Transfer started.
+ *  - false : Previous transfer still pending or HAL error.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_TXRX_DMA(const uint8_t *tx, uint8_t *rx, uint16_t len,
+		NandHal_Callback_t cb, void *ctx)
+{
+	if (dma_busy || len == 0)
+		return false;
+
+	dcache_clean(tx, len);
+	dcache_invalidate(rx, len);
+	dma_arm(rx, len, cb, ctx);
+
+	if (HAL_SPI_TransmitReceive_DMA(&hspi2, tx, rx, len) != HAL_OK)
+	{
+		dma_busy = false;
+		return false;
+	}
+
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function: HAL_SPI_DMA_Busy / HAL_SPI_DMA_Wait
+ * ---------------------------------------------------------------------------
+ * @brief
+ *  - Query or block on the pending DMA transfer.
+ * @details
+ *  - Wait is the blocking wrapper of the submits: the completion interrupt
+ *    clears dma_busy (and runs the callback, if any). On timeout the
+ *    transfer is aborted and the callback reports ok = false.
+ * @return
+ *  - HAL_SPI_DMA_Wait : true if completed without error before timeout.
+ * --------------------------------------------------------------------------- */
+bool HAL_SPI_DMA_Busy(void)
+{
+	return dma_busy;
+}
+
+bool HAL_SPI_DMA_Wait(uint32_t timeout_ms)
+{
+	uint32_t start = HAL_GetTick();
+
+	while (dma_busy)
+	{
+		if ((HAL_GetTick() - start) >= timeout_ms)
+		{
+			HAL_SPI_Abort(&hspi2);
+			dma_complete(false);
+			return false;
+		}
+	}
+
+	return dma_ok;
+}
+
+/* ===========================================================================
+ * Function: NandClock_Init / NandClock_Ticks / NandClock_DelayUs
+ * ===========================================================================
+ * @brief
+ *  - Platform clock of the ready-wait engine (nand_ready.c).
+ *
+ * @details
+ *  - DWT->CYCCNT runs at HCLK: 1 tick ~ 10 ns at 96 MHz, wraps after ~44 s.
+ *    Waits compare tick differences, the wrap is harmless.
+ *  - CYCCNT is not cleared, SpiOverhead_Bench may be sampling it.
+ * --------------------------------------------------------------------------- */
+void NandClock_Init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->LAR = 0xC5ACCE55;                   /// Unlock DWT (Cortex-M7)
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t NandClock_Ticks(void)
+{
+	return DWT->CYCCNT;
+}
+
+uint32_t NandClock_TicksPerUs(void)
+{
+	return SystemCoreClock / 1000000U;
+}
+
+void NandClock_DelayUs(uint32_t us)
+{
+	uint32_t start = DWT->CYCCNT;
+	uint32_t ticks = us * (SystemCoreClock / 1000000U);
+
+	while ((DWT->CYCCNT - start) < ticks)
+		;
+}
+
+/* ---------------------------------------------------------------------------
+ * SPI2 transport backend
+ * ---------------------------------------------------------------------------
+ * - Polling : every transaction through the register-level FIFO pump.
+ * - DMA     : data phase >= NAND_HAL_DMA_THRESHOLD through DMA1.
+ * - No hardware status polling on SPI2: wait_ready = NULL, Nand_WaitReadyOp
+ *   paces SR3 reads on the DWT clock instead.
+ * --------------------------------------------------------------------------- */
+NandSpiCtx_t NandSpi2_Ctx = { &hspi2, GPIOB, GPIO_PIN_4 };
+
+static inline void spi_select(const NandSpiCtx_t *c, bool sel)
+{
+	HAL_GPIO_WritePin(c->cs_port, c->cs_pin, sel ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+static bool spi_command(void *ctx, const uint8_t *cmd, uint16_t cmd_len)
+{
+	NandSpiCtx_t *c = ctx;
+	NandSpiSeg_t seg = { cmd, NULL, cmd_len };
+
+	spi_select(c, true);
+	bool ok = HAL_SPI_Transfer(c->hspi, &seg, 1);
+	spi_select(c, false);
+
+	return ok;
+}
+
+static bool spi_read(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		uint8_t *buf, uint16_t len)
+{
+	NandSpiCtx_t *c = ctx;
+	NandSpiSeg_t seg[2] =
+	{
+	{ cmd, NULL, cmd_len },
+	{ NULL, buf, len } };
+
+	spi_select(c, true);
+	bool ok = HAL_SPI_Transfer(c->hspi, seg, 2);
+	spi_select(c, false);
+
+	return ok;
+}
+
+static bool spi_write(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		const uint8_t *buf, uint16_t len)
+{
+	NandSpiCtx_t *c = ctx;
+	NandSpiSeg_t seg[2] =
+	{
+	{ cmd, NULL, cmd_len },
+	{ buf, NULL, len } };
+
+	spi_select(c, true);
+	bool ok = HAL_SPI_Transfer(c->hspi, seg, (buf != NULL && len != 0) ? 2 : 1);
+	spi_select(c, false);
+
+	return ok;
+}
+
+static bool spi_dma_read(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		uint8_t *buf, uint16_t len)
+{
+	NandSpiCtx_t *c = ctx;
+
+	spi_select(c, true);
+	bool ok = HAL_SPI_CmdRead(cmd, cmd_len, buf, len);
+	spi_select(c, false);
+
+	return ok;
+}
+
+static bool spi_dma_write(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		const uint8_t *buf, uint16_t len)
+{
+	NandSpiCtx_t *c = ctx;
+
+	spi_select(c, true);
+	bool ok = HAL_SPI_CmdWrite(cmd, cmd_len, buf, len);
+	spi_select(c, false);
+
+	return ok;
+}
+
+const NandTransport_t NandTransport_SPI2_Poll =
+{ "SPI2 polling", spi_command, spi_read, spi_write, NULL, NULL, NULL };
+
+const NandTransport_t NandTransport_SPI2_DMA =
+{ "SPI2 DMA", spi_command, spi_dma_read, spi_dma_write, NULL, NULL, NULL };
+
+NandDevice_t NandDev_Default =
+{
+#if NAND_HAL_USE_DMA
+		&NandTransport_SPI2_DMA,
+#else
+		&NandTransport_SPI2_Poll,
+#endif
+		&NandSpi2_Ctx, NAND_IO_SINGLE, 0, 0, 0 };   // SR shadow invalid
+
+/* ---------------------------------------------------------------------------
+ * SPI2 DMA completion (HAL weak callbacks)
+ * --------------------------------------------------------------------------- */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == SPI2)
+		dma_complete(true);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == SPI2)
+		dma_complete(true);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == SPI2)
+		dma_complete(true);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
 {
-	HAL_SPI_Receive(&hspi2, data, len, HAL_MAX_DELAY);
+	if (hspi->Instance == SPI2)
+		dma_complete(false);
 }
@@ -17,22 +17,109 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include "stm32h7xx_hal.h"
+#include "W25N02KV_Config.h"
+#include "nand_transport.h"
+#include "nand_ready.h"
+#include "nand_log.h"
 
 extern SPI_HandleTypeDef hspi2;
 extern UART_HandleTypeDef huart3;
 
-#define CS_LOW()  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_4, GPIO_PIN_RESET)
-#define CS_HIGH() HAL_GPIO_WritePin(GPIOB, GPIO_PIN_4, GPIO_PIN_SET)
+/* ---------------------------------------------------------------------------
+ * SPI Transport Context
+ * ---------------------------------------------------------------------------
+ * hspi    : SPI handle (DMA backend: &hspi2 only, DMA1 Stream0/1 linked)
+ * cs_port : /CS GPIO port
+ * cs_pin  : /CS GPIO pin
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	SPI_HandleTypeDef *hspi;
+	GPIO_TypeDef *cs_port;
+	uint16_t cs_pin;
+} NandSpiCtx_t;
+
+extern NandSpiCtx_t NandSpi2_Ctx;                  // SPI2, /CS = PB4
+extern const NandTransport_t NandTransport_SPI2_Poll;
+extern const NandTransport_t NandTransport_SPI2_DMA;
+
+/* ---------------------------------------------------------------------------
+ * DMA Transport Setting
+ * ---------------------------------------------------------------------------
+ * NAND_HAL_USE_DMA       : 1 -> Data phase >= threshold moves through DMA1
+ * NAND_HAL_DMA_THRESHOLD : Shorter transfers stay on polling (setup cost)
+ * NAND_HAL_DMA_TIMEOUT   : Blocking wrapper timeout (ms)
+ * NAND_DMA_BUFFER        : Place buffer in .nand_dma (RAM_D2, 32-byte aligned)
+ * --------------------------------------------------------------------------- */
+#ifndef NAND_HAL_USE_DMA
+#define NAND_HAL_USE_DMA        1
+#endif
+
+#define NAND_HAL_DMA_THRESHOLD  32
+#define NAND_HAL_DMA_TIMEOUT    100
+
+#define NAND_DMA_ALIGN          32  // Cortex-M7 D-Cache line size
+#define NAND_DMA_BUFFER         __attribute__((section(".nand_dma"), aligned(NAND_DMA_ALIGN)))
+#define NAND_DMA_BUF_SIZE       (((PAGE_TOTAL_SIZE) + NAND_DMA_ALIGN - 1) & ~(NAND_DMA_ALIGN - 1))
+
+/* Completion callback: ok = false on SPI/DMA error or Wait timeout */
+typedef void (*NandHal_Callback_t)(bool ok, void *ctx);
+
+/* ---------------------------------------------------------------------------
+ * Scatter / Gather segment
+ * ---------------------------------------------------------------------------
+ * tx  : Bytes to shift out (NULL -> NAND_SPI_DUMMY)
+ * rx  : Bytes shifted in   (NULL -> discarded)
+ * len : Segment length
+ *
+ * All segments of one HAL_SPI_Transfer() share one /CS assertion and one
+ * SPI2 session (TSIZE = sum of len, single CSTART / EOT).
+ * --------------------------------------------------------------------------- */
+#define NAND_SPI_DUMMY          0xFF
+#define NAND_SPI_FIFO_INFLIGHT  8     // SPI2 FIFO = 16 bytes, keep RX from overrun
+#define NAND_SPI_PUMP_TIMEOUT   10    // ms
+
+typedef struct
+{
+	const uint8_t *tx;
+	uint8_t *rx;
+	uint16_t len;
+} NandSpiSeg_t;
 
 /* -------------------------------------------------------------------------
  * Function Introduction
  * -------------------------------------------------------------------------
- * HAL_SPI_RX
+ * HAL_SPI_TX_DMA / HAL_SPI_RX_DMA / HAL_SPI_TXRX_DMA
+ *  - Asynchronous SPI2 submit, returns at once. cb(ok, ctx) runs from the
+ *    SPI2 DMA interrupt (HAL_SPI_*CpltCallback / ErrorCallback), the CPU is
+ *    free to prepare the next request while the page moves.
+ *  - Buffers must be NAND_DMA_BUFFER (or any 32-byte aligned D1/D2 SRAM).
+ *  - /CS is not touched: caller keeps /CS low until the callback.
  *
+ * HAL_SPI_DMA_Busy / HAL_SPI_DMA_Wait
+ *  - Query or block on the pending transfer (blocking wrapper: submit with
+ *    cb = NULL, then Wait).
+ * ------------------------------------------------------------------------- */
+bool HAL_SPI_TX_DMA(const uint8_t *data, uint16_t len, NandHal_Callback_t cb, void *ctx);
+bool HAL_SPI_RX_DMA(uint8_t *data, uint16_t len, NandHal_Callback_t cb, void *ctx);
+bool HAL_SPI_TXRX_DMA(const uint8_t *tx, uint8_t *rx, uint16_t len,
+		NandHal_Callback_t cb, void *ctx);
+bool HAL_SPI_DMA_Busy(void);
+bool HAL_SPI_DMA_Wait(uint32_t timeout_ms);
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * HAL_SPI_Transfer
+ *  - Register-level FIFO pump over a segment list, one SPI2 session.
  *
- * HAL_SPI_TX
+ * HAL_SPI_CmdRead / HAL_SPI_CmdWrite
+ *  - Command header + data phase in one session. Large data phases use
+ *    one DMA transfer covering header and payload.
+ *  - SPI2 only, /CS is framed by the caller.
  * ------------------------------------------------------------------------- */
-void HAL_SPI_RX(uint8_t *data, uint16_t len);        // Standard SPI Recevice
-void HAL_SPI_TX(const uint8_t *data, uint16_t len);  // Standard SPI Send
+bool HAL_SPI_Transfer(SPI_HandleTypeDef *hspi, const NandSpiSeg_t *seg, uint8_t count);
+bool HAL_SPI_CmdRead(const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf, uint16_t len);
+bool HAL_SPI_CmdWrite(const uint8_t *cmd, uint16_t cmd_len, const uint8_t *buf, uint16_t len);
 
 #endif /* HAL_NAND_HAL_H_ */
@@ -0,0 +1,315 @@
+/*
+ *  nand_log.c
+ *
+ *  Created on: Nov 10, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "nand_log.h"
+#include "nand_ready.h"
+
+#if defined(USE_HAL_DRIVER)
+#include "stm32h7xx_hal.h"     // SCB D-Cache maintenance (target only)
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Event table (flash)
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_FMT_(id, lvl, fmt)     fmt,
+#define NAND_LOG_NAME_(id, lvl, fmt)    #id,
+#define NAND_LOG_LVL_(id, lvl, fmt)     NAND_LOG_##lvl,
+
+static const char *const nand_log_fmt[NAND_EVT_COUNT] =
+{
+	NAND_LOG_EVENTS(NAND_LOG_FMT_)
+};
+
+static const char *const nand_log_name[NAND_EVT_COUNT] =
+{
+	NAND_LOG_EVENTS(NAND_LOG_NAME_)
+};
+
+static const uint8_t nand_log_level[NAND_EVT_COUNT] =
+{
+	NAND_LOG_EVENTS(NAND_LOG_LVL_)
+};
+
+/* ---------------------------------------------------------------------------
+ * Trace ring
+ * ---------------------------------------------------------------------------
+ * Target : .nand_trace (NOLOAD) at the start of RAM_D3, readable by the CM4
+ *          at NAND_LOG_SHARED_ADDR. Contents are random after power-up, the
+ *          first write (or NandLog_Init) formats it.
+ * Host   : Plain static ring.
+ * --------------------------------------------------------------------------- */
+#if defined(SCB_CCR_DC_Msk)
+#define NAND_LOG_SECTION    __attribute__((section(".nand_trace"), aligned(32)))
+#else
+#define NAND_LOG_SECTION    __attribute__((aligned(32)))
+#endif
+
+#if (NAND_LOG_SLOTS & (NAND_LOG_SLOTS - 1)) != 0
+#error "NAND_LOG_SLOTS must be a power of 2"
+#endif
+
+static NandLogRing_t nand_log_ring NAND_LOG_SECTION;
+
+/* ---------------------------------------------------------------------------
+ * Push one 32-byte line to RAM_D3 for the CM4 (no-op while D-Cache is off)
+ * --------------------------------------------------------------------------- */
+static inline void log_publish(const void *line)
+{
+#if defined(SCB_CCR_DC_Msk)
+	if (SCB->CCR & SCB_CCR_DC_Msk)
+		SCB_CleanDCache_by_Addr((uint32_t*) line, 32);
+#else
+	(void) line;
+#endif
+}
+
+/* ===========================================================================
+ * Function: NandLog_Init
+ * ===========================================================================
+ * @brief
+ *  - Format the trace ring and start the platform clock (timestamps).
+ *
+ * @note
+ *  - Call once on the CM7 before the first NAND operation. NandLog_Write
+ *    formats the ring itself if this was skipped.
+ * --------------------------------------------------------------------------- */
+void NandLog_Init(void)
+{
+	NandLogRing_t *ring = &nand_log_ring;
+
+	NandClock_Init();
+
+	memset(ring, 0, sizeof(*ring));
+	ring->slots = NAND_LOG_SLOTS;
+	ring->ticks_per_us = NandClock_TicksPerUs();
+	__atomic_store_n(&ring->magic, NAND_LOG_MAGIC, __ATOMIC_RELEASE);
+
+#if defined(SCB_CCR_DC_Msk)
+	if (SCB->CCR & SCB_CCR_DC_Msk)
+		SCB_CleanDCache_by_Addr((uint32_t*) ring, (int32_t) sizeof(*ring));
+#endif
+}
+
+/* ===========================================================================
+ * Function: NandLog_Write
+ * ===========================================================================
+ * @brief
+ *  - Record one event. Normally reached through NAND_LOG(ID, ...).
+ *
+ * @details
+ *  - TRACE backend: one atomic add reserves a slot, the record is filled,
+ *    then `seq` is published with release order. No lock, no interrupt
+ *    masking, ISR and thread producers may interleave.
+ *  - A full ring overwrites the oldest records; the consumer notices from
+ *    `seq` and counts them in ring->lost.
+ *  - PRINTF backend: formatted and printed immediately.
+ *
+ * @param id   : NandLogEvent_t
+ * @param argc : Number of arguments (clamped to NAND_LOG_MAX_ARGS)
+ * @param args : Arguments
+ * --------------------------------------------------------------------------- */
+void NandLog_Write(uint16_t id, uint8_t argc, const uint32_t *args)
+{
+	if (argc > NAND_LOG_MAX_ARGS)
+		argc = NAND_LOG_MAX_ARGS;
+
+#if NAND_LOG_BACKEND == NAND_LOG_BACKEND_PRINTF
+	const char *fmt = NandLog_Format(id);
+	uint32_t a[NAND_LOG_MAX_ARGS] = { 0 };
+
+	for (uint8_t i = 0; i < argc; i++)
+		a[i] = args[i];
+
+	printf(fmt, (unsigned int) a[0], (unsigned int) a[1], (unsigned int) a[2],
+			(unsigned int) a[3], (unsigned int) a[4]);
+	printf("\r\n");
+#else
+	NandLogRing_t *ring = &nand_log_ring;
+
+	if (__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != NAND_LOG_MAGIC)
+		NandLog_Init();
+
+	uint32_t idx = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+	NandLogRecord_t *r = &ring->rec[idx & (NAND_LOG_SLOTS - 1)];
+
+	/// Step 1: Invalidate the slot before touching the payload
+	__atomic_store_n(&r->seq, 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	/// Step 2: Payload
+	r->ts = NandClock_Ticks();
+	r->id = id;
+	r->level = (id < NAND_EVT_COUNT) ? nand_log_level[id] : NAND_LOG_ERROR;
+	r->argc = argc;
+	for (uint8_t i = 0; i < argc; i++)
+		r->arg[i] = args[i];
+
+	/// Step 3: Publish
+	__atomic_store_n(&r->seq, idx + 1, __ATOMIC_RELEASE);
+	log_publish(r);
+#endif
+}
+
+/* ===========================================================================
+ * Function: NandLog_Pop
+ * ===========================================================================
+ * @brief
+ *  - Take the oldest unread record of `ring` (single consumer).
+ *
+ * @details
+ *  - Only `seq` of the slots is inspected, producer state (head) is not
+ *    needed: the CM4 can drain the ring at NAND_LOG_SHARED_ADDR.
+ *  - seq == tail + 1 : record ready, copied, then `seq` checked again in
+ *                      case a producer lapped the consumer during the copy.
+ *  - seq newer       : slot overwritten, skip to the oldest record still
+ *                      in the ring and add the gap to ring->lost.
+ *  - otherwise       : nothing (or a record still being written).
+ *
+ * @return
+ *  - true  : *out holds a record
+ *  - false : Ring empty
+ * --------------------------------------------------------------------------- */
+bool NandLog_Pop(NandLogRing_t *ring, NandLogRecord_t *out)
+{
+	if (ring == NULL || ring->magic != NAND_LOG_MAGIC || ring->slots == 0)
+		return false;
+
+	uint32_t mask = ring->slots - 1;
+
+	for (;;)
+	{
+		uint32_t tail = ring->tail;
+		NandLogRecord_t *r = &ring->rec[tail & mask];
+		uint32_t seq = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+
+		if (seq == tail + 1)
+		{
+			*out = *r;
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (__atomic_load_n(&r->seq, __ATOMIC_RELAXED) == seq)
+			{
+				ring->tail = tail + 1;
+				return true;
+			}
+		}
+		else if (seq == 0 || (int32_t) (seq - (tail + 1)) < 0)
+		{
+			return false;
+		}
+
+		/// Lapped: oldest record still present is (current seq - slots)
+		seq = __atomic_load_n(&r->seq, __ATOMIC_RELAXED);
+		uint32_t oldest = ((int32_t) (seq - (tail + 1)) > 0) ? seq - ring->slots : tail + 1;
+
+		if ((int32_t) (oldest - tail) <= 0)
+			oldest = tail + 1;
+
+		ring->lost += oldest - tail;
+		ring->tail = oldest;
+	}
+}
+
+NandLogRing_t* NandLog_Ring(void)
+{
+	return &nand_log_ring;
+}
+
+const char* NandLog_Format(uint16_t id)
+{
+	return (id < NAND_EVT_COUNT) ? nand_log_fmt[id] : "[Log] Unknown event";
+}
+
+const char* NandLog_EventName(uint16_t id)
+{
+	return (id < NAND_EVT_COUNT) ? nand_log_name[id] : "UNKNOWN";
+}
+
+/* ===========================================================================
+ * Function: NandLog_Drain
+ * ===========================================================================
+ * @brief
+ *  - Print up to `max` pending records as text (CM7 idle loop).
+ *
+ * @param max : Record budget of this call (0 -> everything pending)
+ *
+ * @return
+ *  - Number of records printed
+ * --------------------------------------------------------------------------- */
+uint32_t NandLog_Drain(uint32_t max)
+{
+	NandLogRing_t *ring = &nand_log_ring;
+	NandLogRecord_t rec;
+	uint32_t lost = ring->lost;
+	uint32_t n = 0;
+
+	while ((max == 0 || n < max) && NandLog_Pop(ring, &rec))
+	{
+		if (ring->lost != lost)
+		{
+			printf(NandLog_Format(NAND_EVT_LOG_LOST),
+					(unsigned int) (ring->lost - lost));
+			printf("\r\n");
+			lost = ring->lost;
+		}
+
+		printf(NandLog_Format(rec.id), (unsigned int) rec.arg[0],
+				(unsigned int) rec.arg[1], (unsigned int) rec.arg[2],
+				(unsigned int) rec.arg[3], (unsigned int) rec.arg[4]);
+		printf("\r\n");
+		n++;
+	}
+
+	return n;
+}
+
+/* ===========================================================================
+ * Function: NandLog_Dump
+ * ===========================================================================
+ * @brief
+ *  - Print every pending record as one hex line for the host decoder.
+ *
+ * @details
+ *  - Format (Tools/nand_trace_decode.py):
+ *      #NLOG BEGIN tpu=<ticks per us> slots=<n> lost=<n>
+ *      #NLOG <seq> <ts> <id> <level> <argc> <arg0> .. <arg4>
+ *      #NLOG END count=<n> lost=<n>
+ *  - ~60 characters per record instead of a formatted line, and the
+ *    records are removed from the ring.
+ *
+ * @return
+ *  - Number of records dumped
+ * --------------------------------------------------------------------------- */
+uint32_t NandLog_Dump(void)
+{
+	NandLogRing_t *ring = &nand_log_ring;
+	NandLogRecord_t rec;
+	uint32_t n = 0;
+
+	printf("#NLOG BEGIN tpu=%lu slots=%lu lost=%lu\r\n",
+			(unsigned long) ring->ticks_per_us, (unsigned long) ring->slots,
+			(unsigned long) ring->lost);
+
+	while (NandLog_Pop(ring, &rec))
+	{
+		printf("#NLOG %08lX %08lX %04X %u %u %08lX %08lX %08lX %08lX %08lX\r\n",
+				(unsigned long) rec.seq, (unsigned long) rec.ts, rec.id,
+				rec.level, rec.argc, (unsigned long) rec.arg[0],
+				(unsigned long) rec.arg[1], (unsigned long) rec.arg[2],
+				(unsigned long) rec.arg[3], (unsigned long) rec.arg[4]);
+		n++;
+	}
+
+	printf("#NLOG END count=%lu lost=%lu\r\n", (unsigned long) n,
+			(unsigned long) ring->lost);
+
+	return n;
+}
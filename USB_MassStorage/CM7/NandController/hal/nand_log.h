@@ -0,0 +1,225 @@
+/*
+ *  nand_log.h
+ *
+ *  Created on: Nov 10, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#ifndef HAL_NAND_LOG_H_
+#define HAL_NAND_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------------------------------------------------------------------------
+ * Log Level
+ * ---------------------------------------------------------------------------
+ * NAND_LOG_LEVEL : Events above this level are removed at compile time
+ *                  (no code, no argument evaluation).
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_OFF        0
+#define NAND_LOG_ERROR      1
+#define NAND_LOG_WARN       2
+#define NAND_LOG_INFO       3
+#define NAND_LOG_DEBUG      4
+
+#ifndef NAND_LOG_LEVEL
+#define NAND_LOG_LEVEL      NAND_LOG_INFO
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Log Backend
+ * ---------------------------------------------------------------------------
+ * NAND_LOG_BACKEND_TRACE  : Binary record into the trace ring (~50 cycles),
+ *                           text produced later by NandLog_Drain() in idle
+ *                           time, by the CM4, or by the host decoder
+ *                           (Tools/nand_trace_decode.py).
+ * NAND_LOG_BACKEND_PRINTF : printf immediately (bring-up, old behaviour).
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_BACKEND_TRACE   0
+#define NAND_LOG_BACKEND_PRINTF  1
+
+#ifndef NAND_LOG_BACKEND
+#define NAND_LOG_BACKEND    NAND_LOG_BACKEND_TRACE
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Event Table
+ * ---------------------------------------------------------------------------
+ * X(ID, LEVEL, "format")
+ *  - Format strings stay in flash, only the event id and up to
+ *    NAND_LOG_MAX_ARGS 32-bit arguments are recorded.
+ *  - Conversions: %u %d %x %X (with width / 0 flag) on 32-bit arguments.
+ *  - Append only: the id is the position in this table, and the host
+ *    decoder reads this table from this file.
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_EVENTS(X) \
+	X(LOG_LOST,            WARN,  "[Log] %u records lost (ring overrun)") \
+	X(READ_TIMEOUT,        ERROR, "[Read] Timeout... Status is Busy. (Page = 0x%05X)") \
+	X(READ_ECC_OK,         DEBUG, "[Status] ECC_SUCCESS (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(READ_ECC_CORRECTED,  INFO,  "[Status] ECC_SUCCESS_CORRECTED (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(READ_ECC_THRESHOLD,  WARN,  "[Status] ECC_CORRECTED_THRESHOLD (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(READ_ECC_FAIL,       ERROR, "[Status] ECC_UNCORRECTABLE (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(READ_ECC_RESERVED,   ERROR, "[Status] ECC_RESERVED (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(PROGRAM_OK,          DEBUG, "[Program] Success (Page = 0x%05X Col = 0x%04X Len = %u)") \
+	X(PROGRAM_FAIL,        ERROR, "[Program] Failed (Page = 0x%05X P_Fail = %u, WEL = %u)") \
+	X(ERASE_UNLOCK_FAIL,   ERROR, "[Block Erase] Failed to unlock all Blocks") \
+	X(ERASE_TIMEOUT,       ERROR, "[Block Erase] Timeout (Block = %u)") \
+	X(ERASE_OK,            DEBUG, "[Block Erase] Success (Block = %u)") \
+	X(ERASE_FAIL,          ERROR, "[Block Erase] Failed (Block = %u, E-FAIL = 1, SR3 = 0x%02X)") \
+	X(ERASE_WEL_SET,       ERROR, "[Block Erase] Failed (Block = %u, WEL not cleared, SR3 = 0x%02X)") \
+	X(WEL_OK,              DEBUG, "[Write Enable] Write Enable Success (WEL = 1)") \
+	X(WEL_FAIL,            ERROR, "[Write Enable] Write Enable Failed  (WEL = 0)") \
+	X(WEL_CLEAR_OK,        DEBUG, "[Write Disable] Write Disable Success (WEL = 0)") \
+	X(WEL_CLEAR_FAIL,      ERROR, "[Write Disable] Write Disable Failed  (WEL = 1)") \
+	X(BP_SET_OK,           DEBUG, "[Set Block Protect] Success (BP=0x%X, TB=%u)") \
+	X(BP_SET_FAIL,         ERROR, "[Set Block Protect] Failed (Expect BP=0x%X, TB=%u / Got BP=0x%X, TB=%u)") \
+	X(READMODE_SET_OK,     DEBUG, "[SET ReadMode] Success (BUF=%u, ECC-E=%u)") \
+	X(READMODE_SET_FAIL,   ERROR, "[SET ReadMode] Failed (Expect BUF=%u,ECC-E=%u / Got BUF=%u,ECC-E=%u)") \
+	X(WAIT_TIMEOUT,        ERROR, "[OIP Status: 1] Timeout, device still busy (op = %u, %u us, SR3 = 0x%02X)") \
+	X(ECC_RESERVED_CODE,   WARN,  "[Warning] ECC Reserved code : 0b%03u (SR3 = 0x%02X)") \
+	X(RESET_OK,            INFO,  "[Device Reset] Success") \
+	X(RESET_TIMEOUT,       ERROR, "[Device Reset] Timeout") \
+	X(SW_RESET_OK,         INFO,  "[Software Reset] Success") \
+	X(SW_RESET_TIMEOUT,    ERROR, "[Software Reset] Timeout") \
+	X(BBT_MARK_TIMEOUT,    ERROR, "[Invalid Table] Timeout while marking bad block (Block = %u)") \
+	X(BBT_MARK_FAIL,       ERROR, "[Invalid Table] Failed to program bad block marker (Block = %u)") \
+	X(BBT_MARK_OK,         INFO,  "[Invalid Table] Permanent marker written (Block:%u)") \
+	X(SR_SHADOW_MISMATCH,  WARN,  "[SR Shadow] Mismatch (SR = 0x%02X, Written = 0x%02X, Read = 0x%02X)") \
+	X(CONTREAD_CLOSE,      DEBUG, "[Continuous Read] Closed (Pages = %u, Commands = %u, Reloads = %u, Failed = %u)") \
+	X(COPY_OK,             DEBUG, "[Copy Page] Success (Src = 0x%05X, Dst = 0x%05X, Src ECC = %u, Patches = %u)") \
+	X(COPY_SOURCE_FAIL,    ERROR, "[Copy Page] Source ECC uncorrectable, not programmed (Src = 0x%05X, Dst = 0x%05X)") \
+	X(BBT_LOAD_OK,         INFO,  "[Invalid Table] Loaded (Block = %u, Seq = %u, Bad = %u, Journal = %u)") \
+	X(BBT_LOAD_NONE,       WARN,  "[Invalid Table] No valid on-flash copy") \
+	X(BBT_SAVE_OK,         INFO,  "[Invalid Table] Saved (Seq = %u, Bad = %u, Copies = %u)") \
+	X(BBT_STORE_FAIL,      ERROR, "[Invalid Table] Copy write failed (Block = %u, Seq = %u)") \
+	X(BBT_STORE_REPAIR,    WARN,  "[Invalid Table] Copy out of sync, rewriting (Block = %u, Seq = %u)") \
+	X(BBT_LAZY_START,      INFO,  "[Invalid Table] No saved table, %u blocks verified lazily") \
+	X(BBT_LAZY_DONE,       INFO,  "[Invalid Table] Background verification complete (Bad = %u)") \
+	X(REMAP_LOAD_OK,       INFO,  "[Remap] Map loaded (Seq = %u, Mapped = %u)") \
+	X(REMAP_ASSIGN,        WARN,  "[Remap] Block %u moved (Physical %u -> Spare %u)") \
+	X(REMAP_MIGRATE,       INFO,  "[Remap] Block %u migrated (Pages = %u, Copy-back = %u, Through RAM = %u)") \
+	X(REMAP_POOL_EMPTY,    ERROR, "[Remap] Spare pool exhausted (Block = %u)") \
+	X(REMAP_STORE_FAIL,    ERROR, "[Remap] Map copy write failed (Block = %u, Seq = %u)") \
+	X(FTL_MOUNT,           INFO,  "[FTL] Mounted (Sectors = %u, Power loss recovered = %u)") \
+	X(FTL_READ_FAIL,       ERROR, "[FTL] Read failed (LBA = %u, Sectors left = %u)") \
+	X(FTL_WRITE_FAIL,      ERROR, "[FTL] Write failed (LBA = %u, Sectors left = %u)") \
+	X(FTL_FORMAT,          WARN,  "[FTL] No checkpoint, formatted (Pages = %u, Generation = %u)") \
+	X(FTL_REPLAY,          WARN,  "[FTL] Roll-forward (Blocks = %u, From seq = %u)") \
+	X(FTL_HYB_MOUNT,       INFO,  "[FTL] Hybrid mount (Log pages = %u, Merges completed = %u)") \
+	X(FTL_CKPT_FAIL,       ERROR, "[FTL] Checkpoint failed (Seq = %u, Block = %u)") \
+	X(FTL_BLOCK_RETIRE,    WARN,  "[FTL] Block %u retired (Pages moved = %u)") \
+	X(HAL_DMA_READ_FAIL,   WARN,  "[NAND HAL] DMA CmdRead failed, fallback to polling (Len = %u)") \
+	X(HAL_DMA_WRITE_FAIL,  WARN,  "[NAND HAL] DMA CmdWrite failed, fallback to polling (Len = %u)") \
+	X(FTL_CKPT_BAD,        WARN,  "[FTL] Checkpoint block %u failed, marked bad") \
+	X(FTL_CKPT_LOST,       ERROR, "[FTL] Checkpoint lost, not mounted (Generation = %u)")
+
+#define NAND_LOG_ENUM_(id, lvl, fmt)    NAND_EVT_##id,
+#define NAND_LOG_LEVEL_(id, lvl, fmt)   NAND_EVT_LEVEL_##id = NAND_LOG_##lvl,
+
+typedef enum
+{
+	NAND_LOG_EVENTS(NAND_LOG_ENUM_)
+	NAND_EVT_COUNT
+} NandLogEvent_t;
+
+enum
+{
+	NAND_LOG_EVENTS(NAND_LOG_LEVEL_)
+};
+
+/* ---------------------------------------------------------------------------
+ * Trace Record / Ring (shared with the CM4 through RAM_D3)
+ * ---------------------------------------------------------------------------
+ * seq   : Reservation index + 1, written last (0 -> slot being written)
+ * ts    : NandClock_Ticks() (DWT cycles on target, ns on the simulator)
+ * id    : NandLogEvent_t
+ * argc  : Valid entries of arg[]
+ *
+ * One record = one 32-byte D-Cache line, the ring sits at the start of
+ * RAM_D3 (NAND_LOG_SHARED_ADDR) so the CM4 can drain it with this header.
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_MAX_ARGS     5
+
+#ifndef NAND_LOG_SLOTS
+#define NAND_LOG_SLOTS        256   // Power of 2
+#endif
+
+#define NAND_LOG_MAGIC        0x474F4C4EU   // "NLOG"
+#define NAND_LOG_SHARED_ADDR  0x38000000U   // RAM_D3, section .nand_trace
+
+typedef struct
+{
+	uint32_t seq;
+	uint32_t ts;
+	uint16_t id;
+	uint8_t level;
+	uint8_t argc;
+	uint32_t arg[NAND_LOG_MAX_ARGS];
+} NandLogRecord_t;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t slots;
+	uint32_t ticks_per_us;
+	uint32_t head;          // Next reservation index (producers)
+	uint32_t tail;          // Next index to drain (single consumer)
+	uint32_t lost;          // Records overwritten before drained
+	uint32_t reserved[2];
+	NandLogRecord_t rec[NAND_LOG_SLOTS];
+} NandLogRing_t;
+
+/* ---------------------------------------------------------------------------
+ * NAND_LOG(ID, args...)
+ * ---------------------------------------------------------------------------
+ *  - Level taken from the event table, compared against NAND_LOG_LEVEL by
+ *    the compiler: disabled events leave nothing behind.
+ *  - Arguments are converted to uint32_t (at most NAND_LOG_MAX_ARGS).
+ * --------------------------------------------------------------------------- */
+#define NAND_LOG_NARG(...)  NAND_LOG_NARG_(0, ##__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define NAND_LOG_NARG_(_0, _1, _2, _3, _4, _5, N, ...)  N
+
+#define NAND_LOG(id, ...) \
+	do \
+	{ \
+		if (NAND_EVT_LEVEL_##id <= NAND_LOG_LEVEL) \
+			NandLog_Write(NAND_EVT_##id, NAND_LOG_NARG(__VA_ARGS__), \
+					(const uint32_t[]){ 0, ##__VA_ARGS__ } + 1); \
+	} while (0)
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * NandLog_Init
+ *  - Reset the ring (CM7 only), start the platform clock.
+ *
+ * NandLog_Write
+ *  - Record one event (lock-free, thread / ISR safe). Use NAND_LOG().
+ *
+ * NandLog_Pop
+ *  - Take the oldest record of a ring (single consumer, CM7 or CM4).
+ *
+ * NandLog_Drain
+ *  - Pop up to `max` records and print them as text (idle loop).
+ *
+ * NandLog_Dump
+ *  - Print pending records as hex lines for nand_trace_decode.py.
+ *
+ * NandLog_Format / NandLog_EventName
+ *  - Event table lookup.
+ * ------------------------------------------------------------------------- */
+void NandLog_Init(void);
+void NandLog_Write(uint16_t id, uint8_t argc, const uint32_t *args);
+
+NandLogRing_t* NandLog_Ring(void);
+bool NandLog_Pop(NandLogRing_t *ring, NandLogRecord_t *out);
+uint32_t NandLog_Drain(uint32_t max);
+uint32_t NandLog_Dump(void);
+
+const char* NandLog_Format(uint16_t id);
+const char* NandLog_EventName(uint16_t id);
+
+#endif /* HAL_NAND_LOG_H_ */
@@ -0,0 +1,332 @@
+/*
+ *  nand_qspi.c
+ *
+ *  Created on: Oct 30, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#include "nand_qspi.h"
+
+#ifdef HAL_QSPI_MODULE_ENABLED
+
+/* ---------------------------------------------------------------------------
+ * Line / size encoding (HAL constants)
+ * --------------------------------------------------------------------------- */
+static uint32_t qspi_addr_mode(uint8_t lines)
+{
+	switch (lines)
+	{
+	case 1:
+		return QSPI_ADDRESS_1_LINE;
+	case 2:
+		return QSPI_ADDRESS_2_LINES;
+	case 4:
+		return QSPI_ADDRESS_4_LINES;
+	default:
+		return QSPI_ADDRESS_NONE;
+	}
+}
+
+static uint32_t qspi_data_mode(uint8_t lines)
+{
+	switch (lines)
+	{
+	case 1:
+		return QSPI_DATA_1_LINE;
+	case 2:
+		return QSPI_DATA_2_LINES;
+	case 4:
+		return QSPI_DATA_4_LINES;
+	default:
+		return QSPI_DATA_NONE;
+	}
+}
+
+static const uint32_t qspi_addr_size[4] =
+{ QSPI_ADDRESS_8_BITS, QSPI_ADDRESS_16_BITS, QSPI_ADDRESS_24_BITS, QSPI_ADDRESS_32_BITS };
+
+/* ---------------------------------------------------------------------------
+ * qspi_config
+ *  - Program CCR / AR / DLR through HAL_QSPI_Command.
+ *  - With a data phase the HAL leaves FMODE = indirect write and does not
+ *    start the transfer, the caller switches FMODE and drains/fills DR.
+ * --------------------------------------------------------------------------- */
+static void qspi_fill(QSPI_CommandTypeDef *c, const NandLineCmd_t *cmd,
+		uint32_t addr, uint32_t len)
+{
+	memset(c, 0, sizeof(*c));
+
+	c->InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	c->Instruction = cmd->opcode;
+	c->AddressMode = qspi_addr_mode(cmd->addr_lines);
+	c->AddressSize = qspi_addr_size[(cmd->addr_bytes ? cmd->addr_bytes : 1) - 1];
+	c->Address = addr;
+	c->AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+	c->DummyCycles = cmd->dummy_cycles;
+	c->DataMode = len ? qspi_data_mode(cmd->data_lines) : QSPI_DATA_NONE;
+	c->NbData = len;
+	c->DdrMode = QSPI_DDR_MODE_DISABLE;
+	c->DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+	c->SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+}
+
+static bool qspi_config(QSPI_HandleTypeDef *hq, const NandLineCmd_t *cmd,
+		uint32_t addr, uint32_t len)
+{
+	QSPI_CommandTypeDef c;
+
+	qspi_fill(&c, cmd, addr, len);
+	return HAL_QSPI_Command(hq, &c, NAND_QSPI_TIMEOUT) == HAL_OK;
+}
+
+static bool qspi_wait_tc(QSPI_HandleTypeDef *hq, uint32_t start)
+{
+	QUADSPI_TypeDef *q = hq->Instance;
+
+	while (!(q->SR & QUADSPI_SR_TCF))
+	{
+		if ((HAL_GetTick() - start) >= NAND_QSPI_TIMEOUT)
+		{
+			HAL_QSPI_Abort(hq);
+			return false;
+		}
+	}
+
+	q->FCR = QUADSPI_FCR_CTCF;
+	return true;
+}
+
+/* ===========================================================================
+ * Function: HAL_QSPI_NandRead
+ * ===========================================================================
+ * @brief
+ *  - Indirect read through QUADSPI with the line widths in `cmd`.
+ *
+ * @details
+ *  - HAL_QSPI_Receive moves one byte per FIFO access. At 96 MHz x 4 lines
+ *    that is ~48 M accesses/s, so the FIFO is drained as 32-bit words while
+ *    FLEVEL >= 4 and only the tail uses byte access.
+ *
+ * @param hq   : QUADSPI handle.
+ * @param cmd  : Command descriptor.
+ * @param addr : Column address.
+ * @param buf  : [out] Data buffer.
+ * @param len  : Number of bytes.
+ *
+ * @return
+ *  - true  : Transfer complete.
+ *  - false : HAL error or timeout.
+ * --------------------------------------------------------------------------- */
+bool HAL_QSPI_NandRead(QSPI_HandleTypeDef *hq, const NandLineCmd_t *cmd,
+		uint32_t addr, uint8_t *buf, uint32_t len)
+{
+	QUADSPI_TypeDef *q = hq->Instance;
+
+	if (len == 0 || !qspi_config(hq, cmd, addr, len))
+		return false;
+
+	uint32_t start = HAL_GetTick();
+
+	/// FMODE = indirect read, re-write AR to trigger the transfer
+	uint32_t ar = q->AR;
+	MODIFY_REG(q->CCR, QUADSPI_CCR_FMODE, QUADSPI_CCR_FMODE_0);
+	q->AR = ar;
+
+	while (len)
+	{
+		uint32_t level = (q->SR & QUADSPI_SR_FLEVEL) >> QUADSPI_SR_FLEVEL_Pos;
+
+		if (len >= 4 && level >= 4)
+		{
+			uint32_t w = *(__IO uint32_t*) &q->DR;
+			memcpy(buf, &w, 4);
+			buf += 4;
+			len -= 4;
+		}
+		else if (len < 4 && level >= 1)
+		{
+			*buf++ = *(__IO uint8_t*) &q->DR;
+			len--;
+		}
+		else if ((HAL_GetTick() - start) >= NAND_QSPI_TIMEOUT)
+		{
+			HAL_QSPI_Abort(hq);
+			return false;
+		}
+	}
+
+	return qspi_wait_tc(hq, start);
+}
+
+/* ===========================================================================
+ * Function: HAL_QSPI_NandWrite
+ * ===========================================================================
+ * @brief
+ *  - Indirect write through QUADSPI with the line widths in `cmd`.
+ *
+ * @param hq   : QUADSPI handle.
+ * @param cmd  : Command descriptor.
+ * @param addr : Column / page address.
+ * @param buf  : [in] Data buffer (NULL when len = 0).
+ * @param len  : Number of bytes, 0 -> command + address only.
+ *
+ * @return
+ *  - true  : Transfer complete.
+ *  - false : HAL error or timeout.
+ * --------------------------------------------------------------------------- */
+bool HAL_QSPI_NandWrite(QSPI_HandleTypeDef *hq, const NandLineCmd_t *cmd,
+		uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+	QUADSPI_TypeDef *q = hq->Instance;
+
+	if (!qspi_config(hq, cmd, addr, len))
+		return false;
+
+	/// No data phase: HAL_QSPI_Command already waited for TCF
+	if (len == 0)
+		return true;
+
+	uint32_t start = HAL_GetTick();
+
+	while (len)
+	{
+		uint32_t level = (q->SR & QUADSPI_SR_FLEVEL) >> QUADSPI_SR_FLEVEL_Pos;
+
+		if (len >= 4 && level <= 28)
+		{
+			uint32_t w;
+			memcpy(&w, buf, 4);
+			*(__IO uint32_t*) &q->DR = w;
+			buf += 4;
+			len -= 4;
+		}
+		else if (len < 4 && level < 32)
+		{
+			*(__IO uint8_t*) &q->DR = *buf++;
+			len--;
+		}
+		else if ((HAL_GetTick() - start) >= NAND_QSPI_TIMEOUT)
+		{
+			HAL_QSPI_Abort(hq);
+			return false;
+		}
+	}
+
+	return qspi_wait_tc(hq, start);
+}
+
+/* ===========================================================================
+ * Function: HAL_QSPI_NandHeader
+ * ===========================================================================
+ * @brief
+ *  - Send a pre-packed SPI header over QUADSPI in single-line mode.
+ *
+ * @details
+ *  - hdr[0] becomes the instruction, hdr[1..] (max 4 bytes, dummy bytes
+ *    included) becomes a single-line address phase. This keeps the existing
+ *    byte-array drivers working unchanged on the QUADSPI bus.
+ *
+ * @param hq      : QUADSPI handle.
+ * @param hdr     : Header bytes [opcode + address / dummy].
+ * @param hdr_len : 1 ~ 5.
+ * @param rx      : [out] Read data (NULL for write / command).
+ * @param tx      : [in]  Write data (NULL for read / command).
+ * @param len     : Data length.
+ * --------------------------------------------------------------------------- */
+bool HAL_QSPI_NandHeader(QSPI_HandleTypeDef *hq, const uint8_t *hdr,
+		uint16_t hdr_len, uint8_t *rx, const uint8_t *tx, uint32_t len)
+{
+	if (hdr_len == 0 || hdr_len > 5)
+		return false;
+
+	NandLineCmd_t cmd = { hdr[0], hdr_len > 1 ? 1 : 0, (uint8_t) (hdr_len - 1), 0, 1 };
+	uint32_t addr = 0;
+
+	for (uint16_t i = 1; i < hdr_len; i++)
+		addr = (addr << 8) | hdr[i];
+
+	if (rx != NULL)
+		return HAL_QSPI_NandRead(hq, &cmd, addr, rx, len);
+
+	return HAL_QSPI_NandWrite(hq, &cmd, addr, tx, tx ? len : 0);
+}
+
+/* ---------------------------------------------------------------------------
+ * QUADSPI transport backend (ctx = QSPI_HandleTypeDef*)
+ * --------------------------------------------------------------------------- */
+static bool qspi_command(void *ctx, const uint8_t *cmd, uint16_t cmd_len)
+{
+	return HAL_QSPI_NandHeader(ctx, cmd, cmd_len, NULL, NULL, 0);
+}
+
+static bool qspi_read(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		uint8_t *buf, uint16_t len)
+{
+	return HAL_QSPI_NandHeader(ctx, cmd, cmd_len, buf, NULL, len);
+}
+
+static bool qspi_write(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		const uint8_t *buf, uint16_t len)
+{
+	return HAL_QSPI_NandHeader(ctx, cmd, cmd_len, NULL, buf, len);
+}
+
+static bool qspi_read_wide(void *ctx, const NandLineCmd_t *cmd, uint32_t addr,
+		uint8_t *buf, uint16_t len)
+{
+	return HAL_QSPI_NandRead(ctx, cmd, addr, buf, len);
+}
+
+static bool qspi_write_wide(void *ctx, const NandLineCmd_t *cmd, uint32_t addr,
+		const uint8_t *buf, uint16_t len)
+{
+	return HAL_QSPI_NandWrite(ctx, cmd, addr, buf, len);
+}
+
+/* ===========================================================================
+ * Function: qspi_wait_ready
+ * ===========================================================================
+ * @brief
+ *  - Hardware status polling: QUADSPI repeats 05h C0h on its own until
+ *    SR3[BUSY] = 0 (status-match mode, automatic stop).
+ *
+ * @details
+ *  - No CPU / bus traffic per poll, the interval is NAND_QSPI_POLL_INTERVAL
+ *    QUADSPI clocks. The matched status byte stays in DR.
+ *  - HAL timeout is in ms, the engine's microsecond budget is rounded up.
+ * --------------------------------------------------------------------------- */
+static bool qspi_wait_ready(void *ctx, uint32_t timeout_us, uint8_t *sr3)
+{
+	static const NandLineCmd_t read_sr3 = { 0x05, 1, 1, 0, 1 };
+	QSPI_HandleTypeDef *hq = ctx;
+	QSPI_CommandTypeDef c;
+	QSPI_AutoPollingTypeDef poll = { 0 };
+
+	qspi_fill(&c, &read_sr3, 0xC0, 1);
+
+	poll.Match = 0x00;
+	poll.Mask = NAND_SR3_BUSY;
+	poll.MatchMode = QSPI_MATCH_MODE_AND;
+	poll.StatusBytesSize = 1;
+	poll.Interval = NAND_QSPI_POLL_INTERVAL;
+	poll.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+
+	if (HAL_QSPI_AutoPolling(hq, &c, &poll, (timeout_us + 999U) / 1000U + 1U)
+			!= HAL_OK)
+	{
+		HAL_QSPI_Abort(hq);
+		*sr3 = NAND_SR3_BUSY;
+		return false;
+	}
+
+	*sr3 = (uint8_t) READ_REG(hq->Instance->DR);
+	return true;
+}
+
+const NandTransport_t NandTransport_QSPI =
+{ "QUADSPI", qspi_command, qspi_read, qspi_write, qspi_read_wide,
+		qspi_write_wide, qspi_wait_ready };
+
+#endif /* HAL_QSPI_MODULE_ENABLED */
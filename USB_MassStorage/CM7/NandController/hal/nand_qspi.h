@@ -0,0 +1,48 @@
+/*
+ *  nand_qspi.h
+ *
+ *  Created on: Oct 30, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#ifndef HAL_NAND_QSPI_H_
+#define HAL_NAND_QSPI_H_
+
+#include "nand_hal.h"
+
+#ifdef HAL_QSPI_MODULE_ENABLED
+
+extern QSPI_HandleTypeDef hqspi;
+
+#define NAND_QSPI_TIMEOUT        10   // ms
+#define NAND_QSPI_POLL_INTERVAL  16   // Status-match interval (QUADSPI clocks)
+
+/* QUADSPI transport backend, ctx = QSPI_HandleTypeDef* (/CS = PB6)
+ * wait_ready = status-match auto-polling (NAND_READY_AUTO)
+ * Needs the NAND rewired to the QUADSPI bank 1 pins (see quadspi.c), the
+ * stock board has it on SPI2 */
+extern const NandTransport_t NandTransport_QSPI;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * HAL_QSPI_NandRead
+ *  - Indirect read, 32-bit FIFO drain.
+ *
+ * HAL_QSPI_NandWrite
+ *  - Indirect write (len = 0 -> command / address only).
+ *
+ * HAL_QSPI_NandHeader
+ *  - Run a pre-packed single-line SPI header [opcode + 0~4 bytes] followed
+ *    by an optional single-line data phase. Lets the byte-array drivers run
+ *    unchanged on QUADSPI.
+ * ------------------------------------------------------------------------- */
+bool HAL_QSPI_NandRead(QSPI_HandleTypeDef *hq, const NandLineCmd_t *cmd, uint32_t addr, uint8_t *buf, uint32_t len);
+bool HAL_QSPI_NandWrite(QSPI_HandleTypeDef *hq, const NandLineCmd_t *cmd, uint32_t addr, const uint8_t *buf, uint32_t len);
+bool HAL_QSPI_NandHeader(QSPI_HandleTypeDef *hq, const uint8_t *hdr, uint16_t hdr_len, uint8_t *rx, const uint8_t *tx, uint32_t len);
+
+#endif /* HAL_QSPI_MODULE_ENABLED */
+
+#endif /* HAL_NAND_QSPI_H_ */
@@ -0,0 +1,235 @@
+/*
+ *  nand_ready.c
+ *
+ *  Created on: Nov 8, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#include "nand_ready.h"
+
+/* ---------------------------------------------------------------------------
+ * W25N02KV timing (Datasheet 9.6, AC Electrical Characteristics)
+ * ---------------------------------------------------------------------------
+ * tRD  : 25 us typ (ECC on), 60 us max
+ * tPP  : 250 us typ, 700 us max
+ * tBE  : 2 ms typ, 10 ms max
+ * tRST : 5 us (idle) ~ 500 us (during erase)
+ * --------------------------------------------------------------------------- */
+static NandOpTiming_t nand_timing[NAND_OP_COUNT] =
+{
+	[NAND_OP_READ]    = { 25,    60,    2  },
+	[NAND_OP_PROGRAM] = { 250,   700,   10 },
+	[NAND_OP_ERASE]   = { 2000,  10000, 50 },
+	[NAND_OP_RESET]   = { 5,     500,   5  },
+	[NAND_OP_GENERIC] = { 0,     10000, 0  },
+};
+
+static NandReadyMode_t nand_ready_mode = NAND_READY_DELAY_POLL;
+static NandReadyStats_t nand_ready_stats;
+static bool nand_clock_ready = false;
+
+/* ===========================================================================
+ * Function: Nand_WaitReadyOp
+ * ===========================================================================
+ * @brief
+ *  - Wait until the array operation `op` has finished (SR3[BUSY] = 0).
+ *
+ * @details
+ *  - Timeout is counted on the platform clock (DWT cycles on target), so a
+ *    25 us tRD is no longer rounded to a 1 ms HAL tick.
+ *  - DELAY_POLL / AUTO first sleep NAND_READY_MIN_PCT % of the typical time:
+ *    no SR3 traffic while the device certainly is busy. The remaining wait
+ *    polls every poll_us, or runs in the transport's hardware status polling
+ *    (AUTO).
+ *  - Built on Nand_ReadyBegin / Nand_ReadyPoll, sleeping between the steps.
+ *  - Nothing is printed, the caller decides what a timeout means.
+ *
+ * @param op         : Operation just issued (timing profile).
+ * @param timeout_us : Timeout, 0 -> default of the operation.
+ * @param sr3        : [out] SR3 value that ended the wait (NULL allowed).
+ *
+ * @return
+ *  - true  : Device ready, *sr3 holds the final SR3 (WEL / FAIL / ECC bits).
+ *  - false : Timeout or bus error, *sr3 holds the last value read.
+ * --------------------------------------------------------------------------- */
+bool Nand_WaitReadyOp(NandOp_t op, uint32_t timeout_us, uint8_t *sr3)
+{
+	NandReadyWait_t w;
+	NandWaitState_t st;
+	uint32_t next_us = 0;
+
+	Nand_ReadyBegin(&w, op, timeout_us);
+
+	while ((st = Nand_ReadyPoll(&w, true, &next_us)) == NAND_WAIT_PENDING)
+	{
+		if (next_us != 0)
+			NandClock_DelayUs(next_us);
+	}
+
+	if (sr3 != NULL)
+		*sr3 = w.sr3;
+
+	return (st == NAND_WAIT_READY);
+}
+
+/* ===========================================================================
+ * Function: Nand_ReadyBegin
+ * ===========================================================================
+ * @brief
+ *  - Start a wait for `op` issued just now (no bus traffic).
+ *
+ * @param w          : Wait context (caller storage)
+ * @param op         : Operation just issued (timing profile)
+ * @param timeout_us : Timeout, 0 -> max_us * NAND_READY_TIMEOUT_MUL
+ * --------------------------------------------------------------------------- */
+void Nand_ReadyBegin(NandReadyWait_t *w, NandOp_t op, uint32_t timeout_us)
+{
+	const NandOpTiming_t *t = &nand_timing[(op < NAND_OP_COUNT) ? op : NAND_OP_GENERIC];
+
+	if (!nand_clock_ready)
+	{
+		NandClock_Init();
+		nand_clock_ready = true;
+	}
+
+	uint32_t tpu = NandClock_TicksPerUs();
+
+	if (timeout_us == 0)
+		timeout_us = t->max_us * NAND_READY_TIMEOUT_MUL;
+
+	w->op = op;
+	w->start = NandClock_Ticks();
+	w->limit = timeout_us * tpu;
+	w->polls = 0;
+	w->sr3 = NAND_SR3_BUSY;
+
+	/// Minimum delay, device cannot be ready before this
+	w->next = (nand_ready_mode != NAND_READY_POLL && t->typ_us != 0) ?
+			((t->typ_us * NAND_READY_MIN_PCT) / 100) * tpu : 0;
+}
+
+/* ===========================================================================
+ * Function: Nand_ReadyPoll
+ * ===========================================================================
+ * @brief
+ *  - Advance a wait by at most one status check.
+ *
+ * @details
+ *  - Before the minimum delay / next poll slot: no bus traffic, *next_us =
+ *    time left until the slot.
+ *  - block = true and AUTO mode with a hardware polling transport: the
+ *    rest of the wait runs in the transport (blocking).
+ *  - Otherwise one SR3 read; busy -> next slot poll_us later (0 in POLL).
+ *
+ * @param w       : Wait context from Nand_ReadyBegin
+ * @param block   : Allow a blocking hardware wait
+ * @param next_us : [out] Microseconds until the next useful call
+ *
+ * @return
+ *  - NAND_WAIT_PENDING : Still busy
+ *  - NAND_WAIT_READY   : BUSY = 0, final SR3 in w->sr3
+ *  - NAND_WAIT_TIMEOUT : Timeout expired (or bus error at the end)
+ * --------------------------------------------------------------------------- */
+NandWaitState_t Nand_ReadyPoll(NandReadyWait_t *w, bool block, uint32_t *next_us)
+{
+	static const uint8_t command[2] = { 0x05, 0xC0 };   // Read Status Register-3
+	NandDevice_t *d = Nand_Dev();
+	const NandOpTiming_t *t = &nand_timing[(w->op < NAND_OP_COUNT) ? w->op : NAND_OP_GENERIC];
+	uint32_t tpu = NandClock_TicksPerUs();
+	uint32_t elapsed = NandClock_Ticks() - w->start;
+	NandWaitState_t st = NAND_WAIT_PENDING;
+
+	*next_us = 0;
+
+	/// Step 1: Minimum delay / poll interval not reached yet
+	if (elapsed < w->next)
+	{
+		*next_us = (w->next - elapsed + tpu - 1) / tpu;
+		return NAND_WAIT_PENDING;
+	}
+
+	w->polls++;
+
+	/// Step 2: Hardware status polling
+	if (block && nand_ready_mode == NAND_READY_AUTO && d->tr->wait_ready != NULL)
+	{
+		bool ready = d->tr->wait_ready(d->ctx,
+				(elapsed < w->limit) ? (w->limit - elapsed) / tpu : 1, &w->sr3);
+
+		st = ready ? NAND_WAIT_READY : NAND_WAIT_TIMEOUT;
+	}
+	/// Step 2: One software status read
+	else
+	{
+		uint8_t sr = NAND_SR3_BUSY;
+
+		if (d->tr->read(d->ctx, command, 2, &sr, 1))
+			w->sr3 = sr;
+
+		elapsed = NandClock_Ticks() - w->start;
+
+		if (!(w->sr3 & NAND_SR3_BUSY))
+			st = NAND_WAIT_READY;
+		else if (elapsed >= w->limit)
+			st = NAND_WAIT_TIMEOUT;
+		else if (nand_ready_mode != NAND_READY_POLL && t->poll_us != 0)
+		{
+			w->next = elapsed + t->poll_us * tpu;
+			*next_us = t->poll_us;
+		}
+		else
+			w->next = elapsed;
+	}
+
+	/// Step 3: Finished, keep last wait statistics
+	if (st != NAND_WAIT_PENDING)
+	{
+		nand_ready_stats.polls = w->polls;
+		nand_ready_stats.elapsed_us = (NandClock_Ticks() - w->start) / tpu;
+		if (st == NAND_WAIT_TIMEOUT)
+			nand_ready_stats.timeouts++;
+	}
+
+	return st;
+}
+
+/* ===========================================================================
+ * Function: Nand_SetReadyMode / Nand_GetReadyMode
+ * ===========================================================================
+ * @brief
+ *  - Select the polling schedule used by every service wait.
+ * --------------------------------------------------------------------------- */
+void Nand_SetReadyMode(NandReadyMode_t mode)
+{
+	nand_ready_mode = mode;
+}
+
+NandReadyMode_t Nand_GetReadyMode(void)
+{
+	return nand_ready_mode;
+}
+
+/* ===========================================================================
+ * Function: Nand_SetOpTiming / Nand_GetOpTiming
+ * ===========================================================================
+ * @brief
+ *  - Override typ / max / poll interval of one operation (e.g. tRD with
+ *    ECC disabled, or values measured on the actual part).
+ * --------------------------------------------------------------------------- */
+void Nand_SetOpTiming(NandOp_t op, const NandOpTiming_t *timing)
+{
+	if (op < NAND_OP_COUNT && timing != NULL)
+		nand_timing[op] = *timing;
+}
+
+const NandOpTiming_t* Nand_GetOpTiming(NandOp_t op)
+{
+	return &nand_timing[(op < NAND_OP_COUNT) ? op : NAND_OP_GENERIC];
+}
+
+const NandReadyStats_t* Nand_GetReadyStats(void)
+{
+	return &nand_ready_stats;
+}
@@ -0,0 +1,149 @@
+/*
+ *  nand_ready.h
+ *
+ *  Created on: Nov 8, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#ifndef HAL_NAND_READY_H_
+#define HAL_NAND_READY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nand_transport.h"
+
+/* ---------------------------------------------------------------------------
+ * Array Operation (selects the timing profile of a wait)
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	NAND_OP_READ = 0,      // 13h -> tRD
+	NAND_OP_PROGRAM,       // 10h -> tPP
+	NAND_OP_ERASE,         // D8h -> tBE
+	NAND_OP_RESET,         // FFh / 66h + 99h -> tRST
+	NAND_OP_GENERIC,       // Unknown, plain polling
+	NAND_OP_COUNT
+} NandOp_t;
+
+/* ---------------------------------------------------------------------------
+ * Ready Wait Mode
+ * ---------------------------------------------------------------------------
+ * NAND_READY_POLL       : Read SR3 back-to-back from the first microsecond
+ * NAND_READY_DELAY_POLL : Sleep typ * NAND_READY_MIN_PCT %, then read SR3
+ *                         every poll_us (DWT paced)
+ * NAND_READY_AUTO       : Minimum delay, then the transport's hardware
+ *                         status polling (QUADSPI status-match). Transports
+ *                         without it fall back to DELAY_POLL.
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	NAND_READY_POLL = 0,
+	NAND_READY_DELAY_POLL,
+	NAND_READY_AUTO
+} NandReadyMode_t;
+
+/* ---------------------------------------------------------------------------
+ * Operation Timing (microseconds)
+ * ---------------------------------------------------------------------------
+ * typ_us  : Typical busy time, minimum delay derived from it
+ * max_us  : Datasheet maximum, default timeout = max_us * NAND_READY_TIMEOUT_MUL
+ * poll_us : SR3 poll interval after the minimum delay
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t typ_us;
+	uint32_t max_us;
+	uint32_t poll_us;
+} NandOpTiming_t;
+
+#define NAND_READY_MIN_PCT      80   // Minimum delay = 80 % of typical
+#define NAND_READY_TIMEOUT_MUL  2
+
+#define NAND_SR3_BUSY           0x01
+
+/* ---------------------------------------------------------------------------
+ * Last wait statistics (bench / tuning)
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t polls;        // SR3 transactions of the last wait
+	uint32_t elapsed_us;   // Duration of the last wait
+	uint32_t timeouts;     // Total timeouts since boot
+} NandReadyStats_t;
+
+/* ---------------------------------------------------------------------------
+ * Non-blocking Wait (operation engine, NandQueue_service)
+ * ---------------------------------------------------------------------------
+ * Nand_ReadyBegin right after the command, then Nand_ReadyPoll whenever the
+ * caller has time: at most one SR3 transaction per call, *next_us tells
+ * when the next call is useful. Same schedule as Nand_WaitReadyOp.
+ *
+ * start / next / limit are platform clock ticks (next, limit relative to
+ * start), sr3 holds the last SR3 read.
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	NAND_WAIT_PENDING = 0,
+	NAND_WAIT_READY,
+	NAND_WAIT_TIMEOUT
+} NandWaitState_t;
+
+typedef struct
+{
+	NandOp_t op;
+	uint32_t start;
+	uint32_t next;
+	uint32_t limit;
+	uint32_t polls;
+	uint8_t sr3;
+} NandReadyWait_t;
+
+/* ---------------------------------------------------------------------------
+ * Platform Clock (nand_hal.c: DWT->CYCCNT, host: simulated clock)
+ * ---------------------------------------------------------------------------
+ * NandClock_Init       : Start the free running counter
+ * NandClock_Ticks      : Counter value (wraps, compare by difference)
+ * NandClock_TicksPerUs : Counter rate
+ * NandClock_DelayUs    : Busy delay
+ * --------------------------------------------------------------------------- */
+void NandClock_Init(void);
+uint32_t NandClock_Ticks(void);
+uint32_t NandClock_TicksPerUs(void);
+void NandClock_DelayUs(uint32_t us);
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Nand_WaitReadyOp
+ *  - Wait for SR3[BUSY] = 0 after `op`, final SR3 returned in *sr3.
+ *    timeout_us = 0 -> max_us * NAND_READY_TIMEOUT_MUL of the operation.
+ *
+ * Nand_ReadyBegin / Nand_ReadyPoll
+ *  - Same wait split in steps. block = true allows the transport's hardware
+ *    polling (AUTO) to run until ready inside one call.
+ *
+ * Nand_SetReadyMode / Nand_GetReadyMode
+ *  - Select polling schedule (default NAND_READY_DELAY_POLL).
+ *
+ * Nand_SetOpTiming / Nand_GetOpTiming
+ *  - Override the timing profile of one operation.
+ *
+ * Nand_GetReadyStats
+ *  - Polls / duration of the last wait.
+ * ------------------------------------------------------------------------- */
+bool Nand_WaitReadyOp(NandOp_t op, uint32_t timeout_us, uint8_t *sr3);
+
+void Nand_ReadyBegin(NandReadyWait_t *w, NandOp_t op, uint32_t timeout_us);
+NandWaitState_t Nand_ReadyPoll(NandReadyWait_t *w, bool block, uint32_t *next_us);
+
+void Nand_SetReadyMode(NandReadyMode_t mode);
+NandReadyMode_t Nand_GetReadyMode(void);
+
+void Nand_SetOpTiming(NandOp_t op, const NandOpTiming_t *timing);
+const NandOpTiming_t* Nand_GetOpTiming(NandOp_t op);
+
+const NandReadyStats_t* Nand_GetReadyStats(void);
+
+#endif /* HAL_NAND_READY_H_ */
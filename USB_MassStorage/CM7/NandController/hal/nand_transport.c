@@ -0,0 +1,72 @@
+/*
+ *  nand_transport.c
+ *
+ *  Created on: Nov 3, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#include <stdio.h>
+#include "nand_transport.h"
+
+static NandDevice_t *nand_active = NULL;
+
+/* ===========================================================================
+ * Function: Nand_Bind / Nand_Dev
+ * ===========================================================================
+ * @brief
+ *  - Bind the device handle used by all drivers and services.
+ *
+ * @details
+ *  - Services keep their original signatures, the handle is looked up once
+ *    per transaction. Swapping the bound device is how the same workload
+ *    runs on SPI2 polling, SPI2 DMA, QUADSPI or the host simulator.
+ *  - Must not be called while an operation is in progress.
+ *
+ * @param dev : Device handle, NULL -> NandDev_Default.
+ * --------------------------------------------------------------------------- */
+void Nand_Bind(NandDevice_t *dev)
+{
+	nand_active = dev;
+
+	if (dev != NULL && dev->tr->read_wide == NULL)
+		dev->io_mode = NAND_IO_SINGLE;
+
+	Nand_Dev()->sr_valid = 0;
+}
+
+NandDevice_t* Nand_Dev(void)
+{
+	return nand_active ? nand_active : &NandDev_Default;
+}
+
+/* ===========================================================================
+ * Function: Nand_SetIoMode / Nand_GetIoMode
+ * ===========================================================================
+ * @brief
+ *  - Select data phase width used by Read_service / Program_service.
+ *
+ * @return
+ *  - true  : Mode accepted.
+ *  - false : Quad mode requested on a single-line transport.
+ * --------------------------------------------------------------------------- */
+bool Nand_SetIoMode(NandIoMode_t mode)
+{
+	NandDevice_t *d = Nand_Dev();
+
+	if (mode != NAND_IO_SINGLE
+			&& (d->tr->read_wide == NULL || d->tr->write_wide == NULL))
+	{
+		printf("[NAND] %s has no quad bus, keep single line\r\n", d->tr->name);
+		return false;
+	}
+
+	d->io_mode = mode;
+	return true;
+}
+
+NandIoMode_t Nand_GetIoMode(void)
+{
+	return Nand_Dev()->io_mode;
+}
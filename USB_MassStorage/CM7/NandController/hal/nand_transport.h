@@ -0,0 +1,164 @@
+/*
+ *  nand_transport.h
+ *
+ *  Created on: Nov 3, 2025
+ *  Author: Henry
+ *
+ *  Address: NandController/hal
+ */
+
+#ifndef HAL_NAND_TRANSPORT_H_
+#define HAL_NAND_TRANSPORT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* ---------------------------------------------------------------------------
+ * Data I/O Mode (cache read / load width used by Read / Program service)
+ * ---------------------------------------------------------------------------
+ * NAND_IO_SINGLE      : 03h / 02h / 84h
+ * NAND_IO_QUAD_OUTPUT : 6Bh / 32h / 34h (1-1-4)
+ * NAND_IO_QUAD_IO     : EBh / 32h / 34h (1-4-4 read)
+ *
+ * Quad modes need a transport with read_wide / write_wide and SR1[WP-E] = 0
+ * (/WP, /HOLD used as IO2, IO3).
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	NAND_IO_SINGLE = 0,
+	NAND_IO_QUAD_OUTPUT,
+	NAND_IO_QUAD_IO
+} NandIoMode_t;
+
+/* ---------------------------------------------------------------------------
+ * Multi-line Command Descriptor
+ * ---------------------------------------------------------------------------
+ * opcode       : Instruction byte (always 1 line on W25N02KV)
+ * addr_lines   : 0 = no address, 1 / 2 / 4 lines
+ * addr_bytes   : Address length (1 ~ 4 bytes)
+ * dummy_cycles : Dummy clocks between address and data
+ * data_lines   : 0 = no data, 1 / 2 / 4 lines
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint8_t opcode;
+	uint8_t addr_lines;
+	uint8_t addr_bytes;
+	uint8_t dummy_cycles;
+	uint8_t data_lines;
+} NandLineCmd_t;
+
+/* ---------------------------------------------------------------------------
+ * Transport Interface
+ * ---------------------------------------------------------------------------
+ * All single-line operations take the pre-packed SPI header used by the
+ * drivers (opcode + address / dummy bytes). Each call is one complete
+ * transaction, /CS handling belongs to the transport.
+ *
+ * command    : Header only (06h, 13h, 10h, D8h, 1Fh ...)
+ * read       : Header + read phase
+ * write      : Header + write phase
+ * read_wide  : Multi-line read  (NULL -> single line only)
+ * write_wide : Multi-line write (NULL -> single line only)
+ * wait_ready : Hardware status polling until SR3[BUSY] = 0, last SR3 in
+ *              *sr3 (NULL -> software polling in Nand_WaitReadyOp)
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	const char *name;
+
+	bool (*command)(void *ctx, const uint8_t *cmd, uint16_t cmd_len);
+	bool (*read)(void *ctx, const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf,
+			uint16_t len);
+	bool (*write)(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+			const uint8_t *buf, uint16_t len);
+	bool (*read_wide)(void *ctx, const NandLineCmd_t *cmd, uint32_t addr,
+			uint8_t *buf, uint16_t len);
+	bool (*write_wide)(void *ctx, const NandLineCmd_t *cmd, uint32_t addr,
+			const uint8_t *buf, uint16_t len);
+	bool (*wait_ready)(void *ctx, uint32_t timeout_us, uint8_t *sr3);
+} NandTransport_t;
+
+/* ---------------------------------------------------------------------------
+ * Device Handle
+ * ---------------------------------------------------------------------------
+ * tr        : Transport backend
+ * ctx       : Backend context (NandSpiCtx_t, QSPI handle, simulator ...)
+ * io_mode   : Data I/O mode for cache read / load
+ * sr1 / sr2 : Shadow of SR1 / SR2 (protection, configuration), written
+ *             through by WriteStatusRegister, dropped on reset
+ * sr_valid  : NAND_SHADOW_SR1 | NAND_SHADOW_SR2, 0 after power-up / reset
+ * --------------------------------------------------------------------------- */
+#define NAND_SHADOW_SR1   0x01
+#define NAND_SHADOW_SR2   0x02
+
+typedef struct
+{
+	const NandTransport_t *tr;
+	void *ctx;
+	NandIoMode_t io_mode;
+	uint8_t sr1;
+	uint8_t sr2;
+	uint8_t sr_valid;
+} NandDevice_t;
+
+/* Provided by the platform (nand_hal.c on target, simulator on host) */
+extern NandDevice_t NandDev_Default;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Nand_Bind / Nand_Dev
+ *  - Select the device every driver / service call runs on.
+ *    Nand_Bind(NULL) returns to NandDev_Default.
+ *
+ * Nand_SetIoMode / Nand_GetIoMode
+ *  - Data I/O mode of the bound device, quad refused without wide bus.
+ *
+ *  Binding drops the SR1 / SR2 shadow of `dev`: another handle (SPI2 / QSPI)
+ *  may have changed the same chip meanwhile.
+ * ------------------------------------------------------------------------- */
+void Nand_Bind(NandDevice_t *dev);
+NandDevice_t* Nand_Dev(void);
+bool Nand_SetIoMode(NandIoMode_t mode);
+NandIoMode_t Nand_GetIoMode(void);
+
+/* ---------------------------------------------------------------------------
+ * Driver entry points (bound device)
+ * --------------------------------------------------------------------------- */
+static inline bool Nand_Command(const uint8_t *cmd, uint16_t cmd_len)
+{
+	NandDevice_t *d = Nand_Dev();
+	return d->tr->command(d->ctx, cmd, cmd_len);
+}
+
+static inline bool Nand_Read(const uint8_t *cmd, uint16_t cmd_len, uint8_t *buf,
+		uint16_t len)
+{
+	NandDevice_t *d = Nand_Dev();
+	return d->tr->read(d->ctx, cmd, cmd_len, buf, len);
+}
+
+static inline bool Nand_Write(const uint8_t *cmd, uint16_t cmd_len,
+		const uint8_t *buf, uint16_t len)
+{
+	NandDevice_t *d = Nand_Dev();
+	return d->tr->write(d->ctx, cmd, cmd_len, buf, len);
+}
+
+static inline bool Nand_ReadWide(const NandLineCmd_t *cmd, uint32_t addr,
+		uint8_t *buf, uint16_t len)
+{
+	NandDevice_t *d = Nand_Dev();
+	return d->tr->read_wide && d->tr->read_wide(d->ctx, cmd, addr, buf, len);
+}
+
+static inline bool Nand_WriteWide(const NandLineCmd_t *cmd, uint32_t addr,
+		const uint8_t *buf, uint16_t len)
+{
+	NandDevice_t *d = Nand_Dev();
+	return d->tr->write_wide && d->tr->write_wide(d->ctx, cmd, addr, buf, len);
+}
+
+#endif /* HAL_NAND_TRANSPORT_H_ */
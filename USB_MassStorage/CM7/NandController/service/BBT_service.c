@@ -8,13 +8,214 @@
 
 #include "BBT_service.h"
 
-bool BBT_Table[TOTAL_BLOCKS]; // Invalid Block Table
+uint32_t BBT_Bitmap[BBT_WORDS]; // Invalid Block Table (1 bit per block)
+
+/* ---------------------------------------------------------------------------
+ * Cached totals / rank-select index
+ * ---------------------------------------------------------------------------
+ * bbt_bad_count : Set bits of BBT_Bitmap
+ * bbt_rank      : Good blocks in words [0, w)
+ * bbt_select    : Word holding good block n * BBT_SELECT_STEP
+ * bbt_dirty     : Index stale (bitmap changed since the last rebuild)
+ * --------------------------------------------------------------------------- */
+#define BBT_SELECT_SLOTS   ((TOTAL_BLOCKS + BBT_SELECT_STEP - 1) / BBT_SELECT_STEP)
+
+static uint32_t bbt_bad_count = 0;
+static uint16_t bbt_rank[BBT_WORDS + 1];
+static uint16_t bbt_select[BBT_SELECT_SLOTS];
+static bool bbt_dirty = true;
+
+/* ---------------------------------------------------------------------------
+ * Lazy verification (BBT_MountLazy)
+ * ---------------------------------------------------------------------------
+ * bbt_unknown   : 1 = factory marker not read yet (never handed out)
+ * unknown_count : Set bits of bbt_unknown
+ * lazy_cfg      : Range / marker policy of the deferred scan
+ * --------------------------------------------------------------------------- */
+static uint32_t bbt_unknown[BBT_WORDS];
+static uint32_t unknown_count = 0;
+static BBT_ScanConfig_t lazy_cfg;
+
+/* ---------------------------------------------------------------------------
+ * On-flash records (main area, little endian words)
+ * ---------------------------------------------------------------------------
+ * crc : CRC-32 (IEEE, reflected) of the words before it
+ * --------------------------------------------------------------------------- */
+#define BBT_SNAP_MAGIC     0x31544242U   // "BBT1"
+#define BBT_JRNL_MAGIC     0x4A544242U   // "BBTJ"
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t bad_count;
+	uint32_t reserved;
+	uint32_t bitmap[BBT_WORDS];
+	uint32_t crc;
+} BBT_Snapshot_t;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t block;
+	uint32_t crc;
+} BBT_Journal_t;
+
+/* ---------------------------------------------------------------------------
+ * Store state
+ * ---------------------------------------------------------------------------
+ * store_mounted : Runtime marks are journaled
+ * store_seq     : Sequence number of the current snapshot
+ * store_journal : Journal entries behind it (next entry -> page + 1)
+ * --------------------------------------------------------------------------- */
+static const uint32_t store_block[2] = { BBT_STORE_BLOCK_A, BBT_STORE_BLOCK_B };
+
+static bool store_mounted = false;
+static uint32_t store_seq = 0;
+static uint32_t store_journal = 0;
 
-extern bool StandardRead_Service(uint32_t page_addr, uint16_t col_addr, uint8_t *buf, uint16_t len);
 extern void LoadProgramData(uint16_t col_addr, const uint8_t *buf, uint16_t len);
 extern void ProgramExecute(uint32_t page_addr);
-extern bool IsBusyWithTimeout_service(uint32_t timeout_ms);
-extern bool CheckProgramFail_service(void);
+
+/* ---------------------------------------------------------------------------
+ * Bitmap helpers (CTZ = RBIT + CLZ on Cortex-M7)
+ * --------------------------------------------------------------------------- */
+static void bbt_set_bad(uint32_t block)
+{
+	uint32_t bit = 1u << (block & 31);
+
+	if (BBT_Bitmap[block >> 5] & bit)
+		return;
+
+	BBT_Bitmap[block >> 5] |= bit;
+	bbt_bad_count++;
+	bbt_dirty = true;
+}
+
+static void bbt_clear_bad(uint32_t block)
+{
+	uint32_t bit = 1u << (block & 31);
+
+	if (!(BBT_Bitmap[block >> 5] & bit))
+		return;
+
+	BBT_Bitmap[block >> 5] &= ~bit;
+	bbt_bad_count--;
+	bbt_dirty = true;
+}
+
+static void bbt_clear(void)
+{
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	memset(bbt_unknown, 0, sizeof(bbt_unknown));
+	bbt_bad_count = 0;
+	unknown_count = 0;
+	bbt_dirty = true;
+}
+
+/// First set bit >= from in (bitmap ^ invert), BBT_NONE when there is none
+static uint32_t bbt_find(uint32_t from, uint32_t invert)
+{
+	if (from >= TOTAL_BLOCKS)
+		return BBT_NONE;
+
+	uint32_t w = from >> 5;
+	uint32_t bits = (BBT_Bitmap[w] ^ invert) & (0xFFFFFFFFu << (from & 31));
+
+	while (bits == 0)
+	{
+		if (++w >= BBT_WORDS)
+			return BBT_NONE;
+		bits = BBT_Bitmap[w] ^ invert;
+	}
+
+	return (w << 5) + (uint32_t) __builtin_ctz(bits);
+}
+
+/// Prefix good counts per word + one word index per BBT_SELECT_STEP good blocks
+static void bbt_rebuild_index(void)
+{
+	uint32_t good = 0;
+
+	for (uint32_t w = 0; w < BBT_WORDS; w++)
+	{
+		uint32_t n = 32u - (uint32_t) __builtin_popcount(BBT_Bitmap[w]);
+
+		bbt_rank[w] = (uint16_t) good;
+
+		/// Samples falling into this word: good + k * STEP in [good, good + n)
+		for (uint32_t s = (good + BBT_SELECT_STEP - 1) / BBT_SELECT_STEP;
+				s * BBT_SELECT_STEP < good + n; s++)
+			bbt_select[s] = (uint16_t) w;
+
+		good += n;
+	}
+
+	bbt_rank[BBT_WORDS] = (uint16_t) good;
+	bbt_dirty = false;
+}
+
+/* ---------------------------------------------------------------------------
+ * CRC-32 (0xEDB88320), 4-bit table (also used by the remap store)
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_Crc32(const void *data, uint32_t len)
+{
+	static const uint32_t table[16] =
+	{ 0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+			0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8,
+			0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C };
+	const uint8_t *p = (const uint8_t*) data;
+	uint32_t crc = 0xFFFFFFFFu;
+
+	while (len--)
+	{
+		crc ^= *p++;
+		crc = (crc >> 4) ^ table[crc & 0x0F];
+		crc = (crc >> 4) ^ table[crc & 0x0F];
+	}
+
+	return ~crc;
+}
+
+/* ---------------------------------------------------------------------------
+ * Store record I/O
+ * --------------------------------------------------------------------------- */
+static bool store_read_snapshot(uint32_t copy, BBT_Snapshot_t *snap)
+{
+	if (!StandardRead_Service(PAGE_ADDR(store_block[copy], 0), 0,
+			(uint8_t*) snap, sizeof(*snap)))
+		return false;
+
+	return snap->magic == BBT_SNAP_MAGIC
+			&& snap->crc == BBT_Crc32(snap, offsetof(BBT_Snapshot_t, crc));
+}
+
+static bool store_read_journal(uint32_t copy, uint32_t index, BBT_Journal_t *j)
+{
+	if (!StandardRead_Service(PAGE_ADDR(store_block[copy], index + 1), 0,
+			(uint8_t*) j, sizeof(*j)))
+		return false;
+
+	return j->magic == BBT_JRNL_MAGIC && j->seq == store_seq
+			&& j->block < TOTAL_BLOCKS
+			&& j->crc == BBT_Crc32(j, offsetof(BBT_Journal_t, crc));
+}
+
+/// Apply the journal of one copy, returns the number of valid entries
+static uint32_t store_replay(uint32_t copy)
+{
+	BBT_Journal_t j;
+	uint32_t n = 0;
+
+	while (n < BBT_JOURNAL_PAGES && store_read_journal(copy, n, &j))
+	{
+		bbt_set_bad(j.block);
+		n++;
+	}
+
+	return n;
+}
 
 /* ===========================================================================
  * Function: read_marker_bytes_page0
@@ -23,37 +224,46 @@ extern bool CheckProgramFail_service(void);
  *  - Reads the factory bad block marker bytes from page0 of a target block.
  *
  * @details
- *  - Reads one byte from main area [main0] and one from spare area [spare0]
- *    of the first page (page0) in the specified block.
- *  - These bytes are checked to identify factory-marked bad blocks.
- *  - A good block should have both bytes = 0xFF.
+ *  - One array fetch: page0 is loaded into the cache once (13h), main[0] and
+ *    spare[0] are then two 1-byte column reads from the cache register.
+ *  - No ECC decision: a factory bad block may well be uncorrectable, the
+ *    marker bytes are evaluated anyway (class returned in *ecc).
+ *  - No per-block logging, the scan reports a summary.
  *
  *  Flow:
- *    1. Read main[0] (first byte of main area).
- *    2. Read spare[0] (first byte of spare area).
+ *    1. [13h + page0]  PageDataRead → cache
+ *    2. Wait until OIP = 0, ECC class from the same SR3 read
+ *    3. [03h + 0000h]  main[0]
+ *    4. [03h + 0800h]  spare[0]
  *
  * @param block : Target block index to read marker from.
  * @param m0    : Pointer to buffer for main[0] byte.
  * @param s0    : Pointer to buffer for spare[0] byte.
+ * @param ecc   : [out] ECC class of the page0 load.
  *
  * @return
- *  - true  : Successfully read both marker bytes.
- *  - false : Read operation failed.
+ *  - true  : Both marker bytes read.
+ *  - false : tRD timeout.
  *
  * @note
- *  - Should only be used during factory BBT scan.
+ *  - Caller owns the device (NandQueue flushed, SR2[BUF] = 1).
  *  - Reference: Winbond W25N02KV Datasheet §8.1.1
  * --------------------------------------------------------------------------- */
-static bool read_marker_bytes_page0(uint32_t block, uint8_t *m0, uint8_t *s0)
+static bool read_marker_bytes_page0(uint32_t block, uint8_t *m0, uint8_t *s0,
+		ECC_Status_t *ecc)
 {
-	uint32_t page0 = PAGE_ADDR(block, 0);
+	uint8_t sr3 = 0;
 
-	if (!StandardRead_Service(page0, 0, m0, 1))
-		return false;
+	PageDataRead(PAGE_ADDR(block, 0));
 
-	if (!StandardRead_Service(page0, PAGE_MAIN_SIZE, s0, 1))
+	if (!Nand_WaitReadyOp(NAND_OP_READ, 0, &sr3))
 		return false;
 
+	*ecc = DecodeECCStatus_service(sr3);
+
+	ReadData(0, m0, 1);
+	ReadData(PAGE_MAIN_SIZE, s0, 1);
+
 	return true;
 }
 
@@ -61,37 +271,101 @@ static bool read_marker_bytes_page0(uint32_t block, uint8_t *m0, uint8_t *s0)
  * Function: is_factory_bad
  * ===========================================================================
  * @brief
- *  - Determines if a block is factory-marked as bad.
+ *  - Determines if a block is factory-marked as bad under a marker policy.
  *
  * @details
- *  - Calls read_marker_bytes_page0() to obtain main0/spare0 bytes.
- *  - A block is considered bad if either marker byte != 0xFF.
- *  - Initializes both bytes to 0xFF before reading to ensure clean state.
+ *  - BBT_MARKER_EITHER : main[0] != 0xFF || spare[0] != 0xFF (default)
+ *  - BBT_MARKER_BOTH   : main[0] != 0xFF && spare[0] != 0xFF
+ *  - BBT_MARKER_SPARE0 : spare[0] != 0xFF
+ *  - BBT_MARKER_MAIN0  : main[0] != 0xFF
  *
- *  Evaluation Logic:
- *    if (main0 != 0xFF) || (spare0 != 0xFF) → Factory bad block
- *
- * @param block   : Target block index to check.
- * @param main0   : Pointer to byte storing main[0] value.
- * @param spare0  : Pointer to byte storing spare[0] value.
+ * @param main0  : main[0] value.
+ * @param spare0 : spare[0] value.
+ * @param policy : Marker policy.
  *
  * @return
  *  - true  : Factory bad block detected.
- *  - false : Block is good or unreadable.
+ *  - false : Block is good.
  *
  * @note
- *  - Used only during initial BBT scan.
  *  - Reference: Winbond W25N02KV Datasheet §8.1.1
  * --------------------------------------------------------------------------- */
-static bool is_factory_bad(uint32_t block, uint8_t *main0, uint8_t *spare0)
+static bool is_factory_bad(uint8_t main0, uint8_t spare0,
+		BBT_MarkerPolicy_t policy)
+{
+	bool m = (main0 != 0xFFu);
+	bool sp = (spare0 != 0xFFu);
+
+	switch (policy)
+	{
+	case BBT_MARKER_BOTH:
+		return m && sp;
+	case BBT_MARKER_SPARE0:
+		return sp;
+	case BBT_MARKER_MAIN0:
+		return m;
+	case BBT_MARKER_EITHER:
+	default:
+		return m || sp;
+	}
+}
+
+/* ---------------------------------------------------------------------------
+ * Block no longer unknown: the last one completes the lazy table, saved at
+ * once (allocation, on-demand check, runtime mark or idle step alike).
+ * Returns true when the table was saved.
+ * --------------------------------------------------------------------------- */
+static bool unknown_clear(uint32_t blk)
 {
-	*main0 = 0xFF;
-	*spare0 = 0xFF;
+	if (!(bbt_unknown[blk >> 5] & (1u << (blk & 31))))
+		return false;
 
-	if (!read_marker_bytes_page0(block, main0, spare0))
+	bbt_unknown[blk >> 5] &= ~(1u << (blk & 31));
+
+	if (--unknown_count != 0)
 		return false;
 
-	return (*main0 != 0xFFu) || (*spare0 != 0xFFu);
+	NAND_LOG(BBT_LAZY_DONE, bbt_bad_count);
+	BBT_Save();
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Read and apply the marker of one block (scan engine / lazy verification)
+ * --------------------------------------------------------------------------- */
+static bool verify_block(uint32_t blk, BBT_MarkerPolicy_t policy,
+		BBT_ScanStats_t *st)
+{
+	uint8_t main0, spare0;
+	ECC_Status_t ecc = ECC_SUCCESS;
+	bool bad;
+
+	if (read_marker_bytes_page0(blk, &main0, &spare0, &ecc))
+	{
+		bad = is_factory_bad(main0, spare0, policy);
+		if (ecc == ECC_UNCORRECTABLE)
+			st->ecc_fail++;
+	}
+	else
+	{
+		bad = true;
+		st->timeouts++;
+	}
+
+	if (bad)
+	{
+		bbt_set_bad(blk);
+		st->bad++;
+	}
+	else
+	{
+		bbt_clear_bad(blk);
+	}
+
+	st->scanned++;
+	unknown_clear(blk);
+
+	return !bad;
 }
 
 /* ===========================================================================
@@ -107,10 +381,10 @@ static bool is_factory_bad(uint32_t block, uint8_t *main0, uint8_t *spare0)
  *  - Waits for operation completion and checks for program failure.
  *
  *  Flow:
- *    1. LoadProgramData(spare0, 0x00)
- *    2. ProgramExecute(page0)
- *    3. Poll busy flag or timeout
- *    4. Verify program result via SR3[3] (P_FAIL)
+ *    1. WriteEnable(06h)
+ *    2. LoadProgramData(spare0, 0x00)
+ *    3. ProgramExecute(page0)
+ *    4. Wait until ready, P_FAIL from the same SR3 read
  *
  * @param block : Target block index to mark as bad.
  *
@@ -123,26 +397,110 @@ static void write_bad_marker_page0_spare0(uint32_t block)
 {
 	uint32_t page0 = PAGE_ADDR(block, 0);
 	uint8_t mark = 0x00;
+	NandCompletion_t done;
 
+	WriteEnable();
 	LoadProgramData(PAGE_MAIN_SIZE, &mark, 1);
 
 	ProgramExecute(page0);
 
-	if (!IsBusyWithTimeout_service(100))
+	if (!WaitComplete_service(NAND_OP_PROGRAM, 0, &done))
 	{
-		printf("[Invalid Table] Timeout while marking bad block\r\n");
+		NAND_LOG(BBT_MARK_TIMEOUT, block);
 		return;
 	}
 
-	if (CheckProgramFail_service())
+	if (done.p_fail)
 	{
-		printf("[Invalid Table] Failed to program bad block marker\r\n");
+		NAND_LOG(BBT_MARK_FAIL, block);
 	}
 	else
 	{
-		printf("[Invalid Table] Permanent marker written (Block:%lu)\r\n",
-				(unsigned long) block);
+		NAND_LOG(BBT_MARK_OK, block);
+	}
+}
+
+/* ===========================================================================
+ * Function: BBT_ScanDefaultConfig
+ * ===========================================================================
+ * @brief
+ *  - Default scan: blocks FACTORY_INFO_BLOCK_END ~ FACTORY_INFO_BLOCK2_START,
+ *    either marker byte, no progress callback.
+ * --------------------------------------------------------------------------- */
+void BBT_ScanDefaultConfig(BBT_ScanConfig_t *cfg)
+{
+	cfg->first_block = FACTORY_INFO_BLOCK_END;
+	cfg->last_block = FACTORY_INFO_BLOCK2_START;
+	cfg->policy = BBT_MARKER_EITHER;
+	cfg->progress = NULL;
+	cfg->user = NULL;
+}
+
+/* ===========================================================================
+ * Function: BBT_Scan
+ * ===========================================================================
+ * @brief
+ *  - Factory marker scan engine over a configurable block range.
+ *
+ * @details
+ *  - One page load per block (read_marker_bytes_page0), the two marker
+ *    bytes come from the cache register: half the array fetches, busy
+ *    waits and SR3 reads of two full read services.
+ *  - Bits inside [first_block, last_block] are rebuilt, the rest of
+ *    BBT_Bitmap[] is left as it is. The range may include the
+ *    FACTORY_INFO_BLOCK regions.
+ *  - No per-block output: cfg->progress is called every
+ *    BBT_SCAN_PROGRESS_STEP blocks and at the end, the result goes to
+ *    *stats and one summary line.
+ *  - A block whose page0 load times out is treated as bad.
+ *
+ * @param cfg   : Range / marker policy / progress (NULL -> default).
+ * @param stats : [out] Result counters and duration (may be NULL).
+ *
+ * @return
+ *  - true  : Range scanned without timeout.
+ *  - false : Invalid range, or at least one tRD timeout.
+ * --------------------------------------------------------------------------- */
+bool BBT_Scan(const BBT_ScanConfig_t *cfg, BBT_ScanStats_t *stats)
+{
+	BBT_ScanConfig_t def;
+	BBT_ScanStats_t st = { 0 };
+
+	if (cfg == NULL)
+	{
+		BBT_ScanDefaultConfig(&def);
+		cfg = &def;
+	}
+
+	if (cfg->first_block > cfg->last_block || cfg->last_block >= TOTAL_BLOCKS)
+		return false;
+
+	uint32_t total = cfg->last_block - cfg->first_block + 1;
+	uint32_t t0 = NandClock_Ticks();
+
+	NandQueue_Flush();
+
+	for (uint32_t blk = cfg->first_block; blk <= cfg->last_block; blk++)
+	{
+		verify_block(blk, cfg->policy, &st);
+
+		if (cfg->progress != NULL
+				&& (st.scanned % BBT_SCAN_PROGRESS_STEP == 0 || st.scanned == total))
+			cfg->progress(st.scanned, total, cfg->user);
 	}
+
+	st.elapsed_us = (NandClock_Ticks() - t0) / NandClock_TicksPerUs();
+
+	printf("[Invalid Table] Scan %lu ~ %lu: %lu blocks, %lu bad, %lu ECC fail, "
+			"%lu timeout, %lu us\r\n", (unsigned long) cfg->first_block,
+			(unsigned long) cfg->last_block, (unsigned long) st.scanned,
+			(unsigned long) st.bad, (unsigned long) st.ecc_fail,
+			(unsigned long) st.timeouts, (unsigned long) st.elapsed_us);
+
+	if (stats != NULL)
+		*stats = st;
+
+	return st.timeouts == 0;
 }
 
 /* ===========================================================================
@@ -152,16 +510,10 @@ static void write_bad_marker_page0_spare0(uint32_t block)
  *  - Scans all blocks and builds the Bad Block Table (BBT) based on factory markers.
  *
  * @details
- *  - Reads the first page (page0) of each block to check the factory-programmed
- *    bad block marker in both main area [byte0] and spare area [spare0].
- *  - A block is considered bad if either byte is not 0xFF.
- *  - Factory information regions (reserved system blocks) are skipped from scan.
- *  - Updates BBT_Table[] with "true" for bad blocks and "false" for valid ones.
- *
- *  Command Flow:
- *    1. Read main[0] from page0.
- *    2. Read spare[0] from page0.
- *    3. If either != 0xFF → mark as bad.
+ *  - Clears the table, then BBT_Scan with the default configuration:
+ *    page0 of blocks 8 ~ 2043 loaded once each, main[0] and spare[0]
+ *    checked, either != 0xFF → bad.
+ *  - Factory information regions (reserved system blocks) stay valid.
  *
  *  @note
  *  - Factory bad blocks must never be used for program/erase operations.
@@ -169,29 +521,8 @@ static void write_bad_marker_page0_spare0(uint32_t block)
  * --------------------------------------------------------------------------- */
 void BBT_ScanFactoryBlocks(void)
 {
-	uint8_t main0, spare0;
-
-	for (uint32_t blk = 0; blk < TOTAL_BLOCKS; blk++)
-	{
-		if (blk < FACTORY_INFO_BLOCK_END || blk > FACTORY_INFO_BLOCK2_START)
-		{
-			BBT_Table[blk] = false;
-			continue;
-		}
-
-		if (is_factory_bad(blk, &main0, &spare0))
-		{
-			BBT_Table[blk] = true;
-			printf("[Invalid Block] = %lu (m:0x%02X s:0x%02X)\r\n",
-					(unsigned long) blk, main0, spare0);
-		}
-		else
-		{
-			BBT_Table[blk] = false;
-			printf("[Valid Block] = %lu (m:0x%02X s:0x%02X)\r\n",
-					(unsigned long) blk, main0, spare0);
-		}
-	}
+	bbt_clear();
+	BBT_Scan(NULL, NULL);
 }
 
 /* ===========================================================================
@@ -202,12 +533,12 @@ void BBT_ScanFactoryBlocks(void)
  *
  * @details
  *  - Triggered when a block encounters erase or program failure.
- *  - Updates BBT_Table[] entry and permanently writes a bad marker
+ *  - Sets the BBT_Bitmap[] bit and permanently writes a bad marker
  *    into the spare area of page0.
  *  - This ensures the block is skipped in future allocation.
  *
  *  Flow:
- *    1. Set BBT_Table[block] = true.
+ *    1. Set the block bit (bad count / index updated).
  *    2. Write 0x00 marker into spare0 of page0.
  *    3. ProgramExecute() to commit the marker.
  *
@@ -222,13 +553,379 @@ void BBT_MarkRuntimeBad(uint32_t block)
 	if (block >= TOTAL_BLOCKS)
 		return;
 
-	if (BBT_Table[block])
+	if (BBT_BadBlock(block))
 		return;
 
-	BBT_Table[block] = true;
+	bbt_set_bad(block);
 	printf("[Invalid Table] Runtime Bad Block = %lu\r\n",
 			(unsigned long) block);
 	write_bad_marker_page0_spare0(block);
+
+	/// Last unknown block: the new snapshot already holds the mark
+	if (unknown_clear(block) || !store_mounted)
+		return;
+
+	/// Journal entry in both copies, a full journal becomes a new snapshot
+	if (store_journal >= BBT_JOURNAL_PAGES)
+	{
+		BBT_Save();
+		return;
+	}
+
+	BBT_Journal_t j = { BBT_JRNL_MAGIC, store_seq, block, 0 };
+	uint32_t written = 0;
+
+	j.crc = BBT_Crc32(&j, offsetof(BBT_Journal_t, crc));
+
+	for (uint32_t copy = 0; copy < 2; copy++)
+	{
+		if (StandardProgram_Service(PAGE_ADDR(store_block[copy], store_journal + 1),
+				(const uint8_t*) &j, sizeof(j)))
+			written++;
+		else
+			NAND_LOG(BBT_STORE_FAIL, store_block[copy], store_seq);
+	}
+
+	store_journal++;
+
+	if (written == 0)
+		BBT_Save();
+}
+
+/* ===========================================================================
+ * Function: BBT_Load
+ * ===========================================================================
+ * @brief
+ *  - Restores the table from the on-flash copies.
+ *
+ * @details
+ *  - Reads the snapshot page of both copies, takes the valid one with the
+ *    highest sequence number and replays the journal entries behind it.
+ *    Copies with the same seq are merged (an append may have reached only
+ *    one of them before power loss).
+ *  - A copy that is missing, older or shorter is rewritten (BBT_Save).
+ *
+ *  Command Flow:
+ *    1. Snapshot page of copy A and B (2 page reads)
+ *    2. CRC-32 / magic / seq check, bitmap copied to BBT_Bitmap[]
+ *    3. Journal pages 1 ~ n until the first invalid (erased) page
+ *
+ * @return
+ *  - true  : Table loaded, runtime marks are journaled from now on.
+ *  - false : No valid copy, table untouched.
+ * --------------------------------------------------------------------------- */
+bool BBT_Load(void)
+{
+	static BBT_Snapshot_t snap[2];
+	bool valid[2];
+	uint32_t use;
+
+	for (uint32_t copy = 0; copy < 2; copy++)
+		valid[copy] = store_read_snapshot(copy, &snap[copy]);
+
+	if (!valid[0] && !valid[1])
+	{
+		NAND_LOG(BBT_LOAD_NONE);
+		return false;
+	}
+
+	if (valid[0] && valid[1])
+		use = ((int32_t) (snap[1].seq - snap[0].seq) > 0) ? 1 : 0;
+	else
+		use = valid[0] ? 0 : 1;
+
+	memcpy(BBT_Bitmap, snap[use].bitmap, sizeof(BBT_Bitmap));
+	memset(bbt_unknown, 0, sizeof(bbt_unknown));
+	unknown_count = 0;
+	bbt_bad_count = 0;
+	for (uint32_t w = 0; w < BBT_WORDS; w++)
+		bbt_bad_count += (uint32_t) __builtin_popcount(BBT_Bitmap[w]);
+	bbt_dirty = true;
+
+	store_seq = snap[use].seq;
+	store_journal = store_replay(use);
+
+	/// Mirror with the same snapshot: union of both journals
+	uint32_t other = use ^ 1;
+	bool in_sync = valid[other] && snap[other].seq == store_seq;
+	uint32_t other_journal = in_sync ? store_replay(other) : 0;
+
+	NAND_LOG(BBT_LOAD_OK, store_block[use], store_seq, bbt_bad_count,
+			store_journal);
+
+	store_mounted = true;
+
+	if (!in_sync || other_journal != store_journal)
+	{
+		NAND_LOG(BBT_STORE_REPAIR, store_block[other], store_seq);
+		BBT_Save();
+	}
+	else if (store_journal >= BBT_JOURNAL_PAGES)
+	{
+		BBT_Save();
+	}
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: BBT_Save
+ * ===========================================================================
+ * @brief
+ *  - Writes the current table as a new snapshot (seq + 1) to both copies.
+ *
+ * @details
+ *  - Copy A is erased and programmed first, copy B only afterwards: the
+ *    old snapshot stays valid in B until A holds the new one.
+ *  - Journal restarts empty behind the new snapshot.
+ *
+ * @return
+ *  - true  : At least one copy written.
+ *  - false : Both copies failed (erase / program).
+ * --------------------------------------------------------------------------- */
+bool BBT_Save(void)
+{
+	static BBT_Snapshot_t snap;
+	uint32_t written = 0;
+
+	memset(&snap, 0, sizeof(snap));
+	snap.magic = BBT_SNAP_MAGIC;
+	snap.seq = store_seq + 1;
+	snap.bad_count = bbt_bad_count;
+	memcpy(snap.bitmap, BBT_Bitmap, sizeof(snap.bitmap));
+	snap.crc = BBT_Crc32(&snap, offsetof(BBT_Snapshot_t, crc));
+
+	for (uint32_t copy = 0; copy < 2; copy++)
+	{
+		if (BlockErase128K_service(store_block[copy], 0)
+				&& StandardProgram_Service(PAGE_ADDR(store_block[copy], 0),
+						(const uint8_t*) &snap, sizeof(snap)))
+			written++;
+		else
+			NAND_LOG(BBT_STORE_FAIL, store_block[copy], snap.seq);
+	}
+
+	store_seq = snap.seq;
+	store_journal = 0;
+	store_mounted = (written != 0);
+
+	if (written != 0)
+		NAND_LOG(BBT_SAVE_OK, store_seq, bbt_bad_count, written);
+
+	return written != 0;
+}
+
+/* ===========================================================================
+ * Function: BBT_Mount
+ * ===========================================================================
+ * @brief
+ *  - Boot-time table setup.
+ *
+ * @details
+ *  - Normal boot: BBT_Load, a few page reads.
+ *  - First boot (or both copies destroyed): default range scanned with
+ *    BBT_MOUNT_POLICY (blocks may hold FTL data), then BBT_Save so the
+ *    scan never runs again.
+ *
+ * @return
+ *  - true  : Table valid and persistent.
+ *  - false : Scanned, but could not be saved (works for this session).
+ * --------------------------------------------------------------------------- */
+bool BBT_Mount(void)
+{
+	BBT_ScanConfig_t cfg;
+
+	if (BBT_Load())
+		return true;
+
+	bbt_clear();
+	BBT_ScanDefaultConfig(&cfg);
+	cfg.policy = BBT_MOUNT_POLICY;
+	BBT_Scan(&cfg, NULL);
+
+	return BBT_Save();
+}
+
+/* ===========================================================================
+ * Function: BBT_MountLazy
+ * ===========================================================================
+ * @brief
+ *  - Instant-on table setup: load, or defer the factory scan.
+ *
+ * @details
+ *  - Saved table present: same as BBT_Mount.
+ *  - Otherwise every block of the default scan range starts "unknown" and
+ *    the function returns at once (USB enumerates without waiting).
+ *    BBT_AllocGood verifies a block before handing it out,
+ *    BBT_BackgroundStep walks the rest; the call that verifies the last
+ *    block saves the table. Markers are read with BBT_MOUNT_POLICY.
+ *
+ * @return
+ *  - true  : Table loaded from flash (nothing pending).
+ *  - false : Verification pending (BBT_UnknownCount() blocks).
+ * --------------------------------------------------------------------------- */
+bool BBT_MountLazy(void)
+{
+	if (BBT_Load())
+		return true;
+
+	bbt_clear();
+	BBT_ScanDefaultConfig(&lazy_cfg);
+	lazy_cfg.policy = BBT_MOUNT_POLICY;
+
+	for (uint32_t blk = lazy_cfg.first_block; blk <= lazy_cfg.last_block; blk++)
+		bbt_unknown[blk >> 5] |= 1u << (blk & 31);
+
+	unknown_count = lazy_cfg.last_block - lazy_cfg.first_block + 1;
+	NAND_LOG(BBT_LAZY_START, unknown_count);
+
+	return false;
+}
+
+/* ===========================================================================
+ * Function: BBT_AllocGood
+ * ===========================================================================
+ * @brief
+ *  - First verified good block >= from, for allocators.
+ *
+ * @details
+ *  - Candidates come from BBT_NextGood (unknown blocks have their bad bit
+ *    clear), an unknown candidate has its factory marker read first
+ *    (one page load) and is skipped if bad. Never returns an unverified
+ *    block.
+ *
+ * @param from : First block to consider.
+ *
+ * @return
+ *  - Block index, BBT_NONE when there is none.
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_AllocGood(uint32_t from)
+{
+	BBT_ScanStats_t st = { 0 };
+
+	for (uint32_t blk = BBT_NextGood(from); blk < TOTAL_BLOCKS;
+			blk = BBT_NextGood(blk + 1))
+	{
+		if (!BBT_IsUnknown(blk))
+			return blk;
+
+		NandQueue_Flush();
+		if (verify_block(blk, lazy_cfg.policy, &st))
+			return blk;
+	}
+
+	return BBT_NONE;
+}
+
+/* ===========================================================================
+ * Function: BBT_BackgroundStep
+ * ===========================================================================
+ * @brief
+ *  - Verify up to `budget` unknown blocks (idle loop / low priority task).
+ *
+ * @details
+ *  - Unknown blocks are found by word scan over the unknown bitmap (CTZ),
+ *    each costs one page load (~tRD + 2 bytes).
+ *  - The table is saved as soon as the last block is verified (here or
+ *    by an allocation), the next boot loads it.
+ *
+ * @param budget : Maximum blocks this call (0 -> all remaining).
+ *
+ * @return
+ *  - Unknown blocks left (0 -> table complete).
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_BackgroundStep(uint32_t budget)
+{
+	BBT_ScanStats_t st = { 0 };
+	uint32_t w = 0;
+
+	if (unknown_count == 0)
+		return 0;
+
+	NandQueue_Flush();
+
+	while (unknown_count != 0 && (budget == 0 || st.scanned < budget))
+	{
+		while (bbt_unknown[w] == 0)
+			w++;
+
+		uint32_t blk = (w << 5) + (uint32_t) __builtin_ctz(bbt_unknown[w]);
+
+		verify_block(blk, lazy_cfg.policy, &st);
+	}
+
+	return unknown_count;
+}
+
+/* ===========================================================================
+ * Function: BBT_VerifyBlock
+ * ===========================================================================
+ * @brief
+ *  - Make sure one block is verified (lazy mount), return whether it is good.
+ *
+ * @details
+ *  - Known block: bit lookup only. Unknown block: factory marker read
+ *    (one page load) with the policy of the pending scan.
+ *
+ * @param block : Target block index.
+ *
+ * @return
+ *  - true  : Block verified good.
+ *  - false : Block bad (or out of range).
+ * --------------------------------------------------------------------------- */
+bool BBT_VerifyBlock(uint32_t block)
+{
+	BBT_ScanStats_t st = { 0 };
+
+	if (!BBT_IsUnknown(block))
+		return !BBT_BadBlock(block);
+
+	NandQueue_Flush();
+	return verify_block(block, lazy_cfg.policy, &st);
+}
+
+bool BBT_IsUnknown(uint32_t block)
+{
+	if (block >= TOTAL_BLOCKS)
+		return false;
+
+	return (bbt_unknown[block >> 5] >> (block & 31)) & 1u;
+}
+
+uint32_t BBT_UnknownCount(void)
+{
+	return unknown_count;
+}
+
+/* ===========================================================================
+ * Function: BBT_GoodLowerBound
+ * ===========================================================================
+ * @brief
+ *  - Good blocks in [first, last] that can be promised without verifying
+ *    the unknown ones (format capacity right after a lazy mount).
+ *
+ * @details
+ *  - Known blocks count as they are. Unknown blocks count as good, less
+ *    the factory bad blocks that may still be among them:
+ *    BBT_FACTORY_BAD_MAX minus the bad blocks already known.
+ *  - Exact once BBT_UnknownCount() == 0.
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_GoodLowerBound(uint32_t first, uint32_t last)
+{
+	uint32_t good = 0, unknown = 0;
+
+	for (uint32_t b = first; b <= last && b < TOTAL_BLOCKS; b++)
+	{
+		if (BBT_IsUnknown(b))
+			unknown++;
+		else if (!BBT_BadBlock(b))
+			good++;
+	}
+
+	uint32_t hidden = (bbt_bad_count < BBT_FACTORY_BAD_MAX) ?
+			BBT_FACTORY_BAD_MAX - bbt_bad_count : 0;
+
+	return good + unknown - ((hidden < unknown) ? hidden : unknown);
 }
 
 /* ===========================================================================
@@ -238,7 +935,7 @@ void BBT_MarkRuntimeBad(uint32_t block)
  *  - Checks if a specific block is marked as bad.
  *
  * @details
- *  - Performs an instant lookup in the in-memory BBT_Table[].
+ *  - Performs an instant bit lookup in the in-memory BBT_Bitmap[].
  *  - Used before any read, program, or erase command to skip bad blocks.
  *
  * @param block : Target block index.
@@ -249,10 +946,17 @@ void BBT_MarkRuntimeBad(uint32_t block)
  * --------------------------------------------------------------------------- */
 bool BBT_IsBad(uint32_t block)
 {
-	if (block >= TOTAL_BLOCKS)
-		return true;
+	return BBT_BadBlock(block);
+}
+
+uint32_t BBT_BadCount(void)
+{
+	return bbt_bad_count;
+}
 
-	return BBT_Table[block];
+uint32_t BBT_GoodCount(void)
+{
+	return TOTAL_BLOCKS - bbt_bad_count;
 }
 
 /* ===========================================================================
@@ -262,7 +966,7 @@ bool BBT_IsBad(uint32_t block)
  *  - Prints total, bad, and good block counts to the console.
  *
  * @details
- *  - Iterates over BBT_Table[] to compute and display statistics.
+ *  - Uses the cached bad count, no table scan.
  *  - Provides a simple diagnostic summary of NAND health.
  *
  * @note
@@ -270,13 +974,7 @@ bool BBT_IsBad(uint32_t block)
  * --------------------------------------------------------------------------- */
 void BBT_PrintSummary(void)
 {
-	uint32_t bad = 0;
-
-	for (uint32_t i = 0; i < TOTAL_BLOCKS; i++)
-	{
-		if (BBT_Table[i])
-			bad++;
-	}
+	uint32_t bad = bbt_bad_count;
 
 	printf("[Invalid Table] Total = %d, Bad = %lu, Good = %lu\r\n",
 	TOTAL_BLOCKS, (unsigned long) bad, (unsigned long) (TOTAL_BLOCKS - bad));
@@ -286,23 +984,20 @@ void BBT_PrintSummary(void)
  * Function: BBT_ShowBadBlock
  * ===========================================================================
  * @brief
- *  - Displays indices of all bad blocks stored in BBT_Table[].
+ *  - Displays indices of all bad blocks stored in BBT_Bitmap[].
  *
  * @details
- *  - Iterates through the table and prints block indices for diagnostic purposes.
+ *  - Walks the set bits only (BBT_NextBad) and prints block indices.
  *
  * @note
  *  - Used in debug or production log to visualize bad block distribution.
  * --------------------------------------------------------------------------- */
 void BBT_ShowBadBlock(void)
 {
-	for (uint32_t blk = 0; blk <= TOTAL_BLOCKS; blk++)
+	for (uint32_t blk = BBT_NextBad(0); blk < TOTAL_BLOCKS;
+			blk = BBT_NextBad(blk + 1))
 	{
-		if (BBT_Table[blk])
-		{
-			printf("[Invalid Table] Invalid Block = %lu\r\n",
-					(unsigned long) blk);
-		}
+		printf("[Invalid Table] Invalid Block = %lu\r\n", (unsigned long) blk);
 	}
 }
 
@@ -313,7 +1008,7 @@ void BBT_ShowBadBlock(void)
  *  - Collects all bad block indices into a user-provided array.
  *
  * @details
- *  - Scans the BBT_Table[] and copies block numbers into list[].
+ *  - Walks the set bits of BBT_Bitmap[] and copies block numbers into list[].
  *  - Returns the number of bad blocks detected.
  *  - Used by upper-layer FTL or wear-leveling manager.
  *
@@ -327,16 +1022,13 @@ uint32_t BBT_GetBadBlocks(uint32_t *list, uint32_t maxlen)
 {
 	uint32_t count = 0;
 
-	for (uint32_t blk = 0; blk < TOTAL_BLOCKS; blk++)
+	for (uint32_t blk = BBT_NextBad(0); blk < TOTAL_BLOCKS && count < maxlen;
+			blk = BBT_NextBad(blk + 1))
 	{
-		if (BBT_Table[blk])
-		{
-			if (count < maxlen)
-				list[count] = blk;
-			count++;
-		}
+		list[count++] = blk;
 	}
-	return count;
+
+	return bbt_bad_count;
 }
 
 /* ===========================================================================
@@ -346,8 +1038,9 @@ uint32_t BBT_GetBadBlocks(uint32_t *list, uint32_t maxlen)
  *  - Finds the first valid (non-bad) block for allocation.
  *
  * @details
- *  - Scans from block index 8 to the start of factory reserved region.
- *  - Returns the first usable block that is not marked bad.
+ *  - Searches from block index 8 to the start of factory reserved region.
+ *  - Returns the first usable block that is not marked bad (BBT_AllocGood,
+ *    verified first while a lazy scan is pending).
  *
  * @return
  *  - Block index of first valid block (≥ 8).
@@ -358,13 +1051,102 @@ uint32_t BBT_GetBadBlocks(uint32_t *list, uint32_t maxlen)
  * --------------------------------------------------------------------------- */
 int FindFirstValidBlock(void)
 {
-	for (int block = 8; block < FACTORY_INFO_BLOCK2_START; block++)
-	{
-		if (!BBT_IsBad(block))
-		{
-			return (int) block;
-		}
-	}
+	uint32_t block = BBT_AllocGood(8);
+
+	if (block < FACTORY_INFO_BLOCK2_START)
+		return (int) block;
 
 	return -1;
 }
+
+/* ===========================================================================
+ * Function: BBT_NextGood / BBT_NextBad
+ * ===========================================================================
+ * @brief
+ *  - First good (bit clear) / bad (bit set) block with index >= from.
+ *
+ * @details
+ *  - One 32-block word per step, the hit inside the word by CTZ: at most
+ *    BBT_WORDS (64) word reads, typically one.
+ *  - Iteration: for (b = BBT_NextGood(0); b < TOTAL_BLOCKS;
+ *                    b = BBT_NextGood(b + 1))
+ *
+ * @param from : First block to consider.
+ *
+ * @return
+ *  - Block index, BBT_NONE (TOTAL_BLOCKS) when there is none.
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_NextGood(uint32_t from)
+{
+	return bbt_find(from, 0xFFFFFFFFu);
+}
+
+uint32_t BBT_NextBad(uint32_t from)
+{
+	return bbt_find(from, 0);
+}
+
+/* ===========================================================================
+ * Function: BBT_GoodRank
+ * ===========================================================================
+ * @brief
+ *  - Number of good blocks with index < block (physical -> logical).
+ *
+ * @details
+ *  - Word prefix count + popcount of the partial word, O(1).
+ *
+ * @param block : Block index (TOTAL_BLOCKS -> total good count).
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_GoodRank(uint32_t block)
+{
+	if (block >= TOTAL_BLOCKS)
+		return BBT_GoodCount();
+
+	if (bbt_dirty)
+		bbt_rebuild_index();
+
+	uint32_t w = block >> 5;
+	uint32_t below = ~BBT_Bitmap[w] & ((1u << (block & 31)) - 1u);
+
+	return bbt_rank[w] + (uint32_t) __builtin_popcount(below);
+}
+
+/* ===========================================================================
+ * Function: BBT_SelectGood
+ * ===========================================================================
+ * @brief
+ *  - Physical block of the n-th good block, n counted from 0 (logical ->
+ *    physical).
+ *
+ * @details
+ *  - The select sample of n / BBT_SELECT_STEP gives the starting word, the
+ *    prefix counts the word (a few steps at most unless whole words are
+ *    bad), then the remaining rank is resolved inside the word by clearing
+ *    the lowest good bits.
+ *  - Index rebuilt here after BBT_MarkRuntimeBad / scan (64 popcounts).
+ *
+ * @param n : Logical index, 0 ~ BBT_GoodCount() - 1.
+ *
+ * @return
+ *  - Block index, BBT_NONE when n >= good count.
+ * --------------------------------------------------------------------------- */
+uint32_t BBT_SelectGood(uint32_t n)
+{
+	if (n >= BBT_GoodCount())
+		return BBT_NONE;
+
+	if (bbt_dirty)
+		bbt_rebuild_index();
+
+	uint32_t w = bbt_select[n / BBT_SELECT_STEP];
+
+	while (bbt_rank[w + 1] <= n)
+		w++;
+
+	uint32_t good = ~BBT_Bitmap[w];
+
+	for (uint32_t k = n - bbt_rank[w]; k != 0; k--)
+		good &= good - 1u;             // Drop the lowest good block
+
+	return (w << 5) + (uint32_t) __builtin_ctz(good);
+}
@@ -11,32 +11,197 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
 #include "W25N02KV_Config.h"
 #include "nand_dri_Program.h"
 #include "Read_service.h"
 #include "Program_service.h"
+#include "BlockErase_service.h"
 
-/* Global BBT Table */
-extern bool BBT_Table[TOTAL_BLOCKS];
+/* ---------------------------------------------------------------------------
+ * Bad Block Bitmap
+ * ---------------------------------------------------------------------------
+ * BBT_Bitmap : One bit per block (1 = bad), block b -> word b / 32, bit b % 32
+ *              256 bytes for 2048 blocks.
+ * BBT_WORDS  : 32-bit words in the bitmap
+ * BBT_NONE   : "No block" result of the iterators / select (= TOTAL_BLOCKS)
+ *
+ * Bad count is cached, the good-block rank / select index (per-word prefix
+ * counts + one select sample per BBT_SELECT_STEP good blocks) is rebuilt
+ * lazily after a change.
+ * --------------------------------------------------------------------------- */
+#if (TOTAL_BLOCKS % 32) != 0
+#error "TOTAL_BLOCKS must be a multiple of 32"
+#endif
+
+#define BBT_WORDS          (TOTAL_BLOCKS / 32)
+#define BBT_NONE           ((uint32_t) TOTAL_BLOCKS)
+#define BBT_SELECT_STEP    32
+
+extern uint32_t BBT_Bitmap[BBT_WORDS];
+
+/* ---------------------------------------------------------------------------
+ * On-flash Table (reserved factory info blocks)
+ * ---------------------------------------------------------------------------
+ * BBT_STORE_BLOCK_A / B : Mirrored copies, each block holds
+ *                           page 0      : snapshot (magic, seq, bitmap, CRC-32)
+ *                           page 1 ~ 63 : journal, one runtime bad block per
+ *                                         page (magic, seq, block, CRC-32)
+ *  - The copy with the highest valid seq wins, journal entries must carry
+ *    the same seq. A full journal is folded into a new snapshot (seq + 1),
+ *    copy A rewritten before copy B: one valid copy at any time.
+ * --------------------------------------------------------------------------- */
+#ifndef BBT_STORE_BLOCK_A
+#define BBT_STORE_BLOCK_A   (FACTORY_INFO_BLOCK_END - 2)
+#endif
+
+#ifndef BBT_STORE_BLOCK_B
+#define BBT_STORE_BLOCK_B   (FACTORY_INFO_BLOCK_END - 1)
+#endif
+
+#define BBT_JOURNAL_PAGES   (PAGES_PER_BLOCK - 1)
+
+/* ---------------------------------------------------------------------------
+ * Lazy Verification (BBT_MountLazy)
+ * ---------------------------------------------------------------------------
+ * BBT_BACKGROUND_BLOCKS : Blocks verified per BBT_BackgroundStep call from
+ *                         the idle loop (~30 us each)
+ * BBT_MOUNT_POLICY      : Marker policy when BBT_Mount / BBT_MountLazy find
+ *                         no saved table. The FTL may have written the
+ *                         blocks by then: main[0] is user data, spare[0] is
+ *                         never programmed except by a bad mark (the factory
+ *                         marks both bytes).
+ * BBT_FACTORY_BAD_MAX   : Invalid blocks the device may ship with (>= 2008
+ *                         valid blocks), bound of BBT_GoodLowerBound
+ * --------------------------------------------------------------------------- */
+#ifndef BBT_BACKGROUND_BLOCKS
+#define BBT_BACKGROUND_BLOCKS    64
+#endif
+
+#ifndef BBT_MOUNT_POLICY
+#define BBT_MOUNT_POLICY         BBT_MARKER_SPARE0
+#endif
+
+#define BBT_FACTORY_BAD_MAX      40U
+
+/* ---------------------------------------------------------------------------
+ * Factory Scan Setting
+ * ---------------------------------------------------------------------------
+ * first_block / last_block : Inclusive range (reserved regions allowed)
+ * policy                   : Which marker bytes decide "bad"
+ * progress / user          : Called every BBT_SCAN_PROGRESS_STEP blocks and
+ *                            at the end (NULL -> silent)
+ * --------------------------------------------------------------------------- */
+#ifndef BBT_SCAN_PROGRESS_STEP
+#define BBT_SCAN_PROGRESS_STEP   256
+#endif
+
+typedef enum
+{
+	BBT_MARKER_EITHER = 0,   // main[0] or spare[0] != 0xFF (datasheet §8.1.1)
+	BBT_MARKER_BOTH,         // main[0] and spare[0] != 0xFF
+	BBT_MARKER_SPARE0,       // spare[0] != 0xFF only
+	BBT_MARKER_MAIN0         // main[0] != 0xFF only
+} BBT_MarkerPolicy_t;
+
+typedef struct
+{
+	uint32_t first_block;
+	uint32_t last_block;
+	BBT_MarkerPolicy_t policy;
+	void (*progress)(uint32_t done, uint32_t total, void *user);
+	void *user;
+} BBT_ScanConfig_t;
+
+typedef struct
+{
+	uint32_t scanned;
+	uint32_t bad;
+	uint32_t ecc_fail;       // page0 uncorrectable (markers still evaluated)
+	uint32_t timeouts;       // tRD timeout, block treated as bad
+	uint32_t elapsed_us;
+} BBT_ScanStats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * BBT_Mount
+ *  - Load the on-flash table (2 ~ 3 page reads + journal), factory scan and
+ *    save only when no valid copy exists.
+ *
+ * BBT_Load / BBT_Save
+ *  - Read the newest valid copy (+ journal) / write a new snapshot to both.
+ *
+ * BBT_ScanFactoryBlocks / BBT_MarkRuntimeBad
+ *  - Build the table from factory markers / add a runtime bad block
+ *    (journaled once mounted).
+ *
+ * BBT_MountLazy / BBT_AllocGood / BBT_BackgroundStep
+ *  - Instant-on: without a saved table blocks start "unknown", allocation
+ *    verifies on first use, the idle loop verifies the rest. The table is
+ *    saved by whichever call verifies the last unknown block.
+ *    BBT_VerifyBlock verifies one block on demand.
+ *    BBT_GoodRank / BBT_SelectGood need BBT_UnknownCount() == 0.
+ *
+ * BBT_GoodLowerBound
+ *  - Good blocks in a range, unknown ones counted good except for the
+ *    factory bad blocks not found yet (capacity without a scan).
+ *
+ * BBT_ScanDefaultConfig / BBT_Scan
+ *  - Scan engine: one page load per block, configurable range / marker
+ *    policy, summary instead of per-block output.
+ *
+ * BBT_IsBad / BBT_BadCount / BBT_GoodCount
+ *  - Bit lookup, cached totals.
+ *
+ * BBT_NextGood / BBT_NextBad
+ *  - First good / bad block >= from (word scan, CTZ), BBT_NONE at the end.
+ *
+ * BBT_GoodRank / BBT_SelectGood
+ *  - Good blocks below `block` / physical block of the n-th good block
+ *    (logical -> physical without a scan), BBT_NONE when n >= good count.
+ * ------------------------------------------------------------------------- */
 
 /* Core Management */
+bool BBT_Mount(void);
+bool BBT_Load(void);
+bool BBT_Save(void);
+bool BBT_MountLazy(void);
+uint32_t BBT_AllocGood(uint32_t from);
+bool BBT_VerifyBlock(uint32_t block);
+uint32_t BBT_BackgroundStep(uint32_t budget);
+bool BBT_IsUnknown(uint32_t block);
+uint32_t BBT_UnknownCount(void);
+uint32_t BBT_GoodLowerBound(uint32_t first, uint32_t last);
 void BBT_ScanFactoryBlocks(void);
+void BBT_ScanDefaultConfig(BBT_ScanConfig_t *cfg);
+bool BBT_Scan(const BBT_ScanConfig_t *cfg, BBT_ScanStats_t *stats);
 void BBT_MarkRuntimeBad(uint32_t block);
 
 /* Query / Output */
 bool BBT_IsBad(uint32_t block);
+uint32_t BBT_BadCount(void);
+uint32_t BBT_GoodCount(void);
 void BBT_PrintSummary(void);
 void BBT_ShowBadBlock(void);
 uint32_t BBT_GetBadBlocks(uint32_t *list, uint32_t maxlen);
 
+/* Iterator / Rank / Select */
+uint32_t BBT_NextGood(uint32_t from);
+uint32_t BBT_NextBad(uint32_t from);
+uint32_t BBT_GoodRank(uint32_t block);
+uint32_t BBT_SelectGood(uint32_t n);
+
 int FindFirstValidBlock(void);
+uint32_t BBT_Crc32(const void *data, uint32_t len);
 
 /* Inline Helper */
 static inline bool BBT_BadBlock(uint32_t block)
 {
-	return (block >= TOTAL_BLOCKS) ? true : BBT_Table[block];
+	return (block >= TOTAL_BLOCKS) ?
+			true : ((BBT_Bitmap[block >> 5] >> (block & 31)) & 1u) != 0;
 }
 
 #endif /* SERVICE_BBT_SERVICE_H_ */
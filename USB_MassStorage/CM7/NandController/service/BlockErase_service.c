@@ -15,6 +15,8 @@
  *  - Performs a full 128-KB block erase operation on the W25N02KV NAND array.
  *
  * @details
+ *  - Blocking wrapper: one NandQueue request, submitted and waited for
+ *    (NandQueue_Run). Asynchronous callers submit the request themselves.
  *  - High-level service routine that executes a complete block erase sequence,
  *    including pre-erase unlock, write enable, erase command, and status polling.
  *  - The erase unit is one block (128 KB = 64 pages × 2 KB).
@@ -22,14 +24,16 @@
  *  - Internally checks for timeout, erase-fail, and WEL (Write Enable Latch) status.
  *
  *  Command Sequence:
- *    1. [SetBlockProtect]   Unlock all blocks (BP = 0)
+ *    1. [SetBlockProtect]   Unlock all blocks (BP = 0), skipped when the
+ *                           SR1 shadow already shows BP = 0
  *    2. [06h]               Write Enable
  *    3. [D8h + BA2:BA1:BA0] Block Erase command
- *    4. Poll SR1[0] (OIP) until ready
- *    5. Check SR2[2] (E_FAIL)
- *    6. Confirm WEL cleared (SR1[1] = 0)
+ *    4. Wait until OIP = 0 (WaitComplete_service)
+ *    5. Check E_FAIL from the same SR3 read
+ *    6. Confirm WEL cleared from the same SR3 read
  *
- * @param block_addr : 24-bit target block address (block index × 128 KB).
+ * @param block_addr : Block index (0 ~ TOTAL_BLOCKS - 1), sent to D8h as the
+ *                     page address of page 0 (PAGE_ADDR(block, 0)).
  * @param timeout_ms : Timeout value in milliseconds for the operation.
  *
  * @return
@@ -43,39 +47,11 @@
  * --------------------------------------------------------------------------- */
 bool BlockErase128K_service(uint32_t block_addr, uint32_t timeout_ms)
 {
-	if (!SetBlockProtect_Service(0x0, false))
-	{
-		printf("[Init] Failed to unlock all Blocks\r\n");
-	}
+	NandRequest_t req = { 0 };
 
-	if (!WriteEnable_Service())
-	{
-		printf("[Block Erase] Write Enable Failed\r\n");
-		return false;
-	}
+	req.type = NAND_REQ_ERASE;
+	req.page = block_addr;
+	req.timeout_us = timeout_ms * 1000U;
 
-	BlockErase128KB(block_addr);
-
-	if (!IsBusyWithTimeout_service(timeout_ms))
-	{
-		printf("[Block Erase] Timeout\r\n");
-		return false;
-	}
-
-	printf("[SR After ] SR1=0x%02X SR2=0x%02X SR3=0x%02X\r\n", GetSR1(),
-			GetSR2(), GetSR3());
-
-	if (CheckEraseFail_service())
-	{
-		printf("[Block Erase] Failed (E-FAIL = 1)\r\n");
-		return false;
-	}
-
-	if (IsWriteEnableLatch_service())
-	{
-		printf("[Block Erase] Warning: WEL not cleared after erase\r\n");
-	}
-
-	printf("[Block Erase] Success (Block = 0x%06lX)\r\n", block_addr);
-	return true;
+	return NandQueue_Run(&req);
 }
@@ -11,6 +11,7 @@
 
 #include "Protect_service.h"
 #include "nand_dri_BlockErase.h"
+#include "NandQueue_service.h"
 #include "StatusRegister_service.h"
 
 // 建議 Timeout
@@ -0,0 +1,367 @@
+/*
+ *  ContinuousRead_service.c
+ *
+ *  Created on: Nov 13, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#include <string.h>
+#include "ContinuousRead_service.h"
+
+/* ---------------------------------------------------------------------------
+ * ECC class helpers (severity: OK < corrected < threshold < uncorrectable)
+ * --------------------------------------------------------------------------- */
+static uint8_t ecc_rank(ECC_Status_t ecc)
+{
+	switch (ecc)
+	{
+	case ECC_SUCCESS_CORRECTED:
+		return 1;
+	case ECC_CORRECTED_THRESHOLD:
+		return 2;
+	case ECC_UNCORRECTABLE:
+		return 3;
+	default:
+		return 0;
+	}
+}
+
+static bool ecc_alarm(ECC_Status_t ecc)
+{
+	return (ecc == ECC_CORRECTED_THRESHOLD || ecc == ECC_UNCORRECTABLE);
+}
+
+static void report_page(ContRead_t *h, uint32_t page, ECC_Status_t ecc)
+{
+	if (ecc == ECC_UNCORRECTABLE)
+	{
+		NAND_LOG(READ_ECC_FAIL, page, 0, PAGE_MAIN_SIZE);
+		h->failed++;
+		h->pull_fail = true;
+		if (h->first_fail == CONTREAD_NO_PAGE)
+			h->first_fail = page;
+	}
+	else
+	{
+		NAND_LOG(READ_ECC_THRESHOLD, page, 0, PAGE_MAIN_SIZE);
+		h->threshold++;
+	}
+
+	if (h->ecc_cb != NULL)
+		h->ecc_cb(page, ecc, h->user);
+}
+
+/* ---------------------------------------------------------------------------
+ * 13h + tRD, SR3[ECC] restarts with this page
+ * --------------------------------------------------------------------------- */
+static bool load_page(uint32_t page, ECC_Status_t *ecc)
+{
+	uint8_t sr3 = 0;
+
+	PageDataRead(page);
+
+	if (!Nand_WaitReadyOp(NAND_OP_READ, 0, &sr3))
+	{
+		NAND_LOG(READ_TIMEOUT, page);
+		return false;
+	}
+
+	*ecc = DecodeECCStatus_service(sr3);
+	return true;
+}
+
+static bool restart(ContRead_t *h)
+{
+	ECC_Status_t ecc;
+
+	h->reloads++;
+	h->reload = false;
+
+	if (!load_page(h->page, &ecc))
+		return false;
+
+	/// A bad start page is known now: clock it alone, then reload behind it
+	h->ecc = ecc;
+	h->single = ecc_alarm(ecc);
+	h->single_ecc = ecc;
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Accumulated class went to threshold / uncorrectable: probe the pages of
+ * the burst one by one (13h + SR3, no data transfer)
+ * --------------------------------------------------------------------------- */
+static bool locate_pages(ContRead_t *h, uint32_t first, uint32_t count)
+{
+	for (uint32_t p = first; p < first + count; p++)
+	{
+		ECC_Status_t ecc;
+
+		if (!load_page(p, &ecc))
+			return false;
+
+		if (ecc_alarm(ecc))
+			report_page(h, p, ecc);
+	}
+
+	/// The cache no longer holds the stream, `page` was possibly the culprit
+	/// (prefetched): the next burst starts with 13h on it
+	h->reload = true;
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * One read command over *pages whole pages (Continuous Read Mode)
+ * --------------------------------------------------------------------------- */
+static bool read_burst(ContRead_t *h, uint8_t *buf, uint32_t *pages)
+{
+	uint32_t first = h->page;
+	uint8_t sr3;
+
+	if (h->reload && !restart(h))
+		return false;
+
+	if (h->single)
+		*pages = 1;
+	if (*pages > TOTAL_PAGES - first)
+		*pages = TOTAL_PAGES - first;     // No wrap past the last page
+	if (*pages == 0)
+		return false;
+
+	/// Step 1: Data phase, the device crosses page boundaries by itself
+	uint16_t len = (uint16_t) (*pages * PAGE_MAIN_SIZE);
+
+	if (Nand_GetIoMode() == NAND_IO_SINGLE)
+		ContinuousReadData(buf, len);
+	else
+		ContinuousReadQuadOutput(buf, len);
+
+	h->page += *pages;
+	h->pages += *pages;
+	h->bursts++;
+
+	/// Step 2: One SR3 read, normally ready (next page read during output)
+	sr3 = GetSR3();
+	if ((sr3 & SR3_BUSY) && !Nand_WaitReadyOp(NAND_OP_GENERIC, 0, &sr3))
+	{
+		NAND_LOG(READ_TIMEOUT, h->page);
+		return false;
+	}
+
+	/// Step 3: Per-page ECC
+	if (h->single)
+	{
+		report_page(h, first, h->single_ecc);
+		h->single = false;
+		h->reload = true;
+		return true;
+	}
+
+	ECC_Status_t ecc = DecodeECCStatus_service(sr3);
+
+	if (ecc_rank(ecc) <= ecc_rank(h->ecc))
+		return true;
+
+	h->ecc = ecc;
+
+	if (!ecc_alarm(ecc))
+	{
+		h->corrected++;
+		return true;
+	}
+
+	return locate_pages(h, first, *pages);
+}
+
+/* ===========================================================================
+ * Function: ContRead_Open
+ * ===========================================================================
+ * @brief
+ *  - Start a sequential main-area stream at `page` (Continuous Read Mode).
+ *
+ * @details
+ *  - Queued requests are finished first (NandQueue_Flush), then SR2 is set
+ *    to BUF = 0, ECC-E = 1 (no bus write when already so, SR2 shadow).
+ *  - 13h on the start page and one tRD wait: the only tR the stream pays
+ *    unless an ECC failure has to be located.
+ *
+ * @param h    : Stream handle (caller storage).
+ * @param page : First page (0 ~ TOTAL_PAGES - 1).
+ * @param cb   : Per-page ECC report (threshold / uncorrectable), may be NULL.
+ * @param user : Passed to `cb`.
+ *
+ * @return
+ *  - true  : Stream open
+ *  - false : Invalid page, SR2 write failed or tRD timeout (mode restored)
+ * --------------------------------------------------------------------------- */
+bool ContRead_Open(ContRead_t *h, uint32_t page, ContRead_EccCallback_t cb,
+		void *user)
+{
+	if (h == NULL || page >= TOTAL_PAGES)
+		return false;
+
+	NandQueue_Flush();
+
+	h->page = page;
+	h->ecc = ECC_SUCCESS;
+	h->open = false;
+	h->reload = false;
+	h->single = false;
+	h->pull_fail = false;
+	h->tail_fail = false;
+	h->tail_pos = 0;
+	h->tail_len = 0;
+	h->ecc_cb = cb;
+	h->user = user;
+	h->pages = 0;
+	h->bursts = 0;
+	h->reloads = 0;
+	h->corrected = 0;
+	h->threshold = 0;
+	h->failed = 0;
+	h->first_fail = CONTREAD_NO_PAGE;
+
+	h->saved_buf = IsBufferMode_service();
+	h->saved_ecc = IsECCEnabled_service();
+
+	if (!SetReadMode_Service(false, true))
+	{
+		SetReadMode_Service(h->saved_buf, h->saved_ecc);
+		return false;
+	}
+
+	h->open = true;
+
+	if (!restart(h))
+	{
+		ContRead_Close(h);
+		return false;
+	}
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: ContRead_Pull
+ * ===========================================================================
+ * @brief
+ *  - Copy the next `len` bytes of the stream into `buf`.
+ *
+ * @details
+ *  - Whole pages are clocked straight into `buf`, CONTREAD_BURST_PAGES per
+ *    read command, each command resuming at column 0 of the page the
+ *    device already holds: no 13h and no tR between pages or pulls.
+ *  - A pull ending inside a page clocks that page into h->tail, the next
+ *    pull starts from there (no bytes clocked twice).
+ *  - ECC: one SR3 read per command. When the accumulated class reaches
+ *    threshold / uncorrectable the pages of that command are probed with
+ *    13h to report the exact page(s), then the stream reloads (13h).
+ *
+ * @param h   : Open stream.
+ * @param buf : [out] Destination.
+ * @param len : Bytes to read.
+ *
+ * @return
+ *  - true  : All data delivered, no uncorrectable page in it
+ *  - false : Uncorrectable page in the data (copied anyway, see
+ *            h->first_fail), timeout or end of device
+ * --------------------------------------------------------------------------- */
+bool ContRead_Pull(ContRead_t *h, uint8_t *buf, uint32_t len)
+{
+	if (h == NULL || !h->open || (buf == NULL && len != 0))
+		return false;
+
+	h->pull_fail = false;
+
+	/// Step 1: Rest of the page staged by the previous pull
+	if (h->tail_pos < h->tail_len && len != 0)
+	{
+		uint32_t n = h->tail_len - h->tail_pos;
+
+		if (n > len)
+			n = len;
+
+		memcpy(buf, &h->tail[h->tail_pos], n);
+		h->tail_pos += (uint16_t) n;
+		buf += n;
+		len -= n;
+
+		if (h->tail_fail)
+			h->pull_fail = true;
+	}
+
+	/// Step 2: Whole pages, straight into the caller buffer
+	while (len >= PAGE_MAIN_SIZE)
+	{
+		uint32_t pages = len / PAGE_MAIN_SIZE;
+
+		if (pages > CONTREAD_BURST_PAGES)
+			pages = CONTREAD_BURST_PAGES;
+
+		if (!read_burst(h, buf, &pages))
+			return false;
+
+		buf += pages * PAGE_MAIN_SIZE;
+		len -= pages * PAGE_MAIN_SIZE;
+	}
+
+	/// Step 3: Partial page through the staging buffer
+	if (len != 0)
+	{
+		uint32_t pages = 1;
+		bool fail = h->pull_fail;
+
+		h->pull_fail = false;
+
+		if (!read_burst(h, h->tail, &pages))
+		{
+			h->tail_pos = 0;
+			h->tail_len = 0;
+			return false;
+		}
+
+		h->tail_fail = h->pull_fail;
+		h->pull_fail = h->pull_fail || fail;
+		h->tail_len = PAGE_MAIN_SIZE;
+		h->tail_pos = (uint16_t) len;
+		memcpy(buf, h->tail, len);
+	}
+
+	return !h->pull_fail;
+}
+
+/* ===========================================================================
+ * Function: ContRead_Close
+ * ===========================================================================
+ * @brief
+ *  - End the stream and restore the buffer / ECC mode found at open.
+ *
+ * @details
+ *  - The data phase already ended with /CS high after the last command,
+ *    the device may still be moving the next page into the cache: wait
+ *    for BUSY = 0, then write SR2 back.
+ *
+ * @return
+ *  - true  : Mode restored
+ *  - false : Not open, timeout or SR2 write failed
+ * --------------------------------------------------------------------------- */
+bool ContRead_Close(ContRead_t *h)
+{
+	uint8_t sr3 = 0;
+
+	if (h == NULL || !h->open)
+		return false;
+
+	h->open = false;
+	h->tail_pos = 0;
+	h->tail_len = 0;
+
+	bool ok = Nand_WaitReadyOp(NAND_OP_GENERIC, 0, &sr3);
+
+	if (!SetReadMode_Service(h->saved_buf, h->saved_ecc))
+		ok = false;
+
+	NAND_LOG(CONTREAD_CLOSE, h->pages, h->bursts, h->reloads, h->failed);
+	return ok;
+}
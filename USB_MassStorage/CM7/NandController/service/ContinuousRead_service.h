@@ -0,0 +1,105 @@
+/*
+ *  ContinuousRead_service.h
+ *
+ *  Created on: Nov 13, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#ifndef SERVICE_CONTINUOUSREAD_SERVICE_H_
+#define SERVICE_CONTINUOUSREAD_SERVICE_H_
+
+#include "nand_dri_Read.h"
+#include "NandQueue_service.h"
+#include "Protect_service.h"
+#include "StatusRegister_service.h"
+
+/* ---------------------------------------------------------------------------
+ * Continuous Read Setting
+ * ---------------------------------------------------------------------------
+ * CONTREAD_BURST_PAGES : Whole pages clocked by one read command (1 ~ 31,
+ *                        the transport length is 16-bit). One SR3 read per
+ *                        burst checks the accumulated ECC class.
+ * CONTREAD_NO_PAGE     : "No page" value of first_fail
+ * --------------------------------------------------------------------------- */
+#ifndef CONTREAD_BURST_PAGES
+#define CONTREAD_BURST_PAGES   16
+#endif
+
+#if (CONTREAD_BURST_PAGES < 1) || (CONTREAD_BURST_PAGES * PAGE_MAIN_SIZE > 0xFFFF)
+#error "CONTREAD_BURST_PAGES must be 1 ~ 31"
+#endif
+
+#define CONTREAD_NO_PAGE       0xFFFFFFFFU
+
+/* ---------------------------------------------------------------------------
+ * Per-page ECC report (threshold reached / uncorrectable pages only)
+ * --------------------------------------------------------------------------- */
+typedef void (*ContRead_EccCallback_t)(uint32_t page, ECC_Status_t ecc,
+		void *user);
+
+/* ---------------------------------------------------------------------------
+ * Stream Handle (caller storage, ~2.1 KB with the staging page)
+ * ---------------------------------------------------------------------------
+ * page        : Page the device outputs next at column 0
+ * ecc         : SR3 ECC class accumulated since the last 13h
+ * reload      : Next burst starts with 13h on `page` (after a failure search)
+ * single      : `page` itself reported >= threshold by 13h, clock it alone
+ * tail        : Page clocked for a pull that ended inside it, tail_pos bytes
+ *               already handed out
+ *
+ * pages / bursts / reloads       : Pages clocked, read commands, 13h issued
+ * corrected / threshold / failed : ECC events (corrected: per burst only)
+ * first_fail                     : First uncorrectable page of the stream
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t page;
+	ECC_Status_t ecc;
+	ECC_Status_t single_ecc;
+	bool open;
+	bool reload;
+	bool single;
+	bool saved_buf;
+	bool saved_ecc;
+	bool pull_fail;
+	bool tail_fail;
+
+	uint16_t tail_pos;
+	uint16_t tail_len;
+	uint8_t tail[PAGE_MAIN_SIZE];
+
+	ContRead_EccCallback_t ecc_cb;
+	void *user;
+
+	uint32_t pages;
+	uint32_t bursts;
+	uint32_t reloads;
+	uint32_t corrected;
+	uint32_t threshold;
+	uint32_t failed;
+	uint32_t first_fail;
+} ContRead_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * ContRead_Open
+ *  - Flush the NandQueue, switch to Continuous Read Mode (BUF = 0) and
+ *    load the start page (13h). The stream owns the device until closed:
+ *    no other NAND access in between.
+ *
+ * ContRead_Pull
+ *  - Next `len` bytes of main area data, across page and block boundaries.
+ *    false -> an uncorrectable page was handed out (data still copied),
+ *    timeout, or end of device.
+ *
+ * ContRead_Close
+ *  - Restore the BUF / ECC-E setting found by ContRead_Open.
+ * ------------------------------------------------------------------------- */
+bool ContRead_Open(ContRead_t *h, uint32_t page, ContRead_EccCallback_t cb,
+		void *user);
+bool ContRead_Pull(ContRead_t *h, uint8_t *buf, uint32_t len);
+bool ContRead_Close(ContRead_t *h);
+
+#endif /* SERVICE_CONTINUOUSREAD_SERVICE_H_ */
@@ -0,0 +1,461 @@
+/*
+ *  NandQueue_service.c
+ *
+ *  Created on: Nov 12, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#include "NandQueue_service.h"
+
+#if (NAND_QUEUE_DEPTH & (NAND_QUEUE_DEPTH - 1)) != 0
+#error "NAND_QUEUE_DEPTH must be a power of 2"
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Engine state
+ * ---------------------------------------------------------------------------
+ * - queue      : Ring of request pointers, q_head written by submitters,
+ *                q_tail by the engine.
+ * - active     : Request whose array operation is running (or NULL).
+ * - wait       : Non-blocking ready wait of the active request.
+ * - lock       : Engine re-entry guard (main loop vs timer ISR).
+ * --------------------------------------------------------------------------- */
+static NandRequest_t *queue[NAND_QUEUE_DEPTH];
+static volatile uint32_t q_head = 0;
+static volatile uint32_t q_tail = 0;
+
+static NandRequest_t *active = NULL;
+static NandReadyWait_t wait;
+static uint8_t lock = 0;
+
+static NandQueueStats_t stats;
+
+/* ---------------------------------------------------------------------------
+ * Cache read / load through the selected data I/O mode (Nand_SetIoMode)
+ * --------------------------------------------------------------------------- */
+static void read_cache(uint16_t col_addr, uint8_t *buf, uint16_t len)
+{
+	switch (Nand_GetIoMode())
+	{
+	case NAND_IO_QUAD_OUTPUT:
+		FastReadQuadOutput(col_addr, buf, len);
+		break;
+
+	case NAND_IO_QUAD_IO:
+		FastReadQuadIO(col_addr, buf, len);
+		break;
+
+	default:
+		ReadData(col_addr, buf, len);
+		break;
+	}
+}
+
+static void load_cache(bool random, uint16_t col_addr, const uint8_t *buf,
+		uint16_t len)
+{
+	bool quad = (Nand_GetIoMode() != NAND_IO_SINGLE);
+
+	if (random && quad)
+		QuadRandomLoadProgramData(col_addr, buf, len);
+	else if (random)
+		RandomLoadProgramData(col_addr, buf, len);
+	else if (quad)
+		QuadLoadProgramData(col_addr, buf, len);
+	else
+		LoadProgramData(col_addr, buf, len);
+}
+
+/* ---------------------------------------------------------------------------
+ * State ACTIVE: issue the command phase, the array is busy afterwards
+ * --------------------------------------------------------------------------- */
+static void start_request(NandRequest_t *r)
+{
+	r->state = NAND_REQ_ACTIVE;
+
+	switch (r->type)
+	{
+	case NAND_REQ_READ:
+		/// 13h, page -> cache
+		PageDataRead(r->page);
+		Nand_ReadyBegin(&wait, NAND_OP_READ, r->timeout_us);
+		break;
+
+	case NAND_REQ_PROGRAM:
+		/// 06h (not read back) -> data load -> 10h
+		WriteEnable();
+		load_cache(r->random, r->col, r->buf, r->len);
+		ProgramExecute(r->page);
+		Nand_ReadyBegin(&wait, NAND_OP_PROGRAM, r->timeout_us);
+		break;
+
+	case NAND_REQ_COPY:
+		/// Phase 0: 13h, source page -> cache (ECC corrected on the way)
+		r->phase = 0;
+		r->src_ecc = ECC_SUCCESS;
+		PageDataRead(r->page);
+		Nand_ReadyBegin(&wait, NAND_OP_READ, r->timeout_us);
+		break;
+
+	case NAND_REQ_ERASE:
+	default:
+		/// Unlock only when the SR1 shadow shows protection
+		if (GetBlockProtectBits() != 0 && !SetBlockProtect_Service(0x0, false))
+			NAND_LOG(ERASE_UNLOCK_FAIL);
+
+		WriteEnable();
+		BlockErase128KB(PAGE_ADDR(r->page, 0));
+		Nand_ReadyBegin(&wait, NAND_OP_ERASE, r->timeout_us);
+		break;
+	}
+}
+
+/* ---------------------------------------------------------------------------
+ * Copy phase 1: source loaded, patch the cache (84h) and program it to `dst`
+ * ---------------------------------------------------------------------------
+ * Returns false when the request ends here (source timeout / uncorrectable:
+ * a corrupt page is not propagated).
+ * --------------------------------------------------------------------------- */
+static bool continue_request(NandRequest_t *r, NandWaitState_t st)
+{
+	if (r->type != NAND_REQ_COPY || r->phase != 0 || st != NAND_WAIT_READY)
+		return false;
+
+	r->src_ecc = DecodeECCStatus_service(wait.sr3);
+	if (r->src_ecc == ECC_UNCORRECTABLE)
+		return false;
+
+	r->phase = 1;
+	WriteEnable();
+	for (uint8_t i = 0; i < r->patch_count; i++)
+		load_cache(true, r->patch[i].col, r->patch[i].data, r->patch[i].len);
+	ProgramExecute(r->dst);
+	Nand_ReadyBegin(&wait, NAND_OP_PROGRAM, r->timeout_us);
+
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * State DONE: data out (read), result from the completion SR3
+ * --------------------------------------------------------------------------- */
+static void finish_request(NandRequest_t *r, NandWaitState_t st)
+{
+	bool ready = (st == NAND_WAIT_READY);
+
+	DecodeCompletion_service(wait.sr3, ready, &r->done);
+
+	if (!ready)
+		NAND_LOG(WAIT_TIMEOUT, wait.op, Nand_GetReadyStats()->elapsed_us, wait.sr3);
+
+	switch (r->type)
+	{
+	case NAND_REQ_READ:
+		if (!ready)
+		{
+			NAND_LOG(READ_TIMEOUT, r->page);
+			r->ok = false;
+			break;
+		}
+
+		read_cache(r->col, r->buf, r->len);
+
+		switch (r->done.ecc)
+		{
+		case ECC_SUCCESS:
+			NAND_LOG(READ_ECC_OK, r->page, r->col, r->len);
+			break;
+		case ECC_SUCCESS_CORRECTED:
+			NAND_LOG(READ_ECC_CORRECTED, r->page, r->col, r->len);
+			break;
+		case ECC_CORRECTED_THRESHOLD:
+			NAND_LOG(READ_ECC_THRESHOLD, r->page, r->col, r->len);
+			break;
+		case ECC_UNCORRECTABLE:
+		default:
+			NAND_LOG(READ_ECC_FAIL, r->page, r->col, r->len);
+			break;
+		}
+
+		r->ok = (r->done.ecc != ECC_UNCORRECTABLE);
+		break;
+
+	case NAND_REQ_PROGRAM:
+		r->ok = ready && !r->done.p_fail && !r->done.wel;
+
+		if (r->ok)
+			NAND_LOG(PROGRAM_OK, r->page, r->col, r->len);
+		else if (ready)
+			NAND_LOG(PROGRAM_FAIL, r->page, r->done.p_fail, r->done.wel);
+		break;
+
+	case NAND_REQ_COPY:
+		if (r->phase == 0)
+		{
+			/// Ended in the source load, nothing programmed
+			r->ok = false;
+			if (!ready)
+				NAND_LOG(READ_TIMEOUT, r->page);
+			else
+				NAND_LOG(COPY_SOURCE_FAIL, r->page, r->dst);
+		}
+		else
+		{
+			r->ok = ready && !r->done.p_fail && !r->done.wel;
+
+			if (r->ok)
+				NAND_LOG(COPY_OK, r->page, r->dst, r->src_ecc, r->patch_count);
+			else if (ready)
+				NAND_LOG(PROGRAM_FAIL, r->dst, r->done.p_fail, r->done.wel);
+		}
+		r->done.ecc = r->src_ecc;
+		break;
+
+	case NAND_REQ_ERASE:
+	default:
+		r->ok = ready && !r->done.e_fail && !r->done.wel;
+
+		if (!ready)
+			NAND_LOG(ERASE_TIMEOUT, r->page);
+		else if (r->done.e_fail)
+			NAND_LOG(ERASE_FAIL, r->page, r->done.sr3);
+		else if (r->done.wel)
+			NAND_LOG(ERASE_WEL_SET, r->page, r->done.sr3);
+		else
+			NAND_LOG(ERASE_OK, r->page);
+		break;
+	}
+
+	stats.completed++;
+	if (!r->ok)
+		stats.failed++;
+
+	active = NULL;
+	r->state = NAND_REQ_DONE;
+}
+
+/* ---------------------------------------------------------------------------
+ * Engine step: finish / start as many requests as possible without waiting
+ * ---------------------------------------------------------------------------
+ * Completion callbacks run after the lock is released: a callback may
+ * Submit, Wait or Run (the engine is free again). cb / user are taken before
+ * the lock is dropped, the owner may reuse a DONE descriptor at once.
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	NandRequest_t *req;
+	NandReq_Callback_t cb;
+	void *user;
+} NandDone_t;
+
+static uint32_t queue_step(bool block)
+{
+	NandDone_t done[NAND_QUEUE_DEPTH + 1];
+	uint32_t n_done = 0;
+	uint32_t next_us = NAND_QUEUE_IDLE;
+
+	if (__atomic_exchange_n(&lock, 1, __ATOMIC_ACQUIRE))
+		return 0;                       // Engine already running (ISR / thread)
+
+	for (;;)
+	{
+		if (active == NULL)
+		{
+			uint32_t tail = q_tail;
+
+			/// Completion list full: hand the callbacks out first
+			if (n_done == NAND_QUEUE_DEPTH + 1)
+			{
+				next_us = 0;
+				break;
+			}
+
+			if (tail == __atomic_load_n(&q_head, __ATOMIC_ACQUIRE))
+			{
+				next_us = NAND_QUEUE_IDLE;
+				break;
+			}
+
+			active = queue[tail & (NAND_QUEUE_DEPTH - 1)];
+			q_tail = tail + 1;
+			start_request(active);
+		}
+
+		NandWaitState_t st = Nand_ReadyPoll(&wait, block, &next_us);
+
+		if (st == NAND_WAIT_PENDING)
+			break;
+
+		if (!continue_request(active, st))
+		{
+			NandRequest_t *r = active;
+
+			done[n_done].req = r;
+			done[n_done].cb = r->cb;
+			done[n_done].user = r->user;
+			n_done++;
+			finish_request(r, st);
+		}
+	}
+
+	__atomic_store_n(&lock, 0, __ATOMIC_RELEASE);
+
+	for (uint32_t i = 0; i < n_done; i++)
+	{
+		if (done[i].cb != NULL)
+			done[i].cb(done[i].req, done[i].user);
+	}
+
+	return next_us;
+}
+
+/* ===========================================================================
+ * Function: NandQueue_Submit
+ * ===========================================================================
+ * @brief
+ *  - Queue a read / program / erase request, return immediately.
+ *
+ * @details
+ *  - The request is started by the next NandQueue_Poll() (or Wait / Run)
+ *    once the requests ahead of it are done. Requests run strictly in
+ *    submission order, one array operation at a time.
+ *  - Single submitter context (main loop / USB task).
+ *
+ * @param req : Request descriptor, owned by the engine until state = DONE.
+ *
+ * @return
+ *  - true  : Queued
+ *  - false : Queue full, invalid request, or request still in flight
+ * --------------------------------------------------------------------------- */
+bool NandQueue_Submit(NandRequest_t *req)
+{
+	if (req == NULL || req->state == NAND_REQ_QUEUED
+			|| req->state == NAND_REQ_ACTIVE)
+		return false;
+
+	if (req->type != NAND_REQ_ERASE && req->buf == NULL && req->len != 0)
+		return false;
+
+	if (req->type == NAND_REQ_COPY && req->patch == NULL && req->patch_count != 0)
+		return false;
+
+	uint32_t head = q_head;
+	uint32_t depth = head - q_tail;
+
+	if (depth >= NAND_QUEUE_DEPTH)
+	{
+		stats.queue_full++;
+		return false;
+	}
+
+	req->ok = false;
+	req->state = NAND_REQ_QUEUED;
+	queue[head & (NAND_QUEUE_DEPTH - 1)] = req;
+	__atomic_store_n(&q_head, head + 1, __ATOMIC_RELEASE);
+
+	stats.submitted++;
+	if (depth + 1 > stats.max_depth)
+		stats.max_depth = depth + 1;
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: NandQueue_Poll
+ * ===========================================================================
+ * @brief
+ *  - Advance the operation engine, never waits on the device.
+ *
+ * @details
+ *  - One call may read SR3 once, finish the active request (data out,
+ *    callback) and start the next one. Before tRD / tPP / tBE can have
+ *    elapsed it costs no bus traffic at all.
+ *  - The return value lets a scheduler sleep: call again after that many
+ *    microseconds (0 -> as soon as possible).
+ *
+ * @return
+ *  - Microseconds until the next useful call, NAND_QUEUE_IDLE when empty.
+ * --------------------------------------------------------------------------- */
+uint32_t NandQueue_Poll(void)
+{
+	return queue_step(false);
+}
+
+/* ===========================================================================
+ * Function: NandQueue_Wait / NandQueue_Run
+ * ===========================================================================
+ * @brief
+ *  - Drive the engine until `req` is done (blocking services).
+ *
+ * @details
+ *  - Sleeps the time returned by the engine between steps, the AUTO ready
+ *    mode may hand the whole busy time to hardware status polling.
+ *  - Run waits for a free queue slot first.
+ *
+ * @return
+ *  - true  : Request done and successful (req->ok)
+ *  - false : Failed, or `req` was never submitted
+ * --------------------------------------------------------------------------- */
+bool NandQueue_Wait(NandRequest_t *req)
+{
+	if (req == NULL || req->state == NAND_REQ_FREE)
+		return false;
+
+	while (req->state != NAND_REQ_DONE)
+	{
+		uint32_t next_us = queue_step(true);
+
+		if (next_us == NAND_QUEUE_IDLE)
+			break;
+		if (next_us != 0)
+			NandClock_DelayUs(next_us);
+	}
+
+	return (req->state == NAND_REQ_DONE) && req->ok;
+}
+
+bool NandQueue_Run(NandRequest_t *req)
+{
+	while (!NandQueue_Submit(req))
+	{
+		if (req == NULL || req->state == NAND_REQ_QUEUED
+				|| req->state == NAND_REQ_ACTIVE)
+			return false;
+
+		uint32_t next_us = queue_step(true);
+
+		if (next_us == NAND_QUEUE_IDLE)
+			return false;               // Not a capacity problem
+		if (next_us != 0)
+			NandClock_DelayUs(next_us);
+	}
+
+	return NandQueue_Wait(req);
+}
+
+/* ---------------------------------------------------------------------------
+ * Function: NandQueue_Flush
+ * ---------------------------------------------------------------------------
+ * @brief
+ *  - Run the engine until every queued request is done.
+ * --------------------------------------------------------------------------- */
+void NandQueue_Flush(void)
+{
+	uint32_t next_us;
+
+	while ((next_us = queue_step(true)) != NAND_QUEUE_IDLE)
+	{
+		if (next_us != 0)
+			NandClock_DelayUs(next_us);
+	}
+}
+
+uint32_t NandQueue_Pending(void)
+{
+	return (q_head - q_tail) + ((active != NULL) ? 1 : 0);
+}
+
+const NandQueueStats_t* NandQueue_GetStats(void)
+{
+	return &stats;
+}
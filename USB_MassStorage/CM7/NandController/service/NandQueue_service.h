@@ -0,0 +1,144 @@
+/*
+ *  NandQueue_service.h
+ *
+ *  Created on: Nov 12, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#ifndef SERVICE_NANDQUEUE_SERVICE_H_
+#define SERVICE_NANDQUEUE_SERVICE_H_
+
+#include "nand_dri_Read.h"
+#include "nand_dri_Program.h"
+#include "nand_dri_BlockErase.h"
+#include "Protect_service.h"
+#include "StatusRegister_service.h"
+
+/* ---------------------------------------------------------------------------
+ * Queue Setting
+ * ---------------------------------------------------------------------------
+ * NAND_QUEUE_DEPTH : Queued requests (power of 2), the active one not counted
+ * NAND_QUEUE_IDLE  : NandQueue_Poll() return value when nothing is pending
+ * --------------------------------------------------------------------------- */
+#ifndef NAND_QUEUE_DEPTH
+#define NAND_QUEUE_DEPTH   8
+#endif
+
+#define NAND_QUEUE_IDLE    0xFFFFFFFFU
+
+/* ---------------------------------------------------------------------------
+ * Request Descriptor (caller storage, must stay valid until completion)
+ * ---------------------------------------------------------------------------
+ * type       : NAND_REQ_READ / PROGRAM / ERASE / COPY
+ * page       : Page address (erase: block index, copy: source page)
+ * col        : Column address (read / program)
+ * buf / len  : Read destination or program source
+ * random     : Program with 84h (keep cache content) instead of 02h
+ * dst        : Copy: destination page
+ * patch      : Copy: patch_count cache edits (84h) between load and program
+ * timeout_us : 0 -> default of the operation (Nand_SetOpTiming)
+ * cb / user  : Completion callback, run by whichever call drives the engine
+ *              (Poll / Wait / Run / Flush) after the engine lock is released.
+ *              It may Submit; Wait / Run / Flush block, so not from a Poll
+ *              driven by an ISR.
+ *
+ * state      : Set by the engine (QUEUED -> ACTIVE -> DONE)
+ * ok         : Result (no timeout, no FAIL, ECC correctable)
+ * done       : Decoded completion SR3 (ECC class, P-FAIL / E-FAIL, WEL),
+ *              copy: ECC class of the source load
+ * phase      : Copy: 0 = source load, 1 = program
+ * --------------------------------------------------------------------------- */
+typedef enum
+{
+	NAND_REQ_READ = 0,     // 13h -> tRD -> 03h / 6Bh / EBh
+	NAND_REQ_PROGRAM,      // 06h -> 02h / 84h (32h / 34h) -> 10h -> tPP
+	NAND_REQ_ERASE,        // 06h -> D8h -> tBE
+	NAND_REQ_COPY          // 13h -> tRD -> 06h -> 84h patches -> 10h -> tPP
+} NandReqType_t;
+
+/* Copy: `len` bytes of `data` into the cache at column `col` */
+typedef struct
+{
+	uint16_t col;
+	uint16_t len;
+	const uint8_t *data;
+} NandPatch_t;
+
+typedef enum
+{
+	NAND_REQ_FREE = 0,
+	NAND_REQ_QUEUED,
+	NAND_REQ_ACTIVE,
+	NAND_REQ_DONE
+} NandReqState_t;
+
+typedef struct NandRequest NandRequest_t;
+typedef void (*NandReq_Callback_t)(NandRequest_t *req, void *user);
+
+struct NandRequest
+{
+	NandReqType_t type;
+	uint32_t page;
+	uint16_t col;
+	uint8_t *buf;
+	uint16_t len;
+	bool random;
+	uint32_t dst;
+	const NandPatch_t *patch;
+	uint8_t patch_count;
+	uint32_t timeout_us;
+	NandReq_Callback_t cb;
+	void *user;
+
+	volatile NandReqState_t state;
+	bool ok;
+	NandCompletion_t done;
+	uint8_t phase;
+	ECC_Status_t src_ecc;
+};
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t submitted;
+	uint32_t completed;
+	uint32_t failed;
+	uint32_t queue_full;    // Submit refused
+	uint32_t max_depth;     // Deepest queue seen
+} NandQueueStats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * NandQueue_Submit
+ *  - Queue a request, returns at once. false -> queue full.
+ *
+ * NandQueue_Poll
+ *  - Advance the engine (cooperative main loop, or a timer ISR when every
+ *    NAND access goes through the queue). Returns microseconds until the
+ *    next call is useful, NAND_QUEUE_IDLE when nothing is pending.
+ *
+ * NandQueue_Wait / NandQueue_Run
+ *  - Block until `req` is done (Run = Submit + Wait), used by the blocking
+ *    Read / Program / Erase services.
+ *
+ * NandQueue_Flush
+ *  - Block until the queue is empty (before direct driver access: OTP,
+ *    reset, status register writes).
+ *
+ * NandQueue_Pending / NandQueue_GetStats
+ *  - Requests not yet done / counters.
+ * ------------------------------------------------------------------------- */
+bool NandQueue_Submit(NandRequest_t *req);
+uint32_t NandQueue_Poll(void);
+bool NandQueue_Wait(NandRequest_t *req);
+bool NandQueue_Run(NandRequest_t *req);
+void NandQueue_Flush(void);
+
+uint32_t NandQueue_Pending(void);
+const NandQueueStats_t* NandQueue_GetStats(void);
+
+#endif /* SERVICE_NANDQUEUE_SERVICE_H_ */
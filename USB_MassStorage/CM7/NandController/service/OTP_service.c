@@ -26,7 +26,7 @@
  *  Command Flow:
  *    1. OTPEnable_Service(true)       → Enter OTP mode
  *    2. PageDataRead(13h)             → Transfer selected OTP page to cache
- *    3. IsBusyWithTimeout_service()   → Wait until device ready
+ *    3. WaitReady_service()           → Wait until device ready
  *    4. ReadData(03h)                 → Read from cache into host buffer
  *    5. OTPEnable_Service(false)      → Exit OTP mode
  *
@@ -55,7 +55,7 @@ bool OTP_ReadPage(uint8_t otp_page_index, uint8_t *buf, uint16_t len)
 
 	PageDataRead(page_addr);
 
-	if (!IsBusyWithTimeout_service(100))
+	if (!WaitReady_service(NAND_OP_READ, 0, NULL))
 		return false;
 
 	ReadData(0x0000, buf, len);
@@ -80,7 +80,7 @@ bool OTP_ReadPage(uint8_t otp_page_index, uint8_t *buf, uint16_t len)
  *    1. OTPEnable_Service(true)       → Enter OTP mode
  *    2. LoadProgramData(02h)          → Load data into cache buffer
  *    3. ProgramExecute(10h)           → Commit cache data to OTP page
- *    4. IsBusyWithTimeout_service()   → Wait for program completion
+ *    4. WaitReady_service()           → Wait for program completion
  *    5. OTPEnable_Service(false)      → Exit OTP mode
  *
  * @param otp_page_index : Target OTP page index (0x02–0x0B).
@@ -112,7 +112,7 @@ bool OTP_ProgramPage(uint8_t otp_page_index, const uint8_t *buf, uint16_t len)
 	LoadProgramData(0x0000, (uint8_t*) buf, len);
 	ProgramExecute(page_addr);
 
-	if (!IsBusyWithTimeout_service(100))
+	if (!WaitReady_service(NAND_OP_PROGRAM, 0, NULL))
 		return false;
 
 	/// Step 1: Disable OTP
@@ -15,6 +15,8 @@
  *  - Performs a full-page program sequence (02h + 10h) on the W25N02KV NAND device.
  *
  * @details
+ *  - Blocking wrapper: one NandQueue request, submitted and waited for
+ *    (NandQueue_Run). Asynchronous callers submit the request themselves.
  *  - High-level service API that combines the standard program command sequence.
  *  - Programs one complete page starting at column address 0x0000.
  *  - Used for normal main-area data programming (2 KB per page).
@@ -24,15 +26,14 @@
  *    1. [06h] Write Enable (WEL = 1)
  *    2. [02h + Column Addr] Load Program Data into cache buffer
  *    3. [10h + Page Addr]   Program Execute (commit data to array)
- *    4. Poll SR1[0] (OIP) until ready
- *    5. Check SR3[3] (P_FAIL) for program failure
+ *    4. Wait until OIP = 0, P_FAIL / WEL taken from the same SR3 read
  *
  * @param page_addr : Target page address to be programmed.
  * @param buf       : [in] Pointer to data buffer containing data to be written.
  * @param len       : Length of data in bytes to program.
  *
  * @return
- *  - true  : Program operation succeeded (no timeout, P_FAIL = 0).
+ *  - true  : Program operation succeeded (no timeout, P_FAIL = 0, WEL = 0).
  *  - false : Program failed or timeout occurred.
  *
  * @note
@@ -43,30 +44,16 @@
  * --------------------------------------------------------------------------- */
 bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf, uint16_t len)
 {
-	/// Step 1: Write Enable
-	if (!WriteEnable_Service())
-		return false;
+	NandRequest_t req = { 0 };
 
-	/// Step 2: 將資料從 Column=0x0000 開始載入 Page Buffer
-	/// Step 3: 執行 Program Execute，把 Buffer 資料寫進 NAND Page
-	LoadProgramData(0x0000, buf, len);
-	ProgramExecute(page_addr);
+	req.type = NAND_REQ_PROGRAM;
+	req.page = page_addr;
+	req.col = 0x0000;
+	req.buf = (uint8_t*) buf;
+	req.len = len;
+	req.random = false;
 
-	/// Step 4: 等待程式完成 (Polling SR3 OIP bit)
-	if (!IsBusyWithTimeout_service(100))
-		return false;
-
-	/// Step 5: 檢查 Program Fail (P_Fail=1 代表失敗)
-	if (CheckProgramFail_service() == true)
-	{
-		printf("[Standard Program] Failed (P_Fail = 1)\r\n");
-		return false;
-	}
-	else
-	{
-		printf("[Standard Program] Success (P_Fail = 0)\r\n");
-		return true;
-	}
+	return NandQueue_Run(&req);
 }
 
 /* ===========================================================================
@@ -76,6 +63,8 @@ bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf, uint16_t le
  *  - Performs a random page program sequence (84h + 10h) to update partial data.
  *
  * @details
+ *  - Blocking wrapper: one NandQueue request, submitted and waited for
+ *    (NandQueue_Run). Asynchronous callers submit the request themselves.
  *  - Allows programming data to a specific column address within a page buffer.
  *  - Useful for updating spare area, OOB (Out-Of-Band), or partial main data.
  *  - Multiple Random Load (84h) commands can be issued before a single
@@ -85,8 +74,7 @@ bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf, uint16_t le
  *    1. [06h] Write Enable (WEL = 1)
  *    2. [84h + Column Addr] Random Load Program Data
  *    3. [10h + Page Addr]   Program Execute
- *    4. Poll SR1[0] (OIP) until ready
- *    5. Check SR3[3] (P_FAIL) for program failure
+ *    4. Wait until OIP = 0, P_FAIL / WEL taken from the same SR3 read
  *
  * @param page_addr : Target page address to be programmed.
  * @param col_addr  : Column start address within the page buffer.
@@ -94,7 +82,7 @@ bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf, uint16_t le
  * @param len       : Number of bytes to program.
  *
  * @return
- *  - true  : Random program succeeded (no timeout, P_FAIL = 0).
+ *  - true  : Random program succeeded (no timeout, P_FAIL = 0, WEL = 0).
  *  - false : Program failed or timeout occurred.
  *
  * @note
@@ -105,27 +93,71 @@ bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf, uint16_t le
  * --------------------------------------------------------------------------- */
 bool RandomProgram_Service(uint32_t page_addr, uint16_t col_addr, const uint8_t *buf, uint16_t len)
 {
-	/// Step 1: Write Enable
-	if (!WriteEnable_Service())
-		return false;
+	NandRequest_t req = { 0 };
+
+	req.type = NAND_REQ_PROGRAM;
+	req.page = page_addr;
+	req.col = col_addr;
+	req.buf = (uint8_t*) buf;
+	req.len = len;
+	req.random = true;
+
+	return NandQueue_Run(&req);
+}
+
+/* ===========================================================================
+ * Function: CopyPage_Service
+ * ===========================================================================
+ * @brief
+ *  - Relocates one page inside the device (13h + 84h patches + 10h).
+ *
+ * @details
+ *  - Blocking wrapper: one NAND_REQ_COPY request (NandQueue_Run). GC, bad
+ *    block retirement and scrubbing submit the request themselves.
+ *  - Page data never crosses the SPI bus: only the patched bytes do, the
+ *    rest is programmed from the cache as loaded (and ECC corrected) by 13h.
+ *  - The source ECC class comes from the SR3 read that ended tRD. An
+ *    uncorrectable source is not programmed.
+ *
+ *  Command Flow:
+ *    1. [13h + src]           PageDataRead → page to cache
+ *    2. Wait until OIP = 0, ECC class of the source from the same SR3
+ *    3. [06h] Write Enable
+ *    4. [84h + CA] × count    RandomLoadProgramData (cache kept, I/O mode)
+ *    5. [10h + dst]           ProgramExecute
+ *    6. Wait until OIP = 0, P_FAIL / WEL taken from the same SR3 read
+ *
+ * @param src_page : Source page address.
+ * @param dst_page : Destination page address (erased).
+ * @param patches  : Cache edits applied before programming (may be NULL).
+ * @param count    : Number of patches.
+ * @param src_ecc  : [out] ECC class of the source load (may be NULL).
+ *
+ * @return
+ *  - true  : Page copied (source correctable, no timeout, P_FAIL = 0).
+ *  - false : Source uncorrectable (nothing programmed), timeout or P_FAIL.
+ *
+ * @note
+ *  - ECC_CORRECTED_THRESHOLD on the source still copies (fresh ECC parity
+ *    on the destination), the caller decides whether to retire the block.
+ *  - Reference: Winbond W25N02KV Datasheet 8.2.11, 8.2.9, 8.2.10
+ * --------------------------------------------------------------------------- */
+bool CopyPage_Service(uint32_t src_page, uint32_t dst_page,
+		const NandPatch_t *patches, uint8_t count, ECC_Status_t *src_ecc)
+{
+	NandRequest_t req = { 0 };
+	bool ok;
+
+	req.type = NAND_REQ_COPY;
+	req.page = src_page;
+	req.dst = dst_page;
+	req.patch = patches;
+	req.patch_count = count;
 
-	/// Step 2: 載入資料到 Page Buffer (可多次呼叫 0x84，更新不同 col_addr)
-	/// Step 3: 執行 Program Execute，把整個 Page Buffer 寫進 NAND
-	RandomLoadProgramData(col_addr, buf, len);
-	ProgramExecute(page_addr);
+	ok = NandQueue_Run(&req);
 
-	/// Step 4: 等待程式完成 (Polling SR3 OIP bit)
-	IsBusyWithTimeout_service(100);
+	if (src_ecc != NULL)
+		*src_ecc = req.done.ecc;
 
-	/// Step 5: 檢查 Program Fail (P_Fail = 1)
-	if (CheckProgramFail_service())
-	{
-		printf("[Random Program] Failed (P_Fail = 1)\r\n");
-		return false;
-	}
-	else
-	{
-		printf("[Random Program] Success (P_Fail = 0)\r\n");
-		return true;
-	}
+	return ok;
 }
@@ -10,6 +10,7 @@
 #define SERVICE_PROGRAM_SERVICE_H_
 
 #include "nand_dri_Program.h"
+#include "NandQueue_service.h"
 #include "Protect_service.h"
 #include "StatusRegister_service.h"
 
@@ -19,4 +20,7 @@ bool StandardProgram_Service(uint32_t page_addr, const uint8_t *buf,
 bool RandomProgram_Service(uint32_t page_addr, uint16_t col_addr,
 		const uint8_t *buf, uint16_t len);
 
+bool CopyPage_Service(uint32_t src_page, uint32_t dst_page,
+		const NandPatch_t *patches, uint8_t count, ECC_Status_t *src_ecc);
+
 #endif /* SERVICE_PROGRAM_SERVICE_H_ */
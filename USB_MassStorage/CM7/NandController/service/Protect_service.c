@@ -8,6 +8,25 @@
 
 #include "Protect_service.h"
 
+/* ---------------------------------------------------------------------------
+ * Write SR1 / SR2 only when the shadow says the value changes
+ * ---------------------------------------------------------------------------
+ *  - Unchanged value : no 06h, no 1Fh, no status read.
+ *  - Otherwise       : Write Enable (WEL verified) + 1Fh, shadow written
+ *                      through by WriteStatusRegister.
+ * --------------------------------------------------------------------------- */
+static bool update_status_register(uint8_t sr_addr, uint8_t value)
+{
+	if (ReadStatusRegisterCached(sr_addr) == value)
+		return true;
+
+	if (!WriteEnable_Service())
+		return false;
+
+	WriteStatusRegister(sr_addr, value);
+	return true;
+}
+
 /* ===========================================================================
  * Function: WriteEnable_Service
  * ===========================================================================
@@ -29,12 +48,12 @@ bool WriteEnable_Service(void)
 
 	if (IsWriteEnableLatch_service())
 	{
-		printf("[Write Enable] Write Enable Success (WEL = 1)\r\n");
+		NAND_LOG(WEL_OK);
 		return true;
 	}
 	else
 	{
-		printf("[Write Enable] Write Enable Failed  (WEL = 0)\r\n");
+		NAND_LOG(WEL_FAIL);
 		return false;
 	}
 }
@@ -54,9 +73,9 @@ void WriteDisable_Service(void)
 	WriteDisable();
 
 	if (!IsWriteEnableLatch_service())
-		printf("[Write Disable] Write Disable Success (WEL = 0)\r\n");
+		NAND_LOG(WEL_CLEAR_OK);
 	else
-		printf("[Write Disable] Write Disable Failed  (WEL = 1)\r\n");
+		NAND_LOG(WEL_CLEAR_FAIL);
 }
 
 /// =========================== Status Register 1 ============================
@@ -72,6 +91,8 @@ void WriteDisable_Service(void)
  *  - TB: Selects protection direction (Top = 1 / Bottom = 0).
  *  - Writes SR1 with the new BP/TB configuration and verifies correctness.
  *  - Requires Write Enable before updating SR1.
+ *  - SR1 comes from the device shadow: no bus traffic when BP / TB already
+ *    match, verification reads the device only in a debug build.
  *
  * @param bp_value   : Block protect value (0–15)
  * @param top_bottom : true = Top protected (TB=1), false = Bottom protected (TB=0)
@@ -90,23 +111,20 @@ bool SetBlockProtect_Service(uint8_t bp_value, bool top_bottom)
 	if (top_bottom)
 		sr1 |= SR1_TB;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register1, sr1))
 		return false;
 
-	WriteStatusRegister(Status_Register1, sr1);
+	uint8_t got_bp = GetBlockProtectBits();
+	bool got_tb = IsTopBottomProtect();
 
-	if (GetBlockProtectBits() == bp_value && IsTopBottomProtect() == top_bottom)
+	if (got_bp == bp_value && got_tb == top_bottom)
 	{
-		printf("[Set Block Protect] Success (BP=0x%X, TB=%u)\r\n",
-				GetBlockProtectBits(), IsTopBottomProtect());
+		NAND_LOG(BP_SET_OK, got_bp, got_tb);
 		return true;
 	}
 	else
 	{
-		printf(
-				"[Set Block Protect] Failed (Expect BP=0x%X, TB=%u / Got BP=0x%X, TB=%u)\r\n",
-				bp_value, top_bottom, GetBlockProtectBits(),
-				IsTopBottomProtect());
+		NAND_LOG(BP_SET_FAIL, bp_value, top_bottom, got_bp, got_tb);
 		return false;
 	}
 }
@@ -132,11 +150,9 @@ bool SetWriteProtectEnable_Service(bool enable)
 	else
 		sr1 &= ~SR1_WPE;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register1, sr1))
 		return false;
 
-	WriteStatusRegister(Status_Register1, sr1);
-
 	if (IsWriteProtectEnabled() == enable)
 	{
 		printf("[SET WP-E] Success (WP-E = %u)\r\n", IsWriteProtectEnabled());
@@ -179,11 +195,9 @@ bool SetStatusRegisterProtect_Service(bool srp0, bool srp1)
 	if (srp1)
 		sr1 |= SR1_SRP1;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register1, sr1))
 		return false;
 
-	WriteStatusRegister(Status_Register1, sr1);
-
 	if (IsSRP0Enabled() == srp0 && IsSRP1Enabled() == srp1)
 	{
 		printf("[SET SRP] Success (SRP0 = %u, SRP1 = %u)\r\n", IsSRP0Enabled(),
@@ -220,11 +234,9 @@ bool OTPLock_Service(void)
 	uint8_t sr2 = GetSR2();
 	sr2 |= SR2_OTPL;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (GetOTP_Lock_service())
 	{
 		printf("[SET OTP-L] Success (OTP-L = 1, Locked permanently)\r\n");
@@ -258,11 +270,9 @@ bool OTPEnable_Service(bool enable)
 	else
 		sr2 &= ~SR2_OTPE;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (IsOTPEnabled_service() == enable)
 	{
 		printf("[SET OTP-E] Success (OTP-E = %u)\r\n", IsOTPEnabled_service());
@@ -291,11 +301,9 @@ bool SR1Lock_Service(void)
 	uint8_t sr2 = GetSR2();
 	sr2 |= SR2_SR1L;  // SR1-L = 1 (永久鎖定)
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (IsSR1Locked_service())
 	{
 		printf("[SET SR1-L] Success (SR1-L = 1, Locked permanently)\r\n");
@@ -329,11 +337,9 @@ bool SetECCEnable_Service(bool enable)
 	else
 		sr2 &= ~SR2_ECCE;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (IsECCEnabled_service() == enable)
 	{
 		printf("[SET ECC] Success (ECC-E = %u)\r\n", IsECCEnabled_service());
@@ -368,11 +374,9 @@ bool SetBufferMode_Service(bool enable)
 	else
 		sr2 &= ~SR2_BUF;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (IsBufferMode_service() == enable)
 	{
 		printf("[SET BUF] Success (BUF = %u)\r\n", IsBufferMode_service());
@@ -408,11 +412,9 @@ bool SetOutputDriverStrength_Service(uint8_t level)
 	sr2 &= ~SR2_ODS_MASK;
 	sr2 |= (level << 1);
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	if (GetOutputDriverStrength_service() == level)
 	{
 		printf("[SET ODS] Success (ODS = %u)\r\n",
@@ -448,12 +450,8 @@ bool SetHoldDisable_Service(bool disable)
 	else
 		sr2 &= ~SR2_HDIS;
 
-	if (!WriteEnable_Service())
-	{
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
-	}
-
-	WriteStatusRegister(Status_Register2, sr2);
 
 	if (IsHoldDisabled_service() == disable)
 	{
@@ -495,26 +493,21 @@ bool SetReadMode_Service(bool buf, bool ecc)
 	if (ecc)
 		sr2 |= SR2_ECCE;
 
-	if (!WriteEnable_Service())
+	if (!update_status_register(Status_Register2, sr2))
 		return false;
 
-	WriteStatusRegister(Status_Register2, sr2);
-
 	// 驗證
 	bool new_buf = IsBufferMode_service();
 	bool new_ecc = IsECCEnabled_service();
 
 	if (new_buf == buf && new_ecc == ecc)
 	{
-		printf("[SET ReadMode] Success (BUF=%u, ECC-E=%u)\r\n", new_buf,
-				new_ecc);
+		NAND_LOG(READMODE_SET_OK, new_buf, new_ecc);
 		return true;
 	}
 	else
 	{
-		printf(
-				"[SET ReadMode] Failed (Expect BUF=%u,ECC-E=%u / Got BUF=%u,ECC-E=%u)\r\n",
-				buf, ecc, new_buf, new_ecc);
+		NAND_LOG(READMODE_SET_FAIL, buf, ecc, new_buf, new_ecc);
 		return false;
 	}
 }
@@ -522,37 +515,73 @@ bool SetReadMode_Service(bool buf, bool ecc)
 /// =========================== Status Register 3 ============================
 
 /* ===========================================================================
- * Function: IsBusyWithTimeout_service
+ * Function: WaitReady_service
  * ===========================================================================
  * @brief
- *  - Polls the OIP (Operation In Progress) bit in SR3 until cleared or timeout.
+ *  - Wait until the array operation just issued has finished (BUSY = 0).
  *
  * @details
- *  - Returns immediately when device becomes ready (OIP=0) or timeout expires.
- *  - Used to synchronize host operations after program/erase commands.
+ *  - Runs Nand_WaitReadyOp(): microsecond timeout on the DWT clock, minimum
+ *    delay from the typical tRD / tPP / tBE, then paced SR3 polling or
+ *    QUADSPI auto-polling. No SR3 traffic while the device is surely busy.
+ *  - The SR3 value that ended the wait is returned, so WEL / P-FAIL /
+ *    E-FAIL / ECC can be checked without another status transaction.
+ *  - Silent on success, one line on timeout.
  *
- * @param timeout_ms : Timeout in milliseconds
+ * @param op         : NAND_OP_READ / PROGRAM / ERASE / RESET / GENERIC
+ * @param timeout_us : Timeout in microseconds (0 -> default of the operation)
+ * @param sr3        : [out] Final SR3 (NULL allowed)
  *
  * @return
- *  - true  : Device ready (OIP=0)
+ *  - true  : Device ready (BUSY = 0)
  *  - false : Timeout expired while device busy
  *
  * @note
- *  - Reference: Winbond W25N02KV Datasheet §7.6.3
+ *  - Reference: Winbond W25N02KV Datasheet §7.6.3, §9.6
  * --------------------------------------------------------------------------- */
-bool IsBusyWithTimeout_service(uint32_t timeout_ms)
+bool WaitReady_service(NandOp_t op, uint32_t timeout_us, uint8_t *sr3)
 {
-	uint32_t start = HAL_GetTick();
+	uint8_t sr = 0;
 
-	while ((HAL_GetTick() - start) < timeout_ms)
+	if (Nand_WaitReadyOp(op, timeout_us, &sr))
 	{
-		if (!IsBusy_service())
-		{
-			printf("[OIP Status: 0] device is ready\r\n");
-			return true;
-		}
+		if (sr3 != NULL)
+			*sr3 = sr;
+		return true;
 	}
 
-	printf("[OIP Status: 1] Timeout, device still busy\r\n");
+	if (sr3 != NULL)
+		*sr3 = sr;
+
+	NAND_LOG(WAIT_TIMEOUT, op, Nand_GetReadyStats()->elapsed_us, sr);
 	return false;
 }
+
+/* ===========================================================================
+ * Function: WaitComplete_service
+ * ===========================================================================
+ * @brief
+ *  - WaitReady_service + decode of the final SR3 into a NandCompletion_t.
+ *
+ * @details
+ *  - Ready, P-FAIL, E-FAIL, WEL and ECC class all come from the SR3 read
+ *    that ended the busy wait. Callers must not issue CheckProgramFail /
+ *    CheckEraseFail / GetECCStatus / IsWriteEnableLatch afterwards: one
+ *    status transaction per page operation instead of ~5.
+ *
+ * @param op         : Operation just issued.
+ * @param timeout_us : Timeout in microseconds (0 -> default of the operation)
+ * @param c          : [out] Completion.
+ *
+ * @return
+ *  - true  : Device ready, `c` valid.
+ *  - false : Timeout (c->ready = false).
+ * --------------------------------------------------------------------------- */
+bool WaitComplete_service(NandOp_t op, uint32_t timeout_us, NandCompletion_t *c)
+{
+	uint8_t sr3 = SR3_BUSY;
+	bool ready = WaitReady_service(op, timeout_us, &sr3);
+
+	DecodeCompletion_service(sr3, ready, c);
+	return c->ready;
+}
@@ -34,6 +34,7 @@ bool SetReadMode_Service(bool buf, bool ecc);
 
 /* ==================== Status Register 3 ==================== */
 
-bool IsBusyWithTimeout_service(uint32_t timeout_ms);
+bool WaitReady_service(NandOp_t op, uint32_t timeout_us, uint8_t *sr3);
+bool WaitComplete_service(NandOp_t op, uint32_t timeout_us, NandCompletion_t *c);
 
 #endif /* SERVICE_PROTECT_SERVICE_H_ */
@@ -15,6 +15,8 @@
  *  - Executes a full-page standard read operation (13h + 03h).
  *
  * @details
+ *  - Blocking wrapper: one NandQueue request, submitted and waited for
+ *    (NandQueue_Run). Asynchronous callers submit the request themselves.
  *  - Reads main data or full page content from the NAND array into MCU buffer.
  *  - Combines PageDataRead (13h) and ReadData (03h) operations under ECC monitoring.
  *  - Supports both ECC check and correction result reporting.
@@ -23,9 +25,9 @@
  *
  *  Command Flow:
  *    1. [13h + PA2:PA1:PA0]  PageDataRead → transfer page to cache
- *    2. Wait until OIP=0 (SR3[0]) → device ready
- *    3. [03h + CA1:CA0] ReadData → read from cache to host
- *    4. ECC check via GetECCStatus_service()
+ *    2. Wait until OIP=0 (SR3[0]) → device ready, ECC class from same SR3
+ *    3. [03h / 6Bh / EBh + CA1:CA0] read from cache to host (I/O mode)
+ *    4. ECC check on the completion (no extra SR3 read)
  *
  * @param page_addr : Target page address to read.
  * @param col_addr  : Column start address within page (0x0000 = main area).
@@ -38,55 +40,15 @@
  * --------------------------------------------------------------------------- */
 bool StandardRead_Service(uint32_t page_addr, uint16_t col_addr, uint8_t *buf, uint16_t len)
 {
-	PageDataRead(page_addr);
+	NandRequest_t req = { 0 };
 
-	if (!IsBusyWithTimeout_service(100))
-	{
-		printf("[Read] Timeout... Status is Busy.\r\n");
-		return false;
-	}
+	req.type = NAND_REQ_READ;
+	req.page = page_addr;
+	req.col = col_addr;
+	req.buf = buf;
+	req.len = len;
 
-	ReadData(col_addr, buf, len);
-
-	ECC_Status_t ecc = GetECCStatus_service();
-
-	/// ECC Status check
-	switch (ecc)
-	{
-	case ECC_SUCCESS:
-		printf("[Status] ECC_SUCCESS (Page = 0x%05X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-
-	case ECC_SUCCESS_CORRECTED:
-		printf(
-				"[Status] ECC_SUCCESS_CORRECTED (Page = 0x%05X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-
-	case ECC_CORRECTED_THRESHOLD:
-		printf(
-				"[Status] ECC_CORRECTED_THRESHOLD (Page = 0x%05X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-
-	case ECC_UNCORRECTABLE:
-		printf(
-				"[Status] ECC_UNCORRECTABLE (Page = 0x%05X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-	default:
-		printf(
-				"[Status] ECC_RESERVED  (Page = 0x%05X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		return false;
-	}
-	return true;
+	return NandQueue_Run(&req);
 }
 
 /* ===========================================================================
@@ -96,15 +58,17 @@ bool StandardRead_Service(uint32_t page_addr, uint16_t col_addr, uint8_t *buf, u
  *  - Executes a random column read sequence (13h + 03h with custom column).
  *
  * @details
+ *  - Blocking wrapper: one NandQueue request, submitted and waited for
+ *    (NandQueue_Run). Asynchronous callers submit the request themselves.
  *  - Reads partial data (e.g., spare area or metadata) from a specific column
  *    offset in a given NAND page.
  *  - Performs ECC status check and classification after read.
  *
  *  Command Flow:
  *    1. [13h + PA2:PA1:PA0]  PageDataRead → load target page into cache
- *    2. Wait for OIP=0 (SR3[0]) → device ready
+ *    2. Wait for OIP=0 (SR3[0]) → device ready, ECC class from same SR3
  *    3. [03h + CA1:CA0] ReadData → read from column offset
- *    4. ECC check via GetECCStatus_service()
+ *    4. ECC check on the completion (no extra SR3 read)
  *
  * @param page_addr : Target page address to read.
  * @param col_addr  : Column address (0x0000–0x083F, main/spare area).
@@ -117,52 +81,14 @@ bool StandardRead_Service(uint32_t page_addr, uint16_t col_addr, uint8_t *buf, u
  * --------------------------------------------------------------------------- */
 bool RandomRead_Service(uint32_t page_addr, uint16_t col_addr, uint8_t *buf, uint16_t len)
 {
-	/// Step 1: PageDataRead (0x13)
-	PageDataRead(page_addr);
-
-	/// Step 2: 等待 NAND Ready
-	if (!IsBusyWithTimeout_service(100))
-	{
-		printf("[Random Read] Timeout ~ NAND Still Busy.\r\n");
-		return false;
-	}
-
-	/// Step 3: ReadData with custom col_addr
-	ReadData(col_addr, buf, len);
-
-	ECC_Status_t ecc = GetECCStatus_service();
-
-	/// ECC Status check
-	switch (ecc)
-	{
-	case ECC_SUCCESS:
-		printf("[Status] ECC_SUCCESS (Page = 0x%08X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-
-	case ECC_SUCCESS_CORRECTED:
-		printf(
-				"[Status] ECC_SUCCESS_CORRECTED (Page = 0x%08X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
-
-	case ECC_CORRECTED_THRESHOLD:
-		printf(
-				"[Status] ECC_CORRECTED_THRESHOLD (Page = 0x%08X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		break;
+	NandRequest_t req = { 0 };
 
-	case ECC_UNCORRECTABLE:
-	default:
-		printf(
-				"[Status] ECC_UNCORRECTABLE (Page = 0x%08X Col = 0x%04X Len = %u)\r\n",
-				(unsigned int) page_addr, (unsigned int) col_addr,
-				(unsigned int) len);
-		return false;
-	}
+	/// Same engine request as StandardRead_Service, any column
+	req.type = NAND_REQ_READ;
+	req.page = page_addr;
+	req.col = col_addr;
+	req.buf = buf;
+	req.len = len;
 
-	return true;
+	return NandQueue_Run(&req);
 }
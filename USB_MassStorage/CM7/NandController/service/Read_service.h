@@ -10,6 +10,7 @@
 #define SERVICE_READ_SERVICE_H_
 
 #include "nand_dri_Read.h"
+#include "NandQueue_service.h"
 #include "Protect_service.h"
 #include "StatusRegister_service.h"
 
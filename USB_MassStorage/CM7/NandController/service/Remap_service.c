@@ -0,0 +1,546 @@
+/*
+ *  Remap_service.c
+ *
+ *  Created on: Nov 17, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#include "Remap_service.h"
+
+#if NAND_REMAP
+
+/* ---------------------------------------------------------------------------
+ * Map record (one page of the store, ~176 bytes)
+ * --------------------------------------------------------------------------- */
+#define REMAP_MAGIC   0x31504D52u   // "RMP1"
+#define REMAP_EMPTY   0xFFFFu       // Free hash slot
+
+typedef struct
+{
+	uint16_t logical;
+	uint16_t physical;
+} Remap_Entry_t;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t count;
+	Remap_Entry_t entry[REMAP_SPARE_BLOCKS];
+	uint32_t crc;
+} Remap_Record_t;
+
+/* ---------------------------------------------------------------------------
+ * Map state
+ * ---------------------------------------------------------------------------
+ * map_hash   : Bad logical block -> spare (logical = REMAP_EMPTY: free slot)
+ * pool_used  : 1 = pool block serves a logical block
+ * store_page : Next record page per copy (PAGES_PER_BLOCK -> erase first)
+ * migrate_buf: Page staging for the RAM fallback of a migration
+ * --------------------------------------------------------------------------- */
+static Remap_Entry_t map_hash[REMAP_HASH_SLOTS];
+static uint32_t pool_used[(REMAP_SPARE_BLOCKS + 31) / 32];
+static Remap_Stats_t stats;
+
+static const uint32_t store_block[2] = { REMAP_STORE_BLOCK_A, REMAP_STORE_BLOCK_B };
+static uint32_t store_page[2];
+static Remap_Record_t record;
+
+static uint8_t migrate_buf[PAGE_TOTAL_SIZE];
+
+/* ---------------------------------------------------------------------------
+ * Hash (multiplicative, top REMAP_HASH_BITS bits)
+ * --------------------------------------------------------------------------- */
+static Remap_Entry_t* map_slot(uint32_t block, bool insert)
+{
+	uint32_t i = (block * 0x9E3779B1u) >> (32 - REMAP_HASH_BITS);
+
+	for (uint32_t n = 0; n < REMAP_HASH_SLOTS; n++)
+	{
+		Remap_Entry_t *e = &map_hash[i];
+
+		if (e->logical == block)
+			return e;
+		if (e->logical == REMAP_EMPTY)
+			return insert ? e : NULL;
+
+		i = (i + 1) & (REMAP_HASH_SLOTS - 1);
+	}
+
+	return NULL;
+}
+
+static void map_set(uint32_t block, uint32_t spare)
+{
+	Remap_Entry_t *e = map_slot(block, true);
+
+	if (e == NULL)
+		return;
+
+	if (e->logical == REMAP_EMPTY)
+		stats.mapped++;
+
+	e->logical = (uint16_t) block;
+	e->physical = (uint16_t) spare;
+
+	pool_used[(spare - REMAP_POOL_START) >> 5] |= 1u << ((spare - REMAP_POOL_START) & 31);
+}
+
+static bool pool_is_used(uint32_t spare)
+{
+	uint32_t i = spare - REMAP_POOL_START;
+
+	return (pool_used[i >> 5] >> (i & 31)) & 1u;
+}
+
+/* ---------------------------------------------------------------------------
+ * Next good, unused pool block, erased (an erase failure retires it)
+ * --------------------------------------------------------------------------- */
+static uint32_t pool_take(void)
+{
+	for (uint32_t b = BBT_NextGood(REMAP_POOL_START); b <= REMAP_LAST_BLOCK;
+			b = BBT_NextGood(b + 1))
+	{
+		if (pool_is_used(b) || !BBT_VerifyBlock(b))
+			continue;
+
+		if (BlockErase128K_service(b, 0))
+			return b;
+
+		BBT_MarkRuntimeBad(b);
+	}
+
+	return REMAP_NONE;
+}
+
+/* ---------------------------------------------------------------------------
+ * Store record I/O
+ * --------------------------------------------------------------------------- */
+static bool store_read(uint32_t copy, uint32_t page, Remap_Record_t *rec)
+{
+	if (!StandardRead_Service(PAGE_ADDR(store_block[copy], page), 0,
+			(uint8_t*) rec, sizeof(*rec)))
+		return false;
+
+	return rec->magic == REMAP_MAGIC && rec->count <= REMAP_SPARE_BLOCKS
+			&& rec->crc == BBT_Crc32(rec, offsetof(Remap_Record_t, crc));
+}
+
+/// Records fill a prefix of the block: binary search for the first free page,
+/// the newest record (page - 1) is left in *rec
+static uint32_t store_scan(uint32_t copy, Remap_Record_t *rec, bool *valid)
+{
+	static Remap_Record_t probe;
+	uint32_t lo = 0, hi = PAGES_PER_BLOCK;
+
+	*valid = false;
+
+	while (lo < hi)
+	{
+		uint32_t mid = (lo + hi) / 2;
+
+		if (store_read(copy, mid, &probe))
+		{
+			*rec = probe;
+			*valid = true;
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static bool store_append(void)
+{
+	uint32_t written = 0;
+	uint32_t n = 0;
+
+	memset(&record, 0xFF, sizeof(record));
+	record.magic = REMAP_MAGIC;
+	record.seq = stats.store_seq + 1;
+
+	for (uint32_t i = 0; i < REMAP_HASH_SLOTS && n < REMAP_SPARE_BLOCKS; i++)
+		if (map_hash[i].logical != REMAP_EMPTY)
+			record.entry[n++] = map_hash[i];
+
+	record.count = n;
+	record.crc = BBT_Crc32(&record, offsetof(Remap_Record_t, crc));
+
+	for (uint32_t copy = 0; copy < 2; copy++)
+	{
+		/// Full block: restart at page 0 (copy B still holds the old record)
+		if (store_page[copy] >= PAGES_PER_BLOCK)
+		{
+			if (!BlockErase128K_service(store_block[copy], 0))
+			{
+				NAND_LOG(REMAP_STORE_FAIL, store_block[copy], record.seq);
+				continue;
+			}
+			store_page[copy] = 0;
+		}
+
+		if (StandardProgram_Service(PAGE_ADDR(store_block[copy], store_page[copy]),
+				(const uint8_t*) &record, sizeof(record)))
+			written++;
+		else
+			NAND_LOG(REMAP_STORE_FAIL, store_block[copy], record.seq);
+
+		store_page[copy]++;
+	}
+
+	if (written == 0)
+		return false;
+
+	stats.store_seq = record.seq;
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Spare for a bad logical block that holds no data (factory / lazy scan)
+ * --------------------------------------------------------------------------- */
+static uint32_t assign_spare(uint32_t block)
+{
+	uint32_t spare = pool_take();
+
+	if (spare == REMAP_NONE)
+	{
+		NAND_LOG(REMAP_POOL_EMPTY, block);
+		return REMAP_NONE;
+	}
+
+	map_set(block, spare);
+	NAND_LOG(REMAP_ASSIGN, block, block, spare);
+	return spare;
+}
+
+/* ---------------------------------------------------------------------------
+ * Move pages [0, pages) of src to the erased dst
+ * --------------------------------------------------------------------------- */
+static bool migrate(uint32_t src, uint32_t dst, uint32_t pages)
+{
+	for (uint32_t p = 0; p < pages; p++)
+	{
+		ECC_Status_t ecc = ECC_SUCCESS;
+
+		/// Step 1: Copy-back, data never leaves the device
+		if (CopyPage_Service(PAGE_ADDR(src, p), PAGE_ADDR(dst, p), NULL, 0, &ecc))
+		{
+			stats.copyback++;
+			continue;
+		}
+
+		if (ecc != ECC_UNCORRECTABLE)
+			return false;              // Destination program failed
+
+		/// Step 2: Uncorrectable source, keep what the page still holds
+		StandardRead_Service(PAGE_ADDR(src, p), 0, migrate_buf, PAGE_TOTAL_SIZE);
+
+		if (!StandardProgram_Service(PAGE_ADDR(dst, p), migrate_buf, PAGE_TOTAL_SIZE))
+			return false;
+
+		stats.fallback++;
+	}
+
+	return true;
+}
+
+/* ===========================================================================
+ * Function: Remap_Mount
+ * ===========================================================================
+ * @brief
+ *  - Restore the logical -> physical map, cover every known bad block.
+ *
+ * @details
+ *  - Both store copies are searched for their newest record (binary search,
+ *    ~6 page reads each), the higher seq wins. Copies that disagree are
+ *    rewritten from page 0.
+ *  - Entries of logical blocks not marked bad are dropped (Remap_Retire
+ *    cut short by a power loss, the old block still holds the data).
+ *  - Bad logical blocks without a spare (factory bad on first boot, marked
+ *    bad outside Remap) get one: nothing to migrate.
+ *
+ * @return
+ *  - true  : Every known bad logical block is mapped.
+ *  - false : Pool exhausted (those blocks read as REMAP_NONE).
+ *
+ * @note
+ *  - Call after BBT_Mount / BBT_MountLazy.
+ * --------------------------------------------------------------------------- */
+bool Remap_Mount(void)
+{
+	static Remap_Record_t rec[2];
+	bool valid[2];
+	bool changed = false;
+	bool ok = true;
+	int use = -1;
+
+	memset(map_hash, 0xFF, sizeof(map_hash));
+	memset(pool_used, 0, sizeof(pool_used));
+	memset(&stats, 0, sizeof(stats));
+
+	/// Step 1: Newest record of each copy
+	for (uint32_t copy = 0; copy < 2; copy++)
+		store_page[copy] = store_scan(copy, &rec[copy], &valid[copy]);
+
+	if (valid[0] && valid[1])
+		use = ((int32_t) (rec[1].seq - rec[0].seq) > 0) ? 1 : 0;
+	else if (valid[0] || valid[1])
+		use = valid[0] ? 0 : 1;
+
+	if (use >= 0)
+	{
+		for (uint32_t i = 0; i < rec[use].count; i++)
+		{
+			uint32_t lb = rec[use].entry[i].logical;
+			uint32_t pb = rec[use].entry[i].physical;
+
+			if (lb < REMAP_FIRST_BLOCK || lb >= REMAP_POOL_START
+					|| pb < REMAP_POOL_START || pb > REMAP_LAST_BLOCK)
+				continue;
+
+			/// Remap_Retire cut short before the BBT mark: the block still serves
+			if (!BBT_IsBad(lb) && BBT_VerifyBlock(lb))
+			{
+				changed = true;
+				continue;
+			}
+
+			map_set(lb, pb);
+		}
+
+		stats.store_seq = rec[use].seq;
+		NAND_LOG(REMAP_LOAD_OK, stats.store_seq, stats.mapped);
+
+		/// Out of sync (append reached one copy only): rewrite both
+		if (!valid[use ^ 1] || rec[use ^ 1].seq != rec[use].seq)
+		{
+			store_page[0] = PAGES_PER_BLOCK;
+			store_page[1] = PAGES_PER_BLOCK;
+			changed = true;
+		}
+	}
+	else
+	{
+		/// No map yet: start both copies from an erased block
+		store_page[0] = PAGES_PER_BLOCK;
+		store_page[1] = PAGES_PER_BLOCK;
+		changed = true;
+	}
+
+	/// Step 2: Known bad logical blocks without a spare
+	for (uint32_t b = BBT_NextBad(REMAP_FIRST_BLOCK); b < REMAP_POOL_START;
+			b = BBT_NextBad(b + 1))
+	{
+		if (map_slot(b, false) != NULL)
+			continue;
+
+		if (assign_spare(b) == REMAP_NONE)
+			ok = false;
+		else
+			changed = true;
+	}
+
+	if (changed)
+		store_append();
+
+	return ok;
+}
+
+/* ===========================================================================
+ * Function: Remap_Block
+ * ===========================================================================
+ * @brief
+ *  - Physical block behind logical `block`.
+ *
+ * @details
+ *  - Good block: the BBT bit is the whole lookup (identity).
+ *  - Bad block: one hash probe (usually the first slot).
+ *  - Still unknown after a lazy mount: verified here first, a late factory
+ *    bad block gets a spare (map saved).
+ *
+ * @param block : Logical block (REMAP_FIRST_BLOCK ~ REMAP_POOL_START - 1).
+ *
+ * @return
+ *  - Physical block, REMAP_NONE when out of range or the pool is exhausted.
+ * --------------------------------------------------------------------------- */
+uint32_t Remap_Block(uint32_t block)
+{
+	if (block < REMAP_FIRST_BLOCK || block >= REMAP_POOL_START)
+		return REMAP_NONE;
+
+	if (BBT_IsUnknown(block))
+		BBT_VerifyBlock(block);
+
+	if (!BBT_BadBlock(block))
+		return block;
+
+	Remap_Entry_t *e = map_slot(block, false);
+
+	if (e != NULL)
+		return e->physical;
+
+	uint32_t spare = assign_spare(block);
+
+	if (spare != REMAP_NONE)
+		store_append();
+
+	return spare;
+}
+
+uint32_t Remap_Page(uint32_t page_addr)
+{
+	uint32_t pb = Remap_Block(BLOCK_ADDR(page_addr));
+
+	if (pb == REMAP_NONE)
+		return REMAP_NONE;
+
+	return PAGE_ADDR(pb, page_addr % PAGES_PER_BLOCK);
+}
+
+/* ===========================================================================
+ * Function: Remap_Retire
+ * ===========================================================================
+ * @brief
+ *  - Replace the physical block behind logical `block` by a spare.
+ *
+ * @details
+ *  Flow:
+ *    1. Take an erased pool block (erase failure -> marked bad, next one)
+ *    2. Pages 0 ~ pages-1: copy-back (13h / 10h, no data transfer), a page
+ *       with an uncorrectable source goes through RAM unchanged
+ *    3. Spare program failure -> spare marked bad, restart with the next
+ *    4. Commit, a power loss before it leaves the old mapping intact:
+ *       - First replacement (the logical block itself fails): map record
+ *         appended, then the block marked bad. The BBT bit is the commit
+ *         (the fast path ignores an entry without it), Remap_Mount drops
+ *         such an entry.
+ *       - Spare replaced: the old spare marked bad, then the record. The
+ *         record is the commit, the bad spare keeps serving until then.
+ *
+ * @param block : Logical block.
+ * @param pages : Pages holding data (programmed in order from page 0),
+ *                0 for an erase failure.
+ *
+ * @return
+ *  - true  : `block` now served by the spare, data moved.
+ *  - false : Invalid block or pool exhausted (mapping unchanged).
+ * --------------------------------------------------------------------------- */
+bool Remap_Retire(uint32_t block, uint32_t pages)
+{
+	uint32_t old = Remap_Block(block);
+	uint32_t spare;
+	uint32_t copied = stats.copyback, fallback = stats.fallback;
+
+	if (old == REMAP_NONE)
+		return false;
+
+	if (pages > PAGES_PER_BLOCK)
+		pages = PAGES_PER_BLOCK;
+
+	for (;;)
+	{
+		spare = pool_take();
+
+		if (spare == REMAP_NONE)
+		{
+			NAND_LOG(REMAP_POOL_EMPTY, block);
+			return false;
+		}
+
+		if (migrate(old, spare, pages))
+			break;
+
+		BBT_MarkRuntimeBad(spare);
+	}
+
+	if (old == block)
+	{
+		map_set(block, spare);
+		store_append();
+		BBT_MarkRuntimeBad(old);
+	}
+	else
+	{
+		BBT_MarkRuntimeBad(old);
+		map_set(block, spare);
+		store_append();
+	}
+
+	stats.retired++;
+	NAND_LOG(REMAP_ASSIGN, block, old, spare);
+	NAND_LOG(REMAP_MIGRATE, block, pages, stats.copyback - copied,
+			stats.fallback - fallback);
+	return true;
+}
+
+/* ===========================================================================
+ * Function: Remap_Read / Remap_Program / Remap_Erase
+ * ===========================================================================
+ * @brief
+ *  - StandardRead / StandardProgram / BlockErase on the mapped address.
+ *
+ * @details
+ *  - Program failure on page n: pages 0 ~ n-1 move to a spare
+ *    (Remap_Retire), page n is programmed there.
+ *  - Erase failure: the replacement is erased already.
+ *  - Read: no retirement (an uncorrectable page is a data problem, the
+ *    caller decides).
+ * --------------------------------------------------------------------------- */
+bool Remap_Read(uint32_t page_addr, uint16_t col_addr, uint8_t *buf,
+		uint16_t len)
+{
+	uint32_t pp = Remap_Page(page_addr);
+
+	if (pp == REMAP_NONE)
+		return false;
+
+	return StandardRead_Service(pp, col_addr, buf, len);
+}
+
+bool Remap_Program(uint32_t page_addr, const uint8_t *buf, uint16_t len)
+{
+	uint32_t pp = Remap_Page(page_addr);
+
+	if (pp == REMAP_NONE)
+		return false;
+
+	if (StandardProgram_Service(pp, buf, len))
+		return true;
+
+	if (!Remap_Retire(BLOCK_ADDR(page_addr), page_addr % PAGES_PER_BLOCK))
+		return false;
+
+	return StandardProgram_Service(Remap_Page(page_addr), buf, len);
+}
+
+bool Remap_Erase(uint32_t block)
+{
+	uint32_t pb = Remap_Block(block);
+
+	if (pb == REMAP_NONE)
+		return false;
+
+	if (BlockErase128K_service(pb, 0))
+		return true;
+
+	return Remap_Retire(block, 0);
+}
+
+const Remap_Stats_t* Remap_GetStats(void)
+{
+	stats.spares_free = 0;
+
+	for (uint32_t b = BBT_NextGood(REMAP_POOL_START); b <= REMAP_LAST_BLOCK;
+			b = BBT_NextGood(b + 1))
+		if (!pool_is_used(b))
+			stats.spares_free++;
+
+	return &stats;
+}
+
+#endif /* NAND_REMAP */
@@ -0,0 +1,143 @@
+/*
+ *  Remap_service.h
+ *
+ *  Created on: Nov 17, 2025
+ *  Author: Henry
+ *  Folder: NandController/service
+ */
+
+#ifndef SERVICE_REMAP_SERVICE_H_
+#define SERVICE_REMAP_SERVICE_H_
+
+#include "BBT_service.h"
+
+/* ---------------------------------------------------------------------------
+ * Build Switch
+ * ---------------------------------------------------------------------------
+ * NAND_REMAP : 1 -> Raw partition served by the Remap layer at the top of
+ *              the device (test / raw data blocks, EnduranceTest_Run), the
+ *              FTL range ends below it (FTL_Config.h).
+ *              0 -> No partition, the FTL owns every block.
+ *              Changing it moves the FTL range: reformat (erase the range).
+ * --------------------------------------------------------------------------- */
+#ifndef NAND_REMAP
+#define NAND_REMAP             1
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Address Space (raw partition)
+ * ---------------------------------------------------------------------------
+ * REMAP_LOGICAL_BLOCKS  : Stable logical blocks, logical b = physical b
+ *                         until b goes bad, then its spare
+ * REMAP_SPARE_BLOCKS    : Replacement pool at the top of the partition, good
+ *                         pool blocks replace bad logical blocks one for one
+ * REMAP_PARTITION_BLOCKS: Blocks taken from the FTL range (0: NAND_REMAP 0)
+ * REMAP_FIRST_BLOCK     : First logical block
+ * REMAP_LAST_BLOCK      : Last block of the partition (below the second
+ *                         factory info area)
+ * REMAP_POOL_START      : First pool block (= end of the logical range)
+ * REMAP_NONE            : "No block / page" (pool exhausted, out of range)
+ * --------------------------------------------------------------------------- */
+#ifndef REMAP_LOGICAL_BLOCKS
+#define REMAP_LOGICAL_BLOCKS   64
+#endif
+
+#ifndef REMAP_SPARE_BLOCKS
+#define REMAP_SPARE_BLOCKS     8       // Factory bad blocks + worn out ones
+#endif
+
+#if NAND_REMAP
+#define REMAP_PARTITION_BLOCKS (REMAP_LOGICAL_BLOCKS + REMAP_SPARE_BLOCKS)
+#else
+#define REMAP_PARTITION_BLOCKS 0
+#endif
+
+#define REMAP_LAST_BLOCK       FACTORY_INFO_BLOCK2_START
+#define REMAP_FIRST_BLOCK      (REMAP_LAST_BLOCK + 1 - REMAP_PARTITION_BLOCKS)
+#define REMAP_POOL_START       (REMAP_FIRST_BLOCK + REMAP_LOGICAL_BLOCKS)
+#define REMAP_NONE             0xFFFFFFFFU
+
+/* ---------------------------------------------------------------------------
+ * Lookup Table
+ * ---------------------------------------------------------------------------
+ * Fast path: the BBT bit of the logical block (clear -> identity).
+ * Bad logical blocks: open addressing hash (linear probing, no deletion:
+ * a logical block never leaves the map, only its spare changes).
+ * REMAP_HASH_BITS : 2^bits slots, at least 2 x REMAP_SPARE_BLOCKS
+ * --------------------------------------------------------------------------- */
+#ifndef REMAP_HASH_BITS
+#define REMAP_HASH_BITS        5
+#endif
+
+#define REMAP_HASH_SLOTS       (1u << REMAP_HASH_BITS)
+
+#if (REMAP_HASH_SLOTS < 2 * REMAP_SPARE_BLOCKS)
+#error "REMAP_HASH_BITS too small for REMAP_SPARE_BLOCKS"
+#endif
+
+/* ---------------------------------------------------------------------------
+ * On-flash Map (reserved factory info blocks)
+ * ---------------------------------------------------------------------------
+ * REMAP_STORE_BLOCK_A / B : Mirrored copies, one full map record per page
+ *                           appended at each change (magic, seq, entries,
+ *                           CRC-32). The newest valid page of both copies
+ *                           wins, found by binary search (pages are
+ *                           programmed in order). A full block is erased
+ *                           and restarted at page 0, copy A before copy B.
+ * --------------------------------------------------------------------------- */
+#ifndef REMAP_STORE_BLOCK_A
+#define REMAP_STORE_BLOCK_A    (FACTORY_INFO_BLOCK_END - 4)
+#endif
+
+#ifndef REMAP_STORE_BLOCK_B
+#define REMAP_STORE_BLOCK_B    (FACTORY_INFO_BLOCK_END - 3)
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t mapped;          // Logical blocks served by a spare
+	uint32_t spares_free;     // Good, unused pool blocks
+	uint32_t retired;         // Runtime replacements (Remap_Retire)
+	uint32_t copyback;        // Pages migrated with copy-back (13h / 10h)
+	uint32_t fallback;        // Pages migrated through RAM (source uncorrectable)
+	uint32_t store_seq;       // Sequence number of the newest map record
+} Remap_Stats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * Remap_Mount
+ *  - Load the map (after BBT_Mount / BBT_MountLazy), give every known bad
+ *    logical block of the partition a spare, save when something changed.
+ *
+ * Remap_Block / Remap_Page
+ *  - Logical -> physical block / page, O(1): one bitmap bit, a hash probe
+ *    only for bad blocks. A bad block without a spare (found late by the
+ *    lazy scan) gets one here. REMAP_NONE when the pool is exhausted.
+ *
+ * Remap_Read / Remap_Program / Remap_Erase
+ *  - Standard services on the mapped page / block. A program or erase
+ *    failure retires the physical block (Remap_Retire) and retries once on
+ *    the replacement, the logical address does not change.
+ *
+ * Remap_Retire
+ *  - Replace the physical block behind `block`: the first `pages` pages are
+ *    moved to a fresh spare (copy-back, through RAM only when the source is
+ *    uncorrectable), the map is saved, the old block marked bad.
+ * ------------------------------------------------------------------------- */
+bool Remap_Mount(void);
+uint32_t Remap_Block(uint32_t block);
+uint32_t Remap_Page(uint32_t page_addr);
+
+bool Remap_Read(uint32_t page_addr, uint16_t col_addr, uint8_t *buf,
+		uint16_t len);
+bool Remap_Program(uint32_t page_addr, const uint8_t *buf, uint16_t len);
+bool Remap_Erase(uint32_t block);
+bool Remap_Retire(uint32_t block, uint32_t pages);
+
+const Remap_Stats_t* Remap_GetStats(void);
+
+#endif /* SERVICE_REMAP_SERVICE_H_ */
@@ -27,14 +27,20 @@
  *    2. Wait tRST (host should poll R/B# or delay ~10 ms)
  *
  * @return
- *  - true  : Command issued successfully.
- *  - false : Reserved (no hardware feedback available in current layer).
+ *  - true  : Reset completed (BUSY = 0).
+ *  - false : Device still busy after tRST (max) x NAND_READY_TIMEOUT_MUL.
  * --------------------------------------------------------------------------- */
 bool DeviceReset_service(void)
 {
 	DeviceReset();
 
-	printf("[Device Reset] Success\r\n");
+	if (!Nand_WaitReadyOp(NAND_OP_RESET, 0, NULL))
+	{
+		NAND_LOG(RESET_TIMEOUT);
+		return false;
+	}
+
+	NAND_LOG(RESET_OK);
 	return true;
 }
 
@@ -60,13 +66,19 @@ bool DeviceReset_service(void)
  *
  * @return
  *  - true  : Reset command sequence completed successfully.
- *  - false : Reserved (for future error handling).
+ *  - false : Device still busy after tRST (max) x NAND_READY_TIMEOUT_MUL.
  * --------------------------------------------------------------------------- */
 bool SoftwareReset_service(void)
 {
 	EnableReset();
 	Reset();
 
-	printf("[Software Reset] Success\r\n");
+	if (!Nand_WaitReadyOp(NAND_OP_RESET, 0, NULL))
+	{
+		NAND_LOG(SW_RESET_TIMEOUT);
+		return false;
+	}
+
+	NAND_LOG(SW_RESET_OK);
 	return true;
 }
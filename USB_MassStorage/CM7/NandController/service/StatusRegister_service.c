@@ -14,7 +14,8 @@
  * Function: GetSR1
  * ---------------------------------------------------------------------------
  * @brief
- *  - Read Status Register-1 (Address = 0xA0).
+ *  - Read Status Register-1 (Address = 0xA0), served from the device
+ *    shadow once it is valid (see ReadStatusRegisterCached).
  *
  * @details
  *  - Contains protection configuration bits:
@@ -28,7 +29,7 @@
  * --------------------------------------------------------------------------- */
 uint8_t GetSR1(void)
 {
-	return ReadStatusRegister(Status_Register1);
+	return ReadStatusRegisterCached(Status_Register1);
 }
 
 /* ---------------------------------------------------------------------------
@@ -97,7 +98,8 @@ bool IsSRP1Enabled(void)
  * Function: GetSR2
  * ---------------------------------------------------------------------------
  * @brief
- *  - Read Status Register-2 (Address = 0xB0).
+ *  - Read Status Register-2 (Address = 0xB0), served from the device
+ *    shadow once it is valid (see ReadStatusRegisterCached).
  *
  * @details
  *  - Contains configuration features:
@@ -114,7 +116,7 @@ bool IsSRP1Enabled(void)
  * --------------------------------------------------------------------------- */
 uint8_t GetSR2(void)
 {
-	return ReadStatusRegister(Status_Register2);
+	return ReadStatusRegisterCached(Status_Register2);
 }
 
 /* ---------------------------------------------------------------------------
@@ -227,7 +229,7 @@ bool IsECCError_service(void)
 }
 
 /* ---------------------------------------------------------------------------
- * Function: GetECCStatus_service
+ * Function: GetECCStatus_service / DecodeECCStatus_service
  * ---------------------------------------------------------------------------
  * @brief
  *  - Decode ECC result bits (SR3[6:4]).
@@ -238,14 +240,19 @@ bool IsECCError_service(void)
  *      001 : Corrected error (ECC_SUCCESS_CORRECTED)
  *      010 : Uncorrectable (ECC_UNCORRECTABLE)
  *      011 : Corrected, threshold reached (ECC_CORRECTED_THRESHOLD)
- *  - Used after each read operation for reliability check.
+ *  - GetECCStatus_service reads SR3, DecodeECCStatus_service works on an
+ *    SR3 value already read (e.g. NandCompletion_t.sr3).
  *
  * @return
  *  - ECC_Status_t : Enumerated result.
  * --------------------------------------------------------------------------- */
 ECC_Status_t GetECCStatus_service(void)
 {
-	uint8_t sr3 = GetSR3();
+	return DecodeECCStatus_service(GetSR3());
+}
+
+ECC_Status_t DecodeECCStatus_service(uint8_t sr3)
+{
 	uint8_t ecc_bits = (sr3 & SR3_ECC_MASK) >> 4;
 
 	switch (ecc_bits)
@@ -259,8 +266,27 @@ ECC_Status_t GetECCStatus_service(void)
 	case 0b011:
 		return ECC_CORRECTED_THRESHOLD;
 	default:
-		printf("[Warning] ECC Reserved code : 0b%03u (SR3 = 0x%02X)\r\n",
-				ecc_bits, sr3);
+		NAND_LOG(ECC_RESERVED_CODE, ecc_bits, sr3);
 		return ECC_SUCCESS;
 	}
 }
+
+/* ---------------------------------------------------------------------------
+ * Function: DecodeCompletion_service
+ * ---------------------------------------------------------------------------
+ * @brief
+ *  - Fill a NandCompletion_t from one SR3 value, no bus access.
+ *
+ * @param sr3   : SR3 that ended the busy wait.
+ * @param ready : Wait result (false -> timeout).
+ * @param c     : [out] Completion.
+ * --------------------------------------------------------------------------- */
+void DecodeCompletion_service(uint8_t sr3, bool ready, NandCompletion_t *c)
+{
+	c->ready = ready && !(sr3 & SR3_BUSY);
+	c->p_fail = (sr3 & SR3_PFAIL) ? true : false;
+	c->e_fail = (sr3 & SR3_EFAIL) ? true : false;
+	c->wel = (sr3 & SR3_WEL) ? true : false;
+	c->ecc = DecodeECCStatus_service(sr3);
+	c->sr3 = sr3;
+}
@@ -107,6 +107,28 @@ typedef enum
 	ECC_CORRECTED_THRESHOLD
 } ECC_Status_t;
 
+/* ---------------------------------------------------------------------------
+ * Operation Completion
+ * ---------------------------------------------------------------------------
+ * Decoded from the one SR3 read that ended the busy wait (WaitComplete_service)
+ *
+ * ready  : BUSY = 0 before timeout
+ * p_fail : P-FAIL (10h)
+ * e_fail : E-FAIL (D8h)
+ * wel    : WEL still set (program / erase did not run)
+ * ecc    : ECC class of the page just loaded (13h)
+ * sr3    : Raw SR3 value
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	bool ready;
+	bool p_fail;
+	bool e_fail;
+	bool wel;
+	ECC_Status_t ecc;
+	uint8_t sr3;
+} NandCompletion_t;
+
 uint8_t GetSR3(void);
 bool IsWriteEnableLatch_service(void);
 bool IsBusy_service(void);
@@ -114,5 +136,7 @@ bool CheckProgramFail_service(void);
 bool CheckEraseFail_service(void);
 bool IsECCError_service(void);
 ECC_Status_t GetECCStatus_service(void);
+ECC_Status_t DecodeECCStatus_service(uint8_t sr3);
+void DecodeCompletion_service(uint8_t sr3, bool ready, NandCompletion_t *c);
 
 #endif /* SERVICE_STATUSREGISTER_SERVICE_H_ */
@@ -0,0 +1,818 @@
+/*
+ *  W25N02KV_Sim.c
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "W25N02KV_Sim.h"
+
+/* ---------------------------------------------------------------------------
+ * Device constants (same values as the driver headers, kept local so the
+ * model does not depend on the controller being tested)
+ * --------------------------------------------------------------------------- */
+#define SIM_SR1_ADDR          0xA0
+#define SIM_SR2_ADDR          0xB0
+#define SIM_SR3_ADDR          0xC0
+
+#define SIM_SR1_POWERUP       0x7C    // BP3..BP0 = 1111, TB = 1
+#define SIM_SR2_POWERUP       0x18    // ECC-E = 1, BUF = 1
+
+#define SIM_SR2_OTPL          (1u << 7)
+#define SIM_SR2_OTPE          (1u << 6)
+#define SIM_SR2_SR1L          (1u << 5)
+#define SIM_SR2_ECCE          (1u << 4)
+#define SIM_SR2_BUF           (1u << 3)
+
+#define SIM_SR3_BUSY          (1u << 0)
+#define SIM_SR3_WEL           (1u << 1)
+#define SIM_SR3_EFAIL         (1u << 2)
+#define SIM_SR3_PFAIL         (1u << 3)
+#define SIM_SR3_ECC_SHIFT     4
+#define SIM_SR3_ECC_MASK      (0x3u << SIM_SR3_ECC_SHIFT)
+
+#define SIM_ECC_OK            0x0
+#define SIM_ECC_CORRECTED     0x1
+#define SIM_ECC_UNCORRECTABLE 0x2
+#define SIM_ECC_THRESHOLD     0x3
+
+#define SIM_SECTOR_MAIN       (PAGE_MAIN_SIZE / W25N_SIM_ECC_SECTORS)   // 512
+#define SIM_SECTOR_SPARE      (PAGE_SPARE_SIZE / W25N_SIM_ECC_SECTORS)  // 32
+#define SIM_SECTOR_BITS       ((SIM_SECTOR_MAIN + SIM_SECTOR_SPARE) * 8)
+
+#define SIM_JEDEC_LEN         3
+
+static const uint8_t sim_jedec[SIM_JEDEC_LEN] = { 0xEF, 0xAA, 0x22 };
+
+/* ---------------------------------------------------------------------------
+ * Model state
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	W25N_SimConfig_t cfg;
+	W25N_SimStats_t stats;
+
+	uint64_t now_ns;
+	uint64_t busy_until_ns;
+
+	uint8_t sr1, sr2, sr3;
+
+	uint8_t **page;                   // NULL -> erased
+	uint8_t (*errors)[W25N_SIM_ECC_SECTORS];
+	uint32_t *erase_count;
+	bool *factory_bad;
+
+	uint8_t *otp[W25N_SIM_OTP_PAGES];
+
+	uint8_t cache[PAGE_TOTAL_SIZE];
+	uint32_t cache_page;              // Page behind the cache (continuous read)
+	uint8_t cache_ecc;                // Worst ECC class of the cached page(s)
+
+	uint32_t rng;
+	bool reset_armed;                 // 66h seen, 99h completes the reset
+
+	/* Current /CS frame */
+	bool selected;
+	bool rejected;                    // Issued while BUSY, ignored
+	uint8_t opcode;
+	uint32_t idx;                     // Bytes shifted in this frame
+	uint32_t addr;                    // Page / status register address
+	uint32_t col;                     // Cache column
+	uint8_t data;                     // Status register value (1Fh)
+} W25N_Sim_t;
+
+static W25N_Sim_t sim;
+
+/* ---------------------------------------------------------------------------
+ * Helpers
+ * --------------------------------------------------------------------------- */
+static uint32_t sim_rand(void)
+{
+	/// xorshift32, deterministic for a given seed
+	uint32_t x = sim.rng;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	sim.rng = x;
+	return x;
+}
+
+static bool sim_busy(void)
+{
+	return sim.now_ns < sim.busy_until_ns;
+}
+
+static void sim_set_busy(uint32_t ns)
+{
+	sim.busy_until_ns = sim.now_ns + ns;
+}
+
+static uint8_t sim_sr3(void)
+{
+	return (uint8_t) (sim.sr3 | (sim_busy() ? SIM_SR3_BUSY : 0));
+}
+
+static void sim_set_ecc(uint8_t ecc)
+{
+	sim.sr3 = (uint8_t) ((sim.sr3 & ~SIM_SR3_ECC_MASK)
+			| (ecc << SIM_SR3_ECC_SHIFT));
+}
+
+/// Severity order: 00 < 01 < 11 < 10
+static uint8_t sim_ecc_worse(uint8_t a, uint8_t b)
+{
+	static const uint8_t rank[4] = { 0, 1, 3, 2 };
+	return (rank[b] > rank[a]) ? b : a;
+}
+
+/// Block range covered by SR1[BP3:BP0] / SR1[TB]
+static bool sim_protected(uint32_t block)
+{
+	uint8_t bp = (sim.sr1 >> 3) & 0x0F;
+	uint32_t count;
+
+	if (bp == 0)
+		return false;
+
+	count = (bp >= 11) ? TOTAL_BLOCKS : (TOTAL_BLOCKS >> (11 - bp));
+
+	if (sim.sr1 & (1u << 2))
+		return block < count;                  // TB = 1: bottom
+	else
+		return block >= TOTAL_BLOCKS - count;  // TB = 0: top
+}
+
+static uint8_t* sim_page_alloc(uint8_t **slot)
+{
+	if (*slot == NULL)
+	{
+		*slot = malloc(PAGE_TOTAL_SIZE);
+		if (*slot == NULL)
+		{
+			fprintf(stderr, "[SIM] Out of memory\r\n");
+			exit(1);
+		}
+		memset(*slot, NAND_ERASED_STATE, PAGE_TOTAL_SIZE);
+	}
+	return *slot;
+}
+
+/// Poisson draw (small lambda) for random raw bit errors of one sector
+static uint8_t sim_random_flips(void)
+{
+	if (sim.cfg.bitflip_ppm == 0)
+		return 0;
+
+	double lambda = (double) SIM_SECTOR_BITS * sim.cfg.bitflip_ppm / 1e6;
+	double limit = exp(-lambda), p = 1.0;
+	uint8_t k = 0;
+
+	do
+	{
+		k++;
+		p *= (sim_rand() + 1.0) / 4294967297.0;
+	} while (p > limit && k < 255);
+
+	return (uint8_t) (k - 1);
+}
+
+/// Flip one random bit inside ECC sector s (512 B main + 32 B spare)
+static void sim_flip_bit(uint8_t *buf, uint8_t s)
+{
+	uint32_t bit = sim_rand() % SIM_SECTOR_BITS;
+	uint32_t byte = bit >> 3;
+
+	if (byte < SIM_SECTOR_MAIN)
+		byte = s * SIM_SECTOR_MAIN + byte;
+	else
+		byte = PAGE_MAIN_SIZE + s * SIM_SECTOR_SPARE + (byte - SIM_SECTOR_MAIN);
+
+	buf[byte] ^= (uint8_t) (1u << (bit & 7));
+}
+
+/* ---------------------------------------------------------------------------
+ * Array operations (run when the /CS frame ends)
+ * --------------------------------------------------------------------------- */
+static void sim_load_page(uint32_t page)
+{
+	uint8_t ecc = SIM_ECC_OK;
+	const uint8_t *src;
+
+	sim.cache_page = page;
+	sim.stats.page_reads++;
+
+	if (sim.sr2 & SIM_SR2_OTPE)
+		src = (page < W25N_SIM_OTP_PAGES) ? sim.otp[page] : NULL;
+	else
+		src = (page < TOTAL_PAGES) ? sim.page[page] : NULL;
+
+	if (src)
+		memcpy(sim.cache, src, PAGE_TOTAL_SIZE);
+	else
+		memset(sim.cache, NAND_ERASED_STATE, PAGE_TOTAL_SIZE);
+
+	if (!(sim.sr2 & SIM_SR2_OTPE) && page < TOTAL_PAGES)
+	{
+		for (uint8_t s = 0; s < W25N_SIM_ECC_SECTORS; s++)
+		{
+			uint32_t n = sim.errors[page][s] + sim_random_flips();
+			uint8_t cls;
+
+			if (n == 0)
+				continue;
+
+			if (!(sim.sr2 & SIM_SR2_ECCE) || n > W25N_SIM_ECC_MAX_BITS)
+			{
+				/// Raw data reaches the host
+				for (uint32_t i = 0; i < n; i++)
+					sim_flip_bit(sim.cache, s);
+
+				cls = SIM_ECC_UNCORRECTABLE;
+			}
+			else
+			{
+				cls = (n > sim.cfg.ecc_threshold) ?
+						SIM_ECC_THRESHOLD : SIM_ECC_CORRECTED;
+			}
+
+			if (sim.sr2 & SIM_SR2_ECCE)
+				ecc = sim_ecc_worse(ecc, cls);
+		}
+	}
+
+	if (ecc == SIM_ECC_UNCORRECTABLE)
+		sim.stats.ecc_uncorrectable++;
+	else if (ecc != SIM_ECC_OK)
+		sim.stats.ecc_corrected++;
+
+	sim.cache_ecc = ecc;
+	sim_set_ecc(ecc);
+	sim_set_busy(sim.cfg.t_read_ns);
+}
+
+static void sim_program(uint32_t page)
+{
+	bool wel = sim.sr3 & SIM_SR3_WEL;
+	uint32_t block = page / PAGES_PER_BLOCK;
+	uint8_t *dst;
+
+	sim.sr3 &= (uint8_t) ~(SIM_SR3_PFAIL | SIM_SR3_WEL);
+	if (!wel)
+		return;
+
+	sim_set_busy(sim.cfg.t_prog_ns);
+
+	sim.stats.page_programs++;
+
+	if (sim.sr2 & SIM_SR2_OTPE)
+	{
+		if (page >= W25N_SIM_OTP_PAGES || (sim.sr2 & SIM_SR2_OTPL))
+		{
+			sim.sr3 |= SIM_SR3_PFAIL;
+			return;
+		}
+		dst = sim_page_alloc(&sim.otp[page]);
+	}
+	else
+	{
+		if (page >= TOTAL_PAGES || sim.factory_bad[block]
+				|| (sim.cfg.endurance
+						&& sim.erase_count[block] >= sim.cfg.endurance))
+		{
+			sim.sr3 |= SIM_SR3_PFAIL;
+			return;
+		}
+		if (sim_protected(block))
+		{
+			sim.stats.protect_rejects++;
+			sim.sr3 |= SIM_SR3_PFAIL;
+			return;
+		}
+		dst = sim_page_alloc(&sim.page[page]);
+	}
+
+	/// NAND program can only clear bits
+	for (uint32_t i = 0; i < PAGE_TOTAL_SIZE; i++)
+		dst[i] &= sim.cache[i];
+}
+
+static void sim_erase(uint32_t page)
+{
+	bool wel = sim.sr3 & SIM_SR3_WEL;
+	uint32_t block = page / PAGES_PER_BLOCK;
+
+	sim.sr3 &= (uint8_t) ~(SIM_SR3_EFAIL | SIM_SR3_WEL);
+	if (!wel)
+		return;
+
+	sim_set_busy(sim.cfg.t_erase_ns);
+
+	sim.stats.block_erases++;
+
+	if (block >= TOTAL_BLOCKS || sim.factory_bad[block]
+			|| (sim.sr2 & SIM_SR2_OTPE))
+	{
+		sim.sr3 |= SIM_SR3_EFAIL;
+		return;
+	}
+	if (sim_protected(block))
+	{
+		sim.stats.protect_rejects++;
+		sim.sr3 |= SIM_SR3_EFAIL;
+		return;
+	}
+	if (sim.cfg.endurance && sim.erase_count[block] >= sim.cfg.endurance)
+	{
+		/// Worn out: erase no longer completes
+		sim.sr3 |= SIM_SR3_EFAIL;
+		return;
+	}
+
+	for (uint32_t p = block * PAGES_PER_BLOCK; p < (block + 1) * PAGES_PER_BLOCK; p++)
+	{
+		free(sim.page[p]);
+		sim.page[p] = NULL;
+		memset(sim.errors[p], 0, W25N_SIM_ECC_SECTORS);
+	}
+
+	sim.erase_count[block]++;
+}
+
+static void sim_write_sr(uint8_t addr, uint8_t val)
+{
+	switch (addr)
+	{
+	case SIM_SR1_ADDR:
+		if (!(sim.sr2 & SIM_SR2_SR1L))
+			sim.sr1 = val;
+		break;
+
+	case SIM_SR2_ADDR:
+		/// OTP-L / SR1-L are one-time bits
+		sim.sr2 = (uint8_t) (val | (sim.sr2 & (SIM_SR2_OTPL | SIM_SR2_SR1L)));
+		break;
+
+	default:
+		break;   // SR3 is read only
+	}
+}
+
+static uint8_t sim_read_sr(uint8_t addr)
+{
+	switch (addr)
+	{
+	case SIM_SR1_ADDR:
+		return sim.sr1;
+	case SIM_SR2_ADDR:
+		return sim.sr2;
+	case SIM_SR3_ADDR:
+		return sim_sr3();
+	default:
+		return 0x00;
+	}
+}
+
+static void sim_device_reset(void)
+{
+	sim.sr3 = 0;
+	sim.busy_until_ns = sim.now_ns;
+	sim_set_busy(sim.cfg.t_reset_ns);
+
+	/// Page 0 is loaded into the cache after reset
+	memset(sim.cache, NAND_ERASED_STATE, PAGE_TOTAL_SIZE);
+	if (sim.page[0])
+		memcpy(sim.cache, sim.page[0], PAGE_TOTAL_SIZE);
+	sim.cache_page = 0;
+	sim.cache_ecc = SIM_ECC_OK;
+}
+
+/* ---------------------------------------------------------------------------
+ * Frame decoder
+ * --------------------------------------------------------------------------- */
+static bool sim_allowed_while_busy(uint8_t op)
+{
+	return op == 0x0F || op == 0x05 || op == 0xFF;
+}
+
+static void sim_select(void)
+{
+	sim.selected = true;
+	sim.rejected = false;
+	sim.idx = 0;
+	sim.addr = 0;
+	sim.col = 0;
+	sim.data = 0;
+	sim.stats.frames++;
+}
+
+static uint8_t sim_read_cache_byte(void)
+{
+	uint8_t out;
+
+	if (sim.sr2 & SIM_SR2_BUF)
+	{
+		out = sim.cache[sim.col % PAGE_TOTAL_SIZE];
+		sim.col++;
+		return out;
+	}
+
+	/// Continuous read: main area only, next page loaded after the last byte
+	out = sim.cache[sim.col];
+	if (++sim.col >= PAGE_MAIN_SIZE)
+	{
+		uint8_t ecc = sim.cache_ecc;
+
+		sim.col = 0;
+		sim_load_page((sim.cache_page + 1) % TOTAL_PAGES);
+		sim.cache_ecc = sim_ecc_worse(ecc, sim.cache_ecc);
+		sim_set_ecc(sim.cache_ecc);
+		sim.busy_until_ns = sim.now_ns;   // Next page prefetched during output
+	}
+	return out;
+}
+
+static uint8_t sim_shift(uint8_t in)
+{
+	uint32_t i = sim.idx++;
+	uint8_t out = 0xFF;
+
+	sim.stats.bytes++;
+
+	if (i == 0)
+	{
+		sim.opcode = in;
+
+		if (sim_busy() && !sim_allowed_while_busy(in))
+		{
+			sim.rejected = true;
+			sim.stats.busy_rejects++;
+			return out;
+		}
+
+		if (in != 0x99)
+			sim.reset_armed = false;
+
+		switch (in)
+		{
+		case 0x02:   // Load Program Data: unloaded bytes become FFh
+			if (sim.sr3 & SIM_SR3_WEL)
+				memset(sim.cache, NAND_ERASED_STATE, PAGE_TOTAL_SIZE);
+			break;
+		case 0x0F:
+		case 0x05:
+			sim.stats.status_reads++;
+			break;
+		default:
+			break;
+		}
+		return out;
+	}
+
+	if (sim.rejected)
+		return out;
+
+	switch (sim.opcode)
+	{
+	case 0x9F:   // JEDEC ID: opcode + 1 dummy
+		if (i >= 2)
+			out = sim_jedec[(i - 2) % SIM_JEDEC_LEN];
+		break;
+
+	case 0x0F:
+	case 0x05:   // Read Status Register
+		if (i == 1)
+			sim.addr = in;
+		else
+			out = sim_read_sr((uint8_t) sim.addr);
+		break;
+
+	case 0x1F:
+	case 0x01:   // Write Status Register
+		if (i == 1)
+			sim.addr = in;
+		else if (i == 2)
+			sim.data = in;
+		break;
+
+	case 0x13:   // Page Data Read
+	case 0x10:   // Program Execute
+	case 0xD8:   // Block Erase
+		if (i <= 3)
+			sim.addr = (sim.addr << 8) | in;
+		break;
+
+	case 0x03:
+	case 0x0B:   // Read Data / Fast Read
+		if (sim.sr2 & SIM_SR2_BUF)
+		{
+			/// BUF = 1: CA[15:8], CA[7:0], dummy
+			if (i <= 2)
+				sim.col = (sim.col << 8) | in;
+			else if (i >= 4)
+				out = sim_read_cache_byte();
+		}
+		else if (i >= 4)
+		{
+			/// BUF = 0: 3 dummy bytes, output from column 0
+			out = sim_read_cache_byte();
+		}
+		break;
+
+	case 0x02:
+	case 0x84:   // (Random) Load Program Data
+		if (i <= 2)
+			sim.col = (sim.col << 8) | in;
+		else if (sim.sr3 & SIM_SR3_WEL)
+		{
+			if (sim.col < PAGE_TOTAL_SIZE)
+				sim.cache[sim.col] = in;
+			sim.col++;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return out;
+}
+
+static void sim_deselect(void)
+{
+	sim.selected = false;
+
+	if (sim.rejected || sim.idx == 0)
+		return;
+
+	switch (sim.opcode)
+	{
+	case 0x06:
+		sim.sr3 |= SIM_SR3_WEL;
+		break;
+
+	case 0x04:
+		sim.sr3 &= (uint8_t) ~SIM_SR3_WEL;
+		break;
+
+	case 0x1F:
+	case 0x01:
+		if (sim.idx >= 3)
+			sim_write_sr((uint8_t) sim.addr, sim.data);
+		break;
+
+	case 0x13:
+		if (sim.idx >= 4)
+			sim_load_page(sim.addr & 0xFFFFFF);
+		break;
+
+	case 0x10:
+		if (sim.idx >= 4)
+			sim_program(sim.addr & 0xFFFFFF);
+		break;
+
+	case 0xD8:
+		if (sim.idx >= 4)
+			sim_erase(sim.addr & 0xFFFFFF);
+		break;
+
+	case 0xFF:
+		sim_device_reset();
+		break;
+
+	case 0x66:
+		sim.reset_armed = true;
+		break;
+
+	case 0x99:
+		if (sim.reset_armed)
+		{
+			sim.sr1 = SIM_SR1_POWERUP;
+			sim.sr2 = (uint8_t) (SIM_SR2_POWERUP
+					| (sim.sr2 & (SIM_SR2_OTPL | SIM_SR2_SR1L)));
+			sim_device_reset();
+		}
+		sim.reset_armed = false;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* ===========================================================================
+ * Function: W25N_Sim_DefaultConfig
+ * ===========================================================================
+ * @brief
+ *  - Typical datasheet timing, ECC threshold 4 bits, no errors, no bad blocks.
+ * --------------------------------------------------------------------------- */
+void W25N_Sim_DefaultConfig(W25N_SimConfig_t *cfg)
+{
+	memset(cfg, 0, sizeof(*cfg));
+
+	cfg->t_read_ns = W25N_SIM_T_READ_NS;
+	cfg->t_prog_ns = W25N_SIM_T_PROG_NS;
+	cfg->t_erase_ns = W25N_SIM_T_ERASE_NS;
+	cfg->t_reset_ns = W25N_SIM_T_RESET_NS;
+	cfg->spi_hz = W25N_SIM_SPI_HZ;
+	cfg->frame_ns = 200;
+	cfg->ecc_threshold = 4;
+	cfg->seed = 0x2545F491;
+}
+
+/* ===========================================================================
+ * Function: W25N_Sim_Init
+ * ===========================================================================
+ * @brief
+ *  - Power-up the device model.
+ *
+ * @details
+ *  - SR1 = 7Ch (all blocks protected), SR2 = 18h (ECC-E, BUF), as on silicon.
+ *  - Factory bad blocks get 00h at page 0 main[0] and spare[0] and refuse
+ *    program / erase (P-FAIL / E-FAIL).
+ *
+ * @param cfg : Configuration, NULL -> W25N_Sim_DefaultConfig().
+ *
+ * @return
+ *  - true  : Model ready.
+ *  - false : Out of memory.
+ * --------------------------------------------------------------------------- */
+bool W25N_Sim_Init(const W25N_SimConfig_t *cfg)
+{
+	W25N_Sim_Free();
+	memset(&sim, 0, sizeof(sim));
+
+	if (cfg)
+		sim.cfg = *cfg;
+	else
+		W25N_Sim_DefaultConfig(&sim.cfg);
+
+	if (sim.cfg.spi_hz == 0)
+		sim.cfg.spi_hz = W25N_SIM_SPI_HZ;
+
+	sim.page = calloc(TOTAL_PAGES, sizeof(*sim.page));
+	sim.errors = calloc(TOTAL_PAGES, sizeof(*sim.errors));
+	sim.erase_count = calloc(TOTAL_BLOCKS, sizeof(*sim.erase_count));
+	sim.factory_bad = calloc(TOTAL_BLOCKS, sizeof(*sim.factory_bad));
+
+	if (!sim.page || !sim.errors || !sim.erase_count || !sim.factory_bad)
+	{
+		W25N_Sim_Free();
+		return false;
+	}
+
+	sim.rng = sim.cfg.seed ? sim.cfg.seed : 1;
+	sim.sr1 = SIM_SR1_POWERUP;
+	sim.sr2 = SIM_SR2_POWERUP;
+
+	for (uint16_t i = 0; i < sim.cfg.bad_count; i++)
+	{
+		uint16_t b = sim.cfg.bad_blocks[i];
+		uint8_t *p;
+
+		if (b >= TOTAL_BLOCKS)
+			continue;
+
+		sim.factory_bad[b] = true;
+		p = sim_page_alloc(&sim.page[PAGE_ADDR(b, 0)]);
+		p[0] = 0x00;
+		p[PAGE_MAIN_SIZE] = 0x00;
+	}
+
+	sim_device_reset();
+	sim.busy_until_ns = 0;
+	return true;
+}
+
+void W25N_Sim_Free(void)
+{
+	if (sim.page)
+	{
+		for (uint32_t p = 0; p < TOTAL_PAGES; p++)
+			free(sim.page[p]);
+	}
+	for (uint8_t i = 0; i < W25N_SIM_OTP_PAGES; i++)
+	{
+		free(sim.otp[i]);
+		sim.otp[i] = NULL;
+	}
+
+	free(sim.page);
+	free(sim.errors);
+	free(sim.erase_count);
+	free(sim.factory_bad);
+
+	sim.page = NULL;
+	sim.errors = NULL;
+	sim.erase_count = NULL;
+	sim.factory_bad = NULL;
+}
+
+/* ===========================================================================
+ * Function: W25N_Sim_Transfer
+ * ===========================================================================
+ * @brief
+ *  - One complete /CS frame.
+ *
+ * @details
+ *  - Bus time = frame_ns + len * 8 / spi_hz is added to the simulated clock.
+ *  - Array operations (13h / 10h / D8h / reset) start when /CS goes high,
+ *    BUSY then stays set for the configured tRD / tPP / tBE.
+ *  - Any command other than status read / FFh during BUSY is ignored and
+ *    counted in busy_rejects.
+ *
+ * @param tx  : Bytes shifted in (NULL -> FFh)
+ * @param rx  : Bytes shifted out (NULL -> discarded)
+ * @param len : Frame length
+ * --------------------------------------------------------------------------- */
+void W25N_Sim_Transfer(const uint8_t *tx, uint8_t *rx, uint32_t len)
+{
+	W25N_Sim_Frame(NULL, 0, tx, rx, len);
+}
+
+/* ===========================================================================
+ * Function: W25N_Sim_Frame
+ * ===========================================================================
+ * @brief
+ *  - One /CS frame made of a command header followed by a data phase.
+ *
+ * @details
+ *  - Same as W25N_Sim_Transfer() on the concatenated bytes, without the
+ *    caller having to build a header + page sized buffer.
+ * --------------------------------------------------------------------------- */
+void W25N_Sim_Frame(const uint8_t *hdr, uint32_t hdr_len, const uint8_t *tx,
+		uint8_t *rx, uint32_t len)
+{
+	uint64_t bits = (uint64_t) (hdr_len + len) * 8u;
+
+	sim.now_ns += sim.cfg.frame_ns + (bits * 1000000000u) / sim.cfg.spi_hz;
+
+	sim_select();
+
+	for (uint32_t i = 0; i < hdr_len; i++)
+		sim_shift(hdr[i]);
+
+	for (uint32_t i = 0; i < len; i++)
+	{
+		uint8_t out = sim_shift(tx ? tx[i] : 0xFF);
+		if (rx)
+			rx[i] = out;
+	}
+
+	sim_deselect();
+}
+
+uint64_t W25N_Sim_TimeNs(void)
+{
+	return sim.now_ns;
+}
+
+void W25N_Sim_AdvanceNs(uint64_t ns)
+{
+	sim.now_ns += ns;
+}
+
+bool W25N_Sim_IsBusy(void)
+{
+	return sim_busy();
+}
+
+/* ===========================================================================
+ * Function: W25N_Sim_InjectBitErrors
+ * ===========================================================================
+ * @brief
+ *  - Add persistent raw bit errors to one ECC sector of a page.
+ *
+ * @details
+ *  - Every 13h on the page sees these errors (plus random flips).
+ *  - With ECC-E = 1: <= threshold -> 01b, <= 8 -> 11b, > 8 -> 10b and the
+ *    flipped bits are returned. With ECC-E = 0 the flips are always visible.
+ *  - Cleared when the block is erased.
+ * --------------------------------------------------------------------------- */
+void W25N_Sim_InjectBitErrors(uint32_t page, uint8_t sector, uint8_t bits)
+{
+	if (page >= TOTAL_PAGES || sector >= W25N_SIM_ECC_SECTORS)
+		return;
+
+	uint32_t n = sim.errors[page][sector] + bits;
+	sim.errors[page][sector] = (uint8_t) (n > 255 ? 255 : n);
+}
+
+uint32_t W25N_Sim_EraseCount(uint32_t block)
+{
+	return (block < TOTAL_BLOCKS) ? sim.erase_count[block] : 0;
+}
+
+const W25N_SimStats_t* W25N_Sim_Stats(void)
+{
+	return &sim.stats;
+}
+
+void W25N_Sim_ResetStats(void)
+{
+	memset(&sim.stats, 0, sizeof(sim.stats));
+}
@@ -0,0 +1,113 @@
+/*
+ *  W25N02KV_Sim.h
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator
+ */
+
+#ifndef NANDSIMULATOR_W25N02KV_SIM_H_
+#define NANDSIMULATOR_W25N02KV_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "W25N02KV_Config.h"
+
+/* ---------------------------------------------------------------------------
+ * Simulator Configuration
+ * ---------------------------------------------------------------------------
+ * t_read_ns      : tRD  (13h page -> cache)
+ * t_prog_ns      : tPP  (10h cache -> page)
+ * t_erase_ns     : tBE  (D8h block erase)
+ * t_reset_ns     : tRST (FFh / 66h + 99h)
+ * spi_hz         : Bus clock used to charge frame transfer time
+ * frame_ns       : Fixed cost per /CS frame (driver + CS setup / hold)
+ * bitflip_ppm    : Random raw bit errors per read, parts per million per bit
+ * ecc_threshold  : Corrected bits per sector reported as ECC 11b (threshold)
+ * endurance      : Erase cycles before a block starts failing (0 = never)
+ * seed           : PRNG seed, identical seed -> identical run
+ * bad_blocks     : Factory bad blocks (marker 00h at page0 main[0] / spare[0])
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint32_t t_read_ns;
+	uint32_t t_prog_ns;
+	uint32_t t_erase_ns;
+	uint32_t t_reset_ns;
+	uint32_t spi_hz;
+	uint32_t frame_ns;
+	uint32_t bitflip_ppm;
+	uint8_t ecc_threshold;
+	uint32_t endurance;
+	uint32_t seed;
+	const uint16_t *bad_blocks;
+	uint16_t bad_count;
+} W25N_SimConfig_t;
+
+/* W25N02KV typical values, 104 MHz single line */
+#define W25N_SIM_T_READ_NS     25000U
+#define W25N_SIM_T_PROG_NS     250000U
+#define W25N_SIM_T_ERASE_NS    2000000U
+#define W25N_SIM_T_RESET_NS    5000U
+#define W25N_SIM_SPI_HZ        104000000U
+#define W25N_SIM_ECC_SECTORS   4           // 512 B main + 32 B spare each
+#define W25N_SIM_ECC_MAX_BITS  8           // Correctable bits per sector
+#define W25N_SIM_OTP_PAGES     12          // OTP page 0x00 ~ 0x0B
+
+/* ---------------------------------------------------------------------------
+ * Statistics
+ * --------------------------------------------------------------------------- */
+typedef struct
+{
+	uint64_t frames;            // /CS frames
+	uint64_t bytes;             // Bytes on the bus
+	uint64_t page_reads;        // 13h
+	uint64_t page_programs;     // 10h
+	uint64_t block_erases;      // D8h
+	uint64_t status_reads;      // 0Fh / 05h
+	uint64_t busy_rejects;      // Commands issued while BUSY = 1
+	uint64_t ecc_corrected;     // Reads with ECC 01b / 11b
+	uint64_t ecc_uncorrectable; // Reads with ECC 10b
+	uint64_t protect_rejects;   // Program / erase on BP-protected block
+} W25N_SimStats_t;
+
+/* -------------------------------------------------------------------------
+ * Function Introduction
+ * -------------------------------------------------------------------------
+ * W25N_Sim_Init / W25N_Sim_Free
+ *  - Power-up the model (cfg = NULL -> defaults). Erased pages cost no RAM.
+ *
+ * W25N_Sim_Transfer
+ *  - One /CS frame: tx is shifted in, rx (may be NULL) shifted out.
+ *
+ * W25N_Sim_Frame
+ *  - One /CS frame: header bytes, then data phase (tx in / rx out).
+ *
+ * W25N_Sim_TimeNs / W25N_Sim_AdvanceNs
+ *  - Simulated clock. Advanced by frames, or by the caller while idle.
+ *
+ * W25N_Sim_InjectBitErrors
+ *  - Persistent raw bit errors on one ECC sector of a page (cleared by erase).
+ *
+ * W25N_Sim_EraseCount
+ *  - P/E cycles of a block (wear model / FTL verification).
+ * ------------------------------------------------------------------------- */
+void W25N_Sim_DefaultConfig(W25N_SimConfig_t *cfg);
+bool W25N_Sim_Init(const W25N_SimConfig_t *cfg);
+void W25N_Sim_Free(void);
+
+void W25N_Sim_Transfer(const uint8_t *tx, uint8_t *rx, uint32_t len);
+void W25N_Sim_Frame(const uint8_t *hdr, uint32_t hdr_len, const uint8_t *tx,
+		uint8_t *rx, uint32_t len);
+
+uint64_t W25N_Sim_TimeNs(void);
+void W25N_Sim_AdvanceNs(uint64_t ns);
+bool W25N_Sim_IsBusy(void);
+
+void W25N_Sim_InjectBitErrors(uint32_t page, uint8_t sector, uint8_t bits);
+uint32_t W25N_Sim_EraseCount(uint32_t block);
+
+const W25N_SimStats_t* W25N_Sim_Stats(void);
+void W25N_Sim_ResetStats(void);
+
+#endif /* NANDSIMULATOR_W25N02KV_SIM_H_ */
@@ -0,0 +1,27 @@
+/*
+ *  nand_hal.h (host)
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator/host
+ *
+ *  Stands in for NandController/hal/nand_hal.h on the host build. Drivers
+ *  only reach the bus through nand_transport.h, so no STM32 HAL is needed.
+ *  Must come first on the include path (-INandSimulator/host).
+ */
+
+#ifndef HAL_NAND_HAL_H_
+#define HAL_NAND_HAL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "W25N02KV_Config.h"
+#include "nand_transport.h"
+#include "nand_ready.h"
+#include "nand_log.h"
+
+#endif /* HAL_NAND_HAL_H_ */
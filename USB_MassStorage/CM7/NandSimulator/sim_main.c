@@ -0,0 +1,1192 @@
+/*
+ *  sim_main.c
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator
+ *
+ *  Host runner: NandController driver / service / application code on top of
+ *  the W25N02KV behavioral model. Not part of the STM32CubeIDE build.
+ *
+ *  Build (from USB_MassStorage/CM7):
+ *
+ *    gcc -O2 -std=gnu11 -o nand_sim \
+ *        -INandSimulator/host -INandSimulator \
+ *        -INandController/driver -INandController/service \
+ *        -INandController/application -INandController/hal \
+ *        -IFTLController/Inc \
+ *        NandSimulator/W25N02KV_Sim.c NandSimulator/sim_transport.c \
+ *        NandSimulator/sim_main.c NandController/hal/nand_transport.c \
+ *        NandController/hal/nand_ready.c NandController/hal/nand_log.c \
+ *        $(find NandController/driver NandController/service -name '*.c') \
+ *        $(find FTLController/Src -name '*.c') \
+ *        NandController/application/Pattern.c \
+ *        NandController/application/Endurance_Test.c \
+ *        NandController/application/FactoryInvalidBlockScan_Test.c \
+ *        NandController/application/SinglePage_Test.c -lm
+ *
+ *  Hybrid mapping build (FTL_MAPPING_HYBRID): the same command with
+ *  -DFTL_MAPPING=1 -o nand_sim_hyb. The endurance and remap workloads use
+ *  the Remap raw partition above the FTL range (REMAP_FIRST_BLOCK ~
+ *  REMAP_POOL_START - 1, NAND_REMAP 1).
+ *
+ *  SpiOverhead_Bench.c measures the real SPI2 / DWT and stays target only.
+ *
+ *  Usage:
+ *
+ *    nand_sim [options] scan              Factory bad block scan (BBT)
+ *    nand_sim [options] unit <block>      Standard_UnitTest on one block
+ *    nand_sim [options] endurance <block> EnduranceTest_Run on one logical
+ *                                         block of the raw partition
+ *    nand_sim [options] choose            Scan + first valid block unit test
+ *    nand_sim [options] queue <block>     Erase + program + read one block
+ *                                         through NandQueue (asynchronous)
+ *    nand_sim [options] stream <block>    Program STREAM_BLOCKS blocks, read
+ *                                         them page by page (13h + 03h) and
+ *                                         as one continuous stream (BUF = 0)
+ *    nand_sim [options] copy <block>      Relocate <block> to <block + 1>
+ *                                         with CopyPage_Service (13h / 10h)
+ *    nand_sim [options] mount             BBT_Mount on a blank device (scan +
+ *                                         save), runtime marks, then reload
+ *    nand_sim [options] lazy              BBT_MountLazy on a blank device:
+ *                                         instant mount, verified allocation,
+ *                                         background steps until saved
+ *    nand_sim [options] remap <block>     Wear logical <block> out (use -e),
+ *                                         check the data moved to a spare
+ *                                         and the map survives a remount
+ *    nand_sim [options] usb               Host traffic through the FTL
+ *                                         (sequential, random 4 KB, single
+ *                                         sectors), verify, power loss and
+ *                                         clean remount, verify
+ *    nand_sim [options] gc [cb]           Whole logical space written, random
+ *                                         4 KB overwrites (GC), verify,
+ *                                         power loss remount, verify
+ *                                         (cb: cost-benefit victims), idle
+ *                                         time GC up to the high watermark
+ *    nand_sim [options] log               FAT32 logging: full volume, a log
+ *                                         file cycled, bulk data left alone,
+ *                                         FAT / directory rewritten on every
+ *                                         append; write amplification, verify,
+ *                                         power loss remount, verify
+ *    nand_sim [options] boot              Firmware boot order (BBT_MountLazy,
+ *                                         FTL_Mount, FTL_Idle): data written
+ *                                         before the table was complete, idle
+ *                                         walk next boot, the third boot loads
+ *                                         the factory bad blocks only
+ *
+ *    -q            Silence controller printf, print the report only
+ *    -s <seed>     PRNG seed (default fixed -> identical runs)
+ *    -p <ppm>      Random raw bit error rate per read
+ *    -e <cycles>   Block endurance, E-FAIL / P-FAIL after <cycles> erases
+ *    -b <list>     Factory bad blocks, comma separated (e.g. -b 12,300,1999)
+ *    -f <hz>       SPI clock used for bus time
+ *    -t <r,p,e>    tRD, tPP, tBE in microseconds
+ *    -r <mode>     Ready wait: poll | delay | auto (default delay)
+ *    -l            Dump the trace ring as #NLOG lines (nand_trace_decode.py)
+ *                  instead of draining it as text after the run
+ *
+ *  Exit status: 0, 1 when a workload reported FAIL, 2 on a usage error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "W25N02KV_Sim.h"
+#include "sim_transport.h"
+#include "FactoryInvalidBlockScan_Test.h"
+#include "Endurance_Test.h"
+#include "NandQueue_service.h"
+#include "ContinuousRead_service.h"
+#include "BlockErase_service.h"
+#include "Program_service.h"
+#include "Read_service.h"
+#include "Remap_service.h"
+#include "FlashTranslationLayer.h"
+#include "Cache.h"
+#include "GarbageCollection.h"
+#include "HybridMapping.h"
+#include "WearLeveling.h"
+#include "HotCold.h"
+
+#define SIM_MAX_BAD_BLOCKS 256
+
+static uint16_t bad_list[SIM_MAX_BAD_BLOCKS];
+static uint16_t bad_list_len = 0;
+static bool sim_failed = false;
+
+/// Verify result printed by the workloads, any FAIL -> exit status 1
+static const char* verdict(bool ok)
+{
+	if (!ok)
+		sim_failed = true;
+
+	return ok ? "PASS" : "FAIL";
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: nand_sim [-q] [-s seed] [-p ppm] [-e cycles] "
+			"[-b b0,b1,..] [-f hz] [-t tr,tp,te] [-r poll|delay|auto] [-l] "
+			"scan | unit <block> | endurance <block> | choose | queue <block> | "
+			"stream <block> | copy <block> | mount | lazy | remap <block> | usb | "
+			"gc [cb] | log | boot\n");
+	exit(2);
+}
+
+static uint16_t parse_bad_blocks(char *arg)
+{
+	uint16_t n = 0;
+
+	for (char *tok = strtok(arg, ","); tok && n < SIM_MAX_BAD_BLOCKS;
+			tok = strtok(NULL, ","))
+		bad_list[n++] = (uint16_t) strtoul(tok, NULL, 0);
+
+	return n;
+}
+
+/* ---------------------------------------------------------------------------
+ * queue: whole block through the asynchronous engine
+ * ---------------------------------------------------------------------------
+ * The "application" only calls NandQueue_Poll() and spends the time the
+ * engine hands back on its own work (simulated by advancing the clock),
+ * the same way the USB / FTL loop would on target. The erase callback reads
+ * the erased page back through a blocking service (engine re-entry).
+ * --------------------------------------------------------------------------- */
+static uint32_t queue_done;
+
+static void queue_cb(NandRequest_t *req, void *user)
+{
+	static uint8_t page[PAGE_MAIN_SIZE];
+	bool *erased = user;
+
+	if (erased != NULL)
+	{
+		*erased = StandardRead_Service(PAGE_ADDR(req->page, 0), 0, page,
+				PAGE_MAIN_SIZE);
+		for (uint32_t i = 0; *erased && i < PAGE_MAIN_SIZE; i++)
+			*erased = (page[i] == NAND_ERASED_STATE);
+	}
+
+	queue_done++;
+}
+
+static uint64_t queue_drive(uint32_t target)
+{
+	uint64_t app_ns = 0;
+
+	while (queue_done < target)
+	{
+		uint32_t next_us = NandQueue_Poll();
+
+		if (next_us == NAND_QUEUE_IDLE)
+			break;
+		if (next_us != 0)
+		{
+			W25N_Sim_AdvanceNs((uint64_t) next_us * 1000U);
+			app_ns += (uint64_t) next_us * 1000U;
+		}
+	}
+
+	return app_ns;
+}
+
+static void queue_run(uint32_t block)
+{
+	static uint8_t wbuf[PAGES_PER_BLOCK][PAGE_MAIN_SIZE];
+	static uint8_t rbuf[PAGES_PER_BLOCK][PAGE_MAIN_SIZE];
+	static NandRequest_t req[PAGES_PER_BLOCK];
+	uint64_t t0 = W25N_Sim_TimeNs();
+	uint64_t app_ns = 0;
+	uint32_t bad = 0;
+	bool erased = false;
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+		for (uint32_t i = 0; i < PAGE_MAIN_SIZE; i++)
+			wbuf[p][i] = (uint8_t) (p * 31U + i * 7U + block);
+
+	/// Erase, then all pages program, then all pages read back
+	for (int phase = 0; phase < 3; phase++)
+	{
+		uint32_t count = (phase == 0) ? 1 : PAGES_PER_BLOCK;
+
+		queue_done = 0;
+		for (uint32_t p = 0; p < count; p++)
+		{
+			memset(&req[p], 0, sizeof(req[p]));
+			req[p].type = (phase == 0) ? NAND_REQ_ERASE :
+							(phase == 1) ? NAND_REQ_PROGRAM : NAND_REQ_READ;
+			req[p].page = (phase == 0) ? block : PAGE_ADDR(block, p);
+			req[p].buf = (phase == 1) ? wbuf[p] : rbuf[p];
+			req[p].len = (phase == 0) ? 0 : PAGE_MAIN_SIZE;
+			req[p].cb = queue_cb;
+			req[p].user = (phase == 0) ? &erased : NULL;
+
+			while (!NandQueue_Submit(&req[p]))
+				app_ns += queue_drive(queue_done + 1);
+		}
+		app_ns += queue_drive(count);
+	}
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+		if (!req[p].ok || memcmp(wbuf[p], rbuf[p], PAGE_MAIN_SIZE) != 0)
+			bad++;
+	if (!erased)
+		bad++;
+
+	const NandQueueStats_t *st = NandQueue_GetStats();
+	uint64_t total = W25N_Sim_TimeNs() - t0;
+
+	fprintf(stderr, "Queue requests     : %u submitted, %u failed, max depth %u, full %u\n",
+			(unsigned) st->submitted, (unsigned) st->failed,
+			(unsigned) st->max_depth, (unsigned) st->queue_full);
+	fprintf(stderr, "CPU free for app   : %.1f %% of %.3f ms\n",
+			total ? 100.0 * (double) app_ns / (double) total : 0.0, total / 1e6);
+	fprintf(stderr, "Verify             : %s (%u bad pages)\n",
+			verdict(bad == 0), (unsigned) bad);
+}
+
+/* ---------------------------------------------------------------------------
+ * stream: page-by-page read vs. Continuous Read Mode over the same data
+ * ---------------------------------------------------------------------------
+ * The stream is pulled in uneven pieces so bursts, page-internal pull ends
+ * and the staging page are all exercised.
+ * --------------------------------------------------------------------------- */
+#define STREAM_BLOCKS  4
+#define STREAM_PAGES   (STREAM_BLOCKS * PAGES_PER_BLOCK)
+
+static void stream_ecc_cb(uint32_t page, ECC_Status_t ecc, void *user)
+{
+	(void) user;
+	fprintf(stderr, "Stream ECC report  : page 0x%05X %s\n", (unsigned) page,
+			(ecc == ECC_UNCORRECTABLE) ? "uncorrectable" : "threshold");
+}
+
+static void stream_run(uint32_t block)
+{
+	static uint8_t wbuf[STREAM_PAGES * PAGE_MAIN_SIZE];
+	static uint8_t rbuf[STREAM_PAGES * PAGE_MAIN_SIZE];
+	static const uint32_t piece[] = { 1000, 3096, 2048, 40960, 7, 65536, 100000 };
+	static ContRead_t h;
+	uint32_t first = PAGE_ADDR(block, 0);
+	uint32_t fails = 0;
+
+	for (uint32_t i = 0; i < sizeof(wbuf); i++)
+		wbuf[i] = (uint8_t) ((i * 7U) ^ (i >> 11) ^ block);
+
+	for (uint32_t b = 0; b < STREAM_BLOCKS; b++)
+		BlockErase128K_service(block + b, 0);
+	for (uint32_t p = 0; p < STREAM_PAGES; p++)
+		StandardProgram_Service(first + p, &wbuf[p * PAGE_MAIN_SIZE], PAGE_MAIN_SIZE);
+
+	/// Page by page: 13h + tRD + 03h per page
+	uint64_t t0 = W25N_Sim_TimeNs();
+
+	for (uint32_t p = 0; p < STREAM_PAGES; p++)
+		if (!StandardRead_Service(first + p, 0, &rbuf[p * PAGE_MAIN_SIZE], PAGE_MAIN_SIZE))
+			fails++;
+
+	uint64_t page_ns = W25N_Sim_TimeNs() - t0;
+	bool page_ok = (memcmp(wbuf, rbuf, sizeof(wbuf)) == 0);
+
+	/// Continuous: one 13h, then 03h bursts across page boundaries
+	memset(rbuf, 0, sizeof(rbuf));
+	t0 = W25N_Sim_TimeNs();
+
+	bool open = ContRead_Open(&h, first, stream_ecc_cb, NULL);
+	uint32_t pos = 0;
+
+	for (uint32_t i = 0; open && pos < sizeof(rbuf); i++)
+	{
+		uint32_t n = piece[i % (sizeof(piece) / sizeof(piece[0]))];
+
+		if (n > sizeof(rbuf) - pos)
+			n = sizeof(rbuf) - pos;
+		if (!ContRead_Pull(&h, &rbuf[pos], n) && h.first_fail == CONTREAD_NO_PAGE)
+			break;
+		pos += n;
+	}
+
+	bool closed = open && ContRead_Close(&h);
+	uint64_t stream_ns = W25N_Sim_TimeNs() - t0;
+	bool stream_ok = closed && (memcmp(wbuf, rbuf, sizeof(wbuf)) == 0);
+
+	fprintf(stderr, "Page-by-page read  : %.3f ms, %.2f MB/s, %u ECC fails, %s\n",
+			page_ns / 1e6, sizeof(rbuf) / (page_ns / 1e9) / 1e6,
+			(unsigned) fails, verdict(page_ok));
+	fprintf(stderr, "Continuous read    : %.3f ms, %.2f MB/s, %s\n",
+			stream_ns / 1e6, sizeof(rbuf) / (stream_ns / 1e9) / 1e6,
+			verdict(stream_ok));
+	fprintf(stderr, "Stream counters    : %u pages, %u commands, %u reloads, "
+			"%u corrected, %u threshold, %u failed\n",
+			(unsigned) h.pages, (unsigned) h.bursts, (unsigned) h.reloads,
+			(unsigned) h.corrected, (unsigned) h.threshold, (unsigned) h.failed);
+	fprintf(stderr, "BUF after close    : %u\n", IsBufferMode_service());
+}
+
+/* ---------------------------------------------------------------------------
+ * copy: block relocation inside the device, one spare byte patched per page
+ * --------------------------------------------------------------------------- */
+static void copy_run(uint32_t block)
+{
+	static uint8_t wbuf[PAGE_MAIN_SIZE];
+	static uint8_t rbuf[PAGE_TOTAL_SIZE];
+	uint32_t bad = 0, ecc_events = 0;
+
+	BlockErase128K_service(block, 0);
+	BlockErase128K_service(block + 1, 0);
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+	{
+		for (uint32_t i = 0; i < PAGE_MAIN_SIZE; i++)
+			wbuf[i] = (uint8_t) (p * 13U + i * 5U + block);
+		StandardProgram_Service(PAGE_ADDR(block, p), wbuf, PAGE_MAIN_SIZE);
+	}
+
+	const W25N_SimStats_t *st = W25N_Sim_Stats();
+	uint64_t bytes0 = st->bytes;
+	uint64_t t0 = W25N_Sim_TimeNs();
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+	{
+		uint8_t tag = (uint8_t) (0xA0 + p);
+		NandPatch_t patch = { PAGE_MAIN_SIZE + 4, 1, &tag };
+		ECC_Status_t ecc;
+
+		if (!CopyPage_Service(PAGE_ADDR(block, p), PAGE_ADDR(block + 1, p),
+				&patch, 1, &ecc))
+			bad++;
+		if (ecc != ECC_SUCCESS)
+			ecc_events++;
+	}
+
+	uint64_t copy_ns = W25N_Sim_TimeNs() - t0;
+	uint64_t copy_bytes = st->bytes - bytes0;
+
+	for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++)
+	{
+		for (uint32_t i = 0; i < PAGE_MAIN_SIZE; i++)
+			wbuf[i] = (uint8_t) (p * 13U + i * 5U + block);
+		if (!StandardRead_Service(PAGE_ADDR(block + 1, p), 0, rbuf, PAGE_TOTAL_SIZE)
+				|| memcmp(wbuf, rbuf, PAGE_MAIN_SIZE) != 0
+				|| rbuf[PAGE_MAIN_SIZE + 4] != (uint8_t) (0xA0 + p))
+			bad++;
+	}
+
+	fprintf(stderr, "Copy-back          : %u pages, %.3f ms, %llu bus bytes "
+			"(%.1f per page), %u source ECC events\n",
+			(unsigned) PAGES_PER_BLOCK, copy_ns / 1e6,
+			(unsigned long long) copy_bytes,
+			(double) copy_bytes / PAGES_PER_BLOCK, (unsigned) ecc_events);
+	fprintf(stderr, "Verify             : %s (%u bad pages)\n",
+			verdict(bad == 0), (unsigned) bad);
+}
+
+/* ---------------------------------------------------------------------------
+ * mount: persistent bad block table, first boot vs. normal boot
+ * --------------------------------------------------------------------------- */
+static void mount_step(const char *name, bool (*fn)(void))
+{
+	uint64_t t0 = W25N_Sim_TimeNs();
+	uint64_t reads0 = W25N_Sim_Stats()->page_reads;
+	bool ok = fn();
+
+	fprintf(stderr, "%-19s: %s, %.3f ms, %llu page reads, bad = %u\n", name,
+			ok ? "OK" : "FAIL", (W25N_Sim_TimeNs() - t0) / 1e6,
+			(unsigned long long) (W25N_Sim_Stats()->page_reads - reads0),
+			(unsigned) BBT_BadCount());
+}
+
+static void mount_run(void)
+{
+	uint32_t expect;
+
+	mount_step("First boot (scan)", BBT_Mount);
+	expect = BBT_BadCount();
+
+	mount_step("Second boot", BBT_Mount);
+
+	for (uint32_t i = 0; i < 70; i++)
+		BBT_MarkRuntimeBad(1000 + i);
+	expect += 70;
+
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	mount_step("Boot after 70 marks", BBT_Mount);
+
+	fprintf(stderr, "Verify             : %s\n",
+			verdict(BBT_BadCount() == expect && BBT_IsBad(1069) && !BBT_IsBad(1070)));
+}
+
+/* ---------------------------------------------------------------------------
+ * lazy: instant-on mount, blocks verified on allocation and in idle steps
+ * --------------------------------------------------------------------------- */
+static void lazy_run(void)
+{
+	uint64_t t0 = W25N_Sim_TimeNs();
+	uint64_t reads0 = W25N_Sim_Stats()->page_reads;
+	uint32_t steps = 0;
+	bool loaded = BBT_MountLazy();
+
+	fprintf(stderr, "Mount              : %s, %.3f ms, %u blocks unknown\n",
+			loaded ? "loaded" : "lazy", (W25N_Sim_TimeNs() - t0) / 1e6,
+			(unsigned) BBT_UnknownCount());
+
+	t0 = W25N_Sim_TimeNs();
+	uint32_t blk = BBT_AllocGood(8);
+	fprintf(stderr, "First allocation   : block %u, %.3f ms, verified = %s\n",
+			(unsigned) blk, (W25N_Sim_TimeNs() - t0) / 1e6,
+			BBT_IsUnknown(blk) ? "NO" : "yes");
+
+	t0 = W25N_Sim_TimeNs();
+	while (BBT_BackgroundStep(BBT_BACKGROUND_BLOCKS) != 0)
+		steps++;
+	steps++;
+
+	fprintf(stderr, "Background         : %u steps of %u, %.3f ms, %llu page "
+			"reads, bad = %u\n", (unsigned) steps,
+			(unsigned) BBT_BACKGROUND_BLOCKS, (W25N_Sim_TimeNs() - t0) / 1e6,
+			(unsigned long long) (W25N_Sim_Stats()->page_reads - reads0),
+			(unsigned) BBT_BadCount());
+
+	uint32_t expect = BBT_BadCount();
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	loaded = BBT_MountLazy();
+
+	fprintf(stderr, "Verify             : %s\n",
+			verdict(loaded && BBT_UnknownCount() == 0 && BBT_BadCount() == expect));
+}
+
+/* ---------------------------------------------------------------------------
+ * endurance: EnduranceTest_Run after the firmware mounts (BBT, Remap)
+ * --------------------------------------------------------------------------- */
+static void endurance_run(uint32_t block)
+{
+#if NAND_REMAP
+	BBT_Mount();
+	Remap_Mount();
+	uint32_t phys = Remap_Block(block);
+#else
+	uint32_t phys = block;
+#endif
+
+	EnduranceTest_Run(block);
+
+	if (phys < TOTAL_BLOCKS)
+		fprintf(stderr, "Block %u erase count: %u\n", (unsigned) phys,
+				(unsigned) W25N_Sim_EraseCount(phys));
+}
+
+/* ---------------------------------------------------------------------------
+ * remap: runtime failure of a logical block, migration to the spare pool
+ * --------------------------------------------------------------------------- */
+#if NAND_REMAP
+
+#define REMAP_RUN_PAGES     16
+#define REMAP_RUN_CYCLES    5000
+
+static uint32_t remap_verify(uint32_t block, uint32_t cycle)
+{
+	static uint8_t rbuf[PAGE_MAIN_SIZE];
+	uint32_t bad = 0;
+
+	for (uint32_t p = 0; p < REMAP_RUN_PAGES; p++)
+	{
+		bool ok = Remap_Read(PAGE_ADDR(block, p), 0, rbuf, PAGE_MAIN_SIZE);
+
+		for (uint32_t i = 0; ok && i < PAGE_MAIN_SIZE; i++)
+			if (rbuf[i] != (uint8_t) (cycle * 7U + p * 11U + i))
+				ok = false;
+
+		if (!ok)
+			bad++;
+	}
+
+	return bad;
+}
+
+static void remap_run(uint32_t block)
+{
+	static uint8_t wbuf[PAGE_MAIN_SIZE];
+	uint32_t cycle = 0;
+
+	BBT_Mount();
+	bool ok = Remap_Mount();
+	const Remap_Stats_t *st = Remap_GetStats();
+
+	fprintf(stderr, "Mount              : %s, %u logical blocks, %u mapped, "
+			"%u spares free\n", ok ? "OK" : "POOL EMPTY",
+			(unsigned) REMAP_LOGICAL_BLOCKS, (unsigned) st->mapped,
+			(unsigned) st->spares_free);
+
+	/// Same logical block until its physical block fails
+	uint32_t phys = Remap_Block(block);
+
+	for (cycle = 0; cycle < REMAP_RUN_CYCLES && Remap_Block(block) == phys; cycle++)
+	{
+		Remap_Erase(block);
+
+		for (uint32_t p = 0; p < REMAP_RUN_PAGES; p++)
+		{
+			for (uint32_t i = 0; i < PAGE_MAIN_SIZE; i++)
+				wbuf[i] = (uint8_t) (cycle * 7U + p * 11U + i);
+			Remap_Program(PAGE_ADDR(block, p), wbuf, PAGE_MAIN_SIZE);
+		}
+	}
+
+	cycle--;
+	st = Remap_GetStats();
+	fprintf(stderr, "Wear-out           : cycle %u, block %u -> %u, %u pages "
+			"copy-back, %u through RAM\n", (unsigned) cycle, (unsigned) phys,
+			(unsigned) Remap_Block(block), (unsigned) st->copyback,
+			(unsigned) st->fallback);
+
+	uint32_t bad = remap_verify(block, cycle);
+
+	/// Data-bearing retirement (e.g. ECC threshold reached on reads)
+	uint32_t before = Remap_Block(block);
+	uint64_t t0 = W25N_Sim_TimeNs();
+	uint64_t bytes0 = W25N_Sim_Stats()->bytes;
+
+	Remap_Retire(block, REMAP_RUN_PAGES);
+	st = Remap_GetStats();
+	fprintf(stderr, "Retire             : block %u -> %u, %.3f ms, %llu bus bytes, "
+			"%u pages copy-back\n", (unsigned) before,
+			(unsigned) Remap_Block(block), (W25N_Sim_TimeNs() - t0) / 1e6,
+			(unsigned long long) (W25N_Sim_Stats()->bytes - bytes0),
+			(unsigned) st->copyback);
+
+	bad += remap_verify(block, cycle);
+	uint32_t now = Remap_Block(block);
+
+	/// Reboot: both tables from flash
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	BBT_Mount();
+	Remap_Mount();
+	bad += remap_verify(block, cycle);
+
+	fprintf(stderr, "Verify             : %s (map seq %u, %u bad pages)\n",
+			verdict(bad == 0 && Remap_Block(block) == now && now != phys),
+			(unsigned) Remap_GetStats()->store_seq, (unsigned) bad);
+}
+
+#endif /* NAND_REMAP */
+
+/* ---------------------------------------------------------------------------
+ * usb: USB MSC data path (STORAGE_Read_FS / STORAGE_Write_FS) on the FTL,
+ * 4 KB packets (MSC_MEDIA_PACKET) inside an 8 MB window
+ * --------------------------------------------------------------------------- */
+#define USB_RUN_SECTORS     (8u * 2048u)
+#define USB_RUN_PACKET      8u
+#define USB_RUN_RANDOM      300u
+#define USB_RUN_SEQ1        1024u
+
+static uint8_t usb_shadow[USB_RUN_SECTORS * FTL_SECTOR_SIZE];
+static uint32_t usb_rng = 12345;
+
+static uint32_t usb_rand(void)
+{
+	usb_rng = usb_rng * 1103515245u + 12345u;
+	return usb_rng >> 8;
+}
+
+static void usb_write(uint32_t lba, uint32_t count)
+{
+	uint8_t *dst = &usb_shadow[lba * FTL_SECTOR_SIZE];
+
+	for (uint32_t i = 0; i < count * FTL_SECTOR_SIZE; i++)
+		dst[i] = (uint8_t) usb_rand();
+
+	if (!FTL_WriteSectors(lba, dst, count))
+		fprintf(stderr, "Write failed       : LBA %u\n", (unsigned) lba);
+}
+
+static uint32_t usb_verify(double *mbps)
+{
+	static uint8_t rbuf[USB_RUN_PACKET * FTL_SECTOR_SIZE];
+	uint64_t t0 = W25N_Sim_TimeNs();
+	uint32_t bad = 0;
+
+	for (uint32_t lba = 0; lba < USB_RUN_SECTORS; lba += USB_RUN_PACKET)
+	{
+		if (!FTL_ReadSectors(lba, rbuf, USB_RUN_PACKET)
+				|| memcmp(rbuf, &usb_shadow[lba * FTL_SECTOR_SIZE], sizeof(rbuf)) != 0)
+			bad++;
+	}
+
+	*mbps = (double) USB_RUN_SECTORS * FTL_SECTOR_SIZE
+			/ ((W25N_Sim_TimeNs() - t0) / 1e3);
+	return bad;
+}
+
+static void usb_phase(const char *name, uint64_t t0, uint64_t prog0,
+		uint32_t sectors, uint32_t cmds)
+{
+	double us = (W25N_Sim_TimeNs() - t0) / 1e3;
+	uint64_t progs = W25N_Sim_Stats()->page_programs - prog0;
+
+	fprintf(stderr, "%-19s: %.2f MB/s, %.0f us per command, %.1f page programs "
+			"per command\n", name, sectors * (double) FTL_SECTOR_SIZE / us,
+			us / cmds, (double) progs / cmds);
+}
+
+static void usb_run(void)
+{
+	uint64_t t0, p0;
+	uint32_t bad;
+	double mbps;
+
+	BBT_Mount();
+	FTL_Mount();
+	fprintf(stderr, "Capacity           : %u sectors (%.1f MB)\n",
+			(unsigned) FTL_SectorCount(),
+			FTL_SectorCount() * (double) FTL_SECTOR_SIZE / 1048576.0);
+
+	memset(usb_shadow, NAND_ERASED_STATE, sizeof(usb_shadow));
+
+	/// Sequential fill of the window
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	for (uint32_t lba = 0; lba < USB_RUN_SECTORS; lba += USB_RUN_PACKET)
+		usb_write(lba, USB_RUN_PACKET);
+	usb_phase("Sequential write", t0, p0, USB_RUN_SECTORS,
+			USB_RUN_SECTORS / USB_RUN_PACKET);
+
+	/// Random aligned 4 KB
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	for (uint32_t i = 0; i < USB_RUN_RANDOM; i++)
+		usb_write((usb_rand() % (USB_RUN_SECTORS / USB_RUN_PACKET)) * USB_RUN_PACKET,
+				USB_RUN_PACKET);
+	usb_phase("Random 4 KB write", t0, p0, USB_RUN_RANDOM * USB_RUN_PACKET,
+			USB_RUN_RANDOM);
+
+	/// Random 1 ~ 8 sectors, unaligned (FAT / directory updates)
+	uint32_t sectors = 0;
+
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	for (uint32_t i = 0; i < USB_RUN_RANDOM; i++)
+	{
+		uint32_t n = 1 + usb_rand() % USB_RUN_PACKET;
+
+		usb_write(usb_rand() % (USB_RUN_SECTORS - n), n);
+		sectors += n;
+	}
+	usb_phase("Random small write", t0, p0, sectors, USB_RUN_RANDOM);
+
+	/// Sequential single sectors (write buffer fills whole pages)
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	for (uint32_t lba = 0; lba < USB_RUN_SEQ1; lba++)
+		usb_write(lba, 1);
+	usb_phase("Sequential 1 sector", t0, p0, USB_RUN_SEQ1, USB_RUN_SEQ1);
+
+	bad = usb_verify(&mbps);
+	fprintf(stderr, "Sequential read    : %.2f MB/s, %u bad packets\n", mbps,
+			(unsigned) bad);
+
+	const Map_Stats_t *ms = Map_GetStats();
+	fprintf(stderr, "Mapping            : %u data pages, %u translation pages, "
+			"CMT %u hits / %u misses, %u checkpoints\n", (unsigned) ms->data_writes,
+			(unsigned) ms->tpage_writes, (unsigned) ms->cache_hits,
+			(unsigned) ms->cache_misses, (unsigned) ms->checkpoints);
+
+#if FTL_MAPPING == FTL_MAPPING_HYBRID
+	const Hyb_Stats_t *hs = Hyb_GetStats();
+	fprintf(stderr, "Hybrid mapping     : %u SW / %u RW log pages, %u switch, %u partial, "
+			"%u full merges, %u pages copied\n", (unsigned) hs->sw_writes,
+			(unsigned) hs->rw_writes, (unsigned) hs->switch_merges,
+			(unsigned) hs->partial_merges, (unsigned) hs->full_merges,
+			(unsigned) hs->merge_copies);
+#endif
+
+	const Cache_Stats_t *cs = Cache_GetStats();
+	fprintf(stderr, "Write buffer       : %u sectors in, %u complete, %u evicted, "
+			"%u merges\n", (unsigned) cs->sectors_in, (unsigned) cs->complete,
+			(unsigned) cs->evicted, (unsigned) cs->merges);
+
+	/// Power loss: buffer flushed (host cache flush) but no checkpoint since
+	/// the writes, roll-forward at mount
+	Cache_Flush();
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	BBT_Mount();
+	FTL_Mount();
+	bad += usb_verify(&mbps);
+	fprintf(stderr, "Power loss remount : %u pages rolled forward, %u bad packets\n",
+			(unsigned) Map_GetStats()->replayed, (unsigned) bad);
+
+	/// Clean power cycle after a sync
+	usb_write(0, USB_RUN_PACKET);
+	FTL_Sync();
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	BBT_Mount();
+	FTL_Mount();
+	bad += usb_verify(&mbps);
+
+	fprintf(stderr, "Verify             : %s (%u bad packets after remount, "
+			"%u pages rolled forward)\n", verdict(bad == 0),
+			(unsigned) bad, (unsigned) Map_GetStats()->replayed);
+}
+
+/* ---------------------------------------------------------------------------
+ * gc: whole logical space written, then random 4 KB overwrites across it
+ * (GC under a full device), every page checked by its write version
+ * --------------------------------------------------------------------------- */
+#define GC_RUN_WRITES       40000u
+
+static uint16_t *gc_version;
+
+static void gc_fill(uint8_t *buf, uint32_t lpn, uint32_t version)
+{
+	uint32_t x = lpn * 2654435761u + version * 40503u + 1u;
+
+	for (uint32_t i = 0; i < PAGE_MAIN_SIZE; i += 4)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		memcpy(&buf[i], &x, 4);
+	}
+}
+
+static uint32_t gc_verify(uint32_t pages)
+{
+	static uint8_t rbuf[PAGE_MAIN_SIZE], want[PAGE_MAIN_SIZE];
+	uint32_t bad = 0;
+
+	for (uint32_t lpn = 0; lpn < pages; lpn++)
+	{
+		gc_fill(want, lpn, gc_version[lpn]);
+		if (!FTL_ReadSectors(lpn * FTL_SECTORS_PER_PAGE, rbuf, FTL_SECTORS_PER_PAGE)
+				|| memcmp(rbuf, want, sizeof(want)) != 0)
+			bad++;
+	}
+
+	return bad;
+}
+
+static void gc_run(bool cost_benefit)
+{
+	static uint8_t wbuf[2 * PAGE_MAIN_SIZE];
+	uint64_t t0, p0, e0;
+
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+	GC_SetPolicy(cost_benefit ? GC_POLICY_COST_BENEFIT : GC_POLICY_GREEDY);
+#else
+	(void) cost_benefit;
+#endif
+	BBT_Mount();
+	FTL_Mount();
+
+	uint32_t pages = Map_PageCount();
+
+	gc_version = calloc(pages, sizeof(uint16_t));
+	fprintf(stderr, "Logical pages      : %u\n", (unsigned) pages);
+
+	/// Sequential fill
+	t0 = W25N_Sim_TimeNs();
+	for (uint32_t lpn = 0; lpn < pages; lpn += 2)
+	{
+		gc_fill(wbuf, lpn, 0);
+		gc_fill(&wbuf[PAGE_MAIN_SIZE], lpn + 1, 0);
+		FTL_WriteSectors(lpn * FTL_SECTORS_PER_PAGE, wbuf, 2 * FTL_SECTORS_PER_PAGE);
+	}
+	fprintf(stderr, "Fill               : %.2f MB/s\n", pages * (double) PAGE_MAIN_SIZE
+			/ ((W25N_Sim_TimeNs() - t0) / 1e3));
+
+	/// Random overwrites, GC active
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	e0 = W25N_Sim_Stats()->block_erases;
+	uint64_t worst = 0;
+
+	for (uint32_t i = 0; i < GC_RUN_WRITES; i++)
+	{
+		uint32_t lpn = (usb_rand() % (pages / 2)) * 2;
+		uint64_t c0 = W25N_Sim_TimeNs();
+
+		gc_version[lpn]++;
+		gc_version[lpn + 1]++;
+		gc_fill(wbuf, lpn, gc_version[lpn]);
+		gc_fill(&wbuf[PAGE_MAIN_SIZE], lpn + 1, gc_version[lpn + 1]);
+		if (!FTL_WriteSectors(lpn * FTL_SECTORS_PER_PAGE, wbuf, 2 * FTL_SECTORS_PER_PAGE))
+			fprintf(stderr, "Write failed       : LPN %u\n", (unsigned) lpn);
+		if (W25N_Sim_TimeNs() - c0 > worst)
+			worst = W25N_Sim_TimeNs() - c0;
+	}
+
+	double us = (W25N_Sim_TimeNs() - t0) / 1e3;
+
+	fprintf(stderr, "Random 4 KB write  : %.2f MB/s, %.0f us per command, "
+			"WA %.2f, %.1f erases per 1000 commands\n",
+			GC_RUN_WRITES * 2.0 * PAGE_MAIN_SIZE / us, us / GC_RUN_WRITES,
+			(W25N_Sim_Stats()->page_programs - p0) / (2.0 * GC_RUN_WRITES),
+			(W25N_Sim_Stats()->block_erases - e0) * 1000.0 / GC_RUN_WRITES);
+	fprintf(stderr, "Longest write      : %.0f us\n", worst / 1e3);
+
+	/// Host idle: background steps up to the high watermark
+	uint32_t steps = 0;
+
+	t0 = W25N_Sim_TimeNs();
+	while (FTL_Background())
+		steps++;
+	fprintf(stderr, "Idle GC            : %u steps, %.1f ms\n", (unsigned) steps,
+			(W25N_Sim_TimeNs() - t0) / 1e6);
+#if FTL_MAPPING == FTL_MAPPING_HYBRID
+	const Hyb_Stats_t *hs = Hyb_GetStats();
+	fprintf(stderr, "Merges             : %u switch, %u partial, %u full, %u pages "
+			"copied, %u free blocks\n", (unsigned) hs->switch_merges,
+			(unsigned) hs->partial_merges, (unsigned) hs->full_merges,
+			(unsigned) hs->merge_copies, (unsigned) Hyb_FreeCount());
+#else
+	const GC_Stats_t *gs = GC_GetStats();
+	fprintf(stderr, "GC                 : %s, %u blocks collected, %u pages moved, "
+			"%u free blocks\n", cost_benefit ? "cost-benefit" : "greedy",
+			(unsigned) gs->collections, (unsigned) gs->pages_moved,
+			(unsigned) GC_FreeCount());
+	fprintf(stderr, "GC time            : %.1f ms, %u runs (longest %u us), "
+			"%u steps (longest %u us)\n", gs->time_us / 1e3, (unsigned) gs->runs,
+			(unsigned) gs->max_us, (unsigned) gs->steps, (unsigned) gs->step_max_us);
+
+	const WL_Stats_t *ws = WL_GetStats();
+	fprintf(stderr, "Wear leveling      : erase count %u ~ %u, %u cold blocks migrated "
+			"(%u checks)\n", (unsigned) ws->min, (unsigned) ws->max,
+			(unsigned) ws->migrations, (unsigned) ws->checks);
+#endif
+
+	uint32_t bad = gc_verify(pages);
+
+	/// Power loss, roll-forward
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	BBT_Mount();
+	FTL_Mount();
+	bad += gc_verify(pages);
+
+	fprintf(stderr, "Verify             : %s (%u bad pages, %u rolled forward)\n",
+			verdict(bad == 0), (unsigned) bad,
+			(unsigned) Map_GetStats()->replayed);
+	free(gc_version);
+}
+
+/* ---------------------------------------------------------------------------
+ * FAT32 logging: LOG_FAT_PAGES FAT pages + one directory page at the start,
+ * bulk files up to LOG_BULK_PERCENT of the space, the log file (preallocated)
+ * in the rest: 2 pages per append, from the start again when full. Every
+ * append rewrites the FAT page of its clusters and the directory page.
+ * --------------------------------------------------------------------------- */
+#define LOG_FAT_PAGES       32u
+#define LOG_DIR_PAGE        LOG_FAT_PAGES
+#define LOG_BULK_PERCENT    60u
+#define LOG_RUN_APPENDS     40000u
+
+static bool log_write(uint32_t lpn)
+{
+	static uint8_t wbuf[PAGE_MAIN_SIZE];
+
+	gc_fill(wbuf, lpn, ++gc_version[lpn]);
+	return FTL_WriteSectors(lpn * FTL_SECTORS_PER_PAGE, wbuf, FTL_SECTORS_PER_PAGE);
+}
+
+static void log_run(void)
+{
+	static uint8_t wbuf[2 * PAGE_MAIN_SIZE];
+	uint64_t t0, p0;
+
+	BBT_Mount();
+	FTL_Mount();
+
+	uint32_t pages = Map_PageCount();
+	uint32_t log_first = pages * LOG_BULK_PERCENT / 100 & ~1u;
+	uint32_t log_len = (pages - log_first) & ~1u;
+
+	gc_version = calloc(pages, sizeof(uint16_t));
+	fprintf(stderr, "Logical pages      : %u (log file %u)\n", (unsigned) pages,
+			(unsigned) log_len);
+
+	/// Volume written once (FAT, bulk files, log file)
+	for (uint32_t lpn = 0; lpn < pages; lpn += 2)
+	{
+		gc_fill(wbuf, lpn, 0);
+		gc_fill(&wbuf[PAGE_MAIN_SIZE], lpn + 1, 0);
+		FTL_WriteSectors(lpn * FTL_SECTORS_PER_PAGE, wbuf, 2 * FTL_SECTORS_PER_PAGE);
+	}
+
+	/// Appends: log data, FAT, directory
+	uint32_t fails = 0;
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+	const Map_Stats_t *ms = Map_GetStats();
+	uint32_t w0 = ms->data_writes, f0 = ms->programs;
+#endif
+
+	t0 = W25N_Sim_TimeNs();
+	p0 = W25N_Sim_Stats()->page_programs;
+	for (uint32_t i = 0; i < LOG_RUN_APPENDS; i++)
+	{
+		uint32_t pos = (i * 2) % log_len;
+
+		if (!log_write(log_first + pos) || !log_write(log_first + pos + 1)
+				|| !log_write((pos / 512) % LOG_FAT_PAGES) || !log_write(LOG_DIR_PAGE))
+			fails++;
+	}
+
+	double us = (W25N_Sim_TimeNs() - t0) / 1e3;
+
+	fprintf(stderr, "Log appends        : %.2f MB/s (log data), %u failed, "
+			"WA %.2f\n", LOG_RUN_APPENDS * 2.0 * PAGE_MAIN_SIZE / us, (unsigned) fails,
+			(W25N_Sim_Stats()->page_programs - p0) / (4.0 * LOG_RUN_APPENDS));
+#if FTL_MAPPING == FTL_MAPPING_PAGE
+	const HC_Stats_t *hs = HC_GetStats();
+
+	fprintf(stderr, "Hot / cold         : %s, %u hot / %u cold writes, FTL WA %.2f\n",
+			FTL_HOT_COLD ? "3 frontiers" : "1 frontier", (unsigned) hs->hot,
+			(unsigned) hs->cold, (double) (ms->programs - f0) / (ms->data_writes - w0));
+#endif
+
+	uint32_t bad = gc_verify(pages);
+
+	/// Power loss, roll-forward
+	memset(BBT_Bitmap, 0, sizeof(BBT_Bitmap));
+	BBT_Mount();
+	FTL_Mount();
+	bad += gc_verify(pages);
+
+	fprintf(stderr, "Verify             : %s (%u bad pages, %u rolled forward)\n",
+			verdict(bad == 0), (unsigned) bad,
+			(unsigned) Map_GetStats()->replayed);
+	free(gc_version);
+}
+
+/* ---------------------------------------------------------------------------
+ * boot: firmware boot order on a blank device. Boot 1 writes BOOT_RUN_BLOCKS
+ * blocks of data and loses power before the idle walk completes the table,
+ * boot 2 verifies the rest (data blocks included) in FTL_Idle, boot 3 must
+ * load a table holding the factory bad blocks only.
+ * --------------------------------------------------------------------------- */
+#define BOOT_RUN_BLOCKS     300u
+
+static bool boot_mount(const char *name)
+{
+	uint64_t t0 = W25N_Sim_TimeNs();
+	bool loaded = BBT_MountLazy();
+	bool ok = FTL_Mount();
+
+	fprintf(stderr, "%-19s: BBT %s, FTL %s, %.3f ms, bad = %u, %u unknown\n",
+			name, loaded ? "loaded" : "lazy", ok ? "OK" : "FAIL",
+			(W25N_Sim_TimeNs() - t0) / 1e6, (unsigned) BBT_BadCount(),
+			(unsigned) BBT_UnknownCount());
+
+	return loaded && ok;
+}
+
+static void boot_run(void)
+{
+	static uint8_t wbuf[2 * PAGE_MAIN_SIZE];
+	uint32_t expect = 0, idle = 0, bad = 0;
+
+	for (uint16_t i = 0; i < bad_list_len; i++)
+		if (bad_list[i] >= FACTORY_INFO_BLOCK_END
+				&& bad_list[i] <= FACTORY_INFO_BLOCK2_START)
+			expect++;
+
+	boot_mount("Boot 1 (blank)");
+
+	uint32_t pages = BOOT_RUN_BLOCKS * PAGES_PER_BLOCK;
+
+	if (pages > Map_PageCount())
+		pages = Map_PageCount() & ~1u;
+	gc_version = calloc(pages, sizeof(uint16_t));
+
+	for (uint32_t lpn = 0; lpn < pages; lpn += 2)
+	{
+		gc_fill(wbuf, lpn, 0);
+		gc_fill(&wbuf[PAGE_MAIN_SIZE], lpn + 1, 0);
+		FTL_WriteSectors(lpn * FTL_SECTORS_PER_PAGE, wbuf, 2 * FTL_SECTORS_PER_PAGE);
+	}
+	FTL_Sync();
+
+	fprintf(stderr, "Written            : %u pages, %u blocks still unknown at "
+			"power loss\n", (unsigned) pages, (unsigned) BBT_UnknownCount());
+
+	boot_mount("Boot 2 (lazy)");
+	bad += gc_verify(pages);
+
+	while (BBT_UnknownCount() != 0)
+	{
+		FTL_Idle();
+		idle++;
+	}
+
+	fprintf(stderr, "Idle walk          : %u FTL_Idle calls, bad = %u (factory %u)\n",
+			(unsigned) idle, (unsigned) BBT_BadCount(), (unsigned) expect);
+
+	bool loaded = boot_mount("Boot 3");
+	bad += gc_verify(pages);
+
+	fprintf(stderr, "Verify             : %s (bad = %u, factory %u, %u bad pages)\n",
+			verdict(loaded && BBT_UnknownCount() == 0 && BBT_BadCount() == expect
+					&& bad == 0), (unsigned) BBT_BadCount(), (unsigned) expect,
+			(unsigned) bad);
+	free(gc_version);
+}
+
+static double host_seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void report(const char *name, double host_s)
+{
+	const W25N_SimStats_t *st = W25N_Sim_Stats();
+	double sim_s = W25N_Sim_TimeNs() / 1e9;
+	uint64_t data = (st->page_reads + st->page_programs) * PAGE_MAIN_SIZE;
+
+	fprintf(stderr, "========================= [SIM] %s =========================\n", name);
+	fprintf(stderr, "Simulated time     : %.6f s\n", sim_s);
+	fprintf(stderr, "Host time          : %.3f s\n", host_s);
+	fprintf(stderr, "Frames / bytes     : %llu / %llu\n",
+			(unsigned long long) st->frames, (unsigned long long) st->bytes);
+	fprintf(stderr, "Page read (13h)    : %llu\n", (unsigned long long) st->page_reads);
+	fprintf(stderr, "Page program (10h) : %llu\n", (unsigned long long) st->page_programs);
+	fprintf(stderr, "Block erase (D8h)  : %llu\n", (unsigned long long) st->block_erases);
+	fprintf(stderr, "Status reads       : %llu (%.1f per array op)\n",
+			(unsigned long long) st->status_reads,
+			(double) st->status_reads
+					/ (double) (st->page_reads + st->page_programs
+							+ st->block_erases + 1));
+	fprintf(stderr, "Busy rejects       : %llu\n", (unsigned long long) st->busy_rejects);
+	fprintf(stderr, "Protect rejects    : %llu\n", (unsigned long long) st->protect_rejects);
+	fprintf(stderr, "ECC corrected      : %llu\n", (unsigned long long) st->ecc_corrected);
+	fprintf(stderr, "ECC uncorrectable  : %llu\n", (unsigned long long) st->ecc_uncorrectable);
+	if (sim_s > 0)
+		fprintf(stderr, "Page data rate     : %.3f MB/s (simulated)\n",
+				data / sim_s / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+	W25N_SimConfig_t cfg;
+	bool quiet = false;
+	bool dump = false;
+	int opt;
+
+	W25N_Sim_DefaultConfig(&cfg);
+
+	while ((opt = getopt(argc, argv, "qs:p:e:b:f:t:r:l")) != -1)
+	{
+		switch (opt)
+		{
+		case 'q':
+			quiet = true;
+			break;
+		case 's':
+			cfg.seed = (uint32_t) strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			cfg.bitflip_ppm = (uint32_t) strtoul(optarg, NULL, 0);
+			break;
+		case 'e':
+			cfg.endurance = (uint32_t) strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			cfg.bad_blocks = bad_list;
+			cfg.bad_count = bad_list_len = parse_bad_blocks(optarg);
+			break;
+		case 'f':
+			cfg.spi_hz = (uint32_t) strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			if (sscanf(optarg, "%u,%u,%u", &cfg.t_read_ns, &cfg.t_prog_ns,
+					&cfg.t_erase_ns) != 3)
+				usage();
+			cfg.t_read_ns *= 1000u;
+			cfg.t_prog_ns *= 1000u;
+			cfg.t_erase_ns *= 1000u;
+			break;
+		case 'r':
+			if (strcmp(optarg, "poll") == 0)
+				Nand_SetReadyMode(NAND_READY_POLL);
+			else if (strcmp(optarg, "delay") == 0)
+				Nand_SetReadyMode(NAND_READY_DELAY_POLL);
+			else if (strcmp(optarg, "auto") == 0)
+				Nand_SetReadyMode(NAND_READY_AUTO);
+			else
+				usage();
+			break;
+		case 'l':
+			dump = true;
+			break;
+		default:
+			usage();
+		}
+	}
+
+	if (optind >= argc)
+		usage();
+
+	if (!W25N_Sim_Init(&cfg))
+	{
+		fprintf(stderr, "[SIM] Init failed\n");
+		return 1;
+	}
+
+	NandLog_Init();
+
+	if (quiet && freopen("/dev/null", "w", stdout) == NULL)
+		return 1;
+
+	const char *cmd = argv[optind];
+	uint32_t block = (optind + 1 < argc) ?
+			(uint32_t) strtoul(argv[optind + 1], NULL, 0) : 8;
+	double t0 = host_seconds();
+
+	if (strcmp(cmd, "scan") == 0)
+		ScanInvaliBlocks();
+	else if (strcmp(cmd, "unit") == 0)
+		Standard_UnitTest(block);
+	else if (strcmp(cmd, "endurance") == 0)
+		endurance_run(block);
+	else if (strcmp(cmd, "choose") == 0)
+		ChoseValidBlock();
+	else if (strcmp(cmd, "queue") == 0)
+		queue_run(block);
+	else if (strcmp(cmd, "stream") == 0)
+		stream_run(block);
+	else if (strcmp(cmd, "copy") == 0)
+		copy_run(block);
+	else if (strcmp(cmd, "mount") == 0)
+		mount_run();
+	else if (strcmp(cmd, "lazy") == 0)
+		lazy_run();
+#if NAND_REMAP
+	else if (strcmp(cmd, "remap") == 0)
+		remap_run(block);
+#endif
+	else if (strcmp(cmd, "usb") == 0)
+		usb_run();
+	else if (strcmp(cmd, "gc") == 0)
+		gc_run(optind + 1 < argc && strcmp(argv[optind + 1], "cb") == 0);
+	else if (strcmp(cmd, "log") == 0)
+		log_run();
+	else if (strcmp(cmd, "boot") == 0)
+		boot_run();
+	else
+		usage();
+
+	double host_s = host_seconds() - t0;
+
+	if (dump)
+		NandLog_Dump();
+	else
+		NandLog_Drain(0);
+
+	fflush(stdout);
+	report(cmd, host_s);
+	fprintf(stderr, "Trace records lost : %u\n", (unsigned) NandLog_Ring()->lost);
+
+	W25N_Sim_Free();
+	return sim_failed ? 1 : 0;
+}
@@ -0,0 +1,61 @@
+/*
+ *  sim_transport.c
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator
+ */
+
+#include "sim_transport.h"
+
+static bool sim_command(void *ctx, const uint8_t *cmd, uint16_t cmd_len)
+{
+	(void) ctx;
+	W25N_Sim_Frame(cmd, cmd_len, NULL, NULL, 0);
+	return true;
+}
+
+static bool sim_read(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		uint8_t *buf, uint16_t len)
+{
+	(void) ctx;
+	W25N_Sim_Frame(cmd, cmd_len, NULL, buf, len);
+	return true;
+}
+
+static bool sim_write(void *ctx, const uint8_t *cmd, uint16_t cmd_len,
+		const uint8_t *buf, uint16_t len)
+{
+	(void) ctx;
+	W25N_Sim_Frame(cmd, cmd_len, buf, NULL, len);
+	return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Platform clock for Nand_WaitReadyOp: simulated nanoseconds.
+ * Delays advance the model clock instead of spinning.
+ * --------------------------------------------------------------------------- */
+void NandClock_Init(void)
+{
+}
+
+uint32_t NandClock_Ticks(void)
+{
+	return (uint32_t) W25N_Sim_TimeNs();
+}
+
+uint32_t NandClock_TicksPerUs(void)
+{
+	return 1000U;
+}
+
+void NandClock_DelayUs(uint32_t us)
+{
+	W25N_Sim_AdvanceNs((uint64_t) us * 1000U);
+}
+
+const NandTransport_t NandTransport_Sim =
+{ "W25N02KV simulator", sim_command, sim_read, sim_write, NULL, NULL, NULL };
+
+NandDevice_t NandDev_Default =
+{ &NandTransport_Sim, NULL, NAND_IO_SINGLE, 0, 0, 0 };
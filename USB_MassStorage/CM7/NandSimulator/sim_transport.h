@@ -0,0 +1,29 @@
+/*
+ *  sim_transport.h
+ *
+ *  Created on: Nov 6, 2025
+ *  Author: Henry
+ *  Folder: NandSimulator
+ */
+
+#ifndef NANDSIMULATOR_SIM_TRANSPORT_H_
+#define NANDSIMULATOR_SIM_TRANSPORT_H_
+
+#include "nand_transport.h"
+#include "nand_ready.h"
+#include "W25N02KV_Sim.h"
+
+/* ---------------------------------------------------------------------------
+ * Host Transport
+ * ---------------------------------------------------------------------------
+ * Every transport call is one W25N_Sim_Frame(). There is no hardware status
+ * polling (wait_ready = NULL): Nand_WaitReadyOp polls SR3 through the model,
+ * so polling cost and tRD / tPP / tBE land on the simulated clock. The
+ * NandClock_* platform clock is the simulated clock, timeouts and minimum
+ * delays are simulated time, not host time.
+ *
+ * NandDev_Default is bound to this transport on the host build.
+ * --------------------------------------------------------------------------- */
+extern const NandTransport_t NandTransport_Sim;
+
+#endif /* NANDSIMULATOR_SIM_TRANSPORT_H_ */
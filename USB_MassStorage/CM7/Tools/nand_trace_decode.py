@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+#
+#  nand_trace_decode.py
+#
+#  Created on: Nov 10, 2025
+#  Author: Henry
+#  Folder: Tools
+#
+#  Turns a NandLog trace back into text (host side, not part of the build).
+#
+#  Input:
+#    - UART capture containing NandLog_Dump() output (#NLOG lines), other
+#      lines are ignored, so the whole terminal log can be passed.
+#    - Binary image of the ring (debugger memory dump of .nand_trace,
+#      0x38000000, sizeof(NandLogRing_t)), detected by the "NLOG" magic.
+#
+#  The event table is read from NandController/hal/nand_log.h, so ids and
+#  format strings never have to be kept in sync by hand.
+#
+#  Usage:
+#    nand_trace_decode.py [-H nand_log.h] [-l level] [--tpu N] <capture | ->
+#
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LEVELS = {"OFF": 0, "ERROR": 1, "WARN": 2, "INFO": 3, "DEBUG": 4}
+LEVEL_NAME = {v: k for k, v in LEVELS.items()}
+
+MAGIC = 0x474F4C4E
+RING_HDR = struct.Struct("<8I")       # magic slots tpu head tail lost reserved[2]
+RECORD = struct.Struct("<IIHBB5I")    # seq ts id level argc arg[5]
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "NandController", "hal", "nand_log.h")
+
+EVENT_RE = re.compile(r'X\(\s*(\w+)\s*,\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+CONV_RE = re.compile(r"%([-0 +#]*)(\d*)([udxXc%])")
+
+
+def load_events(path):
+    """Event table in declaration order: id -> (name, level, format)."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+
+    start = text.find("#define NAND_LOG_EVENTS(X)")
+    if start < 0:
+        sys.exit("nand_trace_decode: NAND_LOG_EVENTS not found in " + path)
+
+    body = []
+    for line in text[start:].splitlines():
+        body.append(line)
+        if not line.rstrip().endswith("\\"):
+            break
+
+    events = []
+    for name, level, fmt in EVENT_RE.findall("\n".join(body)):
+        events.append((name, LEVELS.get(level, 1), fmt.encode().decode("unicode_escape")))
+    return events
+
+
+def render(fmt, args):
+    """printf subset used by the event table, on 32-bit arguments."""
+    it = iter(args)
+
+    def conv(m):
+        flags, width, kind = m.groups()
+        if kind == "%":
+            return "%"
+        v = next(it, 0) & 0xFFFFFFFF
+        if kind == "d" and v & 0x80000000:
+            v -= 1 << 32
+        if kind == "c":
+            return chr(v & 0xFF)
+        return ("%" + flags + width + ("d" if kind == "u" else kind)) % v
+
+    return CONV_RE.sub(conv, fmt)
+
+
+def records_from_text(stream):
+    tpu, lost = None, 0
+    recs = []
+    for line in stream:
+        i = line.find("#NLOG ")
+        if i < 0:
+            continue
+        f = line[i:].split()
+        if f[1] in ("BEGIN", "END"):
+            kv = dict(x.split("=", 1) for x in f[2:] if "=" in x)
+            tpu = int(kv.get("tpu", tpu or 0)) or tpu
+            lost = int(kv.get("lost", lost))
+            continue
+        if len(f) < 11:
+            continue
+        seq, ts, eid = int(f[1], 16), int(f[2], 16), int(f[3], 16)
+        level, argc = int(f[4]), int(f[5])
+        args = [int(x, 16) for x in f[6:11]]
+        recs.append((seq, ts, eid, level, argc, args))
+    return tpu, lost, recs
+
+
+def records_from_image(data):
+    magic, slots, tpu, head, tail, lost = RING_HDR.unpack_from(data, 0)[:6]
+    if magic != MAGIC:
+        sys.exit("nand_trace_decode: no NLOG magic at the start of the image")
+
+    recs = []
+    for i in range(slots):
+        off = RING_HDR.size + i * RECORD.size
+        if off + RECORD.size > len(data):
+            break
+        seq, ts, eid, level, argc, *args = RECORD.unpack_from(data, off)
+        if seq != 0:
+            recs.append((seq, ts, eid, level, argc, list(args)))
+
+    # Slots hold the newest record of each index, order by reservation
+    recs.sort(key=lambda r: (r[0] - tail) & 0xFFFFFFFF)
+    recs = [r for r in recs if ((r[0] - 1 - tail) & 0xFFFFFFFF) < 0x80000000]
+    if recs:
+        lost += (recs[0][0] - 1 - tail) & 0xFFFFFFFF   # lapped, not drained yet
+    return tpu, lost, recs
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode a NandLog binary trace")
+    ap.add_argument("input", help="UART capture / ring image, '-' for stdin")
+    ap.add_argument("-H", "--header", default=DEFAULT_HEADER, help="nand_log.h")
+    ap.add_argument("-l", "--level", default="DEBUG", choices=list(LEVELS),
+                    help="highest level printed")
+    ap.add_argument("--tpu", type=int, help="clock ticks per microsecond")
+    ap.add_argument("--raw", action="store_true", help="print absolute ticks")
+    opt = ap.parse_args()
+
+    events = load_events(opt.header)
+
+    if opt.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(opt.input, "rb") as f:
+            data = f.read()
+
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == MAGIC:
+        tpu, lost, recs = records_from_image(data)
+    else:
+        tpu, lost, recs = records_from_text(data.decode("utf-8", "replace").splitlines())
+
+    tpu = opt.tpu or tpu or 1
+    max_level = LEVELS[opt.level]
+
+    t0 = recs[0][1] if recs else 0
+    elapsed, last_ts, prev_seq, gaps = 0, t0, None, 0
+
+    for seq, ts, eid, level, argc, args in recs:
+        elapsed += (ts - last_ts) & 0xFFFFFFFF     # 32-bit tick counter wraps
+        last_ts = ts
+        if prev_seq is not None and seq != prev_seq + 1:
+            gaps += (seq - prev_seq - 1) & 0xFFFFFFFF
+            print("---- %u records missing ----" % ((seq - prev_seq - 1) & 0xFFFFFFFF))
+        prev_seq = seq
+
+        if level > max_level:
+            continue
+
+        if eid < len(events):
+            name, _, fmt = events[eid]
+            text = render(fmt, args[:argc])
+        else:
+            name, text = "EVT_%u" % eid, "args " + " ".join("0x%X" % a for a in args[:argc])
+
+        stamp = "%10u" % ts if opt.raw else "%12.3f us" % (elapsed / tpu)
+        print("%s %-5s %s" % (stamp, LEVEL_NAME.get(level, "?"), text))
+
+    print("---- %u records, %u lost on target, %u missing ----"
+          % (len(recs), lost, gaps), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
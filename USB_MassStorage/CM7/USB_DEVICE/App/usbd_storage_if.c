@@ -23,6 +23,8 @@
 
 /* USER CODE BEGIN INCLUDE */
 
+#include "FlashTranslationLayer.h"
+
 /* USER CODE END INCLUDE */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -195,7 +197,13 @@ int8_t STORAGE_GetCapacity_FS(uint8_t lun, uint32_t *block_num, uint16_t *block_
   /* USER CODE BEGIN 3 */
   UNUSED(lun);
 
-  *block_num  = STORAGE_BLK_NBR;
+  /* Good NAND blocks minus reserves, as sized by FTL_Mount */
+  if (!FTL_IsReady())
+  {
+    return (USBD_FAIL);
+  }
+
+  *block_num  = FTL_SectorCount();
   *block_size = STORAGE_BLK_SIZ;
   return (USBD_OK);
   /* USER CODE END 3 */
@@ -211,7 +219,7 @@ int8_t STORAGE_IsReady_FS(uint8_t lun)
   /* USER CODE BEGIN 4 */
   UNUSED(lun);
 
-  return (USBD_OK);
+  return FTL_IsReady() ? (USBD_OK) : (USBD_FAIL);
   /* USER CODE END 4 */
 }
 
@@ -241,11 +249,9 @@ int8_t STORAGE_Read_FS(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t bl
 {
   /* USER CODE BEGIN 6 */
   UNUSED(lun);
-  UNUSED(buf);
-  UNUSED(blk_addr);
-  UNUSED(blk_len);
 
-  return (USBD_OK);
+  /* blk_len sectors (MSC_MEDIA_PACKET / 512 at most), page-granular below */
+  return FTL_ReadSectors(blk_addr, buf, blk_len) ? (USBD_OK) : (USBD_FAIL);
   /* USER CODE END 6 */
 }
 
@@ -261,11 +267,8 @@ int8_t STORAGE_Write_FS(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t b
 {
   /* USER CODE BEGIN 7 */
   UNUSED(lun);
-  UNUSED(buf);
-  UNUSED(blk_addr);
-  UNUSED(blk_len);
 
-  return (USBD_OK);
+  return FTL_WriteSectors(blk_addr, buf, blk_len) ? (USBD_OK) : (USBD_FAIL);
   /* USER CODE END 7 */
 }
 
@@ -282,6 +285,43 @@ int8_t STORAGE_GetMaxLun_FS(void)
 }
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+/**
+  * @brief  SYNCHRONIZE CACHE / eject: sector write buffer and mapping to NAND.
+  * @param  lun: Logical unit number.
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+int8_t USBD_MSC_SyncCache(uint8_t lun)
+{
+  UNUSED(lun);
+
+  return FTL_Sync() ? (USBD_OK) : (USBD_FAIL);
+}
+
+/**
+  * @brief  FUA write done: its sectors still in the write buffer go to the
+  *         NAND before the CSW (checkpoint left to FTL_Idle).
+  * @param  lun: Logical unit number.
+  * @retval USBD_OK if all operations are OK else USBD_FAIL
+  */
+int8_t USBD_MSC_ForceUnitAccess(uint8_t lun)
+{
+  UNUSED(lun);
+
+  return FTL_Flush() ? (USBD_OK) : (USBD_FAIL);
+}
+
+/**
+  * @brief  Host idle: no BOT command or data phase in progress (not
+  *         configured counts as idle).
+  * @retval 1 if idle else 0
+  */
+uint8_t USBD_MSC_IsIdle(void)
+{
+  USBD_MSC_BOT_HandleTypeDef *hmsc =
+      (USBD_MSC_BOT_HandleTypeDef *)hUsbDeviceFS.pClassDataCmsit[hUsbDeviceFS.classId];
+
+  return (hmsc == NULL) || (hmsc->bot_state == USBD_BOT_IDLE);
+}
 
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
 
@@ -106,6 +106,8 @@ extern USBD_StorageTypeDef USBD_Storage_Interface_fops_FS;
 
 /* USER CODE BEGIN EXPORTED_FUNCTIONS */
 
+uint8_t USBD_MSC_IsIdle(void);
+
 /* USER CODE END EXPORTED_FUNCTIONS */
 
 /**
@@ -39,8 +39,13 @@ extern "C" {
 /** @defgroup USB_INFO_Exported_Defines
   * @{
   */
-#define MODE_SENSE6_LEN                    0x04U
-#define MODE_SENSE10_LEN                   0x08U
+#define MODE_CACHING_PAGE_LEN              0x14U
+#define MODE_SENSE6_LEN                    (0x04U + MODE_CACHING_PAGE_LEN)
+#define MODE_SENSE10_LEN                   (0x08U + MODE_CACHING_PAGE_LEN)
+
+#define MODE_PAGE_CACHING                  0x08U
+#define MODE_PAGE_ALL                      0x3FU
+#define MODE_CACHING_WCE                   0x04U
 #define LENGTH_INQUIRY_PAGE00              0x06U
 #define LENGTH_INQUIRY_PAGE80              0x08U
 #define LENGTH_FORMAT_CAPACITIES           0x14U
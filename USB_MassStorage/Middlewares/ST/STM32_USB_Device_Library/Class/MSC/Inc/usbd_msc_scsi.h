@@ -73,6 +73,9 @@ extern "C" {
 #define SCSI_SEND_DIAGNOSTIC                        0x1DU
 #define SCSI_READ_FORMAT_CAPACITIES                 0x23U
 
+#define SCSI_SYNCHRONIZE_CACHE10                    0x35U
+#define SCSI_SYNCHRONIZE_CACHE16                    0x91U
+
 #define NO_SENSE                                    0U
 #define RECOVERED_ERROR                             1U
 #define NOT_READY                                   2U
@@ -159,6 +162,9 @@ int8_t SCSI_ProcessCmd(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *cmd);
 void SCSI_SenseCode(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t sKey,
                     uint8_t ASC);
 
+int8_t USBD_MSC_SyncCache(uint8_t lun);
+int8_t USBD_MSC_ForceUnitAccess(uint8_t lun);
+
 /**
   * @}
   */
@@ -91,14 +91,29 @@ uint8_t MSC_Page80_Inquiry_Data[LENGTH_INQUIRY_PAGE80] =
 /* USB Mass storage sense 6 Data */
 uint8_t MSC_Mode_Sense6_data[MODE_SENSE6_LEN] =
 {
-  0x03,     /* MODE DATA LENGTH. The number of bytes that follow. */
+  MODE_SENSE6_LEN - 1U, /* MODE DATA LENGTH. The number of bytes that follow. */
   0x00,     /* MEDIUM TYPE. 00h for SBC devices. */
-  0x00,     /* DEVICE-SPECIFIC PARAMETER. For SBC devices:
+  0x10,     /* DEVICE-SPECIFIC PARAMETER. For SBC devices:
              *   bit 7: WP. Set to 1 if the media is write-protected.
              *   bits 6..5: reserved
              *   bit 4: DPOFUA. Set to 1 if the device supports the DPO and FUA bits
              *   bits 3..0: reserved */
-  0x00      /* BLOCK DESCRIPTOR LENGTH */
+  0x00,     /* BLOCK DESCRIPTOR LENGTH */
+  /* Caching mode page (08h), left out unless page 08h / 3Fh is asked for */
+  0x08,     /* PS = 0, PAGE CODE = 08h */
+  0x12,     /* PAGE LENGTH */
+  MODE_CACHING_WCE, /* WCE = 1 (write-back sector buffer, flushed on
+             *   SYNCHRONIZE CACHE / FUA), MF = 0, RCD = 0 */
+  0x00,     /* DEMAND READ / WRITE RETENTION PRIORITY */
+  0x00, 0x00, /* DISABLE PRE-FETCH TRANSFER LENGTH */
+  0x00, 0x00, /* MINIMUM PRE-FETCH */
+  0x00, 0x00, /* MAXIMUM PRE-FETCH */
+  0x00, 0x00, /* MAXIMUM PRE-FETCH CEILING */
+  0x00,     /* FSW, LBCSS, DRA */
+  0x00,     /* NUMBER OF CACHE SEGMENTS */
+  0x00, 0x00, /* CACHE SEGMENT SIZE */
+  0x00,     /* Reserved */
+  0x00, 0x00, 0x00 /* Obsolete */
 };
 
 
@@ -106,9 +121,9 @@ uint8_t MSC_Mode_Sense6_data[MODE_SENSE6_LEN] =
 uint8_t MSC_Mode_Sense10_data[MODE_SENSE10_LEN] =
 {
   0x00,     /* MODE DATA LENGTH MSB. */
-  0x06,     /* MODE DATA LENGTH LSB. The number of bytes that follow. */
+  MODE_SENSE10_LEN - 2U, /* MODE DATA LENGTH LSB. The number of bytes that follow. */
   0x00,     /* MEDIUM TYPE. 00h for SBC devices. */
-  0x00,     /* DEVICE-SPECIFIC PARAMETER. For SBC devices:
+  0x10,     /* DEVICE-SPECIFIC PARAMETER. For SBC devices:
              *   bit 7: WP. Set to 1 if the media is write-protected.
              *   bits 6..5: reserved
              *   bit 4: DPOFUA. Set to 1 if the device supports the DPO and FUA bits
@@ -116,7 +131,22 @@ uint8_t MSC_Mode_Sense10_data[MODE_SENSE10_LEN] =
   0x00,     /* LONGLBA Set to zero */
   0x00,     /* Reserved */
   0x00,     /* BLOCK DESCRIPTOR LENGTH MSB. */
-  0x00      /* BLOCK DESCRIPTOR LENGTH LSB. */
+  0x00,     /* BLOCK DESCRIPTOR LENGTH LSB. */
+  /* Caching mode page (08h), left out unless page 08h / 3Fh is asked for */
+  0x08,     /* PS = 0, PAGE CODE = 08h */
+  0x12,     /* PAGE LENGTH */
+  MODE_CACHING_WCE, /* WCE = 1 (write-back sector buffer, flushed on
+             *   SYNCHRONIZE CACHE / FUA), MF = 0, RCD = 0 */
+  0x00,     /* DEMAND READ / WRITE RETENTION PRIORITY */
+  0x00, 0x00, /* DISABLE PRE-FETCH TRANSFER LENGTH */
+  0x00, 0x00, /* MINIMUM PRE-FETCH */
+  0x00, 0x00, /* MAXIMUM PRE-FETCH */
+  0x00, 0x00, /* MAXIMUM PRE-FETCH CEILING */
+  0x00,     /* FSW, LBCSS, DRA */
+  0x00,     /* NUMBER OF CACHE SEGMENTS */
+  0x00, 0x00, /* CACHE SEGMENT SIZE */
+  0x00,     /* Reserved */
+  0x00, 0x00, 0x00 /* Obsolete */
 };
 /**
   * @}
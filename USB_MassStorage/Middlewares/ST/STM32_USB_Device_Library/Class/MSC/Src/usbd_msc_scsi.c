@@ -92,6 +92,8 @@ static int8_t SCSI_Write12(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *param
 static int8_t SCSI_Read10(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *params);
 static int8_t SCSI_Read12(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *params);
 static int8_t SCSI_Verify10(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *params);
+static int8_t SCSI_SynchronizeCache(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *params);
+static uint16_t SCSI_ModePageLength(uint8_t *pData, uint8_t pageCtl, uint16_t length);
 static int8_t SCSI_CheckAddressRange(USBD_HandleTypeDef *pdev, uint8_t lun,
                                      uint32_t blk_offset, uint32_t blk_nbr);
 
@@ -190,6 +192,11 @@ int8_t SCSI_ProcessCmd(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *cmd)
       ret = SCSI_Verify10(pdev, lun, cmd);
       break;
 
+    case SCSI_SYNCHRONIZE_CACHE10:
+    case SCSI_SYNCHRONIZE_CACHE16:
+      ret = SCSI_SynchronizeCache(pdev, lun, cmd);
+      break;
+
     default:
       SCSI_SenseCode(pdev, lun, ILLEGAL_REQUEST, INVALID_CDB);
       hmsc->bot_status = USBD_BOT_STATUS_ERROR;
@@ -470,13 +477,16 @@ static int8_t SCSI_ModeSense6(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *pa
 {
   UNUSED(lun);
   USBD_MSC_BOT_HandleTypeDef *hmsc = (USBD_MSC_BOT_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
-  uint16_t len = MODE_SENSE6_LEN;
+  uint16_t len;
 
   if (hmsc == NULL)
   {
     return -1;
   }
 
+  len = SCSI_ModePageLength(&MSC_Mode_Sense6_data[4], params[2], MODE_SENSE6_LEN);
+  MSC_Mode_Sense6_data[0] = (uint8_t)(len - 1U);
+
   /* Check If media is write-protected */
   if (((USBD_StorageTypeDef *)pdev->pUserData[pdev->classId])->IsWriteProtected(lun) != 0)
   {
@@ -505,13 +515,16 @@ static int8_t SCSI_ModeSense10(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *p
 {
   UNUSED(lun);
   USBD_MSC_BOT_HandleTypeDef *hmsc = (USBD_MSC_BOT_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
-  uint16_t len = MODE_SENSE10_LEN;
+  uint16_t len;
 
   if (hmsc == NULL)
   {
     return -1;
   }
 
+  len = SCSI_ModePageLength(&MSC_Mode_Sense10_data[8], params[2], MODE_SENSE10_LEN);
+  MSC_Mode_Sense10_data[1] = (uint8_t)(len - 2U);
+
   /* Check If media is write-protected */
   if (((USBD_StorageTypeDef *)pdev->pUserData[pdev->classId])->IsWriteProtected(lun) != 0)
   {
@@ -529,6 +542,30 @@ static int8_t SCSI_ModeSense10(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *p
 }
 
 
+/**
+  * @brief  SCSI_ModePageLength
+  *         Caching mode page of a Mode Sense reply: kept for page 08h and
+  *         3Fh (all pages), WCE reported as not changeable (PC = 01b)
+  * @param  pData: Caching page inside the reply
+  * @param  pageCtl: CDB byte 2 (PC, PAGE CODE)
+  * @param  length: Reply length with the page
+  * @retval Reply length
+  */
+static uint16_t SCSI_ModePageLength(uint8_t *pData, uint8_t pageCtl, uint16_t length)
+{
+  uint8_t page = pageCtl & 0x3FU;
+
+  pData[2] = ((pageCtl & 0xC0U) == 0x40U) ? 0x00U : MODE_CACHING_WCE;
+
+  if ((page != MODE_PAGE_CACHING) && (page != MODE_PAGE_ALL))
+  {
+    return length - MODE_CACHING_PAGE_LEN;
+  }
+
+  return length;
+}
+
+
 /**
   * @brief  SCSI_RequestSense
   *         Process Request Sense command
@@ -646,6 +683,7 @@ static int8_t SCSI_StartStopUnit(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t
   }
   else if ((params[4] & 0x3U) == 0x2U) /* START=0 and LOEJ Load Eject=1 */
   {
+    (void)USBD_MSC_SyncCache(lun);
     hmsc->scsi_medium_state = SCSI_MEDIUM_EJECTED;
   }
   else if ((params[4] & 0x3U) == 0x3U) /* START=1 and LOEJ Load Eject=1 */
@@ -1043,6 +1081,64 @@ static int8_t SCSI_Verify10(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *para
   return 0;
 }
 
+/**
+  * @brief  SCSI_SynchronizeCache
+  *         Process Synchronize Cache (10) / (16) command: the whole medium is
+  *         flushed, the LBA range is not looked at
+  * @param  lun: Logical unit number
+  * @param  params: Command parameters
+  * @retval status
+  */
+static int8_t SCSI_SynchronizeCache(USBD_HandleTypeDef *pdev, uint8_t lun, uint8_t *params)
+{
+  UNUSED(params);
+  USBD_MSC_BOT_HandleTypeDef *hmsc = (USBD_MSC_BOT_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
+
+  if (hmsc == NULL)
+  {
+    return -1;
+  }
+
+  if (USBD_MSC_SyncCache(lun) != 0)
+  {
+    SCSI_SenseCode(pdev, lun, HARDWARE_ERROR, WRITE_FAULT);
+    return -1;
+  }
+
+  hmsc->bot_data_length = 0U;
+
+  return 0;
+}
+
+/**
+  * @brief  USBD_MSC_SyncCache
+  *         Write data held by the storage back to the medium (Synchronize
+  *         Cache, eject). Storage without a write cache has nothing to do.
+  * @param  lun: Logical unit number
+  * @retval 0 if all operations are OK else -1
+  */
+__weak int8_t USBD_MSC_SyncCache(uint8_t lun)
+{
+  UNUSED(lun);
+
+  return 0;
+}
+
+/**
+  * @brief  USBD_MSC_ForceUnitAccess
+  *         Write data of a FUA write command still held by the storage to
+  *         the medium before its status goes out. Storage without a write
+  *         cache has nothing to do.
+  * @param  lun: Logical unit number
+  * @retval 0 if all operations are OK else -1
+  */
+__weak int8_t USBD_MSC_ForceUnitAccess(uint8_t lun)
+{
+  UNUSED(lun);
+
+  return 0;
+}
+
 /**
   * @brief  SCSI_CheckAddressRange
   *         Check address range
@@ -1160,6 +1256,13 @@ static int8_t SCSI_ProcessWrite(USBD_HandleTypeDef *pdev, uint8_t lun)
 
   if (hmsc->scsi_blk_len == 0U)
   {
+    /* FUA (Write10 / Write12 CDB byte 1 bit 3): on the medium before the CSW */
+    if (((hmsc->cbw.CB[1] & 0x08U) != 0U) && (USBD_MSC_ForceUnitAccess(lun) != 0))
+    {
+      SCSI_SenseCode(pdev, lun, HARDWARE_ERROR, WRITE_FAULT);
+      return -1;
+    }
+
     MSC_BOT_SendCSW(pdev, USBD_CSW_CMD_PASSED);
   }
   else